@@ -70,10 +70,9 @@ void BulletBill::update() {
 
 void BulletBill::draw() {
 
-    std::map<std::string, Texture2D> &textures = ResourceManager::getTextures();
-    const char dir = facingDirection == DIRECTION_RIGHT ? 'R' : 'L';
+    const TextureId texture = facingDirection == DIRECTION_RIGHT ? TEXTURE_BULLET_BILL_0_R : TEXTURE_BULLET_BILL_0_L;
 
-    DrawTexturePro( textures[std::string( TextFormat( "bulletBill%d%c", currentFrame, dir ) )],
+    DrawTexturePro( ResourceManager::getTexture( texture ),
                     Rectangle( 0, 0, dim.x, dim.y ),
                     Rectangle( pos.x + dim.x / 2, pos.y + dim.y / 2, dim.x, dim.y ),
                     Vector2( dim.x / 2, dim.y / 2 ), angle, WHITE );
@@ -72,10 +72,13 @@ void BuzzyBeetle::update() {
 
 void BuzzyBeetle::draw() {
 
-    std::map<std::string, Texture2D> &textures = ResourceManager::getTextures();
-    const char dir = facingDirection == DIRECTION_RIGHT ? 'R' : 'L';
+    static constexpr TextureId frames[2][2] = {
+        { TEXTURE_BUZZY_BEETLE_0_R, TEXTURE_BUZZY_BEETLE_0_L },
+        { TEXTURE_BUZZY_BEETLE_1_R, TEXTURE_BUZZY_BEETLE_1_L }
+    };
+    const int dir = facingDirection == DIRECTION_RIGHT ? 0 : 1;
 
-    DrawTexturePro( textures[std::string( TextFormat( "buzzyBeetle%d%c", currentFrame, dir ) )],
+    DrawTexturePro( ResourceManager::getTexture( frames[currentFrame][dir] ),
                     Rectangle( 0, 0, dim.x, dim.y ),
                     Rectangle( pos.x + dim.x / 2, pos.y + dim.y / 2, dim.x, dim.y ),
                     Vector2( dim.x / 2, dim.y / 2 ), angle, WHITE );
@@ -23,7 +23,7 @@ void CloudBlock::update() {}
 
 void CloudBlock::draw() {
 
-    DrawTexture( ResourceManager::getTextures()["blockCloud"], pos.x, pos.y, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_BLOCK_CLOUD ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug && color.a != 0 ) {
         DrawRectangle( pos.x, pos.y, dim.x, dim.y, Fade( color, 0.5 ) );
@@ -33,7 +33,8 @@ void Coin::update() {
 
 void Coin::draw() {
 
-    DrawTexture( ResourceManager::getTextures()[std::string( TextFormat( "coin%d", currentFrame ))], pos.x, pos.y, WHITE );
+    static constexpr TextureId frames[4] = { TEXTURE_COIN_0, TEXTURE_COIN_1, TEXTURE_COIN_2, TEXTURE_COIN_3 };
+    DrawTexture( ResourceManager::getTexture( frames[currentFrame] ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug ) {
         cpN.draw();
@@ -45,7 +46,7 @@ void Coin::draw() {
 }
 
 void Coin::playCollisionSound() {
-    PlaySound( ResourceManager::getSounds()["coin"] );
+    PlaySound( ResourceManager::getSound( SOUND_COIN ) );
 }
 
 void Coin::updateMario( Mario& mario ) {
@@ -53,6 +54,6 @@ void Coin::updateMario( Mario& mario ) {
     if ( mario.getCoins() >= 100 ) {
         mario.addLives( 1 );
         mario.setCoins( mario.getCoins() - 100 );
-        PlaySound( ResourceManager::getSounds()["1up"] );
+        PlaySound( ResourceManager::getSound( SOUND_1_UP ) );
     }
 }
\ No newline at end of file
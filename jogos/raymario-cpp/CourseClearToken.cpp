@@ -41,7 +41,7 @@ void CourseClearToken::update() {
 
 void CourseClearToken::draw() {
 
-    DrawTexture( ResourceManager::getTextures()["courseClearToken"], pos.x, pos.y, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_COURSE_CLEAR_TOKEN ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug ) {
         cpN.draw();
@@ -23,7 +23,7 @@ void EyesClosedBlock::update() {}
 
 void EyesClosedBlock::draw() {
 
-    DrawTexture( ResourceManager::getTextures()["blockEyesClosed"], pos.x, pos.y, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_BLOCK_EYES_CLOSED ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug && color.a != 0 ) {
         DrawRectangle( pos.x, pos.y, dim.x, dim.y, Fade( color, 0.5 ) );
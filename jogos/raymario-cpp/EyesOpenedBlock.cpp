@@ -47,9 +47,10 @@ void EyesOpenedBlock::update() {
 void EyesOpenedBlock::draw() {
 
     if ( hit ) {
-        DrawTexture( ResourceManager::getTextures()[std::string( TextFormat( "blockEyesOpened%d", currentFrame ) )], pos.x, pos.y, WHITE );
+        static constexpr TextureId frames[4] = { TEXTURE_BLOCK_EYES_OPENED_0, TEXTURE_BLOCK_EYES_OPENED_1, TEXTURE_BLOCK_EYES_OPENED_2, TEXTURE_BLOCK_EYES_OPENED_3 };
+        DrawTexture( ResourceManager::getTexture( frames[currentFrame] ), pos.x, pos.y, WHITE );
     } else {
-        DrawTexture( ResourceManager::getTextures()["blockEyesOpened0"], pos.x, pos.y, WHITE );
+        DrawTexture( ResourceManager::getTexture( TEXTURE_BLOCK_EYES_OPENED_0 ), pos.x, pos.y, WHITE );
     }
 
     if ( GameWorld::debug && color.a != 0 ) {
@@ -60,7 +61,7 @@ void EyesOpenedBlock::draw() {
 
 void EyesOpenedBlock::doHit( Mario& mario, Map *map ) {
     if ( !hit ) {
-        PlaySound( ResourceManager::getSounds()["shellRicochet"] );
+        PlaySound( ResourceManager::getSound( SOUND_SHELL_RICOCHET ) );
         hit = true;
         state = SPRITE_STATE_NO_COLLIDABLE;
     }
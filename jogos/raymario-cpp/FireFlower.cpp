@@ -32,7 +32,8 @@ void FireFlower::update() {
 
 void FireFlower::draw() {
 
-    DrawTexture( ResourceManager::getTextures()[std::string( TextFormat( "fireFlower%d", currentFrame ) )], pos.x, pos.y, WHITE );
+    static constexpr TextureId frames[2] = { TEXTURE_FIRE_FLOWER_0, TEXTURE_FIRE_FLOWER_1 };
+    DrawTexture( ResourceManager::getTexture( frames[currentFrame] ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug ) {
         cpN.draw();
@@ -44,7 +45,7 @@ void FireFlower::draw() {
 }
 
 void FireFlower::playCollisionSound() {
-    PlaySound( ResourceManager::getSounds()["powerUp"] );
+    PlaySound( ResourceManager::getSound( SOUND_POWER_UP ) );
 }
 
 void FireFlower::updateMario( Mario& mario ) {
@@ -60,7 +61,7 @@ void FireFlower::updateMario( Mario& mario ) {
             switch ( mario.getReservedPowerUp() ) {
                 case MARIO_TYPE_SMALL:
                     mario.setReservedPowerUp( MARIO_TYPE_SUPER );
-                    PlaySound( ResourceManager::getSounds()["reserveItemStore"] );
+                    PlaySound( ResourceManager::getSound( SOUND_RESERVE_ITEM_STORE ) );
                     break;
                 case MARIO_TYPE_SUPER:
                     break;
@@ -72,11 +73,11 @@ void FireFlower::updateMario( Mario& mario ) {
             switch ( mario.getReservedPowerUp() ) {
                 case MARIO_TYPE_SMALL:
                     mario.setReservedPowerUp( MARIO_TYPE_FLOWER );
-                    PlaySound( ResourceManager::getSounds()["reserveItemStore"] );
+                    PlaySound( ResourceManager::getSound( SOUND_RESERVE_ITEM_STORE ) );
                     break;
                 case MARIO_TYPE_SUPER:
                     mario.setReservedPowerUp( MARIO_TYPE_FLOWER );
-                    PlaySound( ResourceManager::getSounds()["reserveItemStore"] );
+                    PlaySound( ResourceManager::getSound( SOUND_RESERVE_ITEM_STORE ) );
                     break;
                 case MARIO_TYPE_FLOWER:
                     break;
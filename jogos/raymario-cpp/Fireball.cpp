@@ -50,8 +50,14 @@ void Fireball::update() {
 
 void Fireball::draw() {
 
-    const char dir = facingDirection == DIRECTION_RIGHT ? 'R' : 'L';
-    DrawTexture( ResourceManager::getTextures()[std::string( TextFormat( "fireball%d%c", currentFrame, dir ))], pos.x, pos.y, WHITE );
+    static constexpr TextureId frames[4][2] = {
+        { TEXTURE_FIREBALL_0_R, TEXTURE_FIREBALL_0_L },
+        { TEXTURE_FIREBALL_1_R, TEXTURE_FIREBALL_1_L },
+        { TEXTURE_FIREBALL_2_R, TEXTURE_FIREBALL_2_L },
+        { TEXTURE_FIREBALL_3_R, TEXTURE_FIREBALL_3_L }
+    };
+    const int dir = facingDirection == DIRECTION_RIGHT ? 0 : 1;
+    DrawTexture( ResourceManager::getTexture( frames[currentFrame][dir] ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug ) {
         cpN.draw();
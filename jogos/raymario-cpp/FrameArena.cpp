@@ -0,0 +1,109 @@
+/**
+ * @file FrameArena.cpp
+ * @author Prof. Dr. David Buzatto
+ * @brief FrameArena class implementation and the counting global
+ * operator new.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include "FrameArena.h"
+#include "raylib.h"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// every general heap allocation of the game goes through here, so the
+// count per frame shows what is left to move to the frame arena
+static std::atomic<size_t> heapAllocationCount = 0;
+
+void *operator new( std::size_t size ) {
+    heapAllocationCount.fetch_add( 1, std::memory_order_relaxed );
+    if ( void *p = std::malloc( size == 0 ? 1 : size ) ) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete( void *p ) noexcept {
+    std::free( p );
+}
+
+void operator delete( void *p, std::size_t ) noexcept {
+    std::free( p );
+}
+
+alignas( std::max_align_t ) std::byte FrameArena::buffer[FrameArena::CAPACITY];
+size_t FrameArena::used = 0;
+size_t FrameArena::peakUsed = 0;
+size_t FrameArena::overflowCount = 0;
+size_t FrameArena::lastFrameHeapAllocations = 0;
+size_t FrameArena::heapAllocationsAtReset = 0;
+size_t FrameArena::frameCount = 0;
+size_t FrameArena::overflowCountAfterWarmUp = 0;
+
+void *FrameArena::allocate( size_t size, size_t alignment ) {
+
+    const uintptr_t base = reinterpret_cast<uintptr_t>( buffer );
+    const uintptr_t start = ( base + used + alignment - 1 ) & ~( alignment - 1 );
+
+    if ( start + size > base + CAPACITY ) {
+        if ( overflowCount == 0 ) {
+            TraceLog( LOG_WARNING, "FRAME ARENA: %d bytes are not enough, using the heap", static_cast<int>( CAPACITY ) );
+        }
+        overflowCount++;
+        return ::operator new( size );
+    }
+
+    used = start + size - base;
+    if ( peakUsed < used ) {
+        peakUsed = used;
+    }
+
+    return reinterpret_cast<void*>( start );
+
+}
+
+void FrameArena::deallocate( void *p ) {
+    const uintptr_t address = reinterpret_cast<uintptr_t>( p );
+    const uintptr_t base = reinterpret_cast<uintptr_t>( buffer );
+    if ( address < base || address >= base + CAPACITY ) {
+        ::operator delete( p );
+    }
+}
+
+void FrameArena::reset() {
+    used = 0;
+    const size_t count = heapAllocationCount.load( std::memory_order_relaxed );
+    lastFrameHeapAllocations = count - heapAllocationsAtReset;
+    heapAllocationsAtReset = count;
+
+    frameCount++;
+    if ( frameCount == WARM_UP_FRAMES ) {
+        overflowCountAfterWarmUp = overflowCount;
+    }
+    assert( ( frameCount <= WARM_UP_FRAMES || overflowCount == overflowCountAfterWarmUp ) && 
+            "the frame arena used the heap after the warm up" );
+}
+
+size_t FrameArena::getUsedBytes() {
+    return used;
+}
+
+size_t FrameArena::getPeakUsedBytes() {
+    return peakUsed;
+}
+
+size_t FrameArena::getOverflowCount() {
+    return overflowCount;
+}
+
+size_t FrameArena::getHeapAllocationCount() {
+    return heapAllocationCount.load( std::memory_order_relaxed );
+}
+
+size_t FrameArena::getLastFrameHeapAllocationCount() {
+    return lastFrameHeapAllocations;
+}
\ No newline at end of file
@@ -7,9 +7,11 @@
  */
 #include "Baddie.h"
 #include "Block.h"
+#include "FrameArena.h"
 #include "GameState.h"
 #include "GameWorld.h"
 #include "Item.h"
+#include "JobSystem.h"
 #include "Mario.h"
 #include "raylib.h"
 #include "ResourceManager.h"
@@ -17,7 +19,10 @@
 #include "Tile.h"
 #include "utils.h"
 #include <iostream>
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #define RAYGUI_IMPLEMENTATION
@@ -74,7 +79,11 @@ GameWorld::GameWorld() :
     showOverlayOnPause( true ),
     irisOutFinished( false ),
     irisOutTime( 1 ),
-    irisOutAcum( 0 ) {
+    irisOutAcum( 0 ),
+    jobSystem( static_cast<int>( std::thread::hardware_concurrency() ) ),
+    parallelUpdateTime( 0 ),
+    parallelUpdateFrames( 0 ),
+    parallelUpdateAverageTime( 0 ) {
     //mario.changeToSuper();
     //mario.changeToFlower();
 }
@@ -97,13 +106,19 @@ void GameWorld::inputAndUpdate() {
     std::vector<Item*> &staticItems = map.getStaticItems();
     std::vector<Baddie*> &baddies = map.getBaddies();
 
-    std::map<std::string, Sound> &sounds = ResourceManager::getSounds();
-    std::map<std::string, Music> &musics = ResourceManager::getMusics();
-
     if ( IsKeyPressed( KEY_LEFT_ALT ) && ALLOW_ENABLE_CONTROLS ) {
         showControls = !showControls;
     }
 
+    // cycles between 1, 2, 4 and 8 threads to compare the update times
+    if ( IsKeyPressed( KEY_J ) && showControls ) {
+        const int threadCount = jobSystem.getThreadCount();
+        TraceLog( LOG_INFO, "JOB SYSTEM: %d threads, %.3f ms per parallel update", threadCount, parallelUpdateAverageTime * 1000 );
+        jobSystem.setThreadCount( threadCount >= 8 ? 1 : threadCount < 2 ? 2 : threadCount < 4 ? 4 : 8 );
+        parallelUpdateTime = 0;
+        parallelUpdateFrames = 0;
+    }
+
     if ( mario.getState() != SPRITE_STATE_DYING && 
          mario.getState() != SPRITE_STATE_VICTORY &&
          mario.getState() != SPRITE_STATE_WAITING_TO_NEXT_MAP &&
@@ -127,7 +142,7 @@ void GameWorld::inputAndUpdate() {
          state != GAME_STATE_FINISHED &&
          state != GAME_STATE_PAUSED ) {
 
-        std::vector<int> collectedIndexes;
+        FrameVector<int> collectedIndexes;
 
         if ( IsKeyPressed( KEY_ENTER ) || IsGamepadButtonPressed( 0, GAMEPAD_BUTTON_MIDDLE_RIGHT ) ) {
             pauseGame( true, true, true );
@@ -137,23 +152,136 @@ void GameWorld::inputAndUpdate() {
             block->update();
         }
 
-        for ( const auto& item : items ) {
-            item->update();
-        }
-        
-        for ( const auto& staticItem : staticItems ) {
-            staticItem->update();
-        }
+        // items and baddies only change their own state when updating and
+        // colliding with tiles, so each one is processed by one job
+        const double parallelStartTime = GetTime();
 
-        for ( const auto& baddie : baddies ) {
-            baddie->update();
-        }
+        jobSystem.parallelFor( items.size(), ENTITIES_PER_JOB, [&items]( size_t begin, size_t end ) {
+            for ( size_t i = begin; i < end; i++ ) {
+                items[i]->update();
+            }
+        });
+
+        jobSystem.parallelFor( staticItems.size(), ENTITIES_PER_JOB, [&staticItems]( size_t begin, size_t end ) {
+            for ( size_t i = begin; i < end; i++ ) {
+                staticItems[i]->update();
+            }
+        });
+
+        jobSystem.parallelFor( baddies.size(), ENTITIES_PER_JOB, [&baddies]( size_t begin, size_t end ) {
+            for ( size_t i = begin; i < end; i++ ) {
+                baddies[i]->update();
+            }
+        });
 
         // tiles collision resolution
+        // the tiles are visited in the same order for every entity, so the
+        // result doesn't depend on how the entities are split between jobs
+
+        // baddies x tiles
+        jobSystem.parallelFor( baddies.size(), ENTITIES_PER_JOB, [&baddies, &tiles]( size_t begin, size_t end ) {
+
+            for ( size_t i = begin; i < end; i++ ) {
+
+                Baddie *baddie = baddies[i];
+
+                for ( const auto tile : tiles ) {
+
+                    baddie->updateCollisionProbes();
+
+                    if ( baddie->getState() != SPRITE_STATE_DYING ) {
+                        switch ( baddie->checkCollision( tile ) ) {
+                            case COLLISION_TYPE_NORTH:
+                                baddie->setY( tile->getY() + tile->getHeight() );
+                                baddie->setVelY( 0 );
+                                baddie->updateCollisionProbes();
+                                break;
+                            case COLLISION_TYPE_SOUTH:
+                                baddie->setY( tile->getY() - baddie->getHeight() );
+                                baddie->setVelY( 0 );
+                                baddie->onSouthCollision();
+                                baddie->updateCollisionProbes();
+                                break;
+                            case COLLISION_TYPE_EAST:
+                                baddie->setX( tile->getX() - baddie->getWidth() );
+                                baddie->setVelX( -baddie->getVelX() );
+                                baddie->updateCollisionProbes();
+                                break;
+                            case COLLISION_TYPE_WEST:
+                                baddie->setX( tile->getX() + tile->getWidth() );
+                                baddie->setVelX( -baddie->getVelX() );
+                                baddie->updateCollisionProbes();
+                                break;
+                            default:
+                                break;
+                        }
+                    }
+
+                }
+
+            }
+
+        });
+
+        // items x tiles
+        jobSystem.parallelFor( items.size(), ENTITIES_PER_JOB, [&items, &tiles]( size_t begin, size_t end ) {
+
+            for ( size_t i = begin; i < end; i++ ) {
+
+                Item *item = items[i];
+
+                for ( const auto tile : tiles ) {
+
+                    if ( !tile->isOnlyBaddies() ) {
+
+                        item->updateCollisionProbes();
+
+                        switch ( item->checkCollision( tile ) ) {
+                            case COLLISION_TYPE_NORTH:
+                                item->setY( tile->getY() + tile->getHeight() );
+                                item->setVelY( 0 );
+                                item->updateCollisionProbes();
+                                break;
+                            case COLLISION_TYPE_SOUTH:
+                                item->setY( tile->getY() - item->getHeight() );
+                                item->setVelY( 0 );
+                                item->onSouthCollision();
+                                item->updateCollisionProbes();
+                                break;
+                            case COLLISION_TYPE_EAST:
+                                item->setX( tile->getX() - item->getWidth() );
+                                item->setVelX( -item->getVelX() );
+                                item->updateCollisionProbes();
+                                break;
+                            case COLLISION_TYPE_WEST:
+                                item->setX( tile->getX() + tile->getWidth() );
+                                item->setVelX( -item->getVelX() );
+                                item->updateCollisionProbes();
+                                break;
+                            default:
+                                break;
+                        }
+
+                    }
+
+                }
+
+            }
+
+        });
+
+        parallelUpdateTime += GetTime() - parallelStartTime;
+        parallelUpdateFrames++;
+        if ( parallelUpdateFrames == 60 ) {
+            parallelUpdateAverageTime = parallelUpdateTime / parallelUpdateFrames;
+            parallelUpdateTime = 0;
+            parallelUpdateFrames = 0;
+        }
+
+        // mario x tiles
         mario.updateCollisionProbes();
         for ( const auto tile : tiles ) {
 
-            // mario x tiles
             if ( !tile->isOnlyBaddies() ) {
                 switch ( mario.checkCollision( tile ) ) {
                     case COLLISION_TYPE_NORTH:
@@ -182,78 +310,6 @@ void GameWorld::inputAndUpdate() {
                 }
             }
 
-            // baddies x tiles
-            for ( const auto baddie : baddies ) {
-
-                baddie->updateCollisionProbes();
-
-                if ( baddie->getState() != SPRITE_STATE_DYING ) {
-                    switch ( baddie->checkCollision( tile ) ) {
-                        case COLLISION_TYPE_NORTH:
-                            baddie->setY( tile->getY() + tile->getHeight() );
-                            baddie->setVelY( 0 );
-                            baddie->updateCollisionProbes();
-                            break;
-                        case COLLISION_TYPE_SOUTH:
-                            baddie->setY( tile->getY() - baddie->getHeight() );
-                            baddie->setVelY( 0 );
-                            baddie->onSouthCollision();
-                            baddie->updateCollisionProbes();
-                            break;
-                        case COLLISION_TYPE_EAST:
-                            baddie->setX( tile->getX() - baddie->getWidth() );
-                            baddie->setVelX( -baddie->getVelX() );
-                            baddie->updateCollisionProbes();
-                            break;
-                        case COLLISION_TYPE_WEST:
-                            baddie->setX( tile->getX() + tile->getWidth() );
-                            baddie->setVelX( -baddie->getVelX() );
-                            baddie->updateCollisionProbes();
-                            break;
-                        default:
-                            break;
-                    }
-                }
-
-            }
-
-            // items x tiles
-            for ( const auto item : items ) {
-
-                if ( !tile->isOnlyBaddies() ) {
-
-                    item->updateCollisionProbes();
-
-                    switch ( item->checkCollision( tile ) ) {
-                        case COLLISION_TYPE_NORTH:
-                            item->setY( tile->getY() + tile->getHeight() );
-                            item->setVelY( 0 );
-                            item->updateCollisionProbes();
-                            break;
-                        case COLLISION_TYPE_SOUTH:
-                            item->setY( tile->getY() - item->getHeight() );
-                            item->setVelY( 0 );
-                            item->onSouthCollision();
-                            item->updateCollisionProbes();
-                            break;
-                        case COLLISION_TYPE_EAST:
-                            item->setX( tile->getX() - item->getWidth() );
-                            item->setVelX( -item->getVelX() );
-                            item->updateCollisionProbes();
-                            break;
-                        case COLLISION_TYPE_WEST:
-                            item->setX( tile->getX() + tile->getWidth() );
-                            item->setVelX( -item->getVelX() );
-                            item->updateCollisionProbes();
-                            break;
-                        default:
-                            break;
-                    }
-
-                }
-
-            }
-
         }
 
         // blocks collision resolution
@@ -421,7 +477,7 @@ void GameWorld::inputAndUpdate() {
 
                     if ( mario.isInvincible() && col && baddie->getState() != SPRITE_STATE_DYING ) {
                         baddie->onHit();
-                        PlaySound( sounds["stomp"] );
+                        PlaySound( ResourceManager::getSound( SOUND_STOMP ) );
                         mario.addPoints( 200 );
                     } else {
 
@@ -440,13 +496,13 @@ void GameWorld::inputAndUpdate() {
                                                 mario.removeLives( 1 );
                                                 break;
                                             case MARIO_TYPE_SUPER:
-                                                PlaySound( sounds["pipe"] );
+                                                PlaySound( ResourceManager::getSound( SOUND_PIPE ) );
                                                 mario.changeToSmall();
                                                 mario.setInvulnerable( true );
                                                 mario.consumeReservedPowerUp();
                                                 break;
                                             case MARIO_TYPE_FLOWER:
-                                                PlaySound( sounds["pipe"] );
+                                                PlaySound( ResourceManager::getSound( SOUND_PIPE ) );
                                                 mario.changeToSmall();
                                                 mario.setInvulnerable( true );
                                                 mario.consumeReservedPowerUp();
@@ -465,7 +521,7 @@ void GameWorld::inputAndUpdate() {
                                         }
                                         mario.setState( SPRITE_STATE_JUMPING );
                                         baddie->onHit();
-                                        PlaySound( sounds["stomp"] );
+                                        PlaySound( ResourceManager::getSound( SOUND_STOMP ) );
                                         mario.addPoints( 200 );
                                     } else {
                                         if ( !mario.isImmortal() && !mario.isInvulnerable() ) {
@@ -476,13 +532,13 @@ void GameWorld::inputAndUpdate() {
                                                     mario.removeLives( 1 );
                                                     break;
                                                 case MARIO_TYPE_SUPER:
-                                                    PlaySound( sounds["pipe"] );
+                                                    PlaySound( ResourceManager::getSound( SOUND_PIPE ) );
                                                     mario.changeToSmall();
                                                     mario.setInvulnerable( true );
                                                     mario.consumeReservedPowerUp();
                                                     break;
                                                 case MARIO_TYPE_FLOWER:
-                                                    PlaySound( sounds["pipe"] );
+                                                    PlaySound( ResourceManager::getSound( SOUND_PIPE ) );
                                                     mario.changeToSmall();
                                                     mario.setInvulnerable( true );
                                                     mario.consumeReservedPowerUp();
@@ -493,7 +549,7 @@ void GameWorld::inputAndUpdate() {
                                     break;
                                 case COLLISION_TYPE_FIREBALL:
                                     baddie->onHit();
-                                    PlaySound( sounds["stomp"] );
+                                    PlaySound( ResourceManager::getSound( SOUND_STOMP ) );
                                     mario.addPoints( 200 );
                                     break;
                                 default:
@@ -506,7 +562,7 @@ void GameWorld::inputAndUpdate() {
                             if ( col ) {
                                 if ( col == COLLISION_TYPE_FIREBALL ) {
                                     baddie->onHit();
-                                    PlaySound( sounds["stomp"] );
+                                    PlaySound( ResourceManager::getSound( SOUND_STOMP ) );
                                     mario.addPoints( 200 );
                                 } else {
                                     if ( !mario.isImmortal() && !mario.isInvulnerable() ) {
@@ -517,13 +573,13 @@ void GameWorld::inputAndUpdate() {
                                                 mario.removeLives( 1 );
                                                 break;
                                             case MARIO_TYPE_SUPER:
-                                                PlaySound( sounds["pipe"] );
+                                                PlaySound( ResourceManager::getSound( SOUND_PIPE ) );
                                                 mario.changeToSmall();
                                                 mario.setInvulnerable( true );
                                                 mario.consumeReservedPowerUp();
                                                 break;
                                             case MARIO_TYPE_FLOWER:
-                                                PlaySound( sounds["pipe"] );
+                                                PlaySound( ResourceManager::getSound( SOUND_PIPE ) );
                                                 mario.changeToSmall();
                                                 mario.setInvulnerable( true );
                                                 mario.consumeReservedPowerUp();
@@ -585,17 +641,17 @@ void GameWorld::inputAndUpdate() {
 
     } else if ( state == GAME_STATE_COUNTING_POINTS ) {
 
-        if ( !IsMusicStreamPlaying( musics["courseClear"] ) ) {
-            PlayMusicStream( ResourceManager::getMusics()["courseClear"] );
+        if ( !IsMusicStreamPlaying( ResourceManager::getMusic( MUSIC_COURSE_CLEAR ) ) ) {
+            PlayMusicStream( ResourceManager::getMusic( MUSIC_COURSE_CLEAR ) );
         } else {
-            UpdateMusicStream( musics["courseClear"] );
+            UpdateMusicStream( ResourceManager::getMusic( MUSIC_COURSE_CLEAR ) );
         }
 
         remainingTimePointCount--;
         mario.addPoints( 50 );
 
         if ( remainingTimePointCount % 3 == 0 ) {
-            PlaySound( sounds["coin"] );
+            PlaySound( ResourceManager::getSound( SOUND_COIN ) );
         }
 
         if ( remainingTimePointCount == 0 ) {
@@ -604,15 +660,15 @@ void GameWorld::inputAndUpdate() {
 
     } else if ( state == GAME_STATE_IRIS_OUT ) {
 
-        if ( !IsMusicStreamPlaying( musics["courseClear"] ) ) {
-            StopMusicStream( musics["courseClear"] );
-            PlaySound( sounds["goalIrisOut"] );
+        if ( !IsMusicStreamPlaying( ResourceManager::getMusic( MUSIC_COURSE_CLEAR ) ) ) {
+            StopMusicStream( ResourceManager::getMusic( MUSIC_COURSE_CLEAR ) );
+            PlaySound( ResourceManager::getSound( SOUND_GOAL_IRIS_OUT ) );
             state = GAME_STATE_GO_TO_NEXT_MAP;
             irisOutAcum = 0;
         } else {
-            UpdateMusicStream( musics["courseClear"] );
-            if ( static_cast<int>(GetMusicTimeLength( musics["courseClear"] )) == static_cast<int>(GetMusicTimePlayed( musics["courseClear"] )) ) {
-                StopMusicStream( musics["courseClear"] );
+            UpdateMusicStream( ResourceManager::getMusic( MUSIC_COURSE_CLEAR ) );
+            if ( static_cast<int>(GetMusicTimeLength( ResourceManager::getMusic( MUSIC_COURSE_CLEAR ) )) == static_cast<int>(GetMusicTimePlayed( ResourceManager::getMusic( MUSIC_COURSE_CLEAR ) )) ) {
+                StopMusicStream( ResourceManager::getMusic( MUSIC_COURSE_CLEAR ) );
             }
         }
 
@@ -687,14 +743,14 @@ void GameWorld::inputAndUpdate() {
 
     if ( state == GAME_STATE_TITLE_SCREEN ) {
 
-        if ( !IsMusicStreamPlaying( musics["title"] ) ) {
-            PlayMusicStream( musics["title"] );
+        if ( !IsMusicStreamPlaying( ResourceManager::getMusic( MUSIC_TITLE ) ) ) {
+            PlayMusicStream( ResourceManager::getMusic( MUSIC_TITLE ) );
         } else {
-            UpdateMusicStream( musics["title"] );
+            UpdateMusicStream( ResourceManager::getMusic( MUSIC_TITLE ) );
         }
 
         if ( GetKeyPressed() && !IsKeyPressed( KEY_LEFT_ALT ) ) {
-            StopMusicStream( musics["title"] );
+            StopMusicStream( ResourceManager::getMusic( MUSIC_TITLE ) );
             state = GAME_STATE_PLAYING;
         }
 
@@ -716,7 +772,6 @@ void GameWorld::draw() {
 
     int columns = GetScreenWidth() / Map::TILE_WIDTH;
     int lines = GetScreenHeight() / Map::TILE_WIDTH;
-    std::map<std::string, Texture2D>& textures = ResourceManager::getTextures();
 
     if ( state != GAME_STATE_GAME_OVER && state != GAME_STATE_TITLE_SCREEN ) {
 
@@ -740,21 +795,21 @@ void GameWorld::draw() {
 
         if ( state == GAME_STATE_TIME_UP ) {
 
-            Texture2D* t = &textures["guiTimeUp"];
+            Texture2D* t = &ResourceManager::getTexture( TEXTURE_GUI_TIME_UP );
             DrawTexture( *t, GetScreenWidth() / 2 - t->width / 2, GetScreenHeight() / 2 - t->height / 2, WHITE );
 
         } else if ( state == GAME_STATE_COUNTING_POINTS || state == GAME_STATE_IRIS_OUT || state == GAME_STATE_GO_TO_NEXT_MAP ) {
 
             Vector2 sc( GetScreenWidth() / 2, GetScreenHeight() / 2 );
-            DrawTexture( textures["guiMario"], sc.x - textures["guiMario"].width / 2, sc.y - 120, WHITE);
+            DrawTexture( ResourceManager::getTexture( TEXTURE_GUI_MARIO ), sc.x - ResourceManager::getTexture( TEXTURE_GUI_MARIO ).width / 2, sc.y - 120, WHITE);
 
-            std::string message1 = "course clear!";
+            const std::string_view message1 = "course clear!";
             drawString( message1, sc.x - getDrawStringWidth( message1 ) / 2, sc.y - 80 );
 
-            int clockWidth = textures["guiClock"].width;
+            int clockWidth = ResourceManager::getTexture( TEXTURE_GUI_CLOCK ).width;
             int remainingTimeWidth = getSmallNumberWidth( mario.getRemainingTime() );
             int pointsPerSecondWidth = getSmallNumberWidth( 50 );
-            int timesWidth = textures["guiX"].width;
+            int timesWidth = ResourceManager::getTexture( TEXTURE_GUI_X ).width;
             int equalSignWidth = getDrawStringWidth( "=" );
             int totalTimePoints = mario.getRemainingTime() * 50;
             int totalTimePointsWidth = getSmallNumberWidth( totalTimePoints );
@@ -762,9 +817,9 @@ void GameWorld::draw() {
             int completeMessageStart = sc.x - (completeMessageWidth/2);
             int completeMessageY = sc.y - 40;
 
-            DrawTexture( textures["guiClock"], completeMessageStart, completeMessageY, WHITE );
+            DrawTexture( ResourceManager::getTexture( TEXTURE_GUI_CLOCK ), completeMessageStart, completeMessageY, WHITE );
             drawWhiteSmallNumber( mario.getRemainingTime(), completeMessageStart + clockWidth, completeMessageY );
-            DrawTexture( textures["guiX"], completeMessageStart + clockWidth + remainingTimeWidth, completeMessageY, WHITE );
+            DrawTexture( ResourceManager::getTexture( TEXTURE_GUI_X ), completeMessageStart + clockWidth + remainingTimeWidth, completeMessageY, WHITE );
             drawWhiteSmallNumber( 50, completeMessageStart + clockWidth + remainingTimeWidth + timesWidth, completeMessageY );
             drawString( "=", completeMessageStart + clockWidth + remainingTimeWidth + timesWidth + pointsPerSecondWidth, completeMessageY - 4 );
             drawWhiteSmallNumber( totalTimePoints, completeMessageStart + clockWidth + remainingTimeWidth + timesWidth + pointsPerSecondWidth + equalSignWidth, completeMessageY );
@@ -777,23 +832,23 @@ void GameWorld::draw() {
 
         } else if ( state == GAME_STATE_FINISHED ) {
 
-            if ( !IsMusicStreamPlaying( ResourceManager::getMusics()["ending"] ) ) {
-                PlayMusicStream( ResourceManager::getMusics()["ending"] );
+            if ( !IsMusicStreamPlaying( ResourceManager::getMusic( MUSIC_ENDING ) ) ) {
+                PlayMusicStream( ResourceManager::getMusic( MUSIC_ENDING ) );
             } else {
-                UpdateMusicStream( ResourceManager::getMusics()["ending"] );
+                UpdateMusicStream( ResourceManager::getMusic( MUSIC_ENDING ) );
             }
 
             if ( GetKeyPressed() ) {
-                StopMusicStream( ResourceManager::getMusics()["ending"] );
+                StopMusicStream( ResourceManager::getMusic( MUSIC_ENDING ) );
                 resetGame();
             }
 
             DrawRectangle( 0, 0, GetScreenWidth(), GetScreenHeight(), Fade( RAYWHITE, 0.9 ) );
-            Texture2D* t = &textures["guiCredits"];
+            Texture2D* t = &ResourceManager::getTexture( TEXTURE_GUI_CREDITS );
             DrawTexture( *t, GetScreenWidth() / 2 - t->width / 2, 20, WHITE );
 
-            std::string message1 = "Thank you for playing!!!";
-            std::string message2 = "Press any key to restart!";
+            const std::string_view message1 = "Thank you for playing!!!";
+            const std::string_view message2 = "Press any key to restart!";
 
             drawString( message1, GetScreenWidth() / 2 - getDrawStringWidth( message1 ) / 2, t->height + 40 );
             drawString( message2, GetScreenWidth() / 2 - getDrawStringWidth( message2 ) / 2, t->height + 65 );
@@ -807,13 +862,12 @@ void GameWorld::draw() {
     } else if ( state == GAME_STATE_TITLE_SCREEN ) {
 
         DrawRectangle( 0, 0, GetScreenWidth(), GetScreenHeight(), RAYWHITE );
-        Texture2D* t = &textures["guiRayMarioLogo"];
+        Texture2D* t = &ResourceManager::getTexture( TEXTURE_GUI_RAY_MARIO_LOGO );
         DrawTexture( *t, GetScreenWidth() / 2 - t->width / 2, GetScreenHeight() / 2 - t->height, WHITE );
 
-        std::string message1 = "Press any key to start!";
-        std::string message2 = "Developed by:";
-        std::string message3 = "Prof. Dr. David Buzatto - IFSP";
-        std::string message4 = "2024";
+        const std::string_view message1 = "Press any key to start!";
+        const std::string_view message2 = "Developed by:";
+        const std::string_view message3 = "Prof. Dr. David Buzatto - IFSP";
         drawString( message1, GetScreenWidth() / 2 - getDrawStringWidth( message1 ) / 2, GetScreenHeight() / 2 + getDrawStringHeight() + 30 );
         drawString( message2, GetScreenWidth() / 2 - getDrawStringWidth( message2 ) / 2, GetScreenHeight() / 2 + getDrawStringHeight() * 5 + 30 );
         drawString( message3, GetScreenWidth() / 2 - getDrawStringWidth( message3 ) / 2, GetScreenHeight() / 2 + getDrawStringHeight() * 6 + 35 );
@@ -827,7 +881,7 @@ void GameWorld::draw() {
     } else if ( state == GAME_STATE_GAME_OVER ) {
 
         DrawRectangle( 0, 0, GetScreenWidth(), GetScreenHeight(), BLACK );
-        Texture2D* t = &textures["guiGameOver"];
+        Texture2D* t = &ResourceManager::getTexture( TEXTURE_GUI_GAME_OVER );
         DrawTexture( *t, GetScreenWidth() / 2 - t->width / 2, GetScreenHeight() / 2 - t->height / 2, WHITE );
 
     }
@@ -846,12 +900,27 @@ void GameWorld::draw() {
             DrawRectangle( guiPanelRect.x, guiPanelRect.y - 30, guiPanelRect.width, 25, Fade( WHITE, 0.9 ) );
             DrawRectangleLines( guiPanelRect.x, guiPanelRect.y - 30, guiPanelRect.width, 25, GRAY );
             DrawFPS( guiPanelRect.x + compMargin, guiPanelRect.y - 27 );
+            DrawRectangle( guiPanelRect.x - 190, guiPanelRect.y - 30, 180, 25, Fade( WHITE, 0.9 ) );
+            DrawRectangleLines( guiPanelRect.x - 190, guiPanelRect.y - 30, 180, 25, GRAY );
+            DrawText( 
+                TextFormat( "%d thr: %.3f ms (J)", jobSystem.getThreadCount(), parallelUpdateAverageTime * 1000 ), 
+                guiPanelRect.x - 185, guiPanelRect.y - 25, 14, BLACK );
+            DrawRectangle( guiPanelRect.x - 190, guiPanelRect.y - 60, 290, 25, Fade( WHITE, 0.9 ) );
+            DrawRectangleLines( guiPanelRect.x - 190, guiPanelRect.y - 60, 290, 25, GRAY );
+            DrawText( 
+                TextFormat( "heap: %d/frame arena: %d KB peak", 
+                            static_cast<int>( FrameArena::getLastFrameHeapAllocationCount() ), 
+                            static_cast<int>( FrameArena::getPeakUsedBytes() / 1024 ) ), 
+                guiPanelRect.x - 185, guiPanelRect.y - 55, 14, BLACK );
         }
 
     }
 
     EndDrawing();
 
+    // everything allocated in the frame arena during this frame is discarded
+    FrameArena::reset();
+
 }
 
 /**
@@ -899,7 +968,7 @@ void GameWorld::nextMap() {
 
 void GameWorld::pauseGame( bool playPauseSFX, bool pauseMusic, bool showOverlay ) {
     if ( playPauseSFX ) {
-        PlaySound( ResourceManager::getSounds()["pause"] );
+        PlaySound( ResourceManager::getSound( SOUND_PAUSE ) );
     }
     this->pauseMusic = pauseMusic;
     showOverlayOnPause = showOverlay;
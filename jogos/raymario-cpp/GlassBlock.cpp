@@ -23,7 +23,7 @@ void GlassBlock::update() {}
 
 void GlassBlock::draw() {
 
-    DrawTexture( ResourceManager::getTextures()["blockGlass"], pos.x, pos.y, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_BLOCK_GLASS ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug && color.a != 0 ) {
         DrawRectangle( pos.x, pos.y, dim.x, dim.y, Fade( color, 0.5 ) );
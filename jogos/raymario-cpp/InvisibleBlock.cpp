@@ -58,11 +58,12 @@ void InvisibleBlock::update() {
 void InvisibleBlock::draw() {
 
     if ( coinAnimationStarted ) {
-        DrawTexture( ResourceManager::getTextures()[std::string( TextFormat( "coin%d", coinAnimationFrame ) )], pos.x + 4, coinY, WHITE );
+        static constexpr TextureId coinFrames[4] = { TEXTURE_COIN_0, TEXTURE_COIN_1, TEXTURE_COIN_2, TEXTURE_COIN_3 };
+        DrawTexture( ResourceManager::getTexture( coinFrames[coinAnimationFrame] ), pos.x + 4, coinY, WHITE );
     }
 
     if ( hit ) {
-        DrawTexture( ResourceManager::getTextures()["blockEyesClosed"], pos.x, pos.y, WHITE );
+        DrawTexture( ResourceManager::getTexture( TEXTURE_BLOCK_EYES_CLOSED ), pos.x, pos.y, WHITE );
     } else {
         // invisible!
     }
@@ -75,7 +76,7 @@ void InvisibleBlock::draw() {
 
 void InvisibleBlock::doHit( Mario& mario, Map *map ) {
     if ( !hit ) {
-        PlaySound( ResourceManager::getSounds()["coin"] );
+        PlaySound( ResourceManager::getSound( SOUND_COIN ) );
         hit = true;
         coinAnimationStarted = true;
         coinY = pos.y;
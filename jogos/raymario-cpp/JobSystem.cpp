@@ -0,0 +1,198 @@
+/**
+ * @file JobSystem.cpp
+ * @author Prof. Dr. David Buzatto
+ * @brief JobSystem class implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+JobSystem::JobSystem( int threadCount ) :
+    threadCount( std::max( threadCount, 1 ) ),
+    pendingJobs( 0 ),
+    queuedJobs( 0 ),
+    running( false ) {
+    startWorkers();
+}
+
+JobSystem::~JobSystem() {
+    stopWorkers();
+}
+
+void JobSystem::startWorkers() {
+
+    // queue 0 belongs to the calling thread
+    queues.clear();
+    for ( int i = 0; i < threadCount; i++ ) {
+        queues.push_back( std::make_unique<JobQueue>() );
+    }
+
+    running = true;
+    for ( int i = 1; i < threadCount; i++ ) {
+        workers.emplace_back( &JobSystem::workerLoop, this, i );
+    }
+
+}
+
+void JobSystem::stopWorkers() {
+
+    {
+        std::lock_guard<std::mutex> lock( sleepMutex );
+        running = false;
+    }
+    wakeUp.notify_all();
+
+    for ( auto &worker : workers ) {
+        worker.join();
+    }
+    workers.clear();
+
+}
+
+void JobSystem::workerLoop( int queueIndex ) {
+
+    Job job;
+
+    while ( true ) {
+
+        if ( popOrSteal( queueIndex, job ) ) {
+            execute( job );
+            continue;
+        }
+
+        // sleeps until there are jobs nobody took, not just jobs that
+        // are still running somewhere else
+        std::unique_lock<std::mutex> lock( sleepMutex );
+        wakeUp.wait( lock, [this]() {
+            return !running || queuedJobs.load() > 0;
+        });
+
+        if ( !running ) {
+            return;
+        }
+
+    }
+
+}
+
+bool JobSystem::popOrSteal( int queueIndex, Job &job ) {
+
+    {
+        JobQueue &own = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock( own.mutex );
+        if ( own.head < own.jobs.size() ) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            queuedJobs.fetch_sub( 1 );
+            if ( own.head == own.jobs.size() ) {
+                own.jobs.clear();
+                own.head = 0;
+            }
+            return true;
+        }
+    }
+
+    for ( int i = 1; i < threadCount; i++ ) {
+        JobQueue &victim = *queues[( queueIndex + i ) % threadCount];
+        std::lock_guard<std::mutex> lock( victim.mutex );
+        if ( victim.head < victim.jobs.size() ) {
+            job = victim.jobs[victim.head++];
+            queuedJobs.fetch_sub( 1 );
+            if ( victim.head == victim.jobs.size() ) {
+                victim.jobs.clear();
+                victim.head = 0;
+            }
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+void JobSystem::execute( const Job &job ) {
+    ( *job.work )( job.begin, job.end );
+    if ( pendingJobs.fetch_sub( 1 ) == 1 ) {
+        // under the lock so the caller can't miss it between its test
+        // and its wait
+        std::lock_guard<std::mutex> lock( sleepMutex );
+        jobsDone.notify_one();
+    }
+}
+
+void JobSystem::parallelFor( size_t count, size_t chunkSize, const std::function<void( size_t, size_t )> &work ) {
+
+    if ( count == 0 ) {
+        return;
+    }
+
+    chunkSize = std::max<size_t>( chunkSize, 1 );
+
+    if ( threadCount == 1 || count <= chunkSize ) {
+        work( 0, count );
+        return;
+    }
+
+    size_t chunks = ( count + chunkSize - 1 ) / chunkSize;
+
+    {
+        // counted before any job is queued, so a worker that finishes one
+        // can't take the count to 0 (or below) while others are still
+        // being pushed; under the lock so a worker can't miss the wake up
+        std::lock_guard<std::mutex> lock( sleepMutex );
+        pendingJobs.fetch_add( chunks );
+    }
+
+    // chunks are dealt round robin, so every thread starts with local work
+    for ( size_t i = 0; i < chunks; i++ ) {
+        JobQueue &queue = *queues[i % threadCount];
+        std::lock_guard<std::mutex> lock( queue.mutex );
+        queue.jobs.push_back( Job{ &work, i * chunkSize, std::min( count, ( i + 1 ) * chunkSize ) } );
+    }
+
+    {
+        // only after the jobs can be taken, so a woken worker finds them;
+        // a worker that took one already made the count negative for a while
+        std::lock_guard<std::mutex> lock( sleepMutex );
+        queuedJobs.fetch_add( static_cast<std::ptrdiff_t>( chunks ) );
+    }
+    wakeUp.notify_all();
+
+    // the calling thread works until nothing is left to take, then sleeps
+    // until the jobs that are still running are done
+    Job job;
+    while ( popOrSteal( 0, job ) ) {
+        execute( job );
+    }
+
+    std::unique_lock<std::mutex> lock( sleepMutex );
+    jobsDone.wait( lock, [this]() {
+        return pendingJobs.load() == 0;
+    });
+
+}
+
+void JobSystem::setThreadCount( int threadCount ) {
+
+    threadCount = std::max( threadCount, 1 );
+
+    if ( threadCount != this->threadCount ) {
+        stopWorkers();
+        this->threadCount = threadCount;
+        startWorkers();
+    }
+
+}
+
+int JobSystem::getThreadCount() const {
+    return threadCount;
+}
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "BuzzyBeetle.h"
 #include "CloudBlock.h"
 #include "Coin.h"
+#include "FrameArena.h"
 #include "CourseClearToken.h"
 #include "ExclamationBlock.h"
 #include "EyesClosedBlock.h"
@@ -35,6 +36,7 @@
 #include "QuestionThreeUpMoonBlock.h"
 #include "raylib.h"
 #include "RedKoopaTroopa.h"
+#include "ResourceId.h"
 #include "ResourceManager.h"
 #include "Rex.h"
 #include "Sprite.h"
@@ -44,13 +46,17 @@
 #include "WoodBlock.h"
 #include "YellowKoopaTroopa.h"
 #include <iostream>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Muncher.h"
 #include "PiranhaPlant.h"
 
+// map loaded when loadTestMap is true
+// mapStress has more than a thousand baddies to measure the parallel update
+#define TEST_MAP_NAME "mapTests"
+
 Map::Map( Mario &mario, int id, bool loadTestMap, bool parseBlocks, bool parseItems, bool parseBaddies, GameWorld *gw ) :
 
     id( id ),
@@ -176,7 +182,7 @@ void Map::draw() {
 
     if ( drawMessage ) {
 
-        std::vector<std::string> messages = split( message, "\\n" );
+        FrameVector<std::string_view> messages = splitFrame( message, "\\n" );
         const Vector2 center = GetScreenToWorld2D( Vector2( GetScreenWidth() / 2, GetScreenHeight() / 2 ), *camera );
         int currentLine = 0;
         const int margin = 10;
@@ -230,25 +236,24 @@ std::vector<Baddie*> &Map::getBaddies() {
 
 void Map::playMusic() const {
 
-    std::map<std::string, Music> musics = ResourceManager::getMusics();
-    const std::string key(TextFormat( "music%d", musicId ));
+    Music &music = ResourceManager::getMusic( stageMusicId( musicId ) );
 
     if ( mario.isInvincible() ) {
-        if ( IsMusicStreamPlaying( musics[key] ) ) {
-            StopMusicStream( musics[key] );
+        if ( IsMusicStreamPlaying( music ) ) {
+            StopMusicStream( music );
         }
-        if ( !IsMusicStreamPlaying( musics["invincible"] ) ) {
-            PlayMusicStream( musics["invincible"] );
-            SeekMusicStream( musics["invincible"], 1 );
+        if ( !IsMusicStreamPlaying( ResourceManager::getMusic( MUSIC_INVINCIBLE ) ) ) {
+            PlayMusicStream( ResourceManager::getMusic( MUSIC_INVINCIBLE ) );
+            SeekMusicStream( ResourceManager::getMusic( MUSIC_INVINCIBLE ), 1 );
         } else {
-            UpdateMusicStream( musics["invincible"] );
+            UpdateMusicStream( ResourceManager::getMusic( MUSIC_INVINCIBLE ) );
         }
     } else {
-        if ( !IsMusicStreamPlaying( musics[key] ) ) {
-            StopMusicStream( musics["invincible"] );
-            PlayMusicStream( musics[key] );
+        if ( !IsMusicStreamPlaying( music ) ) {
+            StopMusicStream( ResourceManager::getMusic( MUSIC_INVINCIBLE ) );
+            PlayMusicStream( music );
         } else {
-            UpdateMusicStream( musics[key] );
+            UpdateMusicStream( music );
         }
     }
 
@@ -263,13 +268,11 @@ void Map::parseMap() {
         int messagePosition = 0;
 
         if ( loadTestMap ) {
-            mapData = LoadFileText( TextFormat( "resources/maps/mapTests.txt" ) );
+            mapData = LoadFileText( TextFormat( "resources/maps/%s.txt", TEST_MAP_NAME ) );
         } else {
             mapData = LoadFileText( TextFormat( "resources/maps/map%d.txt", id ) );
         }
 
-        std::map<std::string, Texture2D> &textures = ResourceManager::getTextures();    
-
         int currentColumn = 0;
         int currentLine = 0;
         bool ignoreLine = false;
@@ -316,7 +319,7 @@ void Map::parseMap() {
                         backgroundId = maxBackgroundId;
                     }
 
-                    backgroundTexture = textures[TextFormat( "background%d", backgroundId )];
+                    backgroundTexture = ResourceManager::getTexture( backgroundTextureId( backgroundId ) );
                     currentColumn = 1;
 
                 } else if ( *mapData == 't' ) {     // parse tile set id
@@ -410,16 +413,16 @@ void Map::parseMap() {
 
                     // test tiles
                     /*case 'a':
-                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), GREEN, "", true ) );
+                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), GREEN, TEXTURE_NONE, true ) );
                         break;
                     case 'b':
-                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), BLUE, "", true ) );
+                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), BLUE, TEXTURE_NONE, true ) );
                         break;
                     case 'c':
-                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), RED, "", true ) );
+                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), RED, TEXTURE_NONE, true ) );
                         break;
                     case 'd':
-                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), ORANGE, "", true ) );
+                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), ORANGE, TEXTURE_NONE, true ) );
                         break;*/
 
                     // blocks
@@ -485,28 +488,26 @@ void Map::parseMap() {
 
                     // bondarie tiles
                     case '/':
-                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), WHITE, "", false ) );
+                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), WHITE, TEXTURE_NONE, false ) );
                         break;
                     case '|':
-                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), WHITE, "", false, true ) );
+                        tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), WHITE, TEXTURE_NONE, false, true ) );
                         break;
 
                     // scenario tiles
-                    case '{': backScenarioTiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), DEBUGGABLE_TILE_COLOR, "tileCourseClearPoleBackTop", true ) );
+                    case '{': backScenarioTiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), DEBUGGABLE_TILE_COLOR, TEXTURE_TILE_COURSE_CLEAR_POLE_BACK_TOP, true ) );
                         break;
-                    case '[': backScenarioTiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), DEBUGGABLE_TILE_COLOR, "tileCourseClearPoleBackBody", true ) );
+                    case '[': backScenarioTiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), DEBUGGABLE_TILE_COLOR, TEXTURE_TILE_COURSE_CLEAR_POLE_BACK_BODY, true ) );
                         break;
-                    case '}': frontScenarioTiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), DEBUGGABLE_TILE_COLOR, "tileCourseClearPoleFrontTop", true ) );
+                    case '}': frontScenarioTiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), DEBUGGABLE_TILE_COLOR, TEXTURE_TILE_COURSE_CLEAR_POLE_FRONT_TOP, true ) );
                         break;
-                    case ']': frontScenarioTiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), DEBUGGABLE_TILE_COLOR, "tileCourseClearPoleFrontBody", true ) );
+                    case ']': frontScenarioTiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), DEBUGGABLE_TILE_COLOR, TEXTURE_TILE_COURSE_CLEAR_POLE_FRONT_BODY, true ) );
                         break;
 
                     // tiles from A to Z (depends on tile set parameter)
                     default:
                         if ( *mapData >= 'A' && *mapData <= 'Z' ) {
-                            std::stringstream ss;
-                            ss << *mapData << tileSetId;
-                            tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), DEBUGGABLE_TILE_COLOR, ss.str(), true ) );
+                            tiles.push_back( new Tile( Vector2( x, y ), Vector2( TILE_WIDTH, TILE_WIDTH ), DEBUGGABLE_TILE_COLOR, tileTextureId( *mapData, tileSetId ), true ) );
                         }
                         break;
 
@@ -694,8 +695,8 @@ void Map::setDrawMessage( bool drawMessage ) {
     }
 }
 
-void Map::setMessage( std::string message ) {
-    this->message = std::move( message );
+void Map::setMessage( std::string_view message ) {
+    this->message = message;
 }
 
 void Map::setCamera( Camera2D* camera ) {
@@ -714,6 +715,10 @@ void Map::reset() {
     drawBlackScreen = false;
     drawBlackScreenFadeAcum = 0;
 
+    // the message belongs to a block that is deleted below
+    drawMessage = false;
+    message = {};
+
     for ( const auto& tile : tiles ) {
         delete tile;
     }
@@ -752,7 +757,7 @@ void Map::reset() {
     frontBaddies.clear();
     backBaddies.clear();
 
-    StopMusicStream( ResourceManager::getMusics()[std::string( TextFormat( "music%d", musicId ) )] );
+    StopMusicStream( ResourceManager::getMusic( stageMusicId( musicId ) ) );
     parsed = false;
     parseMap();
 
@@ -6,6 +6,7 @@
  * @copyright Copyright (c) 2024
  */
 #include "Direction.h"
+#include "FrameArena.h"
 #include "GameState.h"
 #include "GameWorld.h"
 #include "Mario.h"
@@ -96,7 +97,6 @@ void Mario::update() {
 
     const float currentSpeedX = running ? ( drawRunningFrames ? maxSpeedX * 1.3f : maxSpeedX ) : speedX;
     const float currentFrameTime = running && state != SPRITE_STATE_DYING ? frameTimeRunning : frameTimeWalking;
-    std::map<std::string, Sound>& sounds = ResourceManager::getSounds();
 
     if ( ellapsedTime >= maxTime && 
          state != SPRITE_STATE_DYING && 
@@ -171,7 +171,7 @@ void Mario::update() {
             if ( state == SPRITE_STATE_ON_GROUND ) {
                 vel.y = jumpSpeed;
                 state = SPRITE_STATE_JUMPING;
-                PlaySound( sounds["jump"] );
+                PlaySound( ResourceManager::getSound( SOUND_JUMP ) );
             }
         }
 
@@ -184,11 +184,11 @@ void Mario::update() {
             } else {
                 fireballs.push_back( Fireball( Vector2( pos.x, pos.y + dim.y / 2 - 3 ), Vector2( 16, 16 ), Vector2( -400, 100 ), RED, DIRECTION_LEFT, 2 ) );
             }
-            PlaySound( sounds["fireball"] );
+            PlaySound( ResourceManager::getSound( SOUND_FIREBALL ) );
 
         }
 
-        std::vector<int> collectedIndexes;
+        FrameVector<int> collectedIndexes;
         for ( size_t i = 0; i < fireballs.size(); i++ ) {
             fireballs[i].update();
             if ( fireballs[i].getState() == SPRITE_STATE_TO_BE_REMOVED ) {
@@ -215,24 +215,50 @@ void Mario::update() {
 
 void Mario::draw() {
 
-    std::map<std::string, Texture2D> &textures = ResourceManager::getTextures();
-    std::string prefix;
-
-    switch ( type ) {
-        default:
-        case MARIO_TYPE_SMALL:
-            prefix = "small";
-            break;
-        case MARIO_TYPE_SUPER:
-            prefix = "super";
-            break;
-        case MARIO_TYPE_FLOWER:
-            prefix = "flower";
-            break;
-    }
+    // textures indexed by [type][frame][direction], TEXTURE_NONE where there is no such frame
+    static constexpr TextureId idleFrames[3][3][2] = {
+        { { TEXTURE_SMALL_MARIO_0_R, TEXTURE_SMALL_MARIO_0_L }, { TEXTURE_SMALL_MARIO_1_R, TEXTURE_SMALL_MARIO_1_L }, { TEXTURE_NONE, TEXTURE_NONE } },
+        { { TEXTURE_SUPER_MARIO_0_R, TEXTURE_SUPER_MARIO_0_L }, { TEXTURE_SUPER_MARIO_1_R, TEXTURE_SUPER_MARIO_1_L }, { TEXTURE_SUPER_MARIO_2_R, TEXTURE_SUPER_MARIO_2_L } },
+        { { TEXTURE_FLOWER_MARIO_0_R, TEXTURE_FLOWER_MARIO_0_L }, { TEXTURE_FLOWER_MARIO_1_R, TEXTURE_FLOWER_MARIO_1_L }, { TEXTURE_FLOWER_MARIO_2_R, TEXTURE_FLOWER_MARIO_2_L } }
+    };
+    static constexpr TextureId runningFrames[3][3][2] = {
+        { { TEXTURE_SMALL_MARIO_0_RUNNING_R, TEXTURE_SMALL_MARIO_0_RUNNING_L }, { TEXTURE_SMALL_MARIO_1_RUNNING_R, TEXTURE_SMALL_MARIO_1_RUNNING_L }, { TEXTURE_NONE, TEXTURE_NONE } },
+        { { TEXTURE_SUPER_MARIO_0_RUNNING_R, TEXTURE_SUPER_MARIO_0_RUNNING_L }, { TEXTURE_SUPER_MARIO_1_RUNNING_R, TEXTURE_SUPER_MARIO_1_RUNNING_L }, { TEXTURE_SUPER_MARIO_2_RUNNING_R, TEXTURE_SUPER_MARIO_2_RUNNING_L } },
+        { { TEXTURE_FLOWER_MARIO_0_RUNNING_R, TEXTURE_FLOWER_MARIO_0_RUNNING_L }, { TEXTURE_FLOWER_MARIO_1_RUNNING_R, TEXTURE_FLOWER_MARIO_1_RUNNING_L }, { TEXTURE_FLOWER_MARIO_2_RUNNING_R, TEXTURE_FLOWER_MARIO_2_RUNNING_L } }
+    };
+    static constexpr TextureId throwingFireballFrames[3][2] = {
+        { TEXTURE_FLOWER_MARIO_0_THROWING_FIREBALL_R, TEXTURE_FLOWER_MARIO_0_THROWING_FIREBALL_L }, { TEXTURE_NONE, TEXTURE_NONE }, { TEXTURE_NONE, TEXTURE_NONE }
+    };
+    static constexpr TextureId lookingUpFrames[3][2] = {
+        { TEXTURE_SMALL_MARIO_0_LOOKING_UP_R, TEXTURE_SMALL_MARIO_0_LOOKING_UP_L },
+        { TEXTURE_SUPER_MARIO_0_LOOKING_UP_R, TEXTURE_SUPER_MARIO_0_LOOKING_UP_L },
+        { TEXTURE_FLOWER_MARIO_0_LOOKING_UP_R, TEXTURE_FLOWER_MARIO_0_LOOKING_UP_L }
+    };
+    static constexpr TextureId duckingFrames[3][2] = {
+        { TEXTURE_SMALL_MARIO_0_DUCKING_R, TEXTURE_SMALL_MARIO_0_DUCKING_L },
+        { TEXTURE_SUPER_MARIO_0_DUCKING_R, TEXTURE_SUPER_MARIO_0_DUCKING_L },
+        { TEXTURE_FLOWER_MARIO_0_DUCKING_R, TEXTURE_FLOWER_MARIO_0_DUCKING_L }
+    };
+    static constexpr TextureId jumpingFrames[3][2] = {
+        { TEXTURE_SMALL_MARIO_0_JUMPING_R, TEXTURE_SMALL_MARIO_0_JUMPING_L },
+        { TEXTURE_SUPER_MARIO_0_JUMPING_R, TEXTURE_SUPER_MARIO_0_JUMPING_L },
+        { TEXTURE_FLOWER_MARIO_0_JUMPING_R, TEXTURE_FLOWER_MARIO_0_JUMPING_L }
+    };
+    static constexpr TextureId jumpingRunningFrames[3][2] = {
+        { TEXTURE_SMALL_MARIO_0_JUMPING_RUNNING_R, TEXTURE_SMALL_MARIO_0_JUMPING_RUNNING_L },
+        { TEXTURE_SUPER_MARIO_0_JUMPING_RUNNING_R, TEXTURE_SUPER_MARIO_0_JUMPING_RUNNING_L },
+        { TEXTURE_FLOWER_MARIO_0_JUMPING_RUNNING_R, TEXTURE_FLOWER_MARIO_0_JUMPING_RUNNING_L }
+    };
+    static constexpr TextureId fallingFrames[3][2] = {
+        { TEXTURE_SMALL_MARIO_0_FALLING_R, TEXTURE_SMALL_MARIO_0_FALLING_L },
+        { TEXTURE_SUPER_MARIO_0_FALLING_R, TEXTURE_SUPER_MARIO_0_FALLING_L },
+        { TEXTURE_FLOWER_MARIO_0_FALLING_R, TEXTURE_FLOWER_MARIO_0_FALLING_L }
+    };
+    static constexpr TextureId victoryFrames[3] = { TEXTURE_SMALL_MARIO_0_VICTORY, TEXTURE_SUPER_MARIO_0_VICTORY, TEXTURE_FLOWER_MARIO_0_VICTORY };
+    static constexpr TextureId dyingFrames[3] = { TEXTURE_SMALL_MARIO_0_DYING, TEXTURE_SMALL_MARIO_1_DYING, TEXTURE_NONE };
 
     if ( state == SPRITE_STATE_DYING ) {
-        DrawTexture( textures[std::string( TextFormat( "smallMario%dDy", currentFrame))], pos.x, pos.y, WHITE);
+        DrawTexture( ResourceManager::getTexture( dyingFrames[currentFrame] ), pos.x, pos.y, WHITE);
     } else {
 
         Color tint = WHITE;
@@ -241,38 +267,38 @@ void Mario::draw() {
             tint = ColorFromHSV( 360 * ( invincibleAcum / invincibleTime * 20 ), 0.3, 1 );
         }
 
-        const char dir = facingDirection == DIRECTION_RIGHT ? 'R' : 'L';
+        const int dir = facingDirection == DIRECTION_RIGHT ? 0 : 1;
 
         if ( !invulnerableBlink ) {
 
             if ( state == SPRITE_STATE_ON_GROUND ) {
 
                 if ( lookingUp ) {
-                    DrawTexture( textures[std::string( TextFormat( "%sMario0Lu%c", prefix.c_str(), dir ) )], pos.x, pos.y, tint );
+                    DrawTexture( ResourceManager::getTexture( lookingUpFrames[type][dir] ), pos.x, pos.y, tint );
                 } else if ( ducking ) {
-                    DrawTexture( textures[std::string( TextFormat( "%sMario0Du%c", prefix.c_str(), dir ) )], pos.x, pos.y, tint );
+                    DrawTexture( ResourceManager::getTexture( duckingFrames[type][dir] ), pos.x, pos.y, tint );
                 } else if ( drawRunningFrames ) {
-                    DrawTexture( textures[std::string( TextFormat( "%sMario%dRu%c", prefix.c_str(), currentFrame, dir ) )], pos.x, pos.y, tint );
+                    DrawTexture( ResourceManager::getTexture( runningFrames[type][currentFrame][dir] ), pos.x, pos.y, tint );
                 } else { // iddle
                     if ( ( IsKeyPressed( KEY_LEFT_CONTROL ) ||
                            IsGamepadButtonPressed( 0, GAMEPAD_BUTTON_RIGHT_FACE_LEFT ) ) && 
                            type == MARIO_TYPE_FLOWER ) {
-                        DrawTexture( textures[std::string( TextFormat( "%sMario%dTf%c", prefix.c_str(), currentFrame, dir ) )], pos.x, pos.y, tint );
+                        DrawTexture( ResourceManager::getTexture( throwingFireballFrames[currentFrame][dir] ), pos.x, pos.y, tint );
                     } else {
-                        DrawTexture( textures[std::string( TextFormat( "%sMario%d%c", prefix.c_str(), currentFrame, dir ) )], pos.x, pos.y, tint );
+                        DrawTexture( ResourceManager::getTexture( idleFrames[type][currentFrame][dir] ), pos.x, pos.y, tint );
                     }
                 }
 
             } else if ( state == SPRITE_STATE_JUMPING ) {
                 if ( drawRunningFrames ) {
-                    DrawTexture( textures[std::string( TextFormat( "%sMario0JuRu%c", prefix.c_str(), dir ) )], pos.x, pos.y, tint );
+                    DrawTexture( ResourceManager::getTexture( jumpingRunningFrames[type][dir] ), pos.x, pos.y, tint );
                 } else {
-                    DrawTexture( textures[std::string( TextFormat( "%sMario0Ju%c", prefix.c_str(), dir ) )], pos.x, pos.y, tint );
+                    DrawTexture( ResourceManager::getTexture( jumpingFrames[type][dir] ), pos.x, pos.y, tint );
                 }
             } else if ( state == SPRITE_STATE_FALLING ) {
-                DrawTexture( textures[std::string( TextFormat( "%sMario0Fa%c", prefix.c_str(), dir ) )], pos.x, pos.y, tint );
+                DrawTexture( ResourceManager::getTexture( fallingFrames[type][dir] ), pos.x, pos.y, tint );
             } else if ( state == SPRITE_STATE_VICTORY || state == SPRITE_STATE_WAITING_TO_NEXT_MAP ) {
-                DrawTexture( textures[std::string( TextFormat( "%sMario0Vic", prefix.c_str() ) )], pos.x, pos.y, tint );
+                DrawTexture( ResourceManager::getTexture( victoryFrames[type] ), pos.x, pos.y, tint );
             }
 
         }
@@ -416,29 +442,27 @@ CollisionType Mario::checkCollisionBaddie( Sprite *sprite ) {
 
 void Mario::drawHud() const {
 
-    std::map<std::string, Texture2D>& textures = ResourceManager::getTextures();
-
-    DrawTexture( textures["guiMario"], 34, 32, WHITE );
-    DrawTexture( textures["guiX"], 54, 49, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_GUI_MARIO ), 34, 32, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_GUI_X ), 54, 49, WHITE );
     drawWhiteSmallNumber( lives < 0 ? 0 : lives, 68, 49 );
     
-    DrawTexture( textures["guiCoin"], GetScreenWidth() - 115, 32, WHITE );
-    DrawTexture( textures["guiX"], GetScreenWidth() - 97, 34, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_GUI_COIN ), GetScreenWidth() - 115, 32, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_GUI_X ), GetScreenWidth() - 97, 34, WHITE );
     drawWhiteSmallNumber( coins, GetScreenWidth() - 34 - getSmallNumberWidth( coins ), 34 );
     drawWhiteSmallNumber( points, GetScreenWidth() - 34 - getSmallNumberWidth( points ), 50 );
 
     int t = getRemainingTime();
     t = t < 0 ? 0 : t;
 
-    DrawTexture( textures["guiTime"], GetScreenWidth() - 34 - 176, 32, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_GUI_TIME ), GetScreenWidth() - 34 - 176, 32, WHITE );
     drawYellowSmallNumber( t, GetScreenWidth() - 34 - 128 - getSmallNumberWidth( t ), 50 );
 
     if ( reservedPowerUp == MARIO_TYPE_SUPER ) {
-        DrawTexture( textures["mushroom"], GetScreenWidth() / 2 - textures["mushroom"].width / 2, 32, WHITE );
+        DrawTexture( ResourceManager::getTexture( TEXTURE_MUSHROOM ), GetScreenWidth() / 2 - ResourceManager::getTexture( TEXTURE_MUSHROOM ).width / 2, 32, WHITE );
     } else if ( reservedPowerUp == MARIO_TYPE_FLOWER ) {
-        DrawTexture( textures["fireFlower0"], GetScreenWidth() / 2 - textures["fireFlower0"].width / 2, 32, WHITE );
+        DrawTexture( ResourceManager::getTexture( TEXTURE_FIRE_FLOWER_0 ), GetScreenWidth() / 2 - ResourceManager::getTexture( TEXTURE_FIRE_FLOWER_0 ).width / 2, 32, WHITE );
     }
-    DrawTexture( textures["guiNextItem"], GetScreenWidth() / 2 - textures["guiNextItem"].width / 2, 20, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_GUI_NEXT_ITEM ), GetScreenWidth() / 2 - ResourceManager::getTexture( TEXTURE_GUI_NEXT_ITEM ).width / 2, 20, WHITE );
 
 }
 
@@ -556,10 +580,10 @@ MarioType Mario::getReservedPowerUp() const {
 void Mario::consumeReservedPowerUp() {
     if ( reservedPowerUp == MARIO_TYPE_SUPER ) {
         changeToSuper();
-        PlaySound( ResourceManager::getSounds()["reserveItemRelease"] );
+        PlaySound( ResourceManager::getSound( SOUND_RESERVE_ITEM_RELEASE ) );
     } else if ( reservedPowerUp == MARIO_TYPE_FLOWER ) {
         changeToFlower();
-        PlaySound( ResourceManager::getSounds()["reserveItemRelease"] );
+        PlaySound( ResourceManager::getSound( SOUND_RESERVE_ITEM_RELEASE ) );
     }
     reservedPowerUp = MARIO_TYPE_SMALL;
 }
@@ -662,17 +686,15 @@ void Mario::resetAll() {
 
 void Mario::playPlayerDownMusicStream() {
 
-    std::map<std::string, Music> musics = ResourceManager::getMusics();
-
     if ( !playerDownMusicStreamPlaying ) {
         playerDownMusicStreamPlaying = true;
     } else {
-        if ( !IsMusicStreamPlaying( musics["playerDown"] ) ) {
-            PlayMusicStream( musics["playerDown"] );
+        if ( !IsMusicStreamPlaying( ResourceManager::getMusic( MUSIC_PLAYER_DOWN ) ) ) {
+            PlayMusicStream( ResourceManager::getMusic( MUSIC_PLAYER_DOWN ) );
         } else {
-            UpdateMusicStream( musics["playerDown"] );
-            if ( static_cast<int>( GetMusicTimeLength( musics["playerDown"] ) ) == static_cast<int>( GetMusicTimePlayed( musics["playerDown"] ) ) ) {
-                StopMusicStream( musics["playerDown"] );
+            UpdateMusicStream( ResourceManager::getMusic( MUSIC_PLAYER_DOWN ) );
+            if ( static_cast<int>( GetMusicTimeLength( ResourceManager::getMusic( MUSIC_PLAYER_DOWN ) ) ) == static_cast<int>( GetMusicTimePlayed( ResourceManager::getMusic( MUSIC_PLAYER_DOWN ) ) ) ) {
+                StopMusicStream( ResourceManager::getMusic( MUSIC_PLAYER_DOWN ) );
                 playerDownMusicStreamPlaying = false;
             }
         }
@@ -683,17 +705,15 @@ void Mario::playPlayerDownMusicStream() {
 
 void Mario::playGameOverMusicStream() {
 
-    std::map<std::string, Music> musics = ResourceManager::getMusics();
-
     if ( !gameOverMusicStreamPlaying ) {
         gameOverMusicStreamPlaying = true;
     } else {
-        if ( !IsMusicStreamPlaying( musics["gameOver"] ) ) {
-            PlayMusicStream( musics["gameOver"] );
+        if ( !IsMusicStreamPlaying( ResourceManager::getMusic( MUSIC_GAME_OVER ) ) ) {
+            PlayMusicStream( ResourceManager::getMusic( MUSIC_GAME_OVER ) );
         } else {
-            UpdateMusicStream( musics["gameOver"] );
-            if ( static_cast<int>( GetMusicTimeLength( musics["gameOver"] ) ) == static_cast<int>( GetMusicTimePlayed( musics["gameOver"] ) ) ) {
-                StopMusicStream( musics["gameOver"] );
+            UpdateMusicStream( ResourceManager::getMusic( MUSIC_GAME_OVER ) );
+            if ( static_cast<int>( GetMusicTimeLength( ResourceManager::getMusic( MUSIC_GAME_OVER ) ) ) == static_cast<int>( GetMusicTimePlayed( ResourceManager::getMusic( MUSIC_GAME_OVER ) ) ) ) {
+                StopMusicStream( ResourceManager::getMusic( MUSIC_GAME_OVER ) );
                 gameOverMusicStreamPlaying = false;
             }
         }
@@ -46,7 +46,7 @@ void MessageBlock::draw() {
 
     }
 
-    DrawTexture( ResourceManager::getTextures()["blockMessage"], pos.x, pos.y - moveY, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_BLOCK_MESSAGE ), pos.x, pos.y - moveY, WHITE );
 
     if ( GameWorld::debug && color.a != 0 ) {
         DrawRectangle( pos.x, pos.y, dim.x, dim.y, Fade( color, 0.5 ) );
@@ -56,7 +56,7 @@ void MessageBlock::draw() {
 
 void MessageBlock::doHit( Mario& mario, Map *map ) {
     if ( !hit ) {
-        PlaySound( ResourceManager::getSounds()["messageBlock"] );
+        PlaySound( ResourceManager::getSound( SOUND_MESSAGE_BLOCK ) );
         hit = true;
         moveAnimationStarted = true;
         map->setDrawMessage( true );
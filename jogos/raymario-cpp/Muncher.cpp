@@ -61,9 +61,9 @@ void Muncher::update() {
 
 void Muncher::draw() {
 
-    std::map<std::string, Texture2D> &textures = ResourceManager::getTextures();
+    static constexpr TextureId frames[2] = { TEXTURE_MUNCHER_0, TEXTURE_MUNCHER_1 };
 
-    DrawTexturePro( textures[std::string( TextFormat( "muncher%d", currentFrame ) )],
+    DrawTexturePro( ResourceManager::getTexture( frames[currentFrame] ),
                     Rectangle( 0, 0, dim.x, dim.y ),
                     Rectangle( pos.x + dim.x / 2, pos.y + dim.y / 2, dim.x, dim.y ),
                     Vector2( dim.x / 2, dim.y / 2 ), angle, WHITE );
@@ -44,7 +44,7 @@ void Mushroom::update() {
 
 void Mushroom::draw() {
 
-    DrawTexture( ResourceManager::getTextures()["mushroom"], pos.x, pos.y, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_MUSHROOM ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug ) {
         cpN.draw();
@@ -56,7 +56,7 @@ void Mushroom::draw() {
 }
 
 void Mushroom::playCollisionSound() {
-    PlaySound( ResourceManager::getSounds()["powerUp"] );
+    PlaySound( ResourceManager::getSound( SOUND_POWER_UP ) );
 }
 
 void Mushroom::updateMario( Mario& mario ) {
@@ -71,7 +71,7 @@ void Mushroom::updateMario( Mario& mario ) {
             switch ( mario.getReservedPowerUp() ) {
                 case MARIO_TYPE_SMALL:
                     mario.setReservedPowerUp( MARIO_TYPE_SUPER );
-                    PlaySound( ResourceManager::getSounds()["reserveItemStore"] );
+                    PlaySound( ResourceManager::getSound( SOUND_RESERVE_ITEM_STORE ) );
                     break;
                 case MARIO_TYPE_SUPER:
                     break;
@@ -83,7 +83,7 @@ void Mushroom::updateMario( Mario& mario ) {
             switch ( mario.getReservedPowerUp() ) {
                 case MARIO_TYPE_SMALL:
                     mario.setReservedPowerUp( MARIO_TYPE_SUPER );
-                    PlaySound( ResourceManager::getSounds()["reserveItemStore"] );
+                    PlaySound( ResourceManager::getSound( SOUND_RESERVE_ITEM_STORE ) );
                     break;
                 case MARIO_TYPE_SUPER:
                     break;
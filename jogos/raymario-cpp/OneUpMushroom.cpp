@@ -44,7 +44,7 @@ void OneUpMushroom::update() {
 
 void OneUpMushroom::draw() {
 
-    DrawTexture( ResourceManager::getTextures()["1UpMushroom"], pos.x, pos.y, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_1_UP_MUSHROOM ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug ) {
         cpN.draw();
@@ -56,7 +56,7 @@ void OneUpMushroom::draw() {
 }
 
 void OneUpMushroom::playCollisionSound() {
-    PlaySound( ResourceManager::getSounds()["1up"] );
+    PlaySound( ResourceManager::getSound( SOUND_1_UP ) );
 }
 
 void OneUpMushroom::updateMario( Mario& mario ) {
@@ -91,9 +91,9 @@ void PiranhaPlant::update() {
 
 void PiranhaPlant::draw() {
 
-    std::map<std::string, Texture2D> &textures = ResourceManager::getTextures();
+    static constexpr TextureId frames[2] = { TEXTURE_PIRANHA_PLANT_0, TEXTURE_PIRANHA_PLANT_1 };
 
-    DrawTexturePro( textures[std::string( TextFormat( "piranhaPlant%d", currentFrame ) )],
+    DrawTexturePro( ResourceManager::getTexture( frames[currentFrame] ),
                     Rectangle( 0, 0, dim.x, dim.y ),
                     Rectangle( pos.x + dim.x / 2, pos.y + dim.y / 2, dim.x, dim.y ),
                     Vector2( dim.x / 2, dim.y / 2 ), angle, WHITE );
@@ -66,13 +66,15 @@ void QuestionBlock::update() {
 void QuestionBlock::draw() {
 
     if ( coinAnimationStarted ) {
-        DrawTexture( ResourceManager::getTextures()[std::string( TextFormat( "coin%d", coinAnimationFrame ) )], pos.x + 4, coinY, WHITE );
+        static constexpr TextureId coinFrames[4] = { TEXTURE_COIN_0, TEXTURE_COIN_1, TEXTURE_COIN_2, TEXTURE_COIN_3 };
+        DrawTexture( ResourceManager::getTexture( coinFrames[coinAnimationFrame] ), pos.x + 4, coinY, WHITE );
     }
 
     if ( hit ) {
-        DrawTexture( ResourceManager::getTextures()["blockEyesClosed"], pos.x, pos.y, WHITE );
+        DrawTexture( ResourceManager::getTexture( TEXTURE_BLOCK_EYES_CLOSED ), pos.x, pos.y, WHITE );
     } else {
-        DrawTexture( ResourceManager::getTextures()[std::string( TextFormat( "blockQuestion%d", currentFrame ) )], pos.x, pos.y, WHITE );
+        static constexpr TextureId frames[4] = { TEXTURE_BLOCK_QUESTION_0, TEXTURE_BLOCK_QUESTION_1, TEXTURE_BLOCK_QUESTION_2, TEXTURE_BLOCK_QUESTION_3 };
+        DrawTexture( ResourceManager::getTexture( frames[currentFrame] ), pos.x, pos.y, WHITE );
     }
 
     if ( GameWorld::debug && color.a != 0 ) {
@@ -83,7 +85,7 @@ void QuestionBlock::draw() {
 
 void QuestionBlock::doHit( Mario& mario, Map *map ) {
     if ( !hit ) {
-        PlaySound( ResourceManager::getSounds()["coin"] );
+        PlaySound( ResourceManager::getSound( SOUND_COIN ) );
         hit = true;
         coinAnimationStarted = true;
         coinY = pos.y;
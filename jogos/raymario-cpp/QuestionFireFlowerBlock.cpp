@@ -57,9 +57,10 @@ void QuestionFireFlowerBlock::draw() {
     }
 
     if ( hit ) {
-        DrawTexture( ResourceManager::getTextures()["blockEyesClosed"], pos.x, pos.y, WHITE );
+        DrawTexture( ResourceManager::getTexture( TEXTURE_BLOCK_EYES_CLOSED ), pos.x, pos.y, WHITE );
     } else {
-        DrawTexture( ResourceManager::getTextures()[std::string( TextFormat( "blockQuestion%d", currentFrame ) )], pos.x, pos.y, WHITE );
+        static constexpr TextureId frames[4] = { TEXTURE_BLOCK_QUESTION_0, TEXTURE_BLOCK_QUESTION_1, TEXTURE_BLOCK_QUESTION_2, TEXTURE_BLOCK_QUESTION_3 };
+        DrawTexture( ResourceManager::getTexture( frames[currentFrame] ), pos.x, pos.y, WHITE );
     }
 
     if ( GameWorld::debug && color.a != 0 ) {
@@ -70,7 +71,7 @@ void QuestionFireFlowerBlock::draw() {
 
 void QuestionFireFlowerBlock::doHit( Mario& mario, Map* map ) {
     if ( !hit ) {
-        PlaySound( ResourceManager::getSounds()["powerUpAppears"] );
+        PlaySound( ResourceManager::getSound( SOUND_POWER_UP_APPEARS ) );
         hit = true;
         item = new FireFlower( Vector2( pos.x, pos.y ), Vector2( 32, 32 ), ORANGE );
         item->setFacingDirection( mario.getFacingDirection() );
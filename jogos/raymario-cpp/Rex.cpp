@@ -73,10 +73,13 @@ void Rex::update() {
 
 void Rex::draw() {
 
-    std::map<std::string, Texture2D> &textures = ResourceManager::getTextures();
-    const char dir = facingDirection == DIRECTION_RIGHT ? 'R' : 'L';
+    static constexpr TextureId frames[2][2][2] = {
+        { { TEXTURE_REX_1_0_R, TEXTURE_REX_1_0_L }, { TEXTURE_REX_1_1_R, TEXTURE_REX_1_1_L } },
+        { { TEXTURE_REX_2_0_R, TEXTURE_REX_2_0_L }, { TEXTURE_REX_2_1_R, TEXTURE_REX_2_1_L } }
+    };
+    const int dir = facingDirection == DIRECTION_RIGHT ? 0 : 1;
 
-    DrawTexturePro( textures[std::string( TextFormat( "rex%d%d%c", hitsToDie, currentFrame, dir ) )],
+    DrawTexturePro( ResourceManager::getTexture( frames[hitsToDie-1][currentFrame][dir] ),
                     Rectangle( 0, 0, dim.x, dim.y ),
                     Rectangle( pos.x + dim.x / 2, pos.y + dim.y / 2, dim.x, dim.y ),
                     Vector2( dim.x / 2, dim.y / 2 ), angle, WHITE );
@@ -43,7 +43,7 @@ void Star::update() {
 
 void Star::draw() {
 
-    DrawTexture( ResourceManager::getTextures()["star"], pos.x, pos.y, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_STAR ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug ) {
         cpN.draw();
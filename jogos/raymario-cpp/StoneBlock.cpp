@@ -23,7 +23,7 @@ void StoneBlock::update() {}
 
 void StoneBlock::draw() {
 
-    DrawTexture( ResourceManager::getTextures()["blockStone"], pos.x, pos.y, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_BLOCK_STONE ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug && color.a != 0 ) {
         DrawRectangle( pos.x, pos.y, dim.x, dim.y, Fade( color, 0.5 ) );
@@ -44,7 +44,7 @@ void ThreeUpMoon::update() {
 
 void ThreeUpMoon::draw() {
 
-    DrawTexture( ResourceManager::getTextures()["3UpMoon"], pos.x, pos.y, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_3_UP_MOON ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug ) {
         cpN.draw();
@@ -56,7 +56,7 @@ void ThreeUpMoon::draw() {
 }
 
 void ThreeUpMoon::playCollisionSound() {
-    PlaySound( ResourceManager::getSounds()["1up"] );
+    PlaySound( ResourceManager::getSound( SOUND_1_UP ) );
 }
 
 void ThreeUpMoon::updateMario( Mario& mario ) {
@@ -9,17 +9,16 @@
 #include "raylib.h"
 #include "ResourceManager.h"
 #include "Tile.h"
+#include "ResourceId.h"
 #include <iostream>
-#include <string>
-#include <utility>
 
-Tile::Tile( Vector2 pos, Vector2 dim, Color color, std::string key, bool visible ) :
-    Tile( pos, dim, color, std::move(key), visible, false ) {
+Tile::Tile( Vector2 pos, Vector2 dim, Color color, TextureId textureId, bool visible ) :
+    Tile( pos, dim, color, textureId, visible, false ) {
 }
 
-Tile::Tile( Vector2 pos, Vector2 dim, Color color, std::string key, bool visible, bool onlyBaddies ) :
+Tile::Tile( Vector2 pos, Vector2 dim, Color color, TextureId textureId, bool visible, bool onlyBaddies ) :
     Sprite( pos, dim, color ),
-    key( std::move(key) ),
+    textureId( textureId ),
     visible( visible ),
     onlyBaddies( onlyBaddies ) {
 }
@@ -32,11 +31,9 @@ void Tile::update() {
 void Tile::draw() {
 
     if ( visible ) {
-        
-        std::map<std::string, Texture2D> &textures = ResourceManager::getTextures();
 
-        if ( key.length() != 0 ) {
-            DrawTexture( textures[key], pos.x, pos.y, WHITE );
+        if ( textureId != TEXTURE_NONE ) {
+            DrawTexture( ResourceManager::getTexture( textureId ), pos.x, pos.y, WHITE );
         } else {
             DrawRectangle( pos.x, pos.y, dim.x, dim.y, color );
         }
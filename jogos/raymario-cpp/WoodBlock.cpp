@@ -23,7 +23,7 @@ void WoodBlock::update() {}
 
 void WoodBlock::draw() {
 
-    DrawTexture( ResourceManager::getTextures()["blockWood"], pos.x, pos.y, WHITE );
+    DrawTexture( ResourceManager::getTexture( TEXTURE_BLOCK_WOOD ), pos.x, pos.y, WHITE );
 
     if ( GameWorld::debug && color.a != 0 ) {
         DrawRectangle( pos.x, pos.y, dim.x, dim.y, Fade( color, 0.5 ) );
@@ -44,6 +44,7 @@ if ( $compile -or $cleanAndCompile -or $compileAndRun -or $all ) {
         -Wno-unused-parameter `
         -pedantic-errors `
         -std=c++23 `
+        -pthread `
         -Wno-missing-braces `
         -Wno-missing-field-initializers `
         -Wno-enum-compare `
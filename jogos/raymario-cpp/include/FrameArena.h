@@ -0,0 +1,105 @@
+/**
+ * @file FrameArena.h
+ * @author Prof. Dr. David Buzatto
+ * @brief FrameArena class declaration. A bump pointer allocator for
+ * data that lives at most until the end of the current frame, and the
+ * STL allocator and containers that use it.
+ *
+ * The arena is reset right after EndDrawing and must be used only by
+ * the main thread.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class FrameArena {
+
+    static constexpr size_t CAPACITY = 256 * 1024;
+
+    // frames the arena may still overflow on, while the first maps and
+    // menus are loaded
+    static constexpr size_t WARM_UP_FRAMES = 120;
+
+    alignas( std::max_align_t ) static std::byte buffer[CAPACITY];
+    static size_t used;
+    static size_t peakUsed;
+    static size_t overflowCount;
+    static size_t lastFrameHeapAllocations;
+    static size_t heapAllocationsAtReset;
+    static size_t frameCount;
+    static size_t overflowCountAfterWarmUp;
+
+public:
+
+    /**
+     * @brief Returns a block of the current frame. When the arena is
+     * full the block comes from the general heap, so it is still valid,
+     * only slower.
+     */
+    static void *allocate( size_t size, size_t alignment );
+
+    /**
+     * @brief Frees a block returned by allocate. Blocks of the arena
+     * are only reclaimed by reset.
+     */
+    static void deallocate( void *p );
+
+    /**
+     * @brief Discards every block of the frame and closes the frame
+     * allocation counters. In debug builds, asserts that the arena did
+     * not fall back to the heap in any frame after WARM_UP_FRAMES.
+     */
+    static void reset();
+
+    static size_t getUsedBytes();
+    static size_t getPeakUsedBytes();
+    static size_t getOverflowCount();
+
+    /**
+     * @brief Number of operator new calls since the program started.
+     */
+    static size_t getHeapAllocationCount();
+
+    /**
+     * @brief Number of operator new calls made during the last frame.
+     */
+    static size_t getLastFrameHeapAllocationCount();
+
+};
+
+/**
+ * @brief STL allocator that takes its memory from the FrameArena.
+ */
+template<typename T>
+struct FrameAllocator {
+
+    using value_type = T;
+
+    FrameAllocator() = default;
+
+    template<typename U>
+    FrameAllocator( const FrameAllocator<U>& ) {}
+
+    T *allocate( size_t n ) {
+        return static_cast<T*>( FrameArena::allocate( n * sizeof( T ), alignof( T ) ) );
+    }
+
+    void deallocate( T *p, size_t ) {
+        FrameArena::deallocate( p );
+    }
+
+    template<typename U>
+    bool operator==( const FrameAllocator<U>& ) const {
+        return true;
+    }
+
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
\ No newline at end of file
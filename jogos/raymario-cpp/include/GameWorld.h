@@ -10,6 +10,7 @@
 
 #include "Drawable.h"
 #include "GameState.h"
+#include "JobSystem.h"
 #include "Map.h"
 #include "Mario.h"
 #include "raylib.h"
@@ -29,6 +30,13 @@ class GameWorld : public virtual Drawable {
     bool irisOutFinished;
     float irisOutTime;
     float irisOutAcum;
+
+    // items and baddies are updated in parallel, in chunks of ENTITIES_PER_JOB
+    static constexpr size_t ENTITIES_PER_JOB = 32;
+    JobSystem jobSystem;
+    double parallelUpdateTime;
+    int parallelUpdateFrames;
+    double parallelUpdateAverageTime;
     
 public:
 
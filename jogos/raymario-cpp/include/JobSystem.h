@@ -0,0 +1,82 @@
+/**
+ * @file JobSystem.h
+ * @author Prof. Dr. David Buzatto
+ * @brief JobSystem class declaration. A small pool of worker threads,
+ * each one with its own job deque, that steal work from each other
+ * when their deque gets empty.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem {
+
+    struct Job {
+        const std::function<void( size_t, size_t )> *work;
+        size_t begin;
+        size_t end;
+    };
+
+    // the owner pops from the back, thieves steal from the front (head)
+    // the storage is only cleared, never freed, so a warmed up queue
+    // doesn't touch the heap
+    struct JobQueue {
+        std::mutex mutex;
+        std::vector<Job> jobs;
+        size_t head = 0;
+    };
+
+    int threadCount;
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<JobQueue>> queues;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::condition_variable jobsDone;
+    std::atomic<size_t> pendingJobs;           // queued or running
+    std::atomic<std::ptrdiff_t> queuedJobs;    // not taken yet
+    bool running;
+
+    void startWorkers();
+    void stopWorkers();
+    void workerLoop( int queueIndex );
+    bool popOrSteal( int queueIndex, Job &job );
+    void execute( const Job &job );
+
+public:
+
+    /**
+     * @brief Construct a new JobSystem object. The calling thread counts
+     * as one of the threads, so threadCount - 1 workers are created.
+     */
+    explicit JobSystem( int threadCount );
+
+    /**
+     * @brief Destroy the JobSystem object, joining its workers.
+     */
+    ~JobSystem();
+
+    JobSystem( const JobSystem& ) = delete;
+    JobSystem& operator=( const JobSystem& ) = delete;
+
+    /**
+     * @brief Splits [0, count) in chunks of at most chunkSize elements
+     * and runs work( begin, end ) for each chunk on every thread, returning
+     * only when all chunks are done. Chunks run in any order, so work
+     * must not touch state shared between chunks.
+     */
+    void parallelFor( size_t count, size_t chunkSize, const std::function<void( size_t, size_t )> &work );
+
+    void setThreadCount( int threadCount );
+    int getThreadCount() const;
+
+};
\ No newline at end of file
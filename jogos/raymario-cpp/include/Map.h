@@ -17,6 +17,8 @@ class GameWorld;
 #include "Mario.h"
 #include "raylib.h"
 #include "Tile.h"
+#include <string>
+#include <string_view>
 #include <vector>
 
 class Map : public virtual Drawable {
@@ -63,7 +65,7 @@ class Map : public virtual Drawable {
     bool parsed;
 
     bool drawMessage;
-    std::string message;
+    std::string_view message;           // owned by the message block that was hit
     Camera2D *camera;
     GameWorld *gw;
 
@@ -81,7 +83,7 @@ public:
     void setMarioOffset( float marioOffset );
     void setDrawBlackScreen( bool drawBlackScreen );
     void setDrawMessage( bool drawMessage );
-    void setMessage( std::string message );
+    void setMessage( std::string_view message );
     void setCamera( Camera2D* camera );
     void setGameWorld( GameWorld *gw );
 
@@ -0,0 +1,99 @@
+/**
+ * @file ResourceId.h
+ * @author Prof. Dr. David Buzatto
+ * @brief TextureId, SoundId and MusicId enumerations, generated from
+ * the resource manifest.
+ *
+ * The ids index the flat resource arrays of the ResourceManager, so a
+ * lookup is a single array access and a misspelled resource is a
+ * compilation error instead of an empty texture created on demand.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#define MANIFEST_TEXTURE( name, path ) TEXTURE_##name,
+#define MANIFEST_TEXTURE_FLIPPED( name, source ) TEXTURE_##name,
+#define MANIFEST_TEXTURE_RECOLORED( name, source ) TEXTURE_##name,
+#define MANIFEST_SOUND( name, path )
+#define MANIFEST_MUSIC( name, path )
+
+// TEXTURE_NONE is an always empty texture, drawn as nothing
+enum TextureId {
+    TEXTURE_NONE,
+    #include "ResourceManifest.h"
+    TEXTURE_COUNT
+};
+
+#undef MANIFEST_TEXTURE
+#undef MANIFEST_TEXTURE_FLIPPED
+#undef MANIFEST_TEXTURE_RECOLORED
+#undef MANIFEST_SOUND
+#undef MANIFEST_MUSIC
+
+#define MANIFEST_TEXTURE( name, path )
+#define MANIFEST_TEXTURE_FLIPPED( name, source )
+#define MANIFEST_TEXTURE_RECOLORED( name, source )
+#define MANIFEST_SOUND( name, path ) SOUND_##name,
+#define MANIFEST_MUSIC( name, path )
+
+enum SoundId {
+    #include "ResourceManifest.h"
+    SOUND_COUNT
+};
+
+#undef MANIFEST_SOUND
+#undef MANIFEST_MUSIC
+
+#define MANIFEST_SOUND( name, path )
+#define MANIFEST_MUSIC( name, path ) MUSIC_##name,
+
+enum MusicId {
+    #include "ResourceManifest.h"
+    MUSIC_COUNT
+};
+
+#undef MANIFEST_TEXTURE_FLIPPED
+#undef MANIFEST_TEXTURE_RECOLORED
+#undef MANIFEST_MUSIC
+
+// derived textures must come after the texture they are created from
+#define MANIFEST_TEXTURE_FLIPPED( name, source ) \
+    static_assert( TEXTURE_##source < TEXTURE_##name, #name " is declared before its source " #source );
+#define MANIFEST_TEXTURE_RECOLORED( name, source ) \
+    static_assert( TEXTURE_##source < TEXTURE_##name, #name " is declared before its source " #source );
+#define MANIFEST_MUSIC( name, path )
+
+#include "ResourceManifest.h"
+
+#undef MANIFEST_TEXTURE
+#undef MANIFEST_TEXTURE_FLIPPED
+#undef MANIFEST_TEXTURE_RECOLORED
+#undef MANIFEST_SOUND
+#undef MANIFEST_MUSIC
+
+// resources selected by number in the map files must be contiguous
+static_assert( TEXTURE_TILE_Z4 - TEXTURE_TILE_A1 == 4 * 26 - 1, "tiles must be declared from A1 to Z4" );
+static_assert( TEXTURE_BACKGROUND_10 - TEXTURE_BACKGROUND_1 == 9, "backgrounds must be declared from 1 to 10" );
+static_assert( MUSIC_STAGE_9 - MUSIC_STAGE_1 == 8, "stage musics must be declared from 1 to 9" );
+
+/**
+ * @brief Texture of the tile identified by letter ('A' to 'Z') in a tile set (1 to 4).
+ */
+constexpr TextureId tileTextureId( char letter, int tileSetId ) {
+    return static_cast<TextureId>( TEXTURE_TILE_A1 + ( tileSetId - 1 ) * 26 + ( letter - 'A' ) );
+}
+
+/**
+ * @brief Texture of a map background (1 to 10).
+ */
+constexpr TextureId backgroundTextureId( int backgroundId ) {
+    return static_cast<TextureId>( TEXTURE_BACKGROUND_1 + backgroundId - 1 );
+}
+
+/**
+ * @brief Music of a stage (1 to 9).
+ */
+constexpr MusicId stageMusicId( int musicId ) {
+    return static_cast<MusicId>( MUSIC_STAGE_1 + musicId - 1 );
+}
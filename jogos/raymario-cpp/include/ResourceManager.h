@@ -8,7 +8,7 @@
 #pragma once
 
 #include "raylib.h"
-#include <map>
+#include "ResourceId.h"
 #include <string>
 #include <vector>
 #include "rres.h"
@@ -16,40 +16,43 @@
 class ResourceManager {
 
 private:
-    static std::map<std::string, Texture2D> textures;
-    static std::map<std::string, Sound> sounds;
-    static std::map<std::string, Music> musics;
+    static Texture2D textures[TEXTURE_COUNT];
+    static Sound sounds[SOUND_COUNT];
+    static Music musics[MUSIC_COUNT];
+    static bool texturesLoaded;
+    static bool soundsLoaded;
+    static bool musicsLoaded;
     static std::vector<void*> musicDataStreamDataPointers;
 
     static std::string centralDirLocation;
     static rresCentralDir centralDir;
 
-    static void loadTextureFromResource( const std::string& fileName, const std::string& textureKey );
-    static void loadSoundFromResource( const std::string& fileName, const std::string& soundKey );
-    static void loadMusicFromResource( const std::string& fileName, const std::string& musicKey );
+    static void loadTextureFromResource( const std::string& fileName, TextureId textureId );
+    static void loadSoundFromResource( const std::string& fileName, SoundId soundId );
+    static void loadMusicFromResource( const std::string& fileName, MusicId musicId );
 
     static void loadTextures();
     static void loadSounds();
     static void loadMusics();
 
-    static void loadTexture( const std::string& key, const std::string& path );
-    static void loadSound( const std::string& key, const std::string& path );
-    static void loadMusic( const std::string& key, const std::string& path );
+    static void loadTexture( TextureId id, const std::string& path );
+    static void loadSound( SoundId id, const std::string& path );
+    static void loadMusic( MusicId id, const std::string& path );
 
     static void unloadTextures();
     static void unloadSounds();
     static void unloadMusics();
 
-    static void unloadTexture( const std::string& key );
-    static void unloadSound( const std::string& key );
-    static void unloadMusic( const std::string& key );
+    static void unloadTexture( TextureId id );
+    static void unloadSound( SoundId id );
+    static void unloadMusic( MusicId id );
 
 public:
     static void loadResources();
     static void unloadResources();
 
-    static std::map<std::string, Texture2D> &getTextures();
-    static std::map<std::string, Sound> &getSounds();
-    static std::map<std::string, Music> &getMusics();
+    static Texture2D &getTexture( TextureId id );
+    static Sound &getSound( SoundId id );
+    static Music &getMusic( MusicId id );
 
 };
\ No newline at end of file
@@ -0,0 +1,374 @@
+/**
+ * @file ResourceManifest.h
+ * @author Prof. Dr. David Buzatto
+ * @brief Manifest of every asset loaded by the ResourceManager.
+ *
+ * Each line is a macro invocation that is expanded by the includer:
+ *
+ *     MANIFEST_TEXTURE( name, path )             texture loaded from the rres file
+ *     MANIFEST_TEXTURE_FLIPPED( name, source )   horizontal flip of a previous texture
+ *     MANIFEST_TEXTURE_RECOLORED( name, source ) previous texture with the flower Mario palette
+ *     MANIFEST_SOUND( name, path )               sound loaded from the rres file
+ *     MANIFEST_MUSIC( name, path )               music stream loaded from the rres file
+ *
+ * ResourceId.h turns it into the TextureId, SoundId and MusicId
+ * enumerations and ResourceManager.cpp into the loading code, so
+ * adding an asset here is all that is needed to use it.
+ *
+ * This file has no include guard on purpose.
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+// small mario
+MANIFEST_TEXTURE( SMALL_MARIO_0_R, "resources/images/sprites/mario/SmallMario_0.png" )
+MANIFEST_TEXTURE( SMALL_MARIO_1_R, "resources/images/sprites/mario/SmallMario_1.png" )
+MANIFEST_TEXTURE_FLIPPED( SMALL_MARIO_0_L, SMALL_MARIO_0_R )
+MANIFEST_TEXTURE_FLIPPED( SMALL_MARIO_1_L, SMALL_MARIO_1_R )
+MANIFEST_TEXTURE( SMALL_MARIO_0_RUNNING_R, "resources/images/sprites/mario/SmallMarioRunning_0.png" )
+MANIFEST_TEXTURE( SMALL_MARIO_1_RUNNING_R, "resources/images/sprites/mario/SmallMarioRunning_1.png" )
+MANIFEST_TEXTURE_FLIPPED( SMALL_MARIO_0_RUNNING_L, SMALL_MARIO_0_RUNNING_R )
+MANIFEST_TEXTURE_FLIPPED( SMALL_MARIO_1_RUNNING_L, SMALL_MARIO_1_RUNNING_R )
+MANIFEST_TEXTURE( SMALL_MARIO_0_JUMPING_R, "resources/images/sprites/mario/SmallMarioJumping_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SMALL_MARIO_0_JUMPING_L, SMALL_MARIO_0_JUMPING_R )
+MANIFEST_TEXTURE( SMALL_MARIO_0_JUMPING_RUNNING_R, "resources/images/sprites/mario/SmallMarioJumpingAndRunning_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SMALL_MARIO_0_JUMPING_RUNNING_L, SMALL_MARIO_0_JUMPING_RUNNING_R )
+MANIFEST_TEXTURE( SMALL_MARIO_0_FALLING_R, "resources/images/sprites/mario/SmallMarioFalling_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SMALL_MARIO_0_FALLING_L, SMALL_MARIO_0_FALLING_R )
+MANIFEST_TEXTURE( SMALL_MARIO_0_LOOKING_UP_R, "resources/images/sprites/mario/SmallMarioLookingUp_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SMALL_MARIO_0_LOOKING_UP_L, SMALL_MARIO_0_LOOKING_UP_R )
+MANIFEST_TEXTURE( SMALL_MARIO_0_DUCKING_R, "resources/images/sprites/mario/SmallMarioDucking_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SMALL_MARIO_0_DUCKING_L, SMALL_MARIO_0_DUCKING_R )
+MANIFEST_TEXTURE( SMALL_MARIO_0_VICTORY, "resources/images/sprites/mario/SmallMarioVictory_0.png" )
+MANIFEST_TEXTURE( SMALL_MARIO_0_DYING, "resources/images/sprites/mario/SmallMarioDying_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SMALL_MARIO_1_DYING, SMALL_MARIO_0_DYING )
+
+// super mario
+MANIFEST_TEXTURE( SUPER_MARIO_0_R, "resources/images/sprites/mario/SuperMario_0.png" )
+MANIFEST_TEXTURE( SUPER_MARIO_1_R, "resources/images/sprites/mario/SuperMario_1.png" )
+MANIFEST_TEXTURE( SUPER_MARIO_2_R, "resources/images/sprites/mario/SuperMario_2.png" )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_0_L, SUPER_MARIO_0_R )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_1_L, SUPER_MARIO_1_R )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_2_L, SUPER_MARIO_2_R )
+MANIFEST_TEXTURE( SUPER_MARIO_0_RUNNING_R, "resources/images/sprites/mario/SuperMarioRunning_0.png" )
+MANIFEST_TEXTURE( SUPER_MARIO_1_RUNNING_R, "resources/images/sprites/mario/SuperMarioRunning_1.png" )
+MANIFEST_TEXTURE( SUPER_MARIO_2_RUNNING_R, "resources/images/sprites/mario/SuperMarioRunning_2.png" )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_0_RUNNING_L, SUPER_MARIO_0_RUNNING_R )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_1_RUNNING_L, SUPER_MARIO_1_RUNNING_R )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_2_RUNNING_L, SUPER_MARIO_2_RUNNING_R )
+MANIFEST_TEXTURE( SUPER_MARIO_0_JUMPING_R, "resources/images/sprites/mario/SuperMarioJumping_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_0_JUMPING_L, SUPER_MARIO_0_JUMPING_R )
+MANIFEST_TEXTURE( SUPER_MARIO_0_JUMPING_RUNNING_R, "resources/images/sprites/mario/SuperMarioJumpingAndRunning_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_0_JUMPING_RUNNING_L, SUPER_MARIO_0_JUMPING_RUNNING_R )
+MANIFEST_TEXTURE( SUPER_MARIO_0_FALLING_R, "resources/images/sprites/mario/SuperMarioFalling_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_0_FALLING_L, SUPER_MARIO_0_FALLING_R )
+MANIFEST_TEXTURE( SUPER_MARIO_0_LOOKING_UP_R, "resources/images/sprites/mario/SuperMarioLookingUp_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_0_LOOKING_UP_L, SUPER_MARIO_0_LOOKING_UP_R )
+MANIFEST_TEXTURE( SUPER_MARIO_0_DUCKING_R, "resources/images/sprites/mario/SuperMarioDucking_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_0_DUCKING_L, SUPER_MARIO_0_DUCKING_R )
+MANIFEST_TEXTURE( SUPER_MARIO_0_VICTORY, "resources/images/sprites/mario/SuperMarioVictory_0.png" )
+MANIFEST_TEXTURE( SUPER_MARIO_0_THROWING_FIREBALL_R, "resources/images/sprites/mario/SuperMarioThrowingFireball_0.png" )
+MANIFEST_TEXTURE_FLIPPED( SUPER_MARIO_0_THROWING_FIREBALL_L, SUPER_MARIO_0_THROWING_FIREBALL_R )
+
+// flower mario
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_0_R, SUPER_MARIO_0_R )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_1_R, SUPER_MARIO_1_R )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_2_R, SUPER_MARIO_2_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_0_L, FLOWER_MARIO_0_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_1_L, FLOWER_MARIO_1_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_2_L, FLOWER_MARIO_2_R )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_0_RUNNING_R, SUPER_MARIO_0_RUNNING_R )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_1_RUNNING_R, SUPER_MARIO_1_RUNNING_R )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_2_RUNNING_R, SUPER_MARIO_2_RUNNING_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_0_RUNNING_L, FLOWER_MARIO_0_RUNNING_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_1_RUNNING_L, FLOWER_MARIO_1_RUNNING_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_2_RUNNING_L, FLOWER_MARIO_2_RUNNING_R )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_0_JUMPING_R, SUPER_MARIO_0_JUMPING_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_0_JUMPING_L, FLOWER_MARIO_0_JUMPING_R )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_0_JUMPING_RUNNING_R, SUPER_MARIO_0_JUMPING_RUNNING_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_0_JUMPING_RUNNING_L, FLOWER_MARIO_0_JUMPING_RUNNING_R )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_0_FALLING_R, SUPER_MARIO_0_FALLING_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_0_FALLING_L, FLOWER_MARIO_0_FALLING_R )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_0_LOOKING_UP_R, SUPER_MARIO_0_LOOKING_UP_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_0_LOOKING_UP_L, FLOWER_MARIO_0_LOOKING_UP_R )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_0_DUCKING_R, SUPER_MARIO_0_DUCKING_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_0_DUCKING_L, FLOWER_MARIO_0_DUCKING_R )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_0_VICTORY, SUPER_MARIO_0_VICTORY )
+MANIFEST_TEXTURE_RECOLORED( FLOWER_MARIO_0_THROWING_FIREBALL_R, SUPER_MARIO_0_THROWING_FIREBALL_R )
+MANIFEST_TEXTURE_FLIPPED( FLOWER_MARIO_0_THROWING_FIREBALL_L, FLOWER_MARIO_0_THROWING_FIREBALL_R )
+
+// fireball
+MANIFEST_TEXTURE( FIREBALL_0_R, "resources/images/sprites/mario/FlowerMarioFireball_0.png" )
+MANIFEST_TEXTURE( FIREBALL_1_R, "resources/images/sprites/mario/FlowerMarioFireball_1.png" )
+MANIFEST_TEXTURE( FIREBALL_2_R, "resources/images/sprites/mario/FlowerMarioFireball_2.png" )
+MANIFEST_TEXTURE( FIREBALL_3_R, "resources/images/sprites/mario/FlowerMarioFireball_3.png" )
+MANIFEST_TEXTURE_FLIPPED( FIREBALL_0_L, FIREBALL_0_R )
+MANIFEST_TEXTURE_FLIPPED( FIREBALL_1_L, FIREBALL_1_R )
+MANIFEST_TEXTURE_FLIPPED( FIREBALL_2_L, FIREBALL_2_R )
+MANIFEST_TEXTURE_FLIPPED( FIREBALL_3_L, FIREBALL_3_R )
+
+// tiles
+MANIFEST_TEXTURE( TILE_A1, "resources/images/tiles/tile_A1.png" )
+MANIFEST_TEXTURE( TILE_B1, "resources/images/tiles/tile_B1.png" )
+MANIFEST_TEXTURE( TILE_C1, "resources/images/tiles/tile_C1.png" )
+MANIFEST_TEXTURE( TILE_D1, "resources/images/tiles/tile_D1.png" )
+MANIFEST_TEXTURE( TILE_E1, "resources/images/tiles/tile_E1.png" )
+MANIFEST_TEXTURE( TILE_F1, "resources/images/tiles/tile_F1.png" )
+MANIFEST_TEXTURE( TILE_G1, "resources/images/tiles/tile_G1.png" )
+MANIFEST_TEXTURE( TILE_H1, "resources/images/tiles/tile_H1.png" )
+MANIFEST_TEXTURE( TILE_I1, "resources/images/tiles/tile_I1.png" )
+MANIFEST_TEXTURE( TILE_J1, "resources/images/tiles/tile_J1.png" )
+MANIFEST_TEXTURE( TILE_K1, "resources/images/tiles/tile_K1.png" )
+MANIFEST_TEXTURE( TILE_L1, "resources/images/tiles/tile_L1.png" )
+MANIFEST_TEXTURE( TILE_M1, "resources/images/tiles/tile_M1.png" )
+MANIFEST_TEXTURE( TILE_N1, "resources/images/tiles/tile_N1.png" )
+MANIFEST_TEXTURE( TILE_O1, "resources/images/tiles/tile_O1.png" )
+MANIFEST_TEXTURE( TILE_P1, "resources/images/tiles/tile_P1.png" )
+MANIFEST_TEXTURE( TILE_Q1, "resources/images/tiles/tile_Q1.png" )
+MANIFEST_TEXTURE( TILE_R1, "resources/images/tiles/tile_R1.png" )
+MANIFEST_TEXTURE( TILE_S1, "resources/images/tiles/tile_S1.png" )
+MANIFEST_TEXTURE( TILE_T1, "resources/images/tiles/tile_T1.png" )
+MANIFEST_TEXTURE( TILE_U1, "resources/images/tiles/tile_U1.png" )
+MANIFEST_TEXTURE( TILE_V1, "resources/images/tiles/tile_V1.png" )
+MANIFEST_TEXTURE( TILE_W1, "resources/images/tiles/tile_W1.png" )
+MANIFEST_TEXTURE( TILE_X1, "resources/images/tiles/tile_X1.png" )
+MANIFEST_TEXTURE( TILE_Y1, "resources/images/tiles/tile_Y1.png" )
+MANIFEST_TEXTURE( TILE_Z1, "resources/images/tiles/tile_Z1.png" )
+MANIFEST_TEXTURE( TILE_A2, "resources/images/tiles/tile_A2.png" )
+MANIFEST_TEXTURE( TILE_B2, "resources/images/tiles/tile_B2.png" )
+MANIFEST_TEXTURE( TILE_C2, "resources/images/tiles/tile_C2.png" )
+MANIFEST_TEXTURE( TILE_D2, "resources/images/tiles/tile_D2.png" )
+MANIFEST_TEXTURE( TILE_E2, "resources/images/tiles/tile_E2.png" )
+MANIFEST_TEXTURE( TILE_F2, "resources/images/tiles/tile_F2.png" )
+MANIFEST_TEXTURE( TILE_G2, "resources/images/tiles/tile_G2.png" )
+MANIFEST_TEXTURE( TILE_H2, "resources/images/tiles/tile_H2.png" )
+MANIFEST_TEXTURE( TILE_I2, "resources/images/tiles/tile_I2.png" )
+MANIFEST_TEXTURE( TILE_J2, "resources/images/tiles/tile_J2.png" )
+MANIFEST_TEXTURE( TILE_K2, "resources/images/tiles/tile_K2.png" )
+MANIFEST_TEXTURE( TILE_L2, "resources/images/tiles/tile_L2.png" )
+MANIFEST_TEXTURE( TILE_M2, "resources/images/tiles/tile_M2.png" )
+MANIFEST_TEXTURE( TILE_N2, "resources/images/tiles/tile_N2.png" )
+MANIFEST_TEXTURE( TILE_O2, "resources/images/tiles/tile_O2.png" )
+MANIFEST_TEXTURE( TILE_P2, "resources/images/tiles/tile_P2.png" )
+MANIFEST_TEXTURE( TILE_Q2, "resources/images/tiles/tile_Q2.png" )
+MANIFEST_TEXTURE( TILE_R2, "resources/images/tiles/tile_R2.png" )
+MANIFEST_TEXTURE( TILE_S2, "resources/images/tiles/tile_S2.png" )
+MANIFEST_TEXTURE( TILE_T2, "resources/images/tiles/tile_T2.png" )
+MANIFEST_TEXTURE( TILE_U2, "resources/images/tiles/tile_U2.png" )
+MANIFEST_TEXTURE( TILE_V2, "resources/images/tiles/tile_V2.png" )
+MANIFEST_TEXTURE( TILE_W2, "resources/images/tiles/tile_W2.png" )
+MANIFEST_TEXTURE( TILE_X2, "resources/images/tiles/tile_X2.png" )
+MANIFEST_TEXTURE( TILE_Y2, "resources/images/tiles/tile_Y2.png" )
+MANIFEST_TEXTURE( TILE_Z2, "resources/images/tiles/tile_Z2.png" )
+MANIFEST_TEXTURE( TILE_A3, "resources/images/tiles/tile_A3.png" )
+MANIFEST_TEXTURE( TILE_B3, "resources/images/tiles/tile_B3.png" )
+MANIFEST_TEXTURE( TILE_C3, "resources/images/tiles/tile_C3.png" )
+MANIFEST_TEXTURE( TILE_D3, "resources/images/tiles/tile_D3.png" )
+MANIFEST_TEXTURE( TILE_E3, "resources/images/tiles/tile_E3.png" )
+MANIFEST_TEXTURE( TILE_F3, "resources/images/tiles/tile_F3.png" )
+MANIFEST_TEXTURE( TILE_G3, "resources/images/tiles/tile_G3.png" )
+MANIFEST_TEXTURE( TILE_H3, "resources/images/tiles/tile_H3.png" )
+MANIFEST_TEXTURE( TILE_I3, "resources/images/tiles/tile_I3.png" )
+MANIFEST_TEXTURE( TILE_J3, "resources/images/tiles/tile_J3.png" )
+MANIFEST_TEXTURE( TILE_K3, "resources/images/tiles/tile_K3.png" )
+MANIFEST_TEXTURE( TILE_L3, "resources/images/tiles/tile_L3.png" )
+MANIFEST_TEXTURE( TILE_M3, "resources/images/tiles/tile_M3.png" )
+MANIFEST_TEXTURE( TILE_N3, "resources/images/tiles/tile_N3.png" )
+MANIFEST_TEXTURE( TILE_O3, "resources/images/tiles/tile_O3.png" )
+MANIFEST_TEXTURE( TILE_P3, "resources/images/tiles/tile_P3.png" )
+MANIFEST_TEXTURE( TILE_Q3, "resources/images/tiles/tile_Q3.png" )
+MANIFEST_TEXTURE( TILE_R3, "resources/images/tiles/tile_R3.png" )
+MANIFEST_TEXTURE( TILE_S3, "resources/images/tiles/tile_S3.png" )
+MANIFEST_TEXTURE( TILE_T3, "resources/images/tiles/tile_T3.png" )
+MANIFEST_TEXTURE( TILE_U3, "resources/images/tiles/tile_U3.png" )
+MANIFEST_TEXTURE( TILE_V3, "resources/images/tiles/tile_V3.png" )
+MANIFEST_TEXTURE( TILE_W3, "resources/images/tiles/tile_W3.png" )
+MANIFEST_TEXTURE( TILE_X3, "resources/images/tiles/tile_X3.png" )
+MANIFEST_TEXTURE( TILE_Y3, "resources/images/tiles/tile_Y3.png" )
+MANIFEST_TEXTURE( TILE_Z3, "resources/images/tiles/tile_Z3.png" )
+MANIFEST_TEXTURE( TILE_A4, "resources/images/tiles/tile_A4.png" )
+MANIFEST_TEXTURE( TILE_B4, "resources/images/tiles/tile_B4.png" )
+MANIFEST_TEXTURE( TILE_C4, "resources/images/tiles/tile_C4.png" )
+MANIFEST_TEXTURE( TILE_D4, "resources/images/tiles/tile_D4.png" )
+MANIFEST_TEXTURE( TILE_E4, "resources/images/tiles/tile_E4.png" )
+MANIFEST_TEXTURE( TILE_F4, "resources/images/tiles/tile_F4.png" )
+MANIFEST_TEXTURE( TILE_G4, "resources/images/tiles/tile_G4.png" )
+MANIFEST_TEXTURE( TILE_H4, "resources/images/tiles/tile_H4.png" )
+MANIFEST_TEXTURE( TILE_I4, "resources/images/tiles/tile_I4.png" )
+MANIFEST_TEXTURE( TILE_J4, "resources/images/tiles/tile_J4.png" )
+MANIFEST_TEXTURE( TILE_K4, "resources/images/tiles/tile_K4.png" )
+MANIFEST_TEXTURE( TILE_L4, "resources/images/tiles/tile_L4.png" )
+MANIFEST_TEXTURE( TILE_M4, "resources/images/tiles/tile_M4.png" )
+MANIFEST_TEXTURE( TILE_N4, "resources/images/tiles/tile_N4.png" )
+MANIFEST_TEXTURE( TILE_O4, "resources/images/tiles/tile_O4.png" )
+MANIFEST_TEXTURE( TILE_P4, "resources/images/tiles/tile_P4.png" )
+MANIFEST_TEXTURE( TILE_Q4, "resources/images/tiles/tile_Q4.png" )
+MANIFEST_TEXTURE( TILE_R4, "resources/images/tiles/tile_R4.png" )
+MANIFEST_TEXTURE( TILE_S4, "resources/images/tiles/tile_S4.png" )
+MANIFEST_TEXTURE( TILE_T4, "resources/images/tiles/tile_T4.png" )
+MANIFEST_TEXTURE( TILE_U4, "resources/images/tiles/tile_U4.png" )
+MANIFEST_TEXTURE( TILE_V4, "resources/images/tiles/tile_V4.png" )
+MANIFEST_TEXTURE( TILE_W4, "resources/images/tiles/tile_W4.png" )
+MANIFEST_TEXTURE( TILE_X4, "resources/images/tiles/tile_X4.png" )
+MANIFEST_TEXTURE( TILE_Y4, "resources/images/tiles/tile_Y4.png" )
+MANIFEST_TEXTURE( TILE_Z4, "resources/images/tiles/tile_Z4.png" )
+MANIFEST_TEXTURE( TILE_COURSE_CLEAR_POLE_BACK_TOP, "resources/images/tiles/tile_CourseClearPoleBackTop.png" )
+MANIFEST_TEXTURE( TILE_COURSE_CLEAR_POLE_BACK_BODY, "resources/images/tiles/tile_CourseClearPoleBackBody.png" )
+MANIFEST_TEXTURE( TILE_COURSE_CLEAR_POLE_FRONT_TOP, "resources/images/tiles/tile_CourseClearPoleFrontTop.png" )
+MANIFEST_TEXTURE( TILE_COURSE_CLEAR_POLE_FRONT_BODY, "resources/images/tiles/tile_CourseClearPoleFrontBody.png" )
+
+// blocks
+MANIFEST_TEXTURE( BLOCK_CLOUD, "resources/images/sprites/blocks/Cloud_0.png" )
+MANIFEST_TEXTURE( BLOCK_EXCLAMATION, "resources/images/sprites/blocks/Exclamation_0.png" )
+MANIFEST_TEXTURE( BLOCK_EYES_CLOSED, "resources/images/sprites/blocks/EyesClosed_0.png" )
+MANIFEST_TEXTURE( BLOCK_EYES_OPENED_0, "resources/images/sprites/blocks/EyesOpened_0.png" )
+MANIFEST_TEXTURE( BLOCK_EYES_OPENED_1, "resources/images/sprites/blocks/EyesOpened_1.png" )
+MANIFEST_TEXTURE( BLOCK_EYES_OPENED_2, "resources/images/sprites/blocks/EyesOpened_2.png" )
+MANIFEST_TEXTURE( BLOCK_EYES_OPENED_3, "resources/images/sprites/blocks/EyesOpened_3.png" )
+MANIFEST_TEXTURE( BLOCK_GLASS, "resources/images/sprites/blocks/Glass_0.png" )
+MANIFEST_TEXTURE( BLOCK_MESSAGE, "resources/images/sprites/blocks/Message_0.png" )
+MANIFEST_TEXTURE( BLOCK_QUESTION_0, "resources/images/sprites/blocks/Question_0.png" )
+MANIFEST_TEXTURE( BLOCK_QUESTION_1, "resources/images/sprites/blocks/Question_1.png" )
+MANIFEST_TEXTURE( BLOCK_QUESTION_2, "resources/images/sprites/blocks/Question_2.png" )
+MANIFEST_TEXTURE( BLOCK_QUESTION_3, "resources/images/sprites/blocks/Question_3.png" )
+MANIFEST_TEXTURE( BLOCK_STONE, "resources/images/sprites/blocks/Stone_0.png" )
+MANIFEST_TEXTURE( BLOCK_WOOD, "resources/images/sprites/blocks/Wood_0.png" )
+
+// backgrounds
+MANIFEST_TEXTURE( BACKGROUND_1, "resources/images/backgrounds/background1.png" )
+MANIFEST_TEXTURE( BACKGROUND_2, "resources/images/backgrounds/background2.png" )
+MANIFEST_TEXTURE( BACKGROUND_3, "resources/images/backgrounds/background3.png" )
+MANIFEST_TEXTURE( BACKGROUND_4, "resources/images/backgrounds/background4.png" )
+MANIFEST_TEXTURE( BACKGROUND_5, "resources/images/backgrounds/background5.png" )
+MANIFEST_TEXTURE( BACKGROUND_6, "resources/images/backgrounds/background6.png" )
+MANIFEST_TEXTURE( BACKGROUND_7, "resources/images/backgrounds/background7.png" )
+MANIFEST_TEXTURE( BACKGROUND_8, "resources/images/backgrounds/background8.png" )
+MANIFEST_TEXTURE( BACKGROUND_9, "resources/images/backgrounds/background9.png" )
+MANIFEST_TEXTURE( BACKGROUND_10, "resources/images/backgrounds/background10.png" )
+
+// items
+MANIFEST_TEXTURE( COIN_0, "resources/images/sprites/items/Coin_0.png" )
+MANIFEST_TEXTURE( COIN_1, "resources/images/sprites/items/Coin_1.png" )
+MANIFEST_TEXTURE( COIN_2, "resources/images/sprites/items/Coin_2.png" )
+MANIFEST_TEXTURE( COIN_3, "resources/images/sprites/items/Coin_3.png" )
+MANIFEST_TEXTURE( 1_UP_MUSHROOM, "resources/images/sprites/items/1UpMushroom.png" )
+MANIFEST_TEXTURE( 3_UP_MOON, "resources/images/sprites/items/3UpMoon.png" )
+MANIFEST_TEXTURE( COURSE_CLEAR_TOKEN, "resources/images/sprites/items/CourseClearToken.png" )
+MANIFEST_TEXTURE( FIRE_FLOWER_0, "resources/images/sprites/items/FireFlower_0.png" )
+MANIFEST_TEXTURE( FIRE_FLOWER_1, "resources/images/sprites/items/FireFlower_1.png" )
+MANIFEST_TEXTURE( MUSHROOM, "resources/images/sprites/items/Mushroom.png" )
+MANIFEST_TEXTURE( STAR, "resources/images/sprites/items/Star.png" )
+
+// baddies
+MANIFEST_TEXTURE( BLUE_KOOPA_TROOPA_0_R, "resources/images/sprites/baddies/BlueKoopaTroopa_0.png" )
+MANIFEST_TEXTURE( BLUE_KOOPA_TROOPA_1_R, "resources/images/sprites/baddies/BlueKoopaTroopa_1.png" )
+MANIFEST_TEXTURE_FLIPPED( BLUE_KOOPA_TROOPA_0_L, BLUE_KOOPA_TROOPA_0_R )
+MANIFEST_TEXTURE_FLIPPED( BLUE_KOOPA_TROOPA_1_L, BLUE_KOOPA_TROOPA_1_R )
+MANIFEST_TEXTURE( BOB_OMB_0_R, "resources/images/sprites/baddies/BobOmb_0.png" )
+MANIFEST_TEXTURE( BOB_OMB_1_R, "resources/images/sprites/baddies/BobOmb_1.png" )
+MANIFEST_TEXTURE_FLIPPED( BOB_OMB_0_L, BOB_OMB_0_R )
+MANIFEST_TEXTURE_FLIPPED( BOB_OMB_1_L, BOB_OMB_1_R )
+MANIFEST_TEXTURE( BULLET_BILL_0_R, "resources/images/sprites/baddies/BulletBill_0.png" )
+MANIFEST_TEXTURE_FLIPPED( BULLET_BILL_0_L, BULLET_BILL_0_R )
+MANIFEST_TEXTURE( BUZZY_BEETLE_0_R, "resources/images/sprites/baddies/BuzzyBeetle_0.png" )
+MANIFEST_TEXTURE( BUZZY_BEETLE_1_R, "resources/images/sprites/baddies/BuzzyBeetle_1.png" )
+MANIFEST_TEXTURE_FLIPPED( BUZZY_BEETLE_0_L, BUZZY_BEETLE_0_R )
+MANIFEST_TEXTURE_FLIPPED( BUZZY_BEETLE_1_L, BUZZY_BEETLE_1_R )
+MANIFEST_TEXTURE( FLYING_GOOMBA_0_R, "resources/images/sprites/baddies/FlyingGoomba_0.png" )
+MANIFEST_TEXTURE( FLYING_GOOMBA_1_R, "resources/images/sprites/baddies/FlyingGoomba_1.png" )
+MANIFEST_TEXTURE_FLIPPED( FLYING_GOOMBA_0_L, FLYING_GOOMBA_0_R )
+MANIFEST_TEXTURE_FLIPPED( FLYING_GOOMBA_1_L, FLYING_GOOMBA_1_R )
+MANIFEST_TEXTURE( GOOMBA_0_R, "resources/images/sprites/baddies/Goomba_0.png" )
+MANIFEST_TEXTURE( GOOMBA_1_R, "resources/images/sprites/baddies/Goomba_1.png" )
+MANIFEST_TEXTURE_FLIPPED( GOOMBA_0_L, GOOMBA_0_R )
+MANIFEST_TEXTURE_FLIPPED( GOOMBA_1_L, GOOMBA_1_R )
+MANIFEST_TEXTURE( GREEN_KOOPA_TROOPA_0_R, "resources/images/sprites/baddies/GreenKoopaTroopa_0.png" )
+MANIFEST_TEXTURE( GREEN_KOOPA_TROOPA_1_R, "resources/images/sprites/baddies/GreenKoopaTroopa_1.png" )
+MANIFEST_TEXTURE_FLIPPED( GREEN_KOOPA_TROOPA_0_L, GREEN_KOOPA_TROOPA_0_R )
+MANIFEST_TEXTURE_FLIPPED( GREEN_KOOPA_TROOPA_1_L, GREEN_KOOPA_TROOPA_1_R )
+MANIFEST_TEXTURE( MUMMY_BEETLE_0_R, "resources/images/sprites/baddies/MummyBeetle_0.png" )
+MANIFEST_TEXTURE( MUMMY_BEETLE_1_R, "resources/images/sprites/baddies/MummyBeetle_1.png" )
+MANIFEST_TEXTURE_FLIPPED( MUMMY_BEETLE_0_L, MUMMY_BEETLE_0_R )
+MANIFEST_TEXTURE_FLIPPED( MUMMY_BEETLE_1_L, MUMMY_BEETLE_1_R )
+MANIFEST_TEXTURE( MUNCHER_0, "resources/images/sprites/baddies/Muncher_0.png" )
+MANIFEST_TEXTURE( MUNCHER_1, "resources/images/sprites/baddies/Muncher_1.png" )
+MANIFEST_TEXTURE( PIRANHA_PLANT_0, "resources/images/sprites/baddies/PiranhaPlant_0.png" )
+MANIFEST_TEXTURE( PIRANHA_PLANT_1, "resources/images/sprites/baddies/PiranhaPlant_1.png" )
+MANIFEST_TEXTURE( RED_KOOPA_TROOPA_0_R, "resources/images/sprites/baddies/RedKoopaTroopa_0.png" )
+MANIFEST_TEXTURE( RED_KOOPA_TROOPA_1_R, "resources/images/sprites/baddies/RedKoopaTroopa_1.png" )
+MANIFEST_TEXTURE_FLIPPED( RED_KOOPA_TROOPA_0_L, RED_KOOPA_TROOPA_0_R )
+MANIFEST_TEXTURE_FLIPPED( RED_KOOPA_TROOPA_1_L, RED_KOOPA_TROOPA_1_R )
+MANIFEST_TEXTURE( REX_1_0_R, "resources/images/sprites/baddies/Rex_1_0.png" )
+MANIFEST_TEXTURE( REX_1_1_R, "resources/images/sprites/baddies/Rex_1_1.png" )
+MANIFEST_TEXTURE( REX_2_0_R, "resources/images/sprites/baddies/Rex_2_0.png" )
+MANIFEST_TEXTURE( REX_2_1_R, "resources/images/sprites/baddies/Rex_2_1.png" )
+MANIFEST_TEXTURE_FLIPPED( REX_1_0_L, REX_1_0_R )
+MANIFEST_TEXTURE_FLIPPED( REX_1_1_L, REX_1_1_R )
+MANIFEST_TEXTURE_FLIPPED( REX_2_0_L, REX_2_0_R )
+MANIFEST_TEXTURE_FLIPPED( REX_2_1_L, REX_2_1_R )
+MANIFEST_TEXTURE( SWOOPER_0_R, "resources/images/sprites/baddies/Swooper_1.png" )
+MANIFEST_TEXTURE( SWOOPER_1_R, "resources/images/sprites/baddies/Swooper_2.png" )
+MANIFEST_TEXTURE_FLIPPED( SWOOPER_0_L, SWOOPER_0_R )
+MANIFEST_TEXTURE_FLIPPED( SWOOPER_1_L, SWOOPER_1_R )
+MANIFEST_TEXTURE( YELLOW_KOOPA_TROOPA_0_R, "resources/images/sprites/baddies/YellowKoopaTroopa_0.png" )
+MANIFEST_TEXTURE( YELLOW_KOOPA_TROOPA_1_R, "resources/images/sprites/baddies/YellowKoopaTroopa_1.png" )
+MANIFEST_TEXTURE_FLIPPED( YELLOW_KOOPA_TROOPA_0_L, YELLOW_KOOPA_TROOPA_0_R )
+MANIFEST_TEXTURE_FLIPPED( YELLOW_KOOPA_TROOPA_1_L, YELLOW_KOOPA_TROOPA_1_R )
+
+// gui
+MANIFEST_TEXTURE( GUI_ALFA, "resources/images/gui/guiAlfa.png" )
+MANIFEST_TEXTURE( GUI_ALFA_LOWER_UPPER, "resources/images/gui/guiAlfaLowerUpper.png" )
+MANIFEST_TEXTURE( GUI_CLOCK, "resources/images/gui/guiClock.png" )
+MANIFEST_TEXTURE( GUI_COIN, "resources/images/gui/guiCoin.png" )
+MANIFEST_TEXTURE( GUI_CREDITS, "resources/images/gui/guiCredits.png" )
+MANIFEST_TEXTURE( GUI_GAME_OVER, "resources/images/gui/guiGameOver.png" )
+MANIFEST_TEXTURE( GUI_LETTERS, "resources/images/gui/guiLetters.png" )
+MANIFEST_TEXTURE( GUI_MARIO, "resources/images/gui/guiMario.png" )
+MANIFEST_TEXTURE( GUI_MARIO_START, "resources/images/gui/guiMarioStart.png" )
+MANIFEST_TEXTURE( GUI_NEXT_ITEM, "resources/images/gui/guiNextItem.png" )
+MANIFEST_TEXTURE( GUI_NUMBERS_BIG, "resources/images/gui/guiNumbersBig.png" )
+MANIFEST_TEXTURE( GUI_NUMBERS_WHITE, "resources/images/gui/guiNumbersWhite.png" )
+MANIFEST_TEXTURE( GUI_NUMBERS_YELLOW, "resources/images/gui/guiNumbersYellow.png" )
+MANIFEST_TEXTURE( GUI_PUNCTUATION, "resources/images/gui/guiPunctuation.png" )
+MANIFEST_TEXTURE( GUI_RAY_MARIO_LOGO, "resources/images/gui/guiRayMarioLogo.png" )
+MANIFEST_TEXTURE( GUI_TIME, "resources/images/gui/guiTime.png" )
+MANIFEST_TEXTURE( GUI_TIME_UP, "resources/images/gui/guiTimeUp.png" )
+MANIFEST_TEXTURE( GUI_X, "resources/images/gui/guiX.png" )
+
+// sounds
+MANIFEST_SOUND( 1_UP, "resources/sfx/smw_1-up.wav" )
+MANIFEST_SOUND( BREAK_BLOCK, "resources/sfx/smw_break_block.wav" )
+MANIFEST_SOUND( COIN, "resources/sfx/smw_coin.wav" )
+MANIFEST_SOUND( CHUCK_WHISTLE, "resources/sfx/smw_chuck_whistle.wav" )
+MANIFEST_SOUND( FIREBALL, "resources/sfx/smw_fireball.wav" )
+MANIFEST_SOUND( GOAL_IRIS_OUT, "resources/sfx/smw_goal_iris-out.wav" )
+MANIFEST_SOUND( JUMP, "resources/sfx/smw_jump.wav" )
+MANIFEST_SOUND( KICK, "resources/sfx/smw_kick.wav" )
+MANIFEST_SOUND( MESSAGE_BLOCK, "resources/sfx/smw_message_block.wav" )
+MANIFEST_SOUND( PAUSE, "resources/sfx/smw_pause.wav" )
+MANIFEST_SOUND( PIPE, "resources/sfx/smw_pipe.wav" )
+MANIFEST_SOUND( POWER_UP, "resources/sfx/smw_power-up.wav" )
+MANIFEST_SOUND( POWER_UP_APPEARS, "resources/sfx/smw_power-up_appears.wav" )
+MANIFEST_SOUND( RESERVE_ITEM_RELEASE, "resources/sfx/smw_reserve_item_release.wav" )
+MANIFEST_SOUND( RESERVE_ITEM_STORE, "resources/sfx/smw_reserve_item_store.wav" )
+MANIFEST_SOUND( RIDING_YOSHI, "resources/sfx/smw_riding_yoshi.wav" )
+MANIFEST_SOUND( SHELL_RICOCHET, "resources/sfx/smw_shell_ricochet.wav" )
+MANIFEST_SOUND( STOMP, "resources/sfx/smw_stomp.wav" )
+MANIFEST_SOUND( STOMP_NO_DAMAGE, "resources/sfx/smw_stomp_no_damage.wav" )
+
+// musics
+MANIFEST_MUSIC( COURSE_CLEAR, "resources/musics/courseClear.mp3" )
+MANIFEST_MUSIC( ENDING, "resources/musics/ending.mp3" )
+MANIFEST_MUSIC( GAME_OVER, "resources/musics/gameOver.mp3" )
+MANIFEST_MUSIC( INVINCIBLE, "resources/musics/invincible.mp3" )
+MANIFEST_MUSIC( STAGE_1, "resources/musics/music1.mp3" )
+MANIFEST_MUSIC( STAGE_2, "resources/musics/music2.mp3" )
+MANIFEST_MUSIC( STAGE_3, "resources/musics/music3.mp3" )
+MANIFEST_MUSIC( STAGE_4, "resources/musics/music4.mp3" )
+MANIFEST_MUSIC( STAGE_5, "resources/musics/music5.mp3" )
+MANIFEST_MUSIC( STAGE_6, "resources/musics/music6.mp3" )
+MANIFEST_MUSIC( STAGE_7, "resources/musics/music7.mp3" )
+MANIFEST_MUSIC( STAGE_8, "resources/musics/music8.mp3" )
+MANIFEST_MUSIC( STAGE_9, "resources/musics/music9.mp3" )
+MANIFEST_MUSIC( PLAYER_DOWN, "resources/musics/playerDown.mp3" )
+MANIFEST_MUSIC( TITLE, "resources/musics/title.mp3" )
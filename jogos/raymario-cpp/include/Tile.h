@@ -8,21 +8,21 @@
 #pragma once
 
 #include "raylib.h"
+#include "ResourceId.h"
 #include "Sprite.h"
-#include <string>
 
 class Tile : public virtual Sprite {
 
 protected:
-    std::string key;
+    TextureId textureId;
     bool visible;
     bool onlyBaddies;
     bool showCollisionOnDebug;
 
 public:
 
-    Tile( Vector2 pos, Vector2 dim, Color color, std::string key, bool visible );
-    Tile( Vector2 pos, Vector2 dim, Color color, std::string key, bool visible, bool onlyBaddies );
+    Tile( Vector2 pos, Vector2 dim, Color color, TextureId textureId, bool visible );
+    Tile( Vector2 pos, Vector2 dim, Color color, TextureId textureId, bool visible, bool onlyBaddies );
     ~Tile() override;
 
     void update() override;
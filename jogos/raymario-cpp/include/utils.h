@@ -8,8 +8,11 @@
 #pragma once
 
 #include <raylib.h>
+#include "FrameArena.h"
+#include "ResourceId.h"
 #include <string>
 #include <map>
+#include <string_view>
 #include <vector>
 
 double toRadians( double degrees );
@@ -21,21 +24,22 @@ Texture2D textureColorReplace( Texture2D texture, std::vector<Color> replacePall
 
 void drawWhiteSmallNumber( int number, int x, int y );
 void drawYellowSmallNumber( int number, int x, int y );
-void drawSmallNumber( int number, int x, int y, std::string textureId );
+void drawSmallNumber( int number, int x, int y, TextureId textureId );
 void drawBigNumber( int number, int x, int y );
 int getSmallNumberWidth( int number );
 int getSmallNumberHeight();
 int getBigNumberWidth( int number );
 int getBigNumberHeight();
 
-void drawString( std::string str, int x, int y );
+void drawString( std::string_view str, int x, int y );
 void drawString( std::wstring str, int x, int y );
-int getDrawStringWidth( std::string str );
+int getDrawStringWidth( std::string_view str );
 int getDrawStringHeight();
 
-void drawMessageString( std::string str, int x, int y );
-int getDrawMessageStringWidth( std::string str );
+void drawMessageString( std::string_view str, int x, int y );
+int getDrawMessageStringWidth( std::string_view str );
 int getDrawMessageStringHeight();
 
 std::vector<std::string> split( std::string s, std::string delimiter = "\n" );
-std::vector<std::string> split( const std::string& s, char delim );
\ No newline at end of file
+std::vector<std::string> split( const std::string& s, char delim );
+FrameVector<std::string_view> splitFrame( std::string_view s, std::string_view delimiter = "\n" );
\ No newline at end of file
@@ -5,12 +5,14 @@
  * 
  * @copyright Copyright (c) 2024
  */
+#include "FrameArena.h"
 #include "raylib.h"
 #include "ResourceManager.h"
 #include "utils.h"
 #include <map>
 #include <string>
 #include <sstream>
+#include <string_view>
 #include <vector>
 
 double toRadians( double degrees ) {
@@ -42,15 +44,15 @@ Texture2D textureColorReplace( Texture2D texture, std::vector<Color> replacePall
 }
 
 void drawWhiteSmallNumber( int number, int x, int y ) {
-    drawSmallNumber( number, x, y, "guiNumbersWhite" );
+    drawSmallNumber( number, x, y, TEXTURE_GUI_NUMBERS_WHITE );
 }
 
 void drawYellowSmallNumber( int number, int x, int y ) {
-    drawSmallNumber( number, x, y, "guiNumbersYellow" );
+    drawSmallNumber( number, x, y, TEXTURE_GUI_NUMBERS_YELLOW );
 }
 
-void drawSmallNumber( int number, int x, int y, std::string textureId ) {
-    Texture2D texture = ResourceManager::getTextures()[textureId];
+void drawSmallNumber( int number, int x, int y, TextureId textureId ) {
+    Texture2D texture = ResourceManager::getTexture( textureId );
     int w = 18;
     int h = 14;
     std::string str = std::to_string( number );
@@ -62,7 +64,7 @@ void drawSmallNumber( int number, int x, int y, std::string textureId ) {
 }
 
 void drawBigNumber( int number, int x, int y ) {
-    Texture2D texture = ResourceManager::getTextures()["guiNumbersBig"];
+    Texture2D texture = ResourceManager::getTexture( TEXTURE_GUI_NUMBERS_BIG );
     int w = 18;
     int h = 28;
     std::string str = std::to_string( number );
@@ -73,9 +75,9 @@ void drawBigNumber( int number, int x, int y ) {
     }
 }
 
-void drawString( std::string str, int x, int y ) {
+void drawString( std::string_view str, int x, int y ) {
 
-    Texture2D texture = ResourceManager::getTextures()["guiAlfa"];
+    Texture2D texture = ResourceManager::getTexture( TEXTURE_GUI_ALFA );
     int w = 18;
     int h = 20;
     int px = x;
@@ -127,7 +129,7 @@ void drawString( std::string str, int x, int y ) {
 
 void drawString( std::wstring str, int x, int y ) {
 
-    Texture2D texture = ResourceManager::getTextures()["guiAlfa"];
+    Texture2D texture = ResourceManager::getTexture( TEXTURE_GUI_ALFA );
     int w = 18;
     int h = 20;
     int px = x;
@@ -210,7 +212,7 @@ int getBigNumberHeight() {
     return 28;
 }
 
-int getDrawStringWidth( std::string str ) {
+int getDrawStringWidth( std::string_view str ) {
     return 16 * str.length();
 }
 
@@ -218,9 +220,9 @@ int getDrawStringHeight() {
     return 20;
 }
 
-void drawMessageString( std::string str, int x, int y ) {
+void drawMessageString( std::string_view str, int x, int y ) {
 
-    Texture2D texture = ResourceManager::getTextures()["guiAlfaLowerUpper"];
+    Texture2D texture = ResourceManager::getTexture( TEXTURE_GUI_ALFA_LOWER_UPPER );
     int w = 16;
     int h = 16;
     int px = x;
@@ -276,7 +278,7 @@ void drawMessageString( std::string str, int x, int y ) {
 
 }
 
-int getDrawMessageStringWidth( std::string str ) {
+int getDrawMessageStringWidth( std::string_view str ) {
     return 16 * str.length();
 }
 
@@ -315,4 +317,21 @@ std::vector<std::string> split( const std::string& s, char delim ) {
     }
 
     return result;
+}
+
+FrameVector<std::string_view> splitFrame( std::string_view s, std::string_view delimiter ) {
+
+    // the views point into s, so they are valid while s is
+    size_t pos_start = 0;
+    size_t pos_end;
+    FrameVector<std::string_view> res;
+
+    while ( ( pos_end = s.find( delimiter, pos_start ) ) != std::string_view::npos ) {
+        res.push_back( s.substr( pos_start, pos_end - pos_start ) );
+        pos_start = pos_end + delimiter.length();
+    }
+
+    res.push_back( s.substr( pos_start ) );
+    return res;
+
 }
\ No newline at end of file
@@ -0,0 +1,406 @@
+/**
+ * @file Sand.c
+ * @author Prof. Dr. David Buzatto
+ * @brief SandGrid implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <Sand.h>
+#include <SandPool.h>
+
+typedef struct SandTask {
+    SandGrid *sand;
+    int gravity;                // in 1/SAND_VELOCITY_SCALE of a cell
+} SandTask;
+
+static void updateTask( SandPool *pool, int worker, void *data );
+static void updateChunk( SandGrid *sand, int ci, int cj, int gravity );
+static int move( SandGrid *sand, int ci, int cj, int line, int column );
+static void swap( SandGrid *sand, int ci, int cj, int line, int column, int toLine, int toColumn );
+static void markDirty( SandGrid *sand, int fromCi, int fromCj, int minLine, int minColumn, int maxLine, int maxColumn );
+static unsigned int randomSandGrid( Chunk *chunk );
+
+SandGrid* createSandGrid( int lines, int columns, int threadCount ) {
+
+    SandGrid *sand = (SandGrid*) malloc( sizeof( SandGrid ) );
+
+    sand->lines = lines;
+    sand->columns = columns;
+    sand->materials = (unsigned char*) calloc( lines * columns, sizeof( unsigned char ) );
+    sand->velocities = (unsigned char*) calloc( lines * columns, sizeof( unsigned char ) );
+    sand->palette[SAND_EMPTY] = SAND_EMPTY_COLOR;
+    sand->paletteCount = 1;
+    sand->chunkLines = ( lines + SAND_CHUNK_SIZE - 1 ) / SAND_CHUNK_SIZE;
+    sand->chunkColumns = ( columns + SAND_CHUNK_SIZE - 1 ) / SAND_CHUNK_SIZE;
+    sand->awakeChunks = 0;
+    sand->clock = 0;
+    sand->gravityRemainder = 0;
+    sand->pool = createSandPool( threadCount );
+
+    int chunkCount = sand->chunkLines * sand->chunkColumns;
+    sand->chunks = (Chunk*) malloc( chunkCount * sizeof( Chunk ) );
+    sand->phaseChunks = (int*) malloc( 4 * chunkCount * sizeof( int ) );
+
+    for ( int k = 0; k < chunkCount; k++ ) {
+        Chunk *c = &sand->chunks[k];
+        c->rect = (DirtyRect) { lines, columns, -1, -1 };
+        for ( int s = 0; s < 9; s++ ) {
+            c->nextRects[s] = c->rect;
+        }
+        // xorshift must not start at zero
+        c->seed = ( k + 1 ) * 2654435761u;
+        if ( c->seed == 0 ) {
+            c->seed = 1;
+        }
+        c->updatedGrains = 0;
+    }
+
+    for ( int p = 0; p < 4; p++ ) {
+        sand->phaseCounts[p] = 0;
+    }
+
+    return sand;
+
+}
+
+void destroySandGrid( SandGrid *sand ) {
+    destroySandPool( sand->pool );
+    free( sand->phaseChunks );
+    free( sand->chunks );
+    free( sand->velocities );
+    free( sand->materials );
+    free( sand );
+}
+
+void updateSandGrid( SandGrid *sand, float gravity ) {
+
+    int chunkCount = sand->chunkLines * sand->chunkColumns;
+
+    sand->clock++;
+    sand->awakeChunks = 0;
+    for ( int p = 0; p < 4; p++ ) {
+        sand->phaseCounts[p] = 0;
+    }
+
+    // what was marked in the last frame (or was created now) is updated
+    // in this one, each chunk in the phase of its line and column
+    for ( int ci = 0; ci < sand->chunkLines; ci++ ) {
+        for ( int cj = 0; cj < sand->chunkColumns; cj++ ) {
+
+            int k = ci * sand->chunkColumns + cj;
+            Chunk *c = &sand->chunks[k];
+            DirtyRect empty = { sand->lines, sand->columns, -1, -1 };
+
+            c->rect = empty;
+            for ( int s = 0; s < 9; s++ ) {
+                DirtyRect *n = &c->nextRects[s];
+                if ( n->maxLine >= n->minLine ) {
+                    if ( n->minLine < c->rect.minLine ) c->rect.minLine = n->minLine;
+                    if ( n->minColumn < c->rect.minColumn ) c->rect.minColumn = n->minColumn;
+                    if ( n->maxLine > c->rect.maxLine ) c->rect.maxLine = n->maxLine;
+                    if ( n->maxColumn > c->rect.maxColumn ) c->rect.maxColumn = n->maxColumn;
+                }
+                *n = empty;
+            }
+            c->updatedGrains = 0;
+
+            if ( c->rect.maxLine >= c->rect.minLine ) {
+                int phase = ( ci % 2 ) * 2 + cj % 2;
+                sand->phaseChunks[phase*chunkCount+sand->phaseCounts[phase]++] = k;
+                sand->awakeChunks++;
+            }
+
+        }
+    }
+
+    if ( sand->awakeChunks == 0 ) {
+        return;
+    }
+
+    float increment = gravity * SAND_VELOCITY_SCALE + sand->gravityRemainder;
+    SandTask task = { sand, (int) increment };
+    sand->gravityRemainder = increment - task.gravity;
+    runSandPool( sand->pool, updateTask, &task );
+
+}
+
+void markDirtySandGrid( SandGrid *sand, int minLine, int minColumn, int maxLine, int maxColumn ) {
+    markDirty( sand, -1, -1, minLine, minColumn, maxLine, maxColumn );
+}
+
+void setGrainSandGrid( SandGrid *sand, int line, int column, unsigned char material, float velY ) {
+
+    int p = line * sand->columns + column;
+    int v = (int) ( velY * SAND_VELOCITY_SCALE + 0.5f );
+
+    if ( v > SAND_VELOCITY_MASK ) {
+        v = SAND_VELOCITY_MASK;
+    }
+
+    // the next frame has the other clock bit
+    sand->materials[p] = material;
+    sand->velocities[p] = v | ( sand->clock & 1 ? SAND_CLOCK_BIT : 0 );
+
+}
+
+unsigned char getPaletteIndexSandGrid( SandGrid *sand, unsigned int color ) {
+
+    for ( int k = 1; k < sand->paletteCount; k++ ) {
+        if ( sand->palette[k] == color ) {
+            return k;
+        }
+    }
+
+    if ( sand->paletteCount < SAND_PALETTE_SIZE ) {
+        sand->palette[sand->paletteCount] = color;
+        return sand->paletteCount++;
+    }
+
+    int closest = 1;
+    int closestDistance = 0x7fffffff;
+
+    for ( int k = 1; k < sand->paletteCount; k++ ) {
+        int distance = 0;
+        for ( int shift = 8; shift < 32; shift += 8 ) {
+            int d = (int) ( ( sand->palette[k] >> shift ) & 0xff ) - (int) ( ( color >> shift ) & 0xff );
+            distance += d * d;
+        }
+        if ( distance < closestDistance ) {
+            closest = k;
+            closestDistance = distance;
+        }
+    }
+
+    return closest;
+
+}
+
+bool isLineColumnOkSandGrid( const SandGrid *sand, int line, int column ) {
+    return line >= 0 && line < sand->lines && column >= 0 && column < sand->columns;
+}
+
+bool getChangedLinesSandGrid( const SandGrid *sand, int *minLine, int *maxLine ) {
+
+    *minLine = sand->lines;
+    *maxLine = -1;
+
+    for ( int k = 0; k < sand->chunkLines * sand->chunkColumns; k++ ) {
+        const Chunk *c = &sand->chunks[k];
+        for ( int s = -1; s < 9; s++ ) {
+            const DirtyRect *r = s < 0 ? &c->rect : &c->nextRects[s];
+            if ( r->maxLine >= r->minLine ) {
+                if ( r->minLine < *minLine ) *minLine = r->minLine;
+                if ( r->maxLine > *maxLine ) *maxLine = r->maxLine;
+            }
+        }
+    }
+
+    return *maxLine >= *minLine;
+
+}
+
+int getUpdatedGrainsSandGrid( const SandGrid *sand ) {
+    int count = 0;
+    for ( int k = 0; k < sand->chunkLines * sand->chunkColumns; k++ ) {
+        count += sand->chunks[k].updatedGrains;
+    }
+    return count;
+}
+
+/**
+ * @brief Updates the awake chunks of each phase, each worker over its
+ * own band of them, waiting for each other between the phases.
+ */
+static void updateTask( SandPool *pool, int worker, void *data ) {
+
+    SandTask *task = (SandTask*) data;
+    SandGrid *sand = task->sand;
+    int chunkCount = sand->chunkLines * sand->chunkColumns;
+
+    for ( int phase = 0; phase < 4; phase++ ) {
+
+        int from;
+        int to;
+        getBandSandPool( pool, worker, 0, sand->phaseCounts[phase], &from, &to );
+
+        for ( int i = from; i < to; i++ ) {
+            int k = sand->phaseChunks[phase*chunkCount+i];
+            updateChunk( sand, k / sand->chunkColumns, k % sand->chunkColumns, task->gravity );
+        }
+
+        if ( phase < 3 ) {
+            syncSandPool( pool );
+        }
+
+    }
+
+}
+
+/**
+ * @brief Updates the dirty rect of a chunk, from the bottom to the top
+ * and from the right to the left, so the grains that fall to the lines
+ * below, already updated, are not moved again.
+ */
+static void updateChunk( SandGrid *sand, int ci, int cj, int gravity ) {
+
+    Chunk *c = &sand->chunks[ci*sand->chunkColumns+cj];
+    DirtyRect r = c->rect;
+    const unsigned char *materials = sand->materials;
+    unsigned char *velocities = sand->velocities;
+    unsigned char clock = sand->clock & 1 ? SAND_CLOCK_BIT : 0;
+
+    for ( int i = r.maxLine; i >= r.minLine; i-- ) {
+        for ( int j = r.maxColumn; j >= r.minColumn; j-- ) {
+
+            int p = i * sand->columns + j;
+
+            if ( materials[p] == SAND_EMPTY ) {
+                continue;
+            }
+
+            // fell from a chunk updated before in this frame
+            if ( ( velocities[p] & SAND_CLOCK_BIT ) == clock ) {
+                markDirty( sand, ci, cj, i, j, i, j );
+                continue;
+            }
+
+            if ( ( velocities[p] & SAND_VELOCITY_MASK ) != 0 ) {
+                p = move( sand, ci, cj, i, j );
+            } else {
+                // will try to move in the next frame
+                markDirty( sand, ci, cj, i, j, i, j );
+            }
+
+            int v = ( velocities[p] & SAND_VELOCITY_MASK ) + gravity;
+            if ( v > SAND_VELOCITY_MASK ) {
+                v = SAND_VELOCITY_MASK;
+            }
+            velocities[p] = v | clock;
+            c->updatedGrains++;
+
+        }
+    }
+
+}
+
+/**
+ * @brief Moves the grain at line and column up to velY lines down,
+ * stopping over the first grain or at the bottom of the grid, or, if it
+ * can not fall, to one of the cells below it at the sides, and returns
+ * the position where the grain ended.
+ */
+static int move( SandGrid *sand, int ci, int cj, int line, int column ) {
+
+    int p = line * sand->columns + column;
+    int lastLine = line + ( sand->velocities[p] & SAND_VELOCITY_MASK ) / SAND_VELOCITY_SCALE;
+    int nextLine = line;
+    int nextColumn = column;
+
+    if ( lastLine >= sand->lines ) {
+        lastLine = sand->lines - 1;
+    }
+
+    while ( nextLine < lastLine && sand->materials[(nextLine+1)*sand->columns+column] == SAND_EMPTY ) {
+        nextLine++;
+    }
+
+    if ( nextLine > line ) {
+        swap( sand, ci, cj, line, column, nextLine, nextColumn );
+        return nextLine * sand->columns + nextColumn;
+    }
+
+    int side = randomSandGrid( &sand->chunks[ci*sand->chunkColumns+cj] ) >> 31 ? 1 : -1;
+    nextColumn += side;
+    nextLine = line + 1;
+    int pNext = nextLine * sand->columns + nextColumn;
+
+    if ( isLineColumnOkSandGrid( sand, nextLine, nextColumn ) ) {
+        if ( sand->materials[pNext] == SAND_EMPTY ) {
+            swap( sand, ci, cj, line, column, nextLine, nextColumn );
+            return pNext;
+        }
+    }
+
+    // too slow to fall yet, or the other side may be free, so the grain
+    // is not settled
+    int otherColumn = column - side;
+    if ( nextLine < sand->lines && 
+         ( sand->materials[nextLine*sand->columns+column] == SAND_EMPTY ||
+           ( isLineColumnOkSandGrid( sand, nextLine, otherColumn ) &&
+             sand->materials[nextLine*sand->columns+otherColumn] == SAND_EMPTY ) ) ) {
+        markDirty( sand, ci, cj, line, column, line, column );
+    }
+
+    return p;
+
+}
+
+static void swap( SandGrid *sand, int ci, int cj, int line, int column, int toLine, int toColumn ) {
+    int p1 = line * sand->columns + column;
+    int p2 = toLine * sand->columns + toColumn;
+    unsigned char material = sand->materials[p1];
+    unsigned char velocity = sand->velocities[p1];
+    sand->materials[p1] = sand->materials[p2];
+    sand->velocities[p1] = sand->velocities[p2];
+    sand->materials[p2] = material;
+    sand->velocities[p2] = velocity;
+    // the grains around the cell left empty may fall into it
+    markDirty( sand, ci, cj, line - 1, column - 1, line + 1, column + 1 );
+    markDirty( sand, ci, cj, toLine - 1, toColumn - 1, toLine + 1, toColumn + 1 );
+}
+
+/**
+ * @brief Marks the cells in every chunk they cover, in the slot of the
+ * chunk at fromCi and fromCj, that must be at most one chunk away, or
+ * in the center slot if fromCi is negative.
+ */
+static void markDirty( SandGrid *sand, int fromCi, int fromCj, int minLine, int minColumn, int maxLine, int maxColumn ) {
+
+    if ( minLine < 0 ) minLine = 0;
+    if ( minColumn < 0 ) minColumn = 0;
+    if ( maxLine > sand->lines - 1 ) maxLine = sand->lines - 1;
+    if ( maxColumn > sand->columns - 1 ) maxColumn = sand->columns - 1;
+
+    for ( int ci = minLine / SAND_CHUNK_SIZE; ci <= maxLine / SAND_CHUNK_SIZE; ci++ ) {
+        for ( int cj = minColumn / SAND_CHUNK_SIZE; cj <= maxColumn / SAND_CHUNK_SIZE; cj++ ) {
+
+            int slot = fromCi < 0 ? 4 : ( ci - fromCi + 1 ) * 3 + ( cj - fromCj + 1 );
+            DirtyRect *r = &sand->chunks[ci*sand->chunkColumns+cj].nextRects[slot];
+
+            // the part of the rect inside the chunk
+            int top = ci * SAND_CHUNK_SIZE;
+            int left = cj * SAND_CHUNK_SIZE;
+            int bottom = top + SAND_CHUNK_SIZE - 1;
+            int right = left + SAND_CHUNK_SIZE - 1;
+
+            int l = minLine > top ? minLine : top;
+            int c = minColumn > left ? minColumn : left;
+            if ( l < r->minLine ) r->minLine = l;
+            if ( c < r->minColumn ) r->minColumn = c;
+
+            l = maxLine < bottom ? maxLine : bottom;
+            c = maxColumn < right ? maxColumn : right;
+            if ( l > r->maxLine ) r->maxLine = l;
+            if ( c > r->maxColumn ) r->maxColumn = c;
+
+        }
+    }
+
+}
+
+/**
+ * @brief xorshift32 of the chunk, so each chunk draws the same numbers
+ * whatever thread updates it.
+ */
+static unsigned int randomSandGrid( Chunk *chunk ) {
+    unsigned int x = chunk->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    chunk->seed = x;
+    return x;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file SandBenchmark.c
+ * @author Prof. Dr. David Buzatto
+ * @brief Headless benchmark of the sand simulation, implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include <Sand.h>
+#include <SandBenchmark.h>
+#include <SandPool.h>
+
+static const int BENCHMARK_LINES = 1080;
+static const int BENCHMARK_COLUMNS = 1920;
+static const int BENCHMARK_FRAMES = 240;
+static const float BENCHMARK_GRAVITY = 0.1f;
+static const int BENCHMARK_DENSITY = 4;        // one grain in each 4 cells
+static const int BENCHMARK_COLORS = 16;
+
+typedef struct BenchmarkResult {
+    double framesPerSecond;
+    double grainsPerSecond;
+    int awakeChunks;            // in the last frame
+    unsigned int hash;
+} BenchmarkResult;
+
+static BenchmarkResult runCaseSandBenchmark( int threadCount );
+static double getTimeSandBenchmark( void );
+
+bool runSandBenchmark( void ) {
+
+    int processors = getProcessorCount();
+    bool ok = true;
+
+    // 1, 2, 4... threads, and all of them
+    int threadCounts[32];
+    int threadCountCount = 0;
+    for ( int t = 1; t < processors && threadCountCount < 31; t *= 2 ) {
+        threadCounts[threadCountCount++] = t;
+    }
+    threadCounts[threadCountCount++] = processors;
+
+    printf( "falling sand, %dx%d cells, upper half with one grain in %d, %d frames, %d processors\n",
+            BENCHMARK_COLUMNS, BENCHMARK_LINES, BENCHMARK_DENSITY, BENCHMARK_FRAMES, processors );
+    printf( "%8s %10s %10s %14s %8s %8s %10s\n", 
+            "threads", "frames/s", "ms/frame", "Mgrains/s", "speedup", "awake", "hash" );
+
+    BenchmarkResult single = { 0 };
+
+    for ( int t = 0; t < threadCountCount; t++ ) {
+
+        BenchmarkResult result = runCaseSandBenchmark( threadCounts[t] );
+
+        if ( t == 0 ) {
+            single = result;
+        }
+
+        printf( "%8d %10.2f %10.2f %14.2f %7.2fx %8d %10x%s\n", 
+                threadCounts[t], result.framesPerSecond, 1000 / result.framesPerSecond, 
+                result.grainsPerSecond / 1e6, result.framesPerSecond / single.framesPerSecond, 
+                result.awakeChunks, result.hash, result.hash == single.hash ? "" : " (differs!)" );
+
+        if ( result.hash != single.hash ) {
+            ok = false;
+        }
+
+    }
+
+    return ok;
+
+}
+
+static BenchmarkResult runCaseSandBenchmark( int threadCount ) {
+
+    SandGrid *sand = createSandGrid( BENCHMARK_LINES, BENCHMARK_COLUMNS, threadCount );
+
+    for ( int k = 0; k < BENCHMARK_COLORS; k++ ) {
+        getPaletteIndexSandGrid( sand, 0xff0000ffu | ( k * 0x100f00u ) );
+    }
+
+    // the same grains for every case
+    unsigned int seed = 12345;
+    for ( int i = 0; i < sand->lines / 2; i++ ) {
+        for ( int j = 0; j < sand->columns; j++ ) {
+            seed = seed * 1103515245u + 12345u;
+            if ( ( seed >> 16 ) % BENCHMARK_DENSITY == 0 ) {
+                setGrainSandGrid( sand, i, j, 1 + ( seed >> 8 ) % BENCHMARK_COLORS, 0 );
+            }
+        }
+    }
+    markDirtySandGrid( sand, 0, 0, sand->lines - 1, sand->columns - 1 );
+
+    long long grains = 0;
+    double start = getTimeSandBenchmark();
+
+    for ( int f = 0; f < BENCHMARK_FRAMES; f++ ) {
+        updateSandGrid( sand, BENCHMARK_GRAVITY );
+        grains += getUpdatedGrainsSandGrid( sand );
+    }
+
+    double seconds = getTimeSandBenchmark() - start;
+
+    // fnv-1a of the materials
+    unsigned int hash = 2166136261u;
+    for ( int i = 0; i < sand->lines * sand->columns; i++ ) {
+        hash = ( hash ^ sand->materials[i] ) * 16777619u;
+    }
+
+    BenchmarkResult result = {
+        .framesPerSecond = BENCHMARK_FRAMES / seconds,
+        .grainsPerSecond = grains / seconds,
+        .awakeChunks = sand->awakeChunks,
+        .hash = hash
+    };
+
+    destroySandGrid( sand );
+
+    return result;
+
+}
+
+static double getTimeSandBenchmark( void ) {
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
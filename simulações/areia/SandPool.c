@@ -0,0 +1,179 @@
+/**
+ * @file SandPool.c
+ * @author Prof. Dr. David Buzatto
+ * @brief SandPool implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#if !defined( _WIN32 )
+#include <unistd.h>
+#endif
+
+#include <SandPool.h>
+
+typedef struct SandPoolWorker {
+    SandPool *pool;
+    int index;
+} SandPoolWorker;
+
+static void *workerSandPool( void *data );
+
+SandPool* createSandPool( int threadCount ) {
+
+    SandPool *pool = (SandPool*) malloc( sizeof( SandPool ) );
+
+    pool->threadCount = threadCount < 1 ? 1 : threadCount;
+    pool->task = NULL;
+    pool->data = NULL;
+    pool->generation = 0;
+    pool->busyThreads = 0;
+    pool->running = true;
+    pool->barrierCount = 0;
+    pool->barrierGeneration = 0;
+
+    pthread_mutex_init( &pool->mutex, NULL );
+    pthread_cond_init( &pool->workAvailable, NULL );
+    pthread_cond_init( &pool->workFinished, NULL );
+    pthread_cond_init( &pool->barrierReleased, NULL );
+
+    // worker 0 is the calling thread
+    pool->threads = (pthread_t*) malloc( pool->threadCount * sizeof( pthread_t ) );
+    for ( int i = 1; i < pool->threadCount; i++ ) {
+        SandPoolWorker *worker = (SandPoolWorker*) malloc( sizeof( SandPoolWorker ) );
+        worker->pool = pool;
+        worker->index = i;
+        pthread_create( &pool->threads[i], NULL, workerSandPool, worker );
+    }
+
+    return pool;
+
+}
+
+void destroySandPool( SandPool *pool ) {
+
+    pthread_mutex_lock( &pool->mutex );
+    pool->running = false;
+    pthread_cond_broadcast( &pool->workAvailable );
+    pthread_mutex_unlock( &pool->mutex );
+
+    for ( int i = 1; i < pool->threadCount; i++ ) {
+        pthread_join( pool->threads[i], NULL );
+    }
+
+    pthread_cond_destroy( &pool->barrierReleased );
+    pthread_cond_destroy( &pool->workFinished );
+    pthread_cond_destroy( &pool->workAvailable );
+    pthread_mutex_destroy( &pool->mutex );
+
+    free( pool->threads );
+    free( pool );
+
+}
+
+void runSandPool( SandPool *pool, SandPoolTask task, void *data ) {
+
+    if ( pool->threadCount == 1 ) {
+        task( pool, 0, data );
+        return;
+    }
+
+    pthread_mutex_lock( &pool->mutex );
+    pool->task = task;
+    pool->data = data;
+    pool->busyThreads = pool->threadCount - 1;
+    pool->generation++;
+    pthread_cond_broadcast( &pool->workAvailable );
+    pthread_mutex_unlock( &pool->mutex );
+
+    task( pool, 0, data );
+
+    pthread_mutex_lock( &pool->mutex );
+    while ( pool->busyThreads > 0 ) {
+        pthread_cond_wait( &pool->workFinished, &pool->mutex );
+    }
+    pthread_mutex_unlock( &pool->mutex );
+
+}
+
+void syncSandPool( SandPool *pool ) {
+
+    if ( pool->threadCount == 1 ) {
+        return;
+    }
+
+    pthread_mutex_lock( &pool->mutex );
+
+    unsigned int generation = pool->barrierGeneration;
+
+    if ( ++pool->barrierCount == pool->threadCount ) {
+        pool->barrierCount = 0;
+        pool->barrierGeneration++;
+        pthread_cond_broadcast( &pool->barrierReleased );
+    } else {
+        while ( generation == pool->barrierGeneration ) {
+            pthread_cond_wait( &pool->barrierReleased, &pool->mutex );
+        }
+    }
+
+    pthread_mutex_unlock( &pool->mutex );
+
+}
+
+void getBandSandPool( const SandPool *pool, int worker, int begin, int end, int *from, int *to ) {
+    int size = end - begin;
+    *from = begin + (int) ( (long long) size * worker / pool->threadCount );
+    *to = begin + (int) ( (long long) size * ( worker + 1 ) / pool->threadCount );
+}
+
+int getProcessorCount( void ) {
+#if defined( _WIN32 )
+    int count = pthread_num_processors_np();
+#else
+    int count = (int) sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+    return count < 1 ? 1 : count;
+}
+
+static void *workerSandPool( void *data ) {
+
+    SandPoolWorker *worker = (SandPoolWorker*) data;
+    SandPool *pool = worker->pool;
+    unsigned int generation = 0;
+
+    while ( true ) {
+
+        pthread_mutex_lock( &pool->mutex );
+        while ( pool->running && pool->generation == generation ) {
+            pthread_cond_wait( &pool->workAvailable, &pool->mutex );
+        }
+        if ( !pool->running ) {
+            pthread_mutex_unlock( &pool->mutex );
+            break;
+        }
+        generation = pool->generation;
+        SandPoolTask task = pool->task;
+        void *taskData = pool->data;
+        pthread_mutex_unlock( &pool->mutex );
+
+        task( pool, worker->index, taskData );
+
+        pthread_mutex_lock( &pool->mutex );
+        if ( --pool->busyThreads == 0 ) {
+            pthread_cond_signal( &pool->workFinished );
+        }
+        pthread_mutex_unlock( &pool->mutex );
+
+    }
+
+    free( worker );
+
+    return NULL;
+
+}
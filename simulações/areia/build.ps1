@@ -44,6 +44,7 @@ if ( $compile -or $cleanAndCompile -or $compileAndRun -or $all ) {
         -pedantic-errors `
         -std=c99 `
         -Wno-missing-braces `
+        -pthread `
         -I include/ `
         -L lib/ `
         -lraylib `
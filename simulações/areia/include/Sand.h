@@ -0,0 +1,132 @@
+/**
+ * @file Sand.h
+ * @author Prof. Dr. David Buzatto
+ * @brief SandGrid struct and functions declarations.
+ *
+ * The grid is divided in chunks of SAND_CHUNK_SIZE x SAND_CHUNK_SIZE
+ * cells, each one with a dirty rect of the cells that changed in the
+ * last frame, and only these cells are updated. A grain that moves or
+ * that is not settled yet marks its cells, and the ones around them, as
+ * dirty, waking the chunks around it if needed.
+ *
+ * The chunks are updated in four phases, one for each combination of
+ * even and odd chunk line and column, so the chunks of a phase are
+ * never neighbors and are updated at the same time by the threads of
+ * the pool. A grain moves at most SAND_MAX_FALL lines down and one
+ * column to the side, half a chunk, so two chunks of a phase never
+ * touch the same cells. Each chunk marks the dirty rects of its
+ * neighbors in a slot of its own, and draws its random numbers from its
+ * own generator, so the result does not depend on the number of
+ * threads nor on the order they run. The clock bit of each grain tells
+ * if it already moved in this frame, into a chunk updated later (a
+ * grain woken with the bit of the current frame just waits one frame).
+ *
+ * The cells are two planes of bytes: the material of each cell, an
+ * index in a palette of 256 colors where 0 is empty, and its velocity
+ * in 1/SAND_VELOCITY_SCALE of a cell per frame, in 7 bits, with the
+ * clock bit on top. The gravity added to the velocities each frame is
+ * rounded carrying the remainder to the next frame, so on average it
+ * is the given one.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <SandPool.h>
+
+#define SAND_CHUNK_SIZE 32
+#define SAND_MAX_FALL ( SAND_CHUNK_SIZE / 2 )
+
+#define SAND_EMPTY 0
+#define SAND_EMPTY_COLOR 0x000000ffu
+#define SAND_PALETTE_SIZE 256
+
+// 127 / 8, less than SAND_MAX_FALL lines per frame
+#define SAND_VELOCITY_SCALE 8
+#define SAND_VELOCITY_MASK 0x7f
+#define SAND_CLOCK_BIT 0x80
+
+/**
+ * @brief Lines and columns of a chunk, inclusive; empty when maxLine is
+ * less than minLine.
+ */
+typedef struct DirtyRect {
+    int minLine;
+    int minColumn;
+    int maxLine;
+    int maxColumn;
+} DirtyRect;
+
+typedef struct Chunk {
+    DirtyRect rect;             // cells updated in this frame
+    // cells changed, to be updated in the next frame, marked by this
+    // chunk and by each of its neighbors (the slot of the chunk itself
+    // is the center one, 4)
+    DirtyRect nextRects[9];
+    unsigned int seed;
+    int updatedGrains;          // in the last frame
+} Chunk;
+
+typedef struct SandGrid {
+    int lines;
+    int columns;
+    unsigned char *materials;
+    unsigned char *velocities;
+    unsigned int palette[SAND_PALETTE_SIZE];     // rgba colors
+    int paletteCount;
+    int chunkLines;
+    int chunkColumns;
+    Chunk *chunks;
+    int awakeChunks;
+    unsigned char clock;
+    float gravityRemainder;     // in 1/SAND_VELOCITY_SCALE of a cell
+    SandPool *pool;
+    // awake chunks of each phase, in the current frame
+    int *phaseChunks;
+    int phaseCounts[4];
+} SandGrid;
+
+/**
+ * @brief Creates an empty grid, updated by threadCount threads.
+ */
+SandGrid* createSandGrid( int lines, int columns, int threadCount );
+void destroySandGrid( SandGrid *sand );
+
+/**
+ * @brief Updates the grains of the dirty rects, applying the gravity
+ * to them.
+ */
+void updateSandGrid( SandGrid *sand, float gravity );
+
+/**
+ * @brief Marks the cells between the given lines and columns, inclusive,
+ * to be updated in the next frame. Not to be called during an update.
+ */
+void markDirtySandGrid( SandGrid *sand, int minLine, int minColumn, int maxLine, int maxColumn );
+
+/**
+ * @brief Puts a grain of the material at line and column, falling at
+ * velY cells per frame. Not to be called during an update.
+ */
+void setGrainSandGrid( SandGrid *sand, int line, int column, unsigned char material, float velY );
+
+/**
+ * @brief The material of the color, added to the palette if it is new,
+ * or the one with the closest color if the palette is full.
+ */
+unsigned char getPaletteIndexSandGrid( SandGrid *sand, unsigned int color );
+
+bool isLineColumnOkSandGrid( const SandGrid *sand, int line, int column );
+
+/**
+ * @brief The lines whose cells may have changed in the last update:
+ * the ones it updated and the ones it marked. Returns false if there
+ * are none.
+ */
+bool getChangedLinesSandGrid( const SandGrid *sand, int *minLine, int *maxLine );
+
+/**
+ * @brief Grains updated in the last frame.
+ */
+int getUpdatedGrainsSandGrid( const SandGrid *sand );
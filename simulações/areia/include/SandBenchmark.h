@@ -0,0 +1,19 @@
+/**
+ * @file SandBenchmark.h
+ * @author Prof. Dr. David Buzatto
+ * @brief Headless benchmark of the sand simulation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdbool.h>
+
+/**
+ * @brief Lets the upper half of a 1920x1080 grid, filled with sand,
+ * fall on 1 to N threads, printing the frames and the grains updated
+ * per second of each. Returns false if the grid ends different with
+ * some number of threads, what would mean the update is not
+ * deterministic.
+ */
+bool runSandBenchmark( void );
@@ -25,6 +25,9 @@
  * Project headers.
  --------------------------------------------*/
 #include <utils.h>
+#include <Sand.h>
+#include <SandBenchmark.h>
+#include <SandPool.h>
 
 /*---------------------------------------------
  * Macros. 
@@ -37,22 +40,22 @@
 const int SCREEN_WIDTH = 1000;
 const int SCREEN_HEIGHT = 1000;
 const int CELL_WIDTH = 2;
-const unsigned int GRID_BACKGROUND_COLOR = 0x000000ff;
+const unsigned int GRID_BACKGROUND_COLOR = SAND_EMPTY_COLOR;
 const unsigned int GRID_COLOR = 0xccccccff;
 const bool DRAW_GRID = false;
 
+// overlay of the awake chunks and their dirty rects
+const bool SHOW_CHUNKS = false;
+const unsigned int AWAKE_CHUNK_COLOR = 0x00ff0080;
+const unsigned int DIRTY_RECT_COLOR = 0xff000080;
+
 /*---------------------------------------------
  * Custom types (enums, structs, unions etc.)
  --------------------------------------------*/
-typedef struct Grain {
-    unsigned int color;
-    float velY;
-} Grain;
-
 typedef struct GameWorld {
-    int lines;
-    int columns;
-    Grain *grid;
+    SandGrid *sand;
+    double updateTime;
+    bool showChunks;
     bool drawGrid;
     int sandLimit;
     Color backgroundColor;
@@ -85,6 +88,14 @@ Rectangle sliderGravityRect = { 400, 80, 200, 20 };
 bool draggingSliders = false;
 bool showControls = true;
 
+// one pixel per cell, where only the lines that changed are updated and
+// uploaded to the texture, drawn scaled as a single quad
+Color *gridPixels;
+Texture2D gridTexture;
+
+// one cell with its grid lines, repeated over the screen
+Texture2D gridLinesTexture;
+
 
 /*---------------------------------------------
  * Function prototypes. 
@@ -94,9 +105,6 @@ bool showControls = true;
  * @param gw GameWorld struct pointer.
  */
 void inputAndUpdate( GameWorld *gw );
-void move( int line, int column, GameWorld *gw );
-void swap( int line, int column, int toLine, int toColumn, GameWorld *gw );
-bool isLineColumnOk( int line, int column, GameWorld *gw );
 void createSand( int line, int column, int limit, float initialVelY, GameWorld *gw );
 
 /**
@@ -105,6 +113,12 @@ void createSand( int line, int column, int limit, float initialVelY, GameWorld *
  */
 void draw( const GameWorld *gw );
 
+/**
+ * @brief Colors the pixels of the lines that changed in the last update
+ * and uploads them to the texture.
+ */
+void updateGridTexture( const GameWorld *gw );
+
 /**
  * @brief Create the global Game World object and all of its dependecies.
  */
@@ -126,14 +140,19 @@ void loadResources( void );
  */
 void unloadResources( void );
 
-int main( void ) {
+int main( int argc, char **argv ) {
+
+    // headless benchmark of the update
+    if ( argc > 1 && strcmp( argv[1], "--benchmark" ) == 0 ) {
+        return runSandBenchmark() ? 0 : 1;
+    }
 
     SetConfigFlags( FLAG_MSAA_4X_HINT );
     InitWindow( SCREEN_WIDTH, SCREEN_HEIGHT, "Simulação de Areia" );
     SetTargetFPS( 60 );    
 
-    loadResources();
     createGameWorld();
+    loadResources();
     while ( !WindowShouldClose() ) {
         inputAndUpdate( &gw );
         draw( &gw );
@@ -178,95 +197,46 @@ void inputAndUpdate( GameWorld *gw ) {
         if ( IsMouseButtonDown( MOUSE_BUTTON_LEFT ) ) {
             int line = GetMouseY() / CELL_WIDTH;
             int column = GetMouseX() / CELL_WIDTH;
-            if ( isLineColumnOk( line, column, gw ) ) {
-                int p = line * gw->columns + column;
-                if ( gw->grid[p].color == GRID_BACKGROUND_COLOR ) {
+            if ( isLineColumnOkSandGrid( gw->sand, line, column ) ) {
+                int p = line * gw->sand->columns + column;
+                if ( gw->sand->materials[p] == SAND_EMPTY ) {
                     createSand( line, column, gw->sandLimit, sliderInitialVelY, gw );
                 }
             }
         }
     }
 
-    for ( int i = gw->lines-1; i >= 0; i-- ) {
-        for ( int j = gw->columns-1; j >= 0; j-- ) {
-            int p = i * gw->columns + j;
-            if ( gw->grid[p].color != GRID_BACKGROUND_COLOR && gw->grid[p].velY != 0 ) {
-                move( i, j, gw );
-            }
-        }
-    }
-
-    for ( int i = gw->lines-1; i >= 0; i-- ) {
-        for ( int j = gw->columns-1; j >= 0; j-- ) {
-            int p = i * gw->columns + j;
-            if ( gw->grid[p].color != GRID_BACKGROUND_COLOR ) {
-                gw->grid[p].velY += sliderGravity;
-            }
-        }
-    }
+    double start = GetTime();
+    updateSandGrid( gw->sand, sliderGravity );
+    gw->updateTime = GetTime() - start;
 
     if ( IsKeyPressed( KEY_SPACE ) ) {
         showControls = !showControls;
     }
 
-}
-
-void move( int line, int column, GameWorld *gw ) {
-
-    Grain *g = &gw->grid[line*gw->columns+column];
-    int nextLine = line + (int) g->velY;
-    int nextColumn = column;
-    int pNext = nextLine * gw->columns + nextColumn;
-
-    if ( isLineColumnOk( nextLine, nextColumn, gw ) ) {
-
-        if ( gw->grid[pNext].color == GRID_BACKGROUND_COLOR ) {
-            swap( line, column, nextLine, nextColumn, gw );
-        } else {
-            if ( GetRandomValue( 0, 1 ) == 0 ) {
-                nextColumn--;
-            } else {
-                nextColumn++;
-            }
-            nextLine = line + 1;
-            pNext = nextLine * gw->columns + nextColumn;
-            if ( isLineColumnOk( nextLine, nextColumn, gw ) ) {
-                if ( gw->grid[pNext].color == GRID_BACKGROUND_COLOR ) {
-                    swap( line, column, nextLine, nextColumn, gw );
-                }/* else {
-                    gw->grid[pNext].velY = 0;
-                }*/
-            }
-        }
+    if ( IsKeyPressed( KEY_C ) ) {
+        gw->showChunks = !gw->showChunks;
     }
 
 }
 
-void swap( int line, int column, int toLine, int toColumn, GameWorld *gw ) {
-    int p1 = line * gw->columns + column;
-    int p2 = toLine * gw->columns + toColumn;
-    Grain g = gw->grid[p1];
-    gw->grid[p1] = gw->grid[p2];
-    gw->grid[p2] = g;
-}
-
-bool isLineColumnOk( int line, int column, GameWorld *gw ) {
-    return line >= 0 && line < gw->lines && column >= 0 && column < gw->columns;
-}
-
 void createSand( int line, int column, int limit, float initialVelY, GameWorld *gw ) {
 
+    SandGrid *sand = gw->sand;
+    unsigned char material = getPaletteIndexSandGrid( sand, ColorToInt( currentColor ) );
+
     for ( int i = line - limit; i < line + limit + 1; i++ ) {
         for ( int j = column - limit; j < column + limit + 1; j++ ) {
-            if ( isLineColumnOk( i, j, gw ) ) {
+            if ( isLineColumnOkSandGrid( sand, i, j ) ) {
                 if ( GetRandomValue( 0, 10 ) == 0 ) {
-                    gw->grid[i*gw->columns+j].color = ColorToInt( currentColor );
-                    gw->grid[i*gw->columns+j].velY = initialVelY;
+                    setGrainSandGrid( sand, i, j, material, initialVelY );
                 }
             }
         }
     }
 
+    markDirtySandGrid( sand, line - limit, column - limit, line + limit, column + limit );
+
 }
 
 void draw( const GameWorld *gw ) {
@@ -274,22 +244,42 @@ void draw( const GameWorld *gw ) {
     BeginDrawing();
     ClearBackground( gw->backgroundColor );
 
-    for ( int i = 0; i < gw->lines; i++ ) {
-        for ( int j = 0; j < gw->columns; j++ ) {
-            int p = i * gw->columns + j;
-            if ( gw->grid[p].color != GRID_BACKGROUND_COLOR ) {
-                DrawRectangle( j * CELL_WIDTH, i * CELL_WIDTH, CELL_WIDTH, CELL_WIDTH, GetColor( gw->grid[p].color ) );
-            }
-        }
-    }
+    const SandGrid *sand = gw->sand;
+    Rectangle gridRect = { 0, 0, sand->columns * CELL_WIDTH, sand->lines * CELL_WIDTH };
+
+    updateGridTexture( gw );
+
+    DrawTexturePro( 
+        gridTexture, 
+        (Rectangle) { 0, 0, sand->columns, sand->lines }, 
+        gridRect, (Vector2) { 0 }, 0, WHITE );
 
     if ( gw->drawGrid ) {
-        for ( int i = 1; i < gw->lines; i++ ) {
-            DrawLine( 0, i * CELL_WIDTH, GetScreenWidth(), i * CELL_WIDTH, gw->gridColor );
-        }
-        for ( int i = 1; i < gw->columns; i++ ) {
-            DrawLine( i * CELL_WIDTH, 0, i * CELL_WIDTH, GetScreenHeight(), gw->gridColor );
+        DrawTextureRec( gridLinesTexture, gridRect, (Vector2) { 0 }, WHITE );
+    }
+
+    if ( gw->showChunks ) {
+        Color awakeColor = GetColor( AWAKE_CHUNK_COLOR );
+        Color dirtyColor = GetColor( DIRTY_RECT_COLOR );
+        for ( int ci = 0; ci < sand->chunkLines; ci++ ) {
+            for ( int cj = 0; cj < sand->chunkColumns; cj++ ) {
+                const DirtyRect *r = &sand->chunks[ci*sand->chunkColumns+cj].rect;
+                if ( r->maxLine >= r->minLine ) {
+                    DrawRectangleLines( 
+                        cj * SAND_CHUNK_SIZE * CELL_WIDTH, ci * SAND_CHUNK_SIZE * CELL_WIDTH, 
+                        SAND_CHUNK_SIZE * CELL_WIDTH, SAND_CHUNK_SIZE * CELL_WIDTH, awakeColor );
+                    DrawRectangleLines( 
+                        r->minColumn * CELL_WIDTH, r->minLine * CELL_WIDTH, 
+                        ( r->maxColumn - r->minColumn + 1 ) * CELL_WIDTH, 
+                        ( r->maxLine - r->minLine + 1 ) * CELL_WIDTH, dirtyColor );
+                }
+            }
         }
+        DrawText( 
+            TextFormat( "chunks acordados: %d / %d, atualização: %.2f ms, %d threads", 
+                        sand->awakeChunks, sand->chunkLines * sand->chunkColumns, 
+                        gw->updateTime * 1000, sand->pool->threadCount ), 
+            10, GetScreenHeight() - 30, 20, WHITE );
     }
 
     if ( showControls ) {
@@ -345,35 +335,77 @@ void createGameWorld( void ) {
     printf( "creating game world...\n" );
 
     gw = (GameWorld) {
-        .lines = SCREEN_HEIGHT / CELL_WIDTH,
-        .columns = SCREEN_WIDTH / CELL_WIDTH,
-        .grid = NULL,
+        .sand = createSandGrid( SCREEN_HEIGHT / CELL_WIDTH, SCREEN_WIDTH / CELL_WIDTH, getProcessorCount() ),
+        .updateTime = 0,
+        .showChunks = SHOW_CHUNKS,
         .drawGrid = DRAW_GRID,
         .sandLimit = sliderLimit,
         .backgroundColor = GetColor( GRID_BACKGROUND_COLOR ),
         .gridColor = GetColor( GRID_COLOR )
     };
 
-    gw.grid = (Grain*) malloc( gw.lines * gw.columns * sizeof( Grain ) );
-
-    for ( int i = 0; i < gw.lines; i++ ) {
-        for ( int j = 0; j < gw.columns; j++ ) {
-            gw.grid[i*gw.columns+j].color = GRID_BACKGROUND_COLOR;
-            gw.grid[i*gw.columns+j].velY = 0;
-        }
-    }
-
 }
 
 void destroyGameWorld( void ) {
     printf( "destroying game world...\n" );
-    free( gw.grid );
+    destroySandGrid( gw.sand );
 }
 
 void loadResources( void ) {
+
     printf( "loading resources...\n" );
+
+    int cells = gw.sand->lines * gw.sand->columns;
+    gridPixels = (Color*) malloc( cells * sizeof( Color ) );
+    for ( int i = 0; i < cells; i++ ) {
+        gridPixels[i] = gw.backgroundColor;
+    }
+
+    Image image = GenImageColor( gw.sand->columns, gw.sand->lines, gw.backgroundColor );
+    gridTexture = LoadTextureFromImage( image );
+    UnloadImage( image );
+
+    image = GenImageColor( CELL_WIDTH, CELL_WIDTH, BLANK );
+    for ( int i = 0; i < CELL_WIDTH; i++ ) {
+        ImageDrawPixel( &image, i, 0, gw.gridColor );
+        ImageDrawPixel( &image, 0, i, gw.gridColor );
+    }
+    gridLinesTexture = LoadTextureFromImage( image );
+    SetTextureWrap( gridLinesTexture, TEXTURE_WRAP_REPEAT );
+    UnloadImage( image );
+
 }
 
 void unloadResources( void ) {
     printf( "unloading resources...\n" );
+    UnloadTexture( gridLinesTexture );
+    UnloadTexture( gridTexture );
+    free( gridPixels );
+}
+
+void updateGridTexture( const GameWorld *gw ) {
+
+    const SandGrid *sand = gw->sand;
+    int minLine;
+    int maxLine;
+
+    if ( !getChangedLinesSandGrid( sand, &minLine, &maxLine ) ) {
+        return;
+    }
+
+    Color colors[SAND_PALETTE_SIZE];
+    for ( int k = 0; k < sand->paletteCount; k++ ) {
+        colors[k] = GetColor( sand->palette[k] );
+    }
+
+    for ( int p = minLine * sand->columns; p < ( maxLine + 1 ) * sand->columns; p++ ) {
+        gridPixels[p] = colors[sand->materials[p]];
+    }
+
+    // whole lines are contiguous in the pixels
+    UpdateTextureRec( 
+        gridTexture, 
+        (Rectangle) { 0, minLine, sand->columns, maxLine - minLine + 1 }, 
+        &gridPixels[minLine*sand->columns] );
+
 }
\ No newline at end of file
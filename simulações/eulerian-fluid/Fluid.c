@@ -0,0 +1,1047 @@
+/**
+ * @file Fluid.c
+ * @author Prof. Dr. David Buzatto
+ * @brief Fluid implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include <Fluid.h>
+#include <FluidAdvection.h>
+#include <FluidPool.h>
+
+// cells of the multigrid levels
+enum {
+    FLUID_CELL_SOLID,
+    FLUID_CELL_FLUID,
+    FLUID_CELL_FIXED
+};
+
+typedef struct RedBlackTask {
+    Fluid *fluid;
+    int numIters;
+    float cp;
+    float overRelaxation;
+} RedBlackTask;
+
+static inline void relaxCellFluid( Fluid *fluid, int c, float cp, float overRelaxation );
+static int solvePCGFluid( Fluid *fluid, float cp );
+static float computeResidualFluid( Fluid *fluid );
+static void setupPCGFluid( Fluid *fluid );
+static void applyAFluid( const Fluid *fluid, const double *in, double *out );
+static void applyPreconditionerFluid( const Fluid *fluid, const double *in, double *out );
+static double dotFluid( const Fluid *fluid, const double *a, const double *b );
+static void setupMultigridFluid( Fluid *fluid );
+static void applyMultigridFluid( const Fluid *fluid, const double *in, double *out );
+static void vCycleFluid( const Fluid *fluid, int l );
+static void relaxLevelFluid( FluidLevel *level, int color );
+static void restrictLevelFluid( FluidLevel *fine, FluidLevel *coarse );
+static void prolongLevelFluid( const FluidLevel *coarse, FluidLevel *fine );
+static void getParentsLevelFluid( const FluidLevel *coarse, int i, int j, int parents[4] );
+static void solveRedBlackTask( FluidPool *pool, int worker, void *data );
+static float avgUFluid( const Fluid *fluid, int i, int j );
+static float avgVFluid( const Fluid *fluid, int i, int j );
+
+// bilinear weights of the coarse cell over a fine one, of its neighbors
+// nearest to it in x and in y and of the one in between
+static const float FLUID_MG_WEIGHTS[4] = { 0.5625f, 0.1875f, 0.1875f, 0.0625f };
+
+Fluid* createFluid( float density, int numX, int numY, float h ) {
+
+    Fluid *fluid = (Fluid*) malloc( sizeof( Fluid ) );
+
+    fluid->density = density;
+    fluid->numX = numX + 2;
+    fluid->numY = numY + 2;
+    fluid->numCells = fluid->numX * fluid->numY;
+    fluid->h = h;
+
+    int n = fluid->numCells;
+    fluid->u = (float*) calloc( n, sizeof( float ) );
+    fluid->v = (float*) calloc( n, sizeof( float ) );
+    fluid->newU = (float*) calloc( n, sizeof( float ) );
+    fluid->newV = (float*) calloc( n, sizeof( float ) );
+    fluid->p = (float*) calloc( n, sizeof( float ) );
+    fluid->s = (float*) calloc( n, sizeof( float ) );
+    fluid->m = (float*) malloc( n * sizeof( float ) );
+    fluid->newM = (float*) calloc( n, sizeof( float ) );
+    fluid->diag = (float*) calloc( n, sizeof( float ) );
+    fluid->precon = (double*) calloc( n, sizeof( double ) );
+    fluid->x = (double*) calloc( n, sizeof( double ) );
+    fluid->r = (double*) calloc( n, sizeof( double ) );
+    fluid->z = (double*) calloc( n, sizeof( double ) );
+    fluid->d = (double*) calloc( n, sizeof( double ) );
+
+    for ( int i = 0; i < n; i++ ) {
+        fluid->s[i] = 1.0f;
+        fluid->m[i] = 1.0f;
+    }
+
+    // multigrid levels, each with half the cells of the one before on
+    // each side, rounded up
+    fluid->numLevels = 1;
+    for ( int x = numX, y = numY; x > FLUID_MG_COARSEST && y > FLUID_MG_COARSEST; x = ( x + 1 ) / 2, y = ( y + 1 ) / 2 ) {
+        fluid->numLevels++;
+    }
+
+    fluid->levels = (FluidLevel*) malloc( fluid->numLevels * sizeof( FluidLevel ) );
+
+    for ( int l = 0, x = numX, y = numY; l < fluid->numLevels; l++, x = ( x + 1 ) / 2, y = ( y + 1 ) / 2 ) {
+        FluidLevel *level = &fluid->levels[l];
+        level->numX = x + 2;
+        level->numY = y + 2;
+        int cells = level->numX * level->numY;
+        level->type = (unsigned char*) calloc( cells, sizeof( unsigned char ) );
+        level->diag = (float*) calloc( cells, sizeof( float ) );
+        level->x = (float*) calloc( cells, sizeof( float ) );
+        level->b = (float*) calloc( cells, sizeof( float ) );
+        level->r = (float*) calloc( cells, sizeof( float ) );
+    }
+
+    fluid->solver = FLUID_SOLVER_GAUSS_SEIDEL;
+    fluid->pool = NULL;
+    fluid->advection = getBestFluidAdvection();
+    fluid->solverIters = 0;
+    fluid->residual = 0.0f;
+    fluid->times = (FluidStepTimes) {0};
+
+    return fluid;
+
+}
+
+void destroyFluid( Fluid *fluid ) {
+    free( fluid->u );
+    free( fluid->v );
+    free( fluid->newU );
+    free( fluid->newV );
+    free( fluid->p );
+    free( fluid->s );
+    free( fluid->m );
+    free( fluid->newM );
+    free( fluid->diag );
+    free( fluid->precon );
+    free( fluid->x );
+    free( fluid->r );
+    free( fluid->z );
+    free( fluid->d );
+    for ( int l = 0; l < fluid->numLevels; l++ ) {
+        free( fluid->levels[l].type );
+        free( fluid->levels[l].diag );
+        free( fluid->levels[l].x );
+        free( fluid->levels[l].b );
+        free( fluid->levels[l].r );
+    }
+    free( fluid->levels );
+    free( fluid );
+}
+
+void integrateFluid( Fluid *fluid, float dt, float gravity ) {
+
+    int n = fluid->numY;
+
+    for ( int i = 1; i < fluid->numX; i++ ) {
+        for ( int j = 1; j < fluid->numY - 1; j++ ) {
+            if ( fluid->s[i*n+j] != 0.0f && fluid->s[i*n+j-1] != 0.0f ) {
+                fluid->v[i*n+j] += gravity * dt;
+            }
+        }
+    }
+
+}
+
+int solveIncompressibilityFluid( Fluid *fluid, int numIters, float dt, float overRelaxation ) {
+
+    float cp = fluid->density * fluid->h / dt;
+
+    if ( fluid->solver == FLUID_SOLVER_PCG || fluid->solver == FLUID_SOLVER_MGPCG ) {
+        return solvePCGFluid( fluid, cp );
+    }
+
+    if ( fluid->solver == FLUID_SOLVER_RED_BLACK && fluid->pool != NULL ) {
+        RedBlackTask task = {
+            .fluid = fluid,
+            .numIters = numIters,
+            .cp = cp,
+            .overRelaxation = overRelaxation
+        };
+        runFluidPool( fluid->pool, solveRedBlackTask, &task );
+        return numIters;
+    }
+
+    int n = fluid->numY;
+
+    for ( int iter = 0; iter < numIters; iter++ ) {
+        for ( int i = 1; i < fluid->numX - 1; i++ ) {
+            for ( int j = 1; j < fluid->numY - 1; j++ ) {
+                relaxCellFluid( fluid, i * n + j, cp, overRelaxation );
+            }
+        }
+    }
+
+    return numIters;
+
+}
+
+void extrapolateFluid( Fluid *fluid ) {
+
+    int n = fluid->numY;
+
+    for ( int i = 0; i < fluid->numX; i++ ) {
+        fluid->u[i*n] = fluid->u[i*n+1];
+        fluid->u[i*n+fluid->numY-1] = fluid->u[i*n+fluid->numY-2];
+    }
+
+    for ( int j = 0; j < fluid->numY; j++ ) {
+        fluid->v[j] = fluid->v[n+j];
+        fluid->v[(fluid->numX-1)*n+j] = fluid->v[(fluid->numX-2)*n+j];
+    }
+
+}
+
+float sampleFieldFluid( const Fluid *fluid, float x, float y, FieldType field ) {
+
+    int n = fluid->numY;
+    float h = fluid->h;
+    float h1 = 1.0f / h;
+    float h2 = 0.5f * h;
+
+    x = fmaxf( fminf( x, fluid->numX * h ), h );
+    y = fmaxf( fminf( y, fluid->numY * h ), h );
+
+    float dx = 0.0f;
+    float dy = 0.0f;
+    const float *f = NULL;
+
+    switch ( field ) {
+        case U_FIELD: f = fluid->u; dy = h2; break;
+        case V_FIELD: f = fluid->v; dx = h2; break;
+        case S_FIELD: f = fluid->m; dx = h2; dy = h2; break;
+    }
+
+    int x0 = (int) fminf( floorf( ( x - dx ) * h1 ), fluid->numX - 1 );
+    float tx = ( ( x - dx ) - x0 * h ) * h1;
+    int x1 = x0 + 1 < fluid->numX - 1 ? x0 + 1 : fluid->numX - 1;
+
+    int y0 = (int) fminf( floorf( ( y - dy ) * h1 ), fluid->numY - 1 );
+    float ty = ( ( y - dy ) - y0 * h ) * h1;
+    int y1 = y0 + 1 < fluid->numY - 1 ? y0 + 1 : fluid->numY - 1;
+
+    float sx = 1.0f - tx;
+    float sy = 1.0f - ty;
+
+    return sx * sy * f[x0*n+y0] +
+           tx * sy * f[x1*n+y0] +
+           tx * ty * f[x1*n+y1] +
+           sx * ty * f[x0*n+y1];
+
+}
+
+void advectVelocityFluid( Fluid *fluid, float dt ) {
+
+    int n = fluid->numY;
+    float h = fluid->h;
+    float h2 = 0.5f * h;
+    const float *s = fluid->s;
+
+    memcpy( fluid->newU, fluid->u, fluid->numCells * sizeof( float ) );
+    memcpy( fluid->newV, fluid->v, fluid->numCells * sizeof( float ) );
+
+    if ( fluid->advection != FLUID_ADVECTION_SCALAR ) {
+        advectVelocityFluidAdvection( fluid->advection, fluid, dt );
+        memcpy( fluid->u, fluid->newU, fluid->numCells * sizeof( float ) );
+        memcpy( fluid->v, fluid->newV, fluid->numCells * sizeof( float ) );
+        return;
+    }
+
+    for ( int i = 1; i < fluid->numX; i++ ) {
+        for ( int j = 1; j < fluid->numY; j++ ) {
+
+            // u component
+            if ( s[i*n+j] != 0.0f && s[(i-1)*n+j] != 0.0f && j < fluid->numY - 1 ) {
+                float x = i * h - dt * fluid->u[i*n+j];
+                float y = j * h + h2 - dt * avgVFluid( fluid, i, j );
+                fluid->newU[i*n+j] = sampleFieldFluid( fluid, x, y, U_FIELD );
+            }
+
+            // v component
+            if ( s[i*n+j] != 0.0f && s[i*n+j-1] != 0.0f && i < fluid->numX - 1 ) {
+                float x = i * h + h2 - dt * avgUFluid( fluid, i, j );
+                float y = j * h - dt * fluid->v[i*n+j];
+                fluid->newV[i*n+j] = sampleFieldFluid( fluid, x, y, V_FIELD );
+            }
+
+        }
+    }
+
+    memcpy( fluid->u, fluid->newU, fluid->numCells * sizeof( float ) );
+    memcpy( fluid->v, fluid->newV, fluid->numCells * sizeof( float ) );
+
+}
+
+void advectSmokeFluid( Fluid *fluid, float dt ) {
+
+    int n = fluid->numY;
+    float h = fluid->h;
+    float h2 = 0.5f * h;
+
+    memcpy( fluid->newM, fluid->m, fluid->numCells * sizeof( float ) );
+
+    if ( fluid->advection != FLUID_ADVECTION_SCALAR ) {
+        advectSmokeFluidAdvection( fluid->advection, fluid, dt );
+        memcpy( fluid->m, fluid->newM, fluid->numCells * sizeof( float ) );
+        return;
+    }
+
+    for ( int i = 1; i < fluid->numX - 1; i++ ) {
+        for ( int j = 1; j < fluid->numY - 1; j++ ) {
+            if ( fluid->s[i*n+j] != 0.0f ) {
+                float u = ( fluid->u[i*n+j] + fluid->u[(i+1)*n+j] ) * 0.5f;
+                float v = ( fluid->v[i*n+j] + fluid->v[i*n+j+1] ) * 0.5f;
+                float x = i * h + h2 - dt * u;
+                float y = j * h + h2 - dt * v;
+                fluid->newM[i*n+j] = sampleFieldFluid( fluid, x, y, S_FIELD );
+            }
+        }
+    }
+
+    memcpy( fluid->m, fluid->newM, fluid->numCells * sizeof( float ) );
+
+}
+
+void simulateFluid( Fluid *fluid, float dt, float gravity, int numIters, float overRelaxation ) {
+
+    double start = getTimeFluid();
+    integrateFluid( fluid, dt, gravity );
+    double integrated = getTimeFluid();
+
+    memset( fluid->p, 0, fluid->numCells * sizeof( float ) );
+    fluid->solverIters = solveIncompressibilityFluid( fluid, numIters, dt, overRelaxation );
+    double projected = getTimeFluid();
+
+    // measured out of the timed parts of the step
+    fluid->residual = getDivergenceFluid( fluid );
+    double measured = getTimeFluid();
+
+    extrapolateFluid( fluid );
+    double extrapolated = getTimeFluid();
+
+    advectVelocityFluid( fluid, dt );
+    advectSmokeFluid( fluid, dt );
+    double advected = getTimeFluid();
+
+    fluid->times = (FluidStepTimes) {
+        .integration = integrated - start,
+        .projection = projected - integrated,
+        .extrapolation = extrapolated - measured,
+        .advection = advected - extrapolated,
+        .total = advected - measured + projected - start
+    };
+
+}
+
+float getDivergenceFluid( const Fluid *fluid ) {
+
+    int n = fluid->numY;
+    const float *s = fluid->s;
+    float divergence = 0.0f;
+
+    for ( int i = 1; i < fluid->numX - 1; i++ ) {
+        for ( int j = 1; j < fluid->numY - 1; j++ ) {
+            int c = i * n + j;
+            if ( s[c] != 0.0f && s[c-n] + s[c+n] + s[c-1] + s[c+1] != 0.0f ) {
+                float div = fluid->u[c+n] - fluid->u[c] + fluid->v[c+1] - fluid->v[c];
+                divergence = fmaxf( divergence, fabsf( div ) );
+            }
+        }
+    }
+
+    return divergence;
+
+}
+
+void setupWindTunnelFluid( Fluid *fluid, float inVelocity, float pipeHeight ) {
+
+    int n = fluid->numY;
+
+    // solid left, bottom and top borders, inflow in the first column
+    for ( int i = 0; i < fluid->numX; i++ ) {
+        for ( int j = 0; j < fluid->numY; j++ ) {
+            fluid->s[i*n+j] = i == 0 || j == 0 || j == fluid->numY - 1 ? 0.0f : 1.0f;
+            if ( i == 1 ) {
+                fluid->u[i*n+j] = inVelocity;
+            }
+        }
+    }
+
+    float pipeH = pipeHeight * fluid->numY;
+    int minJ = (int) floorf( 0.5f * fluid->numY - 0.5f * pipeH );
+    int maxJ = (int) floorf( 0.5f * fluid->numY + 0.5f * pipeH );
+
+    for ( int j = minJ; j < maxJ; j++ ) {
+        fluid->m[j] = 0.0f;
+    }
+
+}
+
+void setObstacleFluid( Fluid *fluid, float x, float y, float radius, float vx, float vy ) {
+
+    int n = fluid->numY;
+
+    for ( int i = 1; i < fluid->numX - 2; i++ ) {
+        for ( int j = 1; j < fluid->numY - 2; j++ ) {
+
+            fluid->s[i*n+j] = 1.0f;
+
+            float dx = ( i + 0.5f ) * fluid->h - x;
+            float dy = ( j + 0.5f ) * fluid->h - y;
+
+            if ( dx * dx + dy * dy < radius * radius ) {
+                fluid->s[i*n+j] = 0.0f;
+                fluid->m[i*n+j] = 1.0f;
+                fluid->u[i*n+j] = vx;
+                fluid->u[(i+1)*n+j] = vx;
+                fluid->v[i*n+j] = vy;
+                fluid->v[i*n+j+1] = vy;
+            }
+
+        }
+    }
+
+}
+
+const char *getNameFluidSolver( FluidSolver solver ) {
+    switch ( solver ) {
+        case FLUID_SOLVER_GAUSS_SEIDEL: return "gauss-seidel";
+        case FLUID_SOLVER_RED_BLACK:    return "red-black";
+        case FLUID_SOLVER_PCG:          return "mic0-pcg";
+        case FLUID_SOLVER_MGPCG:        return "mg-pcg";
+        default:                        return "unknown";
+    }
+}
+
+double getTimeFluid( void ) {
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Solves A x = -div with MIC(0) or multigrid preconditioned
+ * conjugate gradients and applies x to the faces of the fluid cells
+ * like the Gauss-Seidel updates do.
+ */
+static int solvePCGFluid( Fluid *fluid, float cp ) {
+
+    int n = fluid->numY;
+    const float *s = fluid->s;
+    double *x = fluid->x;
+    double *r = fluid->r;
+    double *z = fluid->z;
+    double *d = fluid->d;
+
+    setupPCGFluid( fluid );
+    memset( x, 0, fluid->numCells * sizeof( double ) );
+
+    int iter = 0;
+    float maxR = computeResidualFluid( fluid );
+
+    // the residual updated by the iterations drifts from the true one,
+    // so when it converges the true residual is computed again and the
+    // iterations restart from it if needed
+    while ( maxR > FLUID_PCG_TOLERANCE && iter < FLUID_PCG_MAX_ITERS ) {
+
+        applyPreconditionerFluid( fluid, r, z );
+        memcpy( d, z, fluid->numCells * sizeof( double ) );
+        double sigma = dotFluid( fluid, z, r );
+
+        while ( iter < FLUID_PCG_MAX_ITERS ) {
+
+            iter++;
+
+            applyAFluid( fluid, d, z );
+            double dz = dotFluid( fluid, z, d );
+            if ( dz == 0.0 ) {
+                break;
+            }
+            double alpha = sigma / dz;
+
+            maxR = 0.0f;
+            for ( int c = 0; c < fluid->numCells; c++ ) {
+                x[c] += alpha * d[c];
+                r[c] -= alpha * z[c];
+                float a = (float) fabs( r[c] );
+                maxR = a > maxR ? a : maxR;
+            }
+
+            if ( maxR <= FLUID_PCG_TOLERANCE ) {
+                break;
+            }
+
+            applyPreconditionerFluid( fluid, r, z );
+            double sigmaNew = dotFluid( fluid, z, r );
+            double beta = sigmaNew / sigma;
+            sigma = sigmaNew;
+
+            for ( int c = 0; c < fluid->numCells; c++ ) {
+                d[c] = z[c] + beta * d[c];
+            }
+
+        }
+
+        maxR = computeResidualFluid( fluid );
+
+    }
+
+    for ( int c = 0; c < fluid->numCells; c++ ) {
+        fluid->p[c] += cp * (float) x[c];
+    }
+
+    // each face gets the difference of the corrections of its cells,
+    // subtracted in double: x grows with the grid, and adding the two
+    // to the float velocity one at a time left a divergence of up to
+    // 1e-3 on 1024² of rounding alone
+    for ( int i = 1; i < fluid->numX; i++ ) {
+        for ( int j = 1; j < fluid->numY; j++ ) {
+            int c = i * n + j;
+            fluid->u[c] += (float) ( s[c] * x[c-n] - s[c-n] * x[c] );
+            fluid->v[c] += (float) ( s[c] * x[c-1] - s[c-1] * x[c] );
+        }
+    }
+
+    return iter;
+
+}
+
+/**
+ * @brief r = -div - A x on the solved cells. Returns the greatest
+ * absolute value of r.
+ */
+static float computeResidualFluid( Fluid *fluid ) {
+
+    int n = fluid->numY;
+    const float *diag = fluid->diag;
+    double *r = fluid->r;
+    double *z = fluid->z;
+    float max = 0.0f;
+
+    applyAFluid( fluid, fluid->x, z );
+
+    for ( int c = 0; c < fluid->numCells; c++ ) {
+        r[c] = 0.0f;
+        if ( diag[c] != 0.0f ) {
+            float div = fluid->u[c+n] - fluid->u[c] + fluid->v[c+1] - fluid->v[c];
+            r[c] = -div - z[c];
+            float a = (float) fabs( r[c] );
+            max = a > max ? a : max;
+        }
+    }
+
+    return max;
+
+}
+
+/**
+ * @brief Builds the diagonal of A, where the cells that Gauss-Seidel
+ * does not relax get 0, and the preconditioner: the multigrid levels,
+ * or MIC(0), an approximate factorization L L^T of A whose L has the
+ * sparsity of A.
+ */
+static void setupPCGFluid( Fluid *fluid ) {
+
+    int n = fluid->numY;
+    const float *s = fluid->s;
+    float *diag = fluid->diag;
+    double *precon = fluid->precon;
+
+    memset( diag, 0, fluid->numCells * sizeof( float ) );
+    memset( precon, 0, fluid->numCells * sizeof( double ) );
+
+    for ( int i = 1; i < fluid->numX - 1; i++ ) {
+        for ( int j = 1; j < fluid->numY - 1; j++ ) {
+            int c = i * n + j;
+            if ( s[c] != 0.0f ) {
+                diag[c] = s[c-n] + s[c+n] + s[c-1] + s[c+1];
+            }
+        }
+    }
+
+    if ( fluid->solver == FLUID_SOLVER_MGPCG ) {
+        setupMultigridFluid( fluid );
+        return;
+    }
+
+    // the links of a cell to its neighbors at +x and +y are -1 when
+    // both cells are solved, so the terms below only count them then
+    for ( int i = 1; i < fluid->numX - 1; i++ ) {
+        for ( int j = 1; j < fluid->numY - 1; j++ ) {
+
+            int c = i * n + j;
+            if ( diag[c] == 0.0f ) {
+                continue;
+            }
+
+            double e = diag[c];
+            int left = c - n;
+            int below = c - 1;
+
+            if ( diag[left] != 0.0f ) {
+                double a = precon[left];
+                e -= a * a;
+                if ( diag[left+1] != 0.0f ) {
+                    e -= FLUID_MIC_TUNING * a * a;
+                }
+            }
+
+            if ( diag[below] != 0.0f ) {
+                double a = precon[below];
+                e -= a * a;
+                if ( diag[below+n] != 0.0f ) {
+                    e -= FLUID_MIC_TUNING * a * a;
+                }
+            }
+
+            if ( e < FLUID_MIC_SAFETY * diag[c] ) {
+                e = diag[c];
+            }
+
+            precon[c] = 1.0 / sqrt( e );
+
+        }
+    }
+
+}
+
+/**
+ * @brief out = A in. Vectors are 0 on the cells that are not solved,
+ * so their links need no test.
+ */
+static void applyAFluid( const Fluid *fluid, const double *in, double *out ) {
+
+    int n = fluid->numY;
+    const float *diag = fluid->diag;
+
+    for ( int i = 1; i < fluid->numX - 1; i++ ) {
+        for ( int j = 1; j < fluid->numY - 1; j++ ) {
+            int c = i * n + j;
+            double v = diag[c] * in[c] - in[c-n] - in[c+n] - in[c-1] - in[c+1];
+            out[c] = diag[c] != 0.0f ? v : 0.0;
+        }
+    }
+
+}
+
+/**
+ * @brief out = ( L L^T )^-1 in, solving L q = in forwards and then
+ * L^T out = q backwards. precon and the vectors are 0 on the cells
+ * that are not solved, so their links need no test.
+ */
+static void applyPreconditionerFluid( const Fluid *fluid, const double *in, double *out ) {
+
+    if ( fluid->solver == FLUID_SOLVER_MGPCG ) {
+        applyMultigridFluid( fluid, in, out );
+        return;
+    }
+
+    int n = fluid->numY;
+    const double *precon = fluid->precon;
+
+    for ( int i = 1; i < fluid->numX - 1; i++ ) {
+        for ( int j = 1; j < fluid->numY - 1; j++ ) {
+            int c = i * n + j;
+            double t = in[c] + precon[c-n] * out[c-n] + precon[c-1] * out[c-1];
+            out[c] = t * precon[c];
+        }
+    }
+
+    for ( int i = fluid->numX - 2; i >= 1; i-- ) {
+        for ( int j = fluid->numY - 2; j >= 1; j-- ) {
+            int c = i * n + j;
+            double t = out[c] + precon[c] * ( out[c+n] + out[c+1] );
+            out[c] = t * precon[c];
+        }
+    }
+
+}
+
+static double dotFluid( const Fluid *fluid, const double *a, const double *b ) {
+    double sum = 0.0;
+    for ( int c = 0; c < fluid->numCells; c++ ) {
+        sum += a[c] * b[c];
+    }
+    return sum;
+}
+
+/**
+ * @brief Builds the cells of every multigrid level. The first level is
+ * the grid: the solved cells are fluid and the open cells of the
+ * border are fixed at 0. A cell of the next level covers up to 2x2 of
+ * them, and each cell of its border the cells of the border next to
+ * it. The diagonal of a level counts the fluid neighbors, and a fluid
+ * cell without them or fixed ones is solid, like on the grid.
+ *
+ * The 0 of a fixed cell is at its center, so it would move away from
+ * the fluid on each level. The 0 of the grid is half a cell of the
+ * grid past the last face, and the center of the last fluid cell of
+ * level l half a cell of the level before it, ( 1 + 1 / 2^l ) / 2
+ * cells of the level in all, so the link to a fixed neighbor counts
+ * as the inverse of that.
+ */
+static void setupMultigridFluid( Fluid *fluid ) {
+
+    FluidLevel *first = &fluid->levels[0];
+    int n = fluid->numY;
+
+    for ( int i = 0; i < fluid->numX; i++ ) {
+        for ( int j = 0; j < fluid->numY; j++ ) {
+            int c = i * n + j;
+            bool border = i == 0 || j == 0 || i == fluid->numX - 1 || j == fluid->numY - 1;
+            if ( fluid->diag[c] != 0.0f ) {
+                first->type[c] = FLUID_CELL_FLUID;
+            } else if ( border && fluid->s[c] != 0.0f ) {
+                first->type[c] = FLUID_CELL_FIXED;
+            } else {
+                first->type[c] = FLUID_CELL_SOLID;
+            }
+        }
+    }
+
+    for ( int l = 1; l < fluid->numLevels; l++ ) {
+
+        const FluidLevel *fine = &fluid->levels[l-1];
+        FluidLevel *coarse = &fluid->levels[l];
+        int fn = fine->numY;
+        int cn = coarse->numY;
+
+        for ( int ci = 0; ci < coarse->numX; ci++ ) {
+
+            // the columns of the fine level under the column ci
+            int i0 = ci == 0 ? 0 : ci == coarse->numX - 1 ? fine->numX - 1 : 2 * ci - 1;
+            int i1 = ci == 0 ? 0 : ci == coarse->numX - 1 ? fine->numX - 1 : 2 * ci < fine->numX - 1 ? 2 * ci : 2 * ci - 1;
+
+            for ( int cj = 0; cj < coarse->numY; cj++ ) {
+
+                int j0 = cj == 0 ? 0 : cj == coarse->numY - 1 ? fine->numY - 1 : 2 * cj - 1;
+                int j1 = cj == 0 ? 0 : cj == coarse->numY - 1 ? fine->numY - 1 : 2 * cj < fine->numY - 1 ? 2 * cj : 2 * cj - 1;
+
+                unsigned char type = FLUID_CELL_SOLID;
+                for ( int i = i0; i <= i1; i++ ) {
+                    for ( int j = j0; j <= j1; j++ ) {
+                        unsigned char t = fine->type[i*fn+j];
+                        if ( t == FLUID_CELL_FIXED || ( t == FLUID_CELL_FLUID && type == FLUID_CELL_SOLID ) ) {
+                            type = t;
+                        }
+                    }
+                }
+
+                coarse->type[ci*cn+cj] = type;
+
+            }
+
+        }
+
+    }
+
+    for ( int l = 0; l < fluid->numLevels; l++ ) {
+
+        FluidLevel *level = &fluid->levels[l];
+        int ln = level->numY;
+        float fixedLink = (float) ( 1 << ( l + 1 ) ) / ( ( 1 << l ) + 1 );
+
+        memset( level->diag, 0, level->numX * level->numY * sizeof( float ) );
+
+        for ( int i = 1; i < level->numX - 1; i++ ) {
+            for ( int j = 1; j < level->numY - 1; j++ ) {
+
+                int c = i * ln + j;
+                if ( level->type[c] != FLUID_CELL_FLUID ) {
+                    continue;
+                }
+
+                int neighbors[4] = { c - ln, c + ln, c - 1, c + 1 };
+                for ( int k = 0; k < 4; k++ ) {
+                    unsigned char t = level->type[neighbors[k]];
+                    level->diag[c] += t == FLUID_CELL_FLUID ? 1.0f : t == FLUID_CELL_FIXED ? fixedLink : 0.0f;
+                }
+
+                if ( level->diag[c] == 0.0f ) {
+                    level->type[c] = FLUID_CELL_SOLID;
+                }
+
+            }
+        }
+
+    }
+
+}
+
+/**
+ * @brief out = M^-1 in, one V-cycle from x = 0 on every level.
+ */
+static void applyMultigridFluid( const Fluid *fluid, const double *in, double *out ) {
+
+    FluidLevel *first = &fluid->levels[0];
+
+    for ( int c = 0; c < fluid->numCells; c++ ) {
+        first->b[c] = (float) in[c];
+    }
+
+    vCycleFluid( fluid, 0 );
+
+    for ( int c = 0; c < fluid->numCells; c++ ) {
+        out[c] = first->x[c];
+    }
+
+}
+
+/**
+ * @brief Approximates the solution of the level l for its b in its x.
+ * The relaxations on the way up are the ones on the way down in the
+ * opposite order, and the coarsest level is relaxed red, black, ...,
+ * red, so M^-1 is symmetric, as conjugate gradients need.
+ */
+static void vCycleFluid( const Fluid *fluid, int l ) {
+
+    FluidLevel *level = &fluid->levels[l];
+
+    memset( level->x, 0, level->numX * level->numY * sizeof( float ) );
+
+    if ( l == fluid->numLevels - 1 ) {
+        for ( int k = 0; k < FLUID_MG_COARSEST_ITERS; k++ ) {
+            relaxLevelFluid( level, 0 );
+            relaxLevelFluid( level, 1 );
+        }
+        relaxLevelFluid( level, 0 );
+        return;
+    }
+
+    for ( int k = 0; k < FLUID_MG_SMOOTHING; k++ ) {
+        relaxLevelFluid( level, 0 );
+        relaxLevelFluid( level, 1 );
+    }
+
+    restrictLevelFluid( level, &fluid->levels[l+1] );
+    vCycleFluid( fluid, l + 1 );
+    prolongLevelFluid( &fluid->levels[l+1], level );
+
+    for ( int k = 0; k < FLUID_MG_SMOOTHING; k++ ) {
+        relaxLevelFluid( level, 1 );
+        relaxLevelFluid( level, 0 );
+    }
+
+}
+
+/**
+ * @brief Gauss-Seidel on the fluid cells of one color of a level. x is
+ * 0 on the other cells, so their links need no test.
+ */
+static void relaxLevelFluid( FluidLevel *level, int color ) {
+
+    int n = level->numY;
+    const float *diag = level->diag;
+    const float *b = level->b;
+    float *x = level->x;
+
+    for ( int i = 1; i < level->numX - 1; i++ ) {
+        int j0 = 1 + ( ( i + 1 + color ) & 1 );
+        for ( int j = j0; j < level->numY - 1; j += 2 ) {
+            int c = i * n + j;
+            if ( diag[c] != 0.0f ) {
+                x[c] = ( b[c] + x[c-n] + x[c+n] + x[c-1] + x[c+1] ) / diag[c];
+            }
+        }
+    }
+
+}
+
+/**
+ * @brief b of the coarse level = P^T ( b - A x ) of the fine one, where
+ * P is the interpolation of prolongLevelFluid. Its weights add up to 4
+ * on each coarse cell, what makes A of the coarse level, with the same
+ * stencil on cells of twice the size, match the fine one.
+ */
+static void restrictLevelFluid( FluidLevel *fine, FluidLevel *coarse ) {
+
+    int fn = fine->numY;
+    const float *x = fine->x;
+    float *r = fine->r;
+
+    memset( coarse->b, 0, coarse->numX * coarse->numY * sizeof( float ) );
+
+    for ( int i = 1; i < fine->numX - 1; i++ ) {
+        for ( int j = 1; j < fine->numY - 1; j++ ) {
+
+            int c = i * fn + j;
+            if ( fine->diag[c] == 0.0f ) {
+                continue;
+            }
+
+            r[c] = fine->b[c] - ( fine->diag[c] * x[c] - x[c-fn] - x[c+fn] - x[c-1] - x[c+1] );
+
+            int parents[4];
+            getParentsLevelFluid( coarse, i, j, parents );
+            for ( int k = 0; k < 4; k++ ) {
+                coarse->b[parents[k]] += FLUID_MG_WEIGHTS[k] * r[c];
+            }
+
+        }
+    }
+
+}
+
+/**
+ * @brief Adds the bilinear interpolation of x of the coarse level to x
+ * of the fluid cells of the fine one. x of the fixed coarse cells is 0.
+ */
+static void prolongLevelFluid( const FluidLevel *coarse, FluidLevel *fine ) {
+
+    int fn = fine->numY;
+    const float *cx = coarse->x;
+
+    for ( int i = 1; i < fine->numX - 1; i++ ) {
+        for ( int j = 1; j < fine->numY - 1; j++ ) {
+
+            int c = i * fn + j;
+            if ( fine->diag[c] == 0.0f ) {
+                continue;
+            }
+
+            int parents[4];
+            getParentsLevelFluid( coarse, i, j, parents );
+            fine->x[c] += FLUID_MG_WEIGHTS[0] * cx[parents[0]] + FLUID_MG_WEIGHTS[1] * cx[parents[1]] +
+                          FLUID_MG_WEIGHTS[2] * cx[parents[2]] + FLUID_MG_WEIGHTS[3] * cx[parents[3]];
+
+        }
+    }
+
+}
+
+/**
+ * @brief The coarse cells that the fine cell ( i, j ) is interpolated
+ * from, in the order of FLUID_MG_WEIGHTS. There is no pressure across a
+ * solid cell, so a solid one is replaced by the cell over ( i, j ), as
+ * if the pressure was mirrored by the wall. Interpolating its 0
+ * instead pulled the correction to 0 along every wall, and the
+ * iterations grew with the grid.
+ */
+static void getParentsLevelFluid( const FluidLevel *coarse, int i, int j, int parents[4] ) {
+
+    int cn = coarse->numY;
+    int ci = ( i + 1 ) / 2;
+    int cj = ( j + 1 ) / 2;
+    int ni = i & 1 ? ci - 1 : ci + 1;
+    int nj = j & 1 ? cj - 1 : cj + 1;
+
+    parents[0] = ci * cn + cj;
+    parents[1] = ni * cn + cj;
+    parents[2] = ci * cn + nj;
+    parents[3] = ni * cn + nj;
+
+    for ( int k = 1; k < 4; k++ ) {
+        if ( coarse->type[parents[k]] == FLUID_CELL_SOLID ) {
+            parents[k] = parents[0];
+        }
+    }
+
+}
+
+/**
+ * @brief Removes the divergence of the cell c through its open faces.
+ */
+static inline void relaxCellFluid( Fluid *fluid, int c, float cp, float overRelaxation ) {
+
+    int n = fluid->numY;
+    const float *s = fluid->s;
+    float *u = fluid->u;
+    float *v = fluid->v;
+
+    if ( s[c] == 0.0f ) {
+        return;
+    }
+
+    float sx0 = s[c-n];
+    float sx1 = s[c+n];
+    float sy0 = s[c-1];
+    float sy1 = s[c+1];
+    float sum = sx0 + sx1 + sy0 + sy1;
+
+    if ( sum == 0.0f ) {
+        return;
+    }
+
+    // the division only depends on s, so it is not in the chain of
+    // updates from one cell to the next
+    float scale = overRelaxation / sum;
+
+    // outflow of the cell, removed through its open faces
+    float div = u[c+n] - u[c] + v[c+1] - v[c];
+    float p = -div * scale;
+
+    fluid->p[c] += cp * p;
+
+    u[c] -= sx0 * p;
+    u[c+n] += sx1 * p;
+    v[c] -= sy0 * p;
+    v[c+1] += sy1 * p;
+
+}
+
+/**
+ * @brief Red-black relaxation of a band of columns: every worker relaxes
+ * the red cells of its band, waits for the others, then the black ones.
+ * Relaxing a cell leaves it with ( 1 - overRelaxation ) times its
+ * divergence, so the last black cells are relaxed without
+ * over-relaxation, or that would be most of the residual.
+ */
+static void solveRedBlackTask( FluidPool *pool, int worker, void *data ) {
+
+    const RedBlackTask *task = (const RedBlackTask*) data;
+    Fluid *fluid = task->fluid;
+    int n = fluid->numY;
+
+    int from;
+    int to;
+    getBandFluidPool( pool, worker, 1, fluid->numX - 1, &from, &to );
+
+    for ( int iter = 0; iter < task->numIters; iter++ ) {
+        for ( int color = 0; color < 2; color++ ) {
+            float overRelaxation = iter == task->numIters - 1 && color == 1 ? 1.0f : task->overRelaxation;
+            for ( int i = from; i < to; i++ ) {
+                // first j where ( i + j ) % 2 == color
+                int j0 = 1 + ( ( i + 1 + color ) & 1 );
+                for ( int j = j0; j < fluid->numY - 1; j += 2 ) {
+                    relaxCellFluid( fluid, i * n + j, task->cp, overRelaxation );
+                }
+            }
+            syncFluidPool( pool );
+        }
+    }
+
+}
+
+/**
+ * @brief Average of the four u around the v of the bottom face of the
+ * cell ( i, j ).
+ */
+static float avgUFluid( const Fluid *fluid, int i, int j ) {
+    int n = fluid->numY;
+    return ( fluid->u[i*n+j-1] + fluid->u[i*n+j] +
+             fluid->u[(i+1)*n+j-1] + fluid->u[(i+1)*n+j] ) * 0.25f;
+}
+
+/**
+ * @brief Average of the four v around the u of the left face of the
+ * cell ( i, j ).
+ */
+static float avgVFluid( const Fluid *fluid, int i, int j ) {
+    int n = fluid->numY;
+    return ( fluid->v[(i-1)*n+j] + fluid->v[i*n+j] +
+             fluid->v[(i-1)*n+j+1] + fluid->v[i*n+j+1] ) * 0.25f;
+}
@@ -0,0 +1,623 @@
+/**
+ * @file FluidAdvection.c
+ * @author Prof. Dr. David Buzatto
+ * @brief Vectorized advection kernels implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include <Fluid.h>
+#include <FluidAdvection.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#define FLUID_ADVECTION_X86
+#include <immintrin.h>
+#endif
+
+#define BENCHMARK_SIZES 4
+
+static const int BENCHMARK_SIZE_DATA[BENCHMARK_SIZES] = { 128, 256, 512, 1024 };
+static const float BENCHMARK_DT = 1.0f / 60.0f;
+static const int BENCHMARK_WARMUP_STEPS = 20;
+static const int BENCHMARK_MIN_RUNS = 3;
+static const double BENCHMARK_MIN_SECONDS = 0.5;
+
+// what the kernels need to trace and sample the cells
+typedef struct AdvectionGrid {
+    Fluid *fluid;
+    float dt;
+    int n;
+    float h;
+    float h1;
+    float h2;
+    float maxX;
+    float maxY;
+    float lastX;
+    float lastY;
+} AdvectionGrid;
+
+// advects the cells of column i from j, a few at a time, while they
+// fit before end, and returns where it stopped
+typedef int (*AdvectionSpan)( const AdvectionGrid *grid, int i, int j, int end );
+typedef void (*AdvectionCell)( const AdvectionGrid *grid, int i, int j );
+
+static AdvectionGrid createAdvectionGrid( Fluid *fluid, float dt );
+static void advectTilesFluidAdvection( const AdvectionGrid *grid, AdvectionSpan span, AdvectionCell cell );
+static void advectVelocityCell( const AdvectionGrid *grid, int i, int j );
+static void advectSmokeCell( const AdvectionGrid *grid, int i, int j );
+static float compareFluidAdvection( const float *a, const float *b, int count, bool *identical );
+
+#ifdef FLUID_ADVECTION_X86
+static int advectVelocitySSE2( const AdvectionGrid *grid, int i, int j, int end );
+static int advectSmokeSSE2( const AdvectionGrid *grid, int i, int j, int end );
+static int advectVelocityAVX2( const AdvectionGrid *grid, int i, int j, int end );
+static int advectSmokeAVX2( const AdvectionGrid *grid, int i, int j, int end );
+#endif
+
+void advectVelocityFluidAdvection( FluidAdvection type, Fluid *fluid, float dt ) {
+
+    AdvectionGrid grid = createAdvectionGrid( fluid, dt );
+    AdvectionSpan span = NULL;
+
+    switch ( type ) {
+#ifdef FLUID_ADVECTION_X86
+        case FLUID_ADVECTION_SSE2: span = advectVelocitySSE2; break;
+        case FLUID_ADVECTION_AVX2: span = advectVelocityAVX2; break;
+#endif
+        default: break;
+    }
+
+    advectTilesFluidAdvection( &grid, span, advectVelocityCell );
+
+    // u of the last column and v of the last row, that the spans would
+    // read past the end of the grid to trace
+    for ( int j = 1; j < fluid->numY - 1; j++ ) {
+        advectVelocityCell( &grid, fluid->numX - 1, j );
+    }
+    for ( int i = 1; i < fluid->numX - 1; i++ ) {
+        advectVelocityCell( &grid, i, fluid->numY - 1 );
+    }
+
+}
+
+void advectSmokeFluidAdvection( FluidAdvection type, Fluid *fluid, float dt ) {
+
+    AdvectionGrid grid = createAdvectionGrid( fluid, dt );
+    AdvectionSpan span = NULL;
+
+    switch ( type ) {
+#ifdef FLUID_ADVECTION_X86
+        case FLUID_ADVECTION_SSE2: span = advectSmokeSSE2; break;
+        case FLUID_ADVECTION_AVX2: span = advectSmokeAVX2; break;
+#endif
+        default: break;
+    }
+
+    advectTilesFluidAdvection( &grid, span, advectSmokeCell );
+
+}
+
+bool isSupportedFluidAdvection( FluidAdvection type ) {
+
+    switch ( type ) {
+        case FLUID_ADVECTION_SCALAR:
+            return true;
+#ifdef FLUID_ADVECTION_X86
+        case FLUID_ADVECTION_SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports( "sse2" );
+        case FLUID_ADVECTION_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports( "avx2" );
+#endif
+        default:
+            return false;
+    }
+
+}
+
+FluidAdvection getBestFluidAdvection( void ) {
+    for ( int type = FLUID_ADVECTION_COUNT - 1; type > FLUID_ADVECTION_SCALAR; type-- ) {
+        if ( isSupportedFluidAdvection( type ) ) {
+            return type;
+        }
+    }
+    return FLUID_ADVECTION_SCALAR;
+}
+
+const char *getNameFluidAdvection( FluidAdvection type ) {
+    switch ( type ) {
+        case FLUID_ADVECTION_SCALAR: return "scalar";
+        case FLUID_ADVECTION_SSE2:   return "sse2";
+        case FLUID_ADVECTION_AVX2:   return "avx2";
+        default:                     return "unknown";
+    }
+}
+
+bool runFluidAdvectionBenchmark( void ) {
+
+    bool accepted = true;
+
+    printf( "advection of a developed wind tunnel, tiles of %d cells, tolerance %.0e\n",
+            FLUID_ADVECTION_TILE, FLUID_ADVECTION_TOLERANCE );
+    printf( "%-6s %-7s %12s %10s %10s %8s %12s %s\n",
+            "size", "kernel", "velocity ms", "smoke ms", "Mcells/s", "speedup", "difference", "result" );
+
+    for ( int s = 0; s < BENCHMARK_SIZES; s++ ) {
+
+        int size = BENCHMARK_SIZE_DATA[s];
+        Fluid *fluid = createFluid( 1000.0f, size, size, 1.0f / size );
+        setupWindTunnelFluid( fluid, 2.0f, 0.1f );
+        setObstacleFluid( fluid, 0.4f, 0.5f, 0.15f, 0.0f, 0.0f );
+
+        for ( int i = 0; i < BENCHMARK_WARMUP_STEPS; i++ ) {
+            simulateFluid( fluid, BENCHMARK_DT, 0.0f, 40, 1.9f );
+        }
+
+        // the state every kernel starts from, and what the scalar
+        // kernel makes of it
+        size_t bytes = fluid->numCells * sizeof( float );
+        float *state = (float*) malloc( 3 * bytes );
+        float *reference = (float*) malloc( 3 * bytes );
+        memcpy( state, fluid->u, bytes );
+        memcpy( state + fluid->numCells, fluid->v, bytes );
+        memcpy( state + 2 * fluid->numCells, fluid->m, bytes );
+
+        double scalarSeconds = 0;
+
+        for ( int type = FLUID_ADVECTION_SCALAR; type < FLUID_ADVECTION_COUNT; type++ ) {
+
+            if ( !isSupportedFluidAdvection( type ) ) {
+                printf( "%-6d %-7s %12s %10s %10s %8s %12s %s\n",
+                        size, getNameFluidAdvection( type ), "-", "-", "-", "-", "-", "not supported" );
+                continue;
+            }
+
+            fluid->advection = type;
+            double velocitySeconds = 0;
+            double smokeSeconds = 0;
+            int runs = 0;
+
+            while ( runs < BENCHMARK_MIN_RUNS || velocitySeconds + smokeSeconds < BENCHMARK_MIN_SECONDS ) {
+
+                memcpy( fluid->u, state, bytes );
+                memcpy( fluid->v, state + fluid->numCells, bytes );
+                memcpy( fluid->m, state + 2 * fluid->numCells, bytes );
+
+                double start = getTimeFluid();
+                advectVelocityFluid( fluid, BENCHMARK_DT );
+                double advected = getTimeFluid();
+                advectSmokeFluid( fluid, BENCHMARK_DT );
+                velocitySeconds += advected - start;
+                smokeSeconds += getTimeFluid() - advected;
+                runs++;
+
+            }
+
+            bool identical = true;
+            float difference = 0;
+            const char *result = "reference";
+
+            if ( type == FLUID_ADVECTION_SCALAR ) {
+                memcpy( reference, fluid->u, bytes );
+                memcpy( reference + fluid->numCells, fluid->v, bytes );
+                memcpy( reference + 2 * fluid->numCells, fluid->m, bytes );
+                scalarSeconds = ( velocitySeconds + smokeSeconds ) / runs;
+            } else {
+                float du = compareFluidAdvection( fluid->u, reference, fluid->numCells, &identical );
+                float dv = compareFluidAdvection( fluid->v, reference + fluid->numCells, fluid->numCells, &identical );
+                float dm = compareFluidAdvection( fluid->m, reference + 2 * fluid->numCells, fluid->numCells, &identical );
+                difference = fmaxf( du, fmaxf( dv, dm ) );
+                if ( identical ) {
+                    result = "identical";
+                } else if ( difference <= FLUID_ADVECTION_TOLERANCE ) {
+                    result = "within tolerance";
+                } else {
+                    result = "MISMATCH";
+                    accepted = false;
+                }
+            }
+
+            double seconds = ( velocitySeconds + smokeSeconds ) / runs;
+            printf( "%-6d %-7s %12.3f %10.3f %10.1f %7.2fx %12.3e %s\n",
+                    size, getNameFluidAdvection( type ),
+                    velocitySeconds / runs * 1000, smokeSeconds / runs * 1000,
+                    fluid->numCells / seconds / 1e6, scalarSeconds / seconds, difference, result );
+
+        }
+
+        free( state );
+        free( reference );
+        destroyFluid( fluid );
+
+    }
+
+    return accepted;
+
+}
+
+static AdvectionGrid createAdvectionGrid( Fluid *fluid, float dt ) {
+
+    // the same values sampleFieldFluid computes for every sample
+    return (AdvectionGrid) {
+        .fluid = fluid,
+        .dt = dt,
+        .n = fluid->numY,
+        .h = fluid->h,
+        .h1 = 1.0f / fluid->h,
+        .h2 = 0.5f * fluid->h,
+        .maxX = fluid->numX * fluid->h,
+        .maxY = fluid->numY * fluid->h,
+        .lastX = (float) ( fluid->numX - 1 ),
+        .lastY = (float) ( fluid->numY - 1 )
+    };
+
+}
+
+/**
+ * @brief Advects the cells inside the border, tile by tile, with span
+ * and cell advecting what span leaves at the end of each column of a
+ * tile. A NULL span advects everything cell by cell.
+ */
+static void advectTilesFluidAdvection( const AdvectionGrid *grid, AdvectionSpan span, AdvectionCell cell ) {
+
+    const Fluid *fluid = grid->fluid;
+
+    for ( int start = 1; start < fluid->numY - 1; start += FLUID_ADVECTION_TILE ) {
+
+        int end = start + FLUID_ADVECTION_TILE;
+        end = end < fluid->numY - 1 ? end : fluid->numY - 1;
+
+        for ( int i = 1; i < fluid->numX - 1; i++ ) {
+            int j = span != NULL ? span( grid, i, start, end ) : start;
+            for ( ; j < end; j++ ) {
+                cell( grid, i, j );
+            }
+        }
+
+    }
+
+}
+
+/**
+ * @brief The scalar advection of both velocity components of a cell,
+ * as in advectVelocityFluid.
+ */
+static void advectVelocityCell( const AdvectionGrid *grid, int i, int j ) {
+
+    Fluid *fluid = grid->fluid;
+    int n = grid->n;
+    float h = grid->h;
+    float h2 = grid->h2;
+    float dt = grid->dt;
+    const float *s = fluid->s;
+    const float *u = fluid->u;
+    const float *v = fluid->v;
+    int c = i * n + j;
+
+    if ( s[c] != 0.0f && s[c-n] != 0.0f && j < fluid->numY - 1 ) {
+        float avgV = ( v[c-n] + v[c] + v[c-n+1] + v[c+1] ) * 0.25f;
+        float x = i * h - dt * u[c];
+        float y = j * h + h2 - dt * avgV;
+        fluid->newU[c] = sampleFieldFluid( fluid, x, y, U_FIELD );
+    }
+
+    if ( s[c] != 0.0f && s[c-1] != 0.0f && i < fluid->numX - 1 ) {
+        float avgU = ( u[c-1] + u[c] + u[c+n-1] + u[c+n] ) * 0.25f;
+        float x = i * h + h2 - dt * avgU;
+        float y = j * h - dt * v[c];
+        fluid->newV[c] = sampleFieldFluid( fluid, x, y, V_FIELD );
+    }
+
+}
+
+/**
+ * @brief The scalar advection of the smoke of a cell, as in
+ * advectSmokeFluid.
+ */
+static void advectSmokeCell( const AdvectionGrid *grid, int i, int j ) {
+
+    Fluid *fluid = grid->fluid;
+    int n = grid->n;
+    int c = i * n + j;
+
+    if ( fluid->s[c] != 0.0f ) {
+        float u = ( fluid->u[c] + fluid->u[c+n] ) * 0.5f;
+        float v = ( fluid->v[c] + fluid->v[c+1] ) * 0.5f;
+        float x = i * grid->h + grid->h2 - grid->dt * u;
+        float y = j * grid->h + grid->h2 - grid->dt * v;
+        fluid->newM[c] = sampleFieldFluid( fluid, x, y, S_FIELD );
+    }
+
+}
+
+/**
+ * @brief Greatest difference between a and b, clearing identical if
+ * they differ in any bit.
+ */
+static float compareFluidAdvection( const float *a, const float *b, int count, bool *identical ) {
+
+    float max = 0.0f;
+
+    for ( int i = 0; i < count; i++ ) {
+        float d = fabsf( a[i] - b[i] );
+        max = d > max ? d : max;
+    }
+
+    if ( memcmp( a, b, count * sizeof( float ) ) != 0 ) {
+        *identical = false;
+    }
+
+    return max;
+
+}
+
+#ifdef FLUID_ADVECTION_X86
+
+static inline __m128 blendSSE2( __m128 mask, __m128 a, __m128 b ) {
+    return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) );
+}
+
+/**
+ * @brief sampleFieldFluid of f at 4 points, with the field offset by
+ * dx and dy.
+ */
+static inline __m128 sampleSSE2( const AdvectionGrid *grid, const float *f, __m128 x, __m128 y, float dx, float dy ) {
+
+    const int n = grid->n;
+    const __m128 h = _mm_set1_ps( grid->h );
+    const __m128 h1 = _mm_set1_ps( grid->h1 );
+    const __m128 one = _mm_set1_ps( 1.0f );
+    const __m128 lastX = _mm_set1_ps( grid->lastX );
+    const __m128 lastY = _mm_set1_ps( grid->lastY );
+
+    x = _mm_sub_ps( _mm_max_ps( _mm_min_ps( x, _mm_set1_ps( grid->maxX ) ), h ), _mm_set1_ps( dx ) );
+    y = _mm_sub_ps( _mm_max_ps( _mm_min_ps( y, _mm_set1_ps( grid->maxY ) ), h ), _mm_set1_ps( dy ) );
+
+    // x and y are at least h / 2 here, so truncating floors them
+    const __m128 x0 = _mm_min_ps( _mm_cvtepi32_ps( _mm_cvttps_epi32( _mm_mul_ps( x, h1 ) ) ), lastX );
+    const __m128 y0 = _mm_min_ps( _mm_cvtepi32_ps( _mm_cvttps_epi32( _mm_mul_ps( y, h1 ) ) ), lastY );
+    const __m128 tx = _mm_mul_ps( _mm_sub_ps( x, _mm_mul_ps( x0, h ) ), h1 );
+    const __m128 ty = _mm_mul_ps( _mm_sub_ps( y, _mm_mul_ps( y0, h ) ), h1 );
+    const __m128 sx = _mm_sub_ps( one, tx );
+    const __m128 sy = _mm_sub_ps( one, ty );
+
+    // sse2 has no gather
+    int ix0[4];
+    int ix1[4];
+    int iy0[4];
+    int iy1[4];
+    _mm_storeu_si128( (__m128i*) ix0, _mm_cvttps_epi32( x0 ) );
+    _mm_storeu_si128( (__m128i*) ix1, _mm_cvttps_epi32( _mm_min_ps( _mm_add_ps( x0, one ), lastX ) ) );
+    _mm_storeu_si128( (__m128i*) iy0, _mm_cvttps_epi32( y0 ) );
+    _mm_storeu_si128( (__m128i*) iy1, _mm_cvttps_epi32( _mm_min_ps( _mm_add_ps( y0, one ), lastY ) ) );
+
+    const __m128 f00 = _mm_setr_ps( f[ix0[0]*n+iy0[0]], f[ix0[1]*n+iy0[1]], f[ix0[2]*n+iy0[2]], f[ix0[3]*n+iy0[3]] );
+    const __m128 f10 = _mm_setr_ps( f[ix1[0]*n+iy0[0]], f[ix1[1]*n+iy0[1]], f[ix1[2]*n+iy0[2]], f[ix1[3]*n+iy0[3]] );
+    const __m128 f11 = _mm_setr_ps( f[ix1[0]*n+iy1[0]], f[ix1[1]*n+iy1[1]], f[ix1[2]*n+iy1[2]], f[ix1[3]*n+iy1[3]] );
+    const __m128 f01 = _mm_setr_ps( f[ix0[0]*n+iy1[0]], f[ix0[1]*n+iy1[1]], f[ix0[2]*n+iy1[2]], f[ix0[3]*n+iy1[3]] );
+
+    __m128 r = _mm_mul_ps( _mm_mul_ps( sx, sy ), f00 );
+    r = _mm_add_ps( r, _mm_mul_ps( _mm_mul_ps( tx, sy ), f10 ) );
+    r = _mm_add_ps( r, _mm_mul_ps( _mm_mul_ps( tx, ty ), f11 ) );
+    r = _mm_add_ps( r, _mm_mul_ps( _mm_mul_ps( sx, ty ), f01 ) );
+
+    return r;
+
+}
+
+static int advectVelocitySSE2( const AdvectionGrid *grid, int i, int j, int end ) {
+
+    Fluid *fluid = grid->fluid;
+    const int n = grid->n;
+    const float *s = fluid->s;
+    const float *u = fluid->u;
+    const float *v = fluid->v;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 quarter = _mm_set1_ps( 0.25f );
+    const __m128 dt = _mm_set1_ps( grid->dt );
+    const __m128 h = _mm_set1_ps( grid->h );
+    const __m128 h2 = _mm_set1_ps( grid->h2 );
+    const __m128 ih = _mm_set1_ps( i * grid->h );
+    const __m128i lanes = _mm_setr_epi32( 0, 1, 2, 3 );
+
+    for ( ; j + 4 <= end; j += 4 ) {
+
+        const int c = i * n + j;
+        const __m128 sc = _mm_loadu_ps( s + c );
+        const __m128 uc = _mm_loadu_ps( u + c );
+        const __m128 vc = _mm_loadu_ps( v + c );
+        const __m128 jh = _mm_mul_ps( _mm_cvtepi32_ps( _mm_add_epi32( _mm_set1_epi32( j ), lanes ) ), h );
+        const __m128 fluidCell = _mm_cmpneq_ps( sc, zero );
+
+        // u, traced from the middle of the left face
+        __m128 avg = _mm_add_ps( _mm_loadu_ps( v + c - n ), vc );
+        avg = _mm_add_ps( avg, _mm_loadu_ps( v + c - n + 1 ) );
+        avg = _mm_mul_ps( _mm_add_ps( avg, _mm_loadu_ps( v + c + 1 ) ), quarter );
+        __m128 x = _mm_sub_ps( ih, _mm_mul_ps( dt, uc ) );
+        __m128 y = _mm_sub_ps( _mm_add_ps( jh, h2 ), _mm_mul_ps( dt, avg ) );
+        __m128 mask = _mm_and_ps( fluidCell, _mm_cmpneq_ps( _mm_loadu_ps( s + c - n ), zero ) );
+        _mm_storeu_ps( fluid->newU + c, blendSSE2( mask, sampleSSE2( grid, u, x, y, 0.0f, grid->h2 ), uc ) );
+
+        // v, traced from the middle of the bottom face
+        avg = _mm_add_ps( _mm_loadu_ps( u + c - 1 ), uc );
+        avg = _mm_add_ps( avg, _mm_loadu_ps( u + c + n - 1 ) );
+        avg = _mm_mul_ps( _mm_add_ps( avg, _mm_loadu_ps( u + c + n ) ), quarter );
+        x = _mm_sub_ps( _mm_add_ps( ih, h2 ), _mm_mul_ps( dt, avg ) );
+        y = _mm_sub_ps( jh, _mm_mul_ps( dt, vc ) );
+        mask = _mm_and_ps( fluidCell, _mm_cmpneq_ps( _mm_loadu_ps( s + c - 1 ), zero ) );
+        _mm_storeu_ps( fluid->newV + c, blendSSE2( mask, sampleSSE2( grid, v, x, y, grid->h2, 0.0f ), vc ) );
+
+    }
+
+    return j;
+
+}
+
+static int advectSmokeSSE2( const AdvectionGrid *grid, int i, int j, int end ) {
+
+    Fluid *fluid = grid->fluid;
+    const int n = grid->n;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 half = _mm_set1_ps( 0.5f );
+    const __m128 dt = _mm_set1_ps( grid->dt );
+    const __m128 h = _mm_set1_ps( grid->h );
+    const __m128 h2 = _mm_set1_ps( grid->h2 );
+    const __m128 x0 = _mm_add_ps( _mm_set1_ps( i * grid->h ), h2 );
+    const __m128i lanes = _mm_setr_epi32( 0, 1, 2, 3 );
+
+    for ( ; j + 4 <= end; j += 4 ) {
+
+        const int c = i * n + j;
+        const __m128 u = _mm_mul_ps( _mm_add_ps( _mm_loadu_ps( fluid->u + c ), _mm_loadu_ps( fluid->u + c + n ) ), half );
+        const __m128 v = _mm_mul_ps( _mm_add_ps( _mm_loadu_ps( fluid->v + c ), _mm_loadu_ps( fluid->v + c + 1 ) ), half );
+        const __m128 jh = _mm_mul_ps( _mm_cvtepi32_ps( _mm_add_epi32( _mm_set1_epi32( j ), lanes ) ), h );
+        const __m128 x = _mm_sub_ps( x0, _mm_mul_ps( dt, u ) );
+        const __m128 y = _mm_sub_ps( _mm_add_ps( jh, h2 ), _mm_mul_ps( dt, v ) );
+        const __m128 mask = _mm_cmpneq_ps( _mm_loadu_ps( fluid->s + c ), zero );
+        const __m128 sampled = sampleSSE2( grid, fluid->m, x, y, grid->h2, grid->h2 );
+        _mm_storeu_ps( fluid->newM + c, blendSSE2( mask, sampled, _mm_loadu_ps( fluid->m + c ) ) );
+
+    }
+
+    return j;
+
+}
+
+/**
+ * @brief sampleFieldFluid of f at 8 points, with the field offset by
+ * dx and dy.
+ */
+__attribute__(( target( "avx2" ) ))
+static inline __m256 sampleAVX2( const AdvectionGrid *grid, const float *f, __m256 x, __m256 y, float dx, float dy ) {
+
+    const __m256i n = _mm256_set1_epi32( grid->n );
+    const __m256 h = _mm256_set1_ps( grid->h );
+    const __m256 h1 = _mm256_set1_ps( grid->h1 );
+    const __m256 one = _mm256_set1_ps( 1.0f );
+    const __m256 lastX = _mm256_set1_ps( grid->lastX );
+    const __m256 lastY = _mm256_set1_ps( grid->lastY );
+
+    x = _mm256_sub_ps( _mm256_max_ps( _mm256_min_ps( x, _mm256_set1_ps( grid->maxX ) ), h ), _mm256_set1_ps( dx ) );
+    y = _mm256_sub_ps( _mm256_max_ps( _mm256_min_ps( y, _mm256_set1_ps( grid->maxY ) ), h ), _mm256_set1_ps( dy ) );
+
+    // x and y are at least h / 2 here, so truncating floors them
+    const __m256 x0 = _mm256_min_ps( _mm256_cvtepi32_ps( _mm256_cvttps_epi32( _mm256_mul_ps( x, h1 ) ) ), lastX );
+    const __m256 y0 = _mm256_min_ps( _mm256_cvtepi32_ps( _mm256_cvttps_epi32( _mm256_mul_ps( y, h1 ) ) ), lastY );
+    const __m256 tx = _mm256_mul_ps( _mm256_sub_ps( x, _mm256_mul_ps( x0, h ) ), h1 );
+    const __m256 ty = _mm256_mul_ps( _mm256_sub_ps( y, _mm256_mul_ps( y0, h ) ), h1 );
+    const __m256 sx = _mm256_sub_ps( one, tx );
+    const __m256 sy = _mm256_sub_ps( one, ty );
+
+    const __m256i col0 = _mm256_mullo_epi32( _mm256_cvttps_epi32( x0 ), n );
+    const __m256i col1 = _mm256_mullo_epi32( _mm256_cvttps_epi32( _mm256_min_ps( _mm256_add_ps( x0, one ), lastX ) ), n );
+    const __m256i row0 = _mm256_cvttps_epi32( y0 );
+    const __m256i row1 = _mm256_cvttps_epi32( _mm256_min_ps( _mm256_add_ps( y0, one ), lastY ) );
+
+    const __m256 f00 = _mm256_i32gather_ps( f, _mm256_add_epi32( col0, row0 ), 4 );
+    const __m256 f10 = _mm256_i32gather_ps( f, _mm256_add_epi32( col1, row0 ), 4 );
+    const __m256 f11 = _mm256_i32gather_ps( f, _mm256_add_epi32( col1, row1 ), 4 );
+    const __m256 f01 = _mm256_i32gather_ps( f, _mm256_add_epi32( col0, row1 ), 4 );
+
+    __m256 r = _mm256_mul_ps( _mm256_mul_ps( sx, sy ), f00 );
+    r = _mm256_add_ps( r, _mm256_mul_ps( _mm256_mul_ps( tx, sy ), f10 ) );
+    r = _mm256_add_ps( r, _mm256_mul_ps( _mm256_mul_ps( tx, ty ), f11 ) );
+    r = _mm256_add_ps( r, _mm256_mul_ps( _mm256_mul_ps( sx, ty ), f01 ) );
+
+    return r;
+
+}
+
+__attribute__(( target( "avx2" ) ))
+static int advectVelocityAVX2( const AdvectionGrid *grid, int i, int j, int end ) {
+
+    Fluid *fluid = grid->fluid;
+    const int n = grid->n;
+    const float *s = fluid->s;
+    const float *u = fluid->u;
+    const float *v = fluid->v;
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 quarter = _mm256_set1_ps( 0.25f );
+    const __m256 dt = _mm256_set1_ps( grid->dt );
+    const __m256 h = _mm256_set1_ps( grid->h );
+    const __m256 h2 = _mm256_set1_ps( grid->h2 );
+    const __m256 ih = _mm256_set1_ps( i * grid->h );
+    const __m256i lanes = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+
+    for ( ; j + 8 <= end; j += 8 ) {
+
+        const int c = i * n + j;
+        const __m256 sc = _mm256_loadu_ps( s + c );
+        const __m256 uc = _mm256_loadu_ps( u + c );
+        const __m256 vc = _mm256_loadu_ps( v + c );
+        const __m256 jh = _mm256_mul_ps( _mm256_cvtepi32_ps( _mm256_add_epi32( _mm256_set1_epi32( j ), lanes ) ), h );
+        const __m256 fluidCell = _mm256_cmp_ps( sc, zero, _CMP_NEQ_UQ );
+
+        // u, traced from the middle of the left face
+        __m256 avg = _mm256_add_ps( _mm256_loadu_ps( v + c - n ), vc );
+        avg = _mm256_add_ps( avg, _mm256_loadu_ps( v + c - n + 1 ) );
+        avg = _mm256_mul_ps( _mm256_add_ps( avg, _mm256_loadu_ps( v + c + 1 ) ), quarter );
+        __m256 x = _mm256_sub_ps( ih, _mm256_mul_ps( dt, uc ) );
+        __m256 y = _mm256_sub_ps( _mm256_add_ps( jh, h2 ), _mm256_mul_ps( dt, avg ) );
+        __m256 mask = _mm256_and_ps( fluidCell, _mm256_cmp_ps( _mm256_loadu_ps( s + c - n ), zero, _CMP_NEQ_UQ ) );
+        _mm256_storeu_ps( fluid->newU + c, _mm256_blendv_ps( uc, sampleAVX2( grid, u, x, y, 0.0f, grid->h2 ), mask ) );
+
+        // v, traced from the middle of the bottom face
+        avg = _mm256_add_ps( _mm256_loadu_ps( u + c - 1 ), uc );
+        avg = _mm256_add_ps( avg, _mm256_loadu_ps( u + c + n - 1 ) );
+        avg = _mm256_mul_ps( _mm256_add_ps( avg, _mm256_loadu_ps( u + c + n ) ), quarter );
+        x = _mm256_sub_ps( _mm256_add_ps( ih, h2 ), _mm256_mul_ps( dt, avg ) );
+        y = _mm256_sub_ps( jh, _mm256_mul_ps( dt, vc ) );
+        mask = _mm256_and_ps( fluidCell, _mm256_cmp_ps( _mm256_loadu_ps( s + c - 1 ), zero, _CMP_NEQ_UQ ) );
+        _mm256_storeu_ps( fluid->newV + c, _mm256_blendv_ps( vc, sampleAVX2( grid, v, x, y, grid->h2, 0.0f ), mask ) );
+
+    }
+
+    // the caller is not VEX encoded: clearing the upper halves of the
+    // registers before returning avoids the AVX to SSE transition
+    // penalty on its legacy SSE instructions
+    _mm256_zeroupper();
+
+    return j;
+
+}
+
+__attribute__(( target( "avx2" ) ))
+static int advectSmokeAVX2( const AdvectionGrid *grid, int i, int j, int end ) {
+
+    Fluid *fluid = grid->fluid;
+    const int n = grid->n;
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 half = _mm256_set1_ps( 0.5f );
+    const __m256 dt = _mm256_set1_ps( grid->dt );
+    const __m256 h = _mm256_set1_ps( grid->h );
+    const __m256 h2 = _mm256_set1_ps( grid->h2 );
+    const __m256 x0 = _mm256_add_ps( _mm256_set1_ps( i * grid->h ), h2 );
+    const __m256i lanes = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+
+    for ( ; j + 8 <= end; j += 8 ) {
+
+        const int c = i * n + j;
+        const __m256 u = _mm256_mul_ps( _mm256_add_ps( _mm256_loadu_ps( fluid->u + c ), _mm256_loadu_ps( fluid->u + c + n ) ), half );
+        const __m256 v = _mm256_mul_ps( _mm256_add_ps( _mm256_loadu_ps( fluid->v + c ), _mm256_loadu_ps( fluid->v + c + 1 ) ), half );
+        const __m256 jh = _mm256_mul_ps( _mm256_cvtepi32_ps( _mm256_add_epi32( _mm256_set1_epi32( j ), lanes ) ), h );
+        const __m256 x = _mm256_sub_ps( x0, _mm256_mul_ps( dt, u ) );
+        const __m256 y = _mm256_sub_ps( _mm256_add_ps( jh, h2 ), _mm256_mul_ps( dt, v ) );
+        const __m256 mask = _mm256_cmp_ps( _mm256_loadu_ps( fluid->s + c ), zero, _CMP_NEQ_UQ );
+        const __m256 sampled = sampleAVX2( grid, fluid->m, x, y, grid->h2, grid->h2 );
+        _mm256_storeu_ps( fluid->newM + c, _mm256_blendv_ps( _mm256_loadu_ps( fluid->m + c ), sampled, mask ) );
+
+    }
+
+    _mm256_zeroupper();
+
+    return j;
+
+}
+
+#endif
@@ -0,0 +1,384 @@
+/**
+ * @file FluidBenchmark.c
+ * @author Prof. Dr. David Buzatto
+ * @brief Headless benchmark of the fluid solver, implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <Fluid.h>
+#include <FluidAdvection.h>
+#include <FluidBenchmark.h>
+#include <FluidParticles.h>
+#include <FluidPool.h>
+
+#define BENCHMARK_SIZES 4
+#define BENCHMARK_CONVERGENCE_ITERS 4
+#define BENCHMARK_PARTICLE_COUNTS 3
+#define BENCHMARK_THREAD_COUNTS 4
+
+static const int BENCHMARK_SIZE_DATA[BENCHMARK_SIZES] = { 128, 256, 512, 1024 };
+static const float BENCHMARK_DT = 1.0f / 60.0f;
+static const int BENCHMARK_ITERS = 40;
+static const float BENCHMARK_OVER_RELAXATION = 1.9f;
+static const int BENCHMARK_WARMUP_STEPS = 2;
+static const int BENCHMARK_MIN_STEPS = 3;
+static const double BENCHMARK_MIN_SECONDS = 1.0;
+static const int BENCHMARK_CONVERGENCE_ITER_DATA[BENCHMARK_CONVERGENCE_ITERS] = { 10, 40, 160, 640 };
+static const int BENCHMARK_CONVERGENCE_WARMUP_STEPS = 10;
+static const int BENCHMARK_PARTICLE_COUNT_DATA[BENCHMARK_PARTICLE_COUNTS] = { 1 << 18, 1 << 20, 1 << 21 };
+static const int BENCHMARK_PARTICLE_SIZE = 256;
+static const float BENCHMARK_FLIP_RATIO = 0.9f;
+static const int BENCHMARK_THREAD_COUNT_DATA[BENCHMARK_THREAD_COUNTS] = { 1, 2, 4, 8 };
+
+typedef struct BenchmarkResult {
+    double stepsPerSecond;
+    double projectionTime;
+    int iters;
+    float divergence;
+} BenchmarkResult;
+
+static BenchmarkResult runCaseFluidBenchmark( int size, FluidSolver solver, FluidPool *pool );
+static bool runThreadsFluidBenchmark( int size, const int *threadCounts, int threadCountCount );
+static bool runConvergenceFluidBenchmark( int size, FluidPool *pool );
+static void runParticlesFluidBenchmark( int count, int threadCount );
+static Fluid* createWindTunnelFluidBenchmark( int size, FluidSolver solver, FluidPool *pool );
+
+bool runFluidBenchmark( void ) {
+
+    bool accepted = true;
+    int processors = getProcessorCount();
+
+    // 1, 2, 4 and 8 threads, however many processors there are, and
+    // all of them if there are more
+    int threadCounts[BENCHMARK_THREAD_COUNTS + 1];
+    int threadCountCount = 0;
+    for ( int t = 0; t < BENCHMARK_THREAD_COUNTS; t++ ) {
+        threadCounts[threadCountCount++] = BENCHMARK_THREAD_COUNT_DATA[t];
+    }
+    if ( processors > BENCHMARK_THREAD_COUNT_DATA[BENCHMARK_THREAD_COUNTS - 1] ) {
+        threadCounts[threadCountCount++] = processors;
+    }
+
+    printf( "wind tunnel, %d iterations, over-relaxation %.1f, %d processors\n",
+            BENCHMARK_ITERS, BENCHMARK_OVER_RELAXATION, processors );
+    printf( "%-6s %-13s %8s %10s %14s %8s %8s %12s\n", 
+            "size", "solver", "threads", "steps/s", "projection ms", "speedup", "iters", "residual" );
+
+    for ( int s = 0; s < BENCHMARK_SIZES; s++ ) {
+
+        int size = BENCHMARK_SIZE_DATA[s];
+
+        BenchmarkResult serial = runCaseFluidBenchmark( size, FLUID_SOLVER_GAUSS_SEIDEL, NULL );
+        printf( "%-6d %-13s %8d %10.2f %14.2f %8s %8d %12.3e\n", 
+                size, getNameFluidSolver( FLUID_SOLVER_GAUSS_SEIDEL ), 1, 
+                serial.stepsPerSecond, serial.projectionTime * 1000, "-", serial.iters, serial.divergence );
+
+        double single = 0;
+
+        for ( int t = 0; t < threadCountCount; t++ ) {
+
+            FluidPool *pool = createFluidPool( threadCounts[t] );
+            BenchmarkResult result = runCaseFluidBenchmark( size, FLUID_SOLVER_RED_BLACK, pool );
+            destroyFluidPool( pool );
+
+            if ( t == 0 ) {
+                single = result.stepsPerSecond;
+            }
+
+            printf( "%-6d %-13s %8d %10.2f %14.2f %7.2fx %8d %12.3e\n", 
+                    size, getNameFluidSolver( FLUID_SOLVER_RED_BLACK ), threadCounts[t], 
+                    result.stepsPerSecond, result.projectionTime * 1000, 
+                    result.stepsPerSecond / single, result.iters, result.divergence );
+
+        }
+
+        // the conjugate gradients run to the tolerance, not to the
+        // iterations given to the others
+        for ( int solver = FLUID_SOLVER_PCG; solver <= FLUID_SOLVER_MGPCG; solver++ ) {
+            BenchmarkResult result = runCaseFluidBenchmark( size, solver, NULL );
+            printf( "%-6d %-13s %8d %10.2f %14.2f %8s %8d %12.3e\n", 
+                    size, getNameFluidSolver( solver ), 1, 
+                    result.stepsPerSecond, result.projectionTime * 1000, "-", result.iters, result.divergence );
+        }
+
+    }
+
+    printf( "\nred-black on each thread count, one projection of the same developed flow\n" );
+    printf( "%-6s %8s %12s %s\n", "size", "threads", "residual", "result" );
+
+    for ( int s = 0; s < BENCHMARK_SIZES; s++ ) {
+        accepted = runThreadsFluidBenchmark( BENCHMARK_SIZE_DATA[s], threadCounts, threadCountCount ) && accepted;
+    }
+
+    FluidPool *pool = createFluidPool( processors );
+
+    printf( "\nconvergence of one projection, up to the given iterations (the pcgs run to %.0e, up to %d)\n", 
+            FLUID_PCG_TOLERANCE, FLUID_PCG_MAX_ITERS );
+    printf( "%-6s %-13s %8s %8s %12s %10s %12s %s\n", "size", "solver", "limit", "done", "residual", "vs gs", "ms", "result" );
+
+    for ( int s = 0; s < BENCHMARK_SIZES; s++ ) {
+        accepted = runConvergenceFluidBenchmark( BENCHMARK_SIZE_DATA[s], pool ) && accepted;
+    }
+
+    destroyFluidPool( pool );
+
+    printf( "\nflip/pic (ratio %.1f) on a %dx%d wind tunnel, red-black projection\n", 
+            BENCHMARK_FLIP_RATIO, BENCHMARK_PARTICLE_SIZE, BENCHMARK_PARTICLE_SIZE );
+    printf( "%-10s %8s %10s %12s %12s %14s\n", 
+            "particles", "threads", "steps/s", "transfer ms", "move ms", "projection ms" );
+
+    for ( int c = 0; c < BENCHMARK_PARTICLE_COUNTS; c++ ) {
+        for ( int t = 0; t < threadCountCount; t++ ) {
+            runParticlesFluidBenchmark( BENCHMARK_PARTICLE_COUNT_DATA[c], threadCounts[t] );
+        }
+    }
+
+    printf( "\n" );
+    accepted = runFluidAdvectionBenchmark() && accepted;
+
+    return accepted;
+
+}
+
+/**
+ * @brief Steps a size x size wind tunnel for at least BENCHMARK_MIN_SECONDS,
+ * then measures the residual of one more projection.
+ */
+static BenchmarkResult runCaseFluidBenchmark( int size, FluidSolver solver, FluidPool *pool ) {
+
+    Fluid *fluid = createWindTunnelFluidBenchmark( size, solver, pool );
+
+    for ( int i = 0; i < BENCHMARK_WARMUP_STEPS; i++ ) {
+        simulateFluid( fluid, BENCHMARK_DT, 0.0f, BENCHMARK_ITERS, BENCHMARK_OVER_RELAXATION );
+    }
+
+    int steps = 0;
+    double seconds = 0;
+    double projection = 0;
+
+    while ( steps < BENCHMARK_MIN_STEPS || seconds < BENCHMARK_MIN_SECONDS ) {
+        simulateFluid( fluid, BENCHMARK_DT, 0.0f, BENCHMARK_ITERS, BENCHMARK_OVER_RELAXATION );
+        seconds += fluid->times.total;
+        projection += fluid->times.projection;
+        steps++;
+    }
+
+    integrateFluid( fluid, BENCHMARK_DT, 0.0f );
+    memset( fluid->p, 0, fluid->numCells * sizeof( float ) );
+    int iters = solveIncompressibilityFluid( fluid, BENCHMARK_ITERS, BENCHMARK_DT, BENCHMARK_OVER_RELAXATION );
+
+    BenchmarkResult result = {
+        .stepsPerSecond = steps / seconds,
+        .projectionTime = projection / steps,
+        .iters = iters,
+        .divergence = getDivergenceFluid( fluid )
+    };
+
+    destroyFluid( fluid );
+
+    return result;
+
+}
+
+/**
+ * @brief Projects the same velocities of a developed flow with the
+ * red-black solver on each thread count. Each cell of a color only
+ * reads cells of the other, so the velocities and the pressure must
+ * be the same, bit by bit, as on one thread; returns false otherwise.
+ */
+static bool runThreadsFluidBenchmark( int size, const int *threadCounts, int threadCountCount ) {
+
+    bool accepted = true;
+    Fluid *fluid = createWindTunnelFluidBenchmark( size, FLUID_SOLVER_RED_BLACK, NULL );
+
+    for ( int i = 0; i < BENCHMARK_CONVERGENCE_WARMUP_STEPS; i++ ) {
+        simulateFluid( fluid, BENCHMARK_DT, 0.0f, BENCHMARK_ITERS, BENCHMARK_OVER_RELAXATION );
+    }
+    integrateFluid( fluid, BENCHMARK_DT, 0.0f );
+
+    // the state every thread count starts from, and what one thread
+    // makes of it
+    size_t bytes = fluid->numCells * sizeof( float );
+    float *state = (float*) malloc( 2 * bytes );
+    float *reference = (float*) malloc( 3 * bytes );
+    memcpy( state, fluid->u, bytes );
+    memcpy( state + fluid->numCells, fluid->v, bytes );
+
+    for ( int t = 0; t < threadCountCount; t++ ) {
+
+        FluidPool *pool = createFluidPool( threadCounts[t] );
+        fluid->pool = pool;
+
+        memcpy( fluid->u, state, bytes );
+        memcpy( fluid->v, state + fluid->numCells, bytes );
+        memset( fluid->p, 0, bytes );
+        solveIncompressibilityFluid( fluid, BENCHMARK_ITERS, BENCHMARK_DT, BENCHMARK_OVER_RELAXATION );
+
+        fluid->pool = NULL;
+        destroyFluidPool( pool );
+
+        const char *result = "reference";
+
+        if ( t == 0 ) {
+            memcpy( reference, fluid->u, bytes );
+            memcpy( reference + fluid->numCells, fluid->v, bytes );
+            memcpy( reference + 2 * fluid->numCells, fluid->p, bytes );
+        } else if ( memcmp( fluid->u, reference, bytes ) == 0 &&
+                    memcmp( fluid->v, reference + fluid->numCells, bytes ) == 0 &&
+                    memcmp( fluid->p, reference + 2 * fluid->numCells, bytes ) == 0 ) {
+            result = "identical";
+        } else {
+            result = "MISMATCH";
+            accepted = false;
+        }
+
+        printf( "%-6d %8d %12.3e %s\n", size, threadCounts[t], getDivergenceFluid( fluid ), result );
+
+    }
+
+    free( state );
+    free( reference );
+    destroyFluid( fluid );
+
+    return accepted;
+
+}
+
+/**
+ * @brief Projects the same velocities of a developed flow with each
+ * solver and iteration limit, printing the residual and the time.
+ * Returns false if red-black leaves more divergence than Gauss-Seidel
+ * with the same iterations, or if a conjugate gradient solver does not
+ * reach the tolerance.
+ */
+static bool runConvergenceFluidBenchmark( int size, FluidPool *pool ) {
+
+    bool accepted = true;
+
+    Fluid *fluid = createWindTunnelFluidBenchmark( size, FLUID_SOLVER_GAUSS_SEIDEL, pool );
+
+    for ( int i = 0; i < BENCHMARK_CONVERGENCE_WARMUP_STEPS; i++ ) {
+        simulateFluid( fluid, BENCHMARK_DT, 0.0f, BENCHMARK_ITERS, BENCHMARK_OVER_RELAXATION );
+    }
+    integrateFluid( fluid, BENCHMARK_DT, 0.0f );
+
+    size_t bytes = fluid->numCells * sizeof( float );
+    float *u = (float*) malloc( bytes );
+    float *v = (float*) malloc( bytes );
+    memcpy( u, fluid->u, bytes );
+    memcpy( v, fluid->v, bytes );
+
+    // residual of Gauss-Seidel at each limit, that the others are
+    // compared to
+    float serial[BENCHMARK_CONVERGENCE_ITERS];
+
+    for ( int solver = 0; solver < FLUID_SOLVER_COUNT; solver++ ) {
+
+        fluid->solver = solver;
+
+        // the limit doesn't apply to the conjugate gradients, so they
+        // have a single row, with the iterations they took to converge
+        bool limited = solver < FLUID_SOLVER_PCG;
+        int limits = limited ? BENCHMARK_CONVERGENCE_ITERS : 1;
+
+        for ( int k = 0; k < limits; k++ ) {
+
+            memcpy( fluid->u, u, bytes );
+            memcpy( fluid->v, v, bytes );
+            memset( fluid->p, 0, bytes );
+
+            double start = getTimeFluid();
+            int iters = solveIncompressibilityFluid( fluid, BENCHMARK_CONVERGENCE_ITER_DATA[k], 
+                                                     BENCHMARK_DT, BENCHMARK_OVER_RELAXATION );
+            double seconds = getTimeFluid() - start;
+            float residual = getDivergenceFluid( fluid );
+
+            if ( solver == FLUID_SOLVER_GAUSS_SEIDEL ) {
+                serial[k] = residual;
+            }
+
+            char limit[16] = "-";
+            if ( limited ) {
+                snprintf( limit, sizeof( limit ), "%d", BENCHMARK_CONVERGENCE_ITER_DATA[k] );
+            }
+
+            // next to Gauss-Seidel at the same limit, or at the greatest
+            float reference = serial[limited ? k : BENCHMARK_CONVERGENCE_ITERS - 1];
+
+            const char *result = solver == FLUID_SOLVER_GAUSS_SEIDEL ? "reference" : "ok";
+            if ( solver == FLUID_SOLVER_RED_BLACK && residual > reference ) {
+                result = "WORSE THAN GS";
+                accepted = false;
+            } else if ( !limited && iters >= FLUID_PCG_MAX_ITERS ) {
+                result = "NOT CONVERGED";
+                accepted = false;
+            }
+
+            printf( "%-6d %-13s %8s %8d %12.3e %9.3gx %12.2f %s\n", 
+                    size, getNameFluidSolver( solver ), limit, 
+                    iters, residual, residual / reference, seconds * 1000, result );
+
+        }
+
+    }
+
+    free( u );
+    free( v );
+    destroyFluid( fluid );
+
+    return accepted;
+
+}
+
+/**
+ * @brief Steps a wind tunnel with count particles in FLIP/PIC mode for
+ * at least BENCHMARK_MIN_SECONDS, printing the time of each part.
+ */
+static void runParticlesFluidBenchmark( int count, int threadCount ) {
+
+    FluidPool *pool = createFluidPool( threadCount );
+    Fluid *fluid = createWindTunnelFluidBenchmark( BENCHMARK_PARTICLE_SIZE, FLUID_SOLVER_RED_BLACK, pool );
+    FluidParticles *particles = createFluidParticles( fluid, count, BENCHMARK_FLIP_RATIO );
+
+    for ( int i = 0; i < BENCHMARK_WARMUP_STEPS; i++ ) {
+        simulateFluidParticles( particles, fluid, BENCHMARK_DT, 0.0f, BENCHMARK_ITERS, BENCHMARK_OVER_RELAXATION );
+    }
+
+    int steps = 0;
+    FluidStepTimes times = {0};
+
+    while ( steps < BENCHMARK_MIN_STEPS || times.total < BENCHMARK_MIN_SECONDS ) {
+        simulateFluidParticles( particles, fluid, BENCHMARK_DT, 0.0f, BENCHMARK_ITERS, BENCHMARK_OVER_RELAXATION );
+        times.total += fluid->times.total;
+        times.transfer += fluid->times.transfer;
+        times.advection += fluid->times.advection;
+        times.projection += fluid->times.projection;
+        steps++;
+    }
+
+    printf( "%-10d %8d %10.2f %12.2f %12.2f %14.2f\n", 
+            count, threadCount, steps / times.total, times.transfer / steps * 1000, 
+            times.advection / steps * 1000, times.projection / steps * 1000 );
+
+    destroyFluidParticles( particles );
+    destroyFluid( fluid );
+    destroyFluidPool( pool );
+
+}
+
+static Fluid* createWindTunnelFluidBenchmark( int size, FluidSolver solver, FluidPool *pool ) {
+
+    Fluid *fluid = createFluid( 1000.0f, size, size, 1.0f / size );
+    fluid->solver = solver;
+    fluid->pool = pool;
+    setupWindTunnelFluid( fluid, 2.0f, 0.1f );
+    setObstacleFluid( fluid, 0.4f, 0.5f, 0.15f, 0.0f, 0.0f );
+
+    return fluid;
+
+}
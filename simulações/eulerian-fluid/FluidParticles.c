@@ -0,0 +1,472 @@
+/**
+ * @file FluidParticles.c
+ * @author Prof. Dr. David Buzatto
+ * @brief FluidParticles implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <Fluid.h>
+#include <FluidParticles.h>
+#include <FluidPool.h>
+
+typedef struct ParticlesTask {
+    FluidParticles *particles;
+    Fluid *fluid;
+    float dt;
+    float gravity;
+} ParticlesTask;
+
+// the four faces around a point and their bilinear weights
+typedef struct FaceWeights {
+    int c[4];
+    float w[4];
+} FaceWeights;
+
+static void moveParticlesTask( FluidPool *pool, int worker, void *data );
+static void particlesToGridTask( FluidPool *pool, int worker, void *data );
+static void gridToParticlesTask( FluidPool *pool, int worker, void *data );
+static bool pushOutFluidParticles( const Fluid *fluid, float *x, float *y, float *u, float *v );
+static inline FaceWeights getFaceWeights( const Fluid *fluid, float x, float y, float dx, float dy );
+static float randomFluidParticles( FluidParticles *particles );
+
+FluidParticles* createFluidParticles( const Fluid *fluid, int count, float flipRatio ) {
+
+    FluidParticles *particles = (FluidParticles*) malloc( sizeof( FluidParticles ) );
+
+    particles->count = count;
+    particles->x = (float*) malloc( 4 * (size_t) count * sizeof( float ) );
+    particles->y = particles->x + count;
+    particles->u = particles->x + 2 * (size_t) count;
+    particles->v = particles->x + 3 * (size_t) count;
+    particles->flipRatio = flipRatio;
+    particles->prevU = (float*) calloc( fluid->numCells, sizeof( float ) );
+    particles->prevV = (float*) calloc( fluid->numCells, sizeof( float ) );
+    particles->sums = NULL;
+    particles->sumsWorkers = 0;
+    particles->seed = 2463534242u;
+
+    int n = fluid->numY;
+    float h = fluid->h;
+    int fluidCells = 0;
+
+    for ( int i = 1; i < fluid->numX - 1; i++ ) {
+        for ( int j = 1; j < fluid->numY - 1; j++ ) {
+            if ( fluid->s[i*n+j] != 0.0f ) {
+                fluidCells++;
+            }
+        }
+    }
+
+    if ( fluidCells == 0 ) {
+        particles->count = 0;
+    }
+
+    // the same number of particles in each cell, give or take one, in
+    // the order of the cells, so the particles close in the grid start
+    // close in memory too
+    int i = 1;
+    int j = 0;
+    int cell = -1;
+
+    for ( int p = 0; p < particles->count; p++ ) {
+
+        int target = (int) ( (long long) p * fluidCells / count );
+
+        while ( cell < target ) {
+            if ( ++j == fluid->numY - 1 ) {
+                j = 1;
+                i++;
+            }
+            if ( fluid->s[i*n+j] != 0.0f ) {
+                cell++;
+            }
+        }
+
+        float x = ( i + randomFluidParticles( particles ) ) * h;
+        float y = ( j + randomFluidParticles( particles ) ) * h;
+        particles->x[p] = x;
+        particles->y[p] = y;
+        particles->u[p] = sampleFieldFluid( fluid, x, y, U_FIELD );
+        particles->v[p] = sampleFieldFluid( fluid, x, y, V_FIELD );
+
+    }
+
+    return particles;
+
+}
+
+void destroyFluidParticles( FluidParticles *particles ) {
+    free( particles->x );
+    free( particles->prevU );
+    free( particles->prevV );
+    free( particles->sums );
+    free( particles );
+}
+
+void simulateFluidParticles( FluidParticles *particles, Fluid *fluid, float dt, float gravity, int numIters, float overRelaxation ) {
+
+    FluidPool *pool = fluid->pool;
+
+    if ( particles->sumsWorkers != pool->threadCount ) {
+        particles->sumsWorkers = pool->threadCount;
+        size_t size = (size_t) particles->sumsWorkers * 4 * fluid->numCells;
+        particles->sums = (float*) realloc( particles->sums, size * sizeof( float ) );
+    }
+
+    ParticlesTask task = {
+        .particles = particles,
+        .fluid = fluid,
+        .dt = dt,
+        .gravity = gravity
+    };
+
+    double start = getTimeFluid();
+    runFluidPool( pool, moveParticlesTask, &task );
+    double moved = getTimeFluid();
+
+    // the faces of the border follow the new ones inside, before the
+    // velocities are saved, or FLIP would take the copies as changes
+    runFluidPool( pool, particlesToGridTask, &task );
+    extrapolateFluid( fluid );
+    memcpy( particles->prevU, fluid->u, fluid->numCells * sizeof( float ) );
+    memcpy( particles->prevV, fluid->v, fluid->numCells * sizeof( float ) );
+    double transferred = getTimeFluid();
+
+    memset( fluid->p, 0, fluid->numCells * sizeof( float ) );
+    fluid->solverIters = solveIncompressibilityFluid( fluid, numIters, dt, overRelaxation );
+    double projected = getTimeFluid();
+
+    // measured out of the timed parts of the step
+    fluid->residual = getDivergenceFluid( fluid );
+    double measured = getTimeFluid();
+
+    extrapolateFluid( fluid );
+    double extrapolated = getTimeFluid();
+
+    runFluidPool( pool, gridToParticlesTask, &task );
+    double returned = getTimeFluid();
+
+    advectSmokeFluid( fluid, dt );
+    double advected = getTimeFluid();
+
+    fluid->times = (FluidStepTimes) {
+        .integration = 0,
+        .projection = projected - transferred,
+        .extrapolation = extrapolated - measured,
+        .advection = moved - start + advected - returned,
+        .transfer = transferred - moved + returned - extrapolated,
+        .total = advected - measured + projected - start
+    };
+
+}
+
+/**
+ * @brief Moves a band of particles, with gravity, keeping them inside
+ * the wind tunnel and out of the solid cells.
+ */
+static void moveParticlesTask( FluidPool *pool, int worker, void *data ) {
+
+    const ParticlesTask *task = (const ParticlesTask*) data;
+    FluidParticles *particles = task->particles;
+    const Fluid *fluid = task->fluid;
+    const int n = fluid->numY;
+    const float h = fluid->h;
+    const float h1 = 1.0f / h;
+    const float minX = h;
+    const float maxX = ( fluid->numX - 1 ) * h;
+    const float minY = h;
+    const float maxY = ( fluid->numY - 1 ) * h;
+    const float dt = task->dt;
+    const float dv = task->gravity * task->dt;
+
+    int from;
+    int to;
+    getBandFluidPool( pool, worker, 0, particles->count, &from, &to );
+
+    for ( int p = from; p < to; p++ ) {
+
+        // a particle the obstacle was dragged over goes ahead of it
+        if ( pushOutFluidParticles( fluid, &particles->x[p], &particles->y[p], &particles->u[p], &particles->v[p] ) ) {
+            continue;
+        }
+
+        float u = particles->u[p];
+        float v = particles->v[p] + dv;
+        float x = particles->x[p] + u * dt;
+        float y = particles->y[p] + v * dt;
+
+        // out at the right, in again at the left, with the inflow
+        if ( x >= maxX ) {
+            x = fmaxf( x - ( maxX - minX ), minX );
+            int j = (int) fminf( y * h1, fluid->numY - 2 );
+            u = fluid->u[n+j];
+            v = 0.0f;
+        } else if ( x < minX ) {
+            x = minX;
+        }
+
+        if ( y < minY ) {
+            y = minY;
+            v = 0.0f;
+        } else if ( y > maxY ) {
+            y = maxY;
+            v = 0.0f;
+        }
+
+        // a particle that would get into a solid cell stays where it
+        // was, and the grid gives it the velocity of the solid
+        int i = (int) fminf( x * h1, fluid->numX - 2 );
+        int j = (int) fminf( y * h1, fluid->numY - 2 );
+        if ( fluid->s[i*n+j] == 0.0f ) {
+            x = particles->x[p];
+            y = particles->y[p];
+        }
+
+        particles->x[p] = x;
+        particles->y[p] = y;
+        particles->u[p] = u;
+        particles->v[p] = v;
+
+    }
+
+}
+
+/**
+ * @brief If the particle at ( x, y ) is inside a moving solid cell,
+ * moves it along the velocity of the cell, one cell at a time, to the
+ * first cell that is not solid, gives it that velocity and returns
+ * true. Otherwise, or if there is no such cell inside the grid, it
+ * stays as it is, since it could only be taken back by the grid.
+ */
+static bool pushOutFluidParticles( const Fluid *fluid, float *x, float *y, float *u, float *v ) {
+
+    const int n = fluid->numY;
+    const float h = fluid->h;
+    const float h1 = 1.0f / h;
+
+    int i = (int) fminf( *x * h1, fluid->numX - 2 );
+    int j = (int) fminf( *y * h1, fluid->numY - 2 );
+    int c = i * n + j;
+
+    if ( fluid->s[c] != 0.0f ) {
+        return false;
+    }
+
+    // the faces of the cell have the velocity of the solid
+    float su = 0.5f * ( fluid->u[c] + fluid->u[c+n] );
+    float sv = 0.5f * ( fluid->v[c] + fluid->v[c+1] );
+    float speed = sqrtf( su * su + sv * sv );
+
+    if ( speed == 0.0f ) {
+        return false;
+    }
+
+    float dx = su / speed * h;
+    float dy = sv / speed * h;
+    float px = *x;
+    float py = *y;
+
+    for ( int k = 0; k < fluid->numX + fluid->numY; k++ ) {
+
+        px += dx;
+        py += dy;
+        i = (int) floorf( px * h1 );
+        j = (int) floorf( py * h1 );
+
+        if ( i < 1 || j < 1 || i > fluid->numX - 2 || j > fluid->numY - 2 ) {
+            return false;
+        }
+
+        if ( fluid->s[i*n+j] != 0.0f ) {
+            *x = px;
+            *y = py;
+            *u = su;
+            *v = sv;
+            return true;
+        }
+
+    }
+
+    return false;
+
+}
+
+/**
+ * @brief Adds the velocities of a band of particles to the sums of the
+ * worker and, once every worker is done, sets the velocity of each face
+ * of a band of columns to the weighted average of the particles around
+ * it. The faces of the solid cells and the faces without particles
+ * keep their velocity.
+ */
+static void particlesToGridTask( FluidPool *pool, int worker, void *data ) {
+
+    const ParticlesTask *task = (const ParticlesTask*) data;
+    FluidParticles *particles = task->particles;
+    Fluid *fluid = task->fluid;
+    const int n = fluid->numY;
+    const int cells = fluid->numCells;
+    const float h2 = 0.5f * fluid->h;
+
+    // weighted velocity and weight of each face side by side, so each
+    // particle touches one cache line for each of its faces
+    float *sumU = particles->sums + (size_t) worker * 4 * cells;
+    float *sumV = sumU + 2 * cells;
+    memset( sumU, 0, 4 * (size_t) cells * sizeof( float ) );
+
+    int from;
+    int to;
+    getBandFluidPool( pool, worker, 0, particles->count, &from, &to );
+
+    for ( int p = from; p < to; p++ ) {
+
+        float x = particles->x[p];
+        float y = particles->y[p];
+
+        FaceWeights fu = getFaceWeights( fluid, x, y, 0.0f, h2 );
+        float u = particles->u[p];
+        for ( int k = 0; k < 4; k++ ) {
+            sumU[2*fu.c[k]] += fu.w[k] * u;
+            sumU[2*fu.c[k]+1] += fu.w[k];
+        }
+
+        FaceWeights fv = getFaceWeights( fluid, x, y, h2, 0.0f );
+        float v = particles->v[p];
+        for ( int k = 0; k < 4; k++ ) {
+            sumV[2*fv.c[k]] += fv.w[k] * v;
+            sumV[2*fv.c[k]+1] += fv.w[k];
+        }
+
+    }
+
+    syncFluidPool( pool );
+
+    getBandFluidPool( pool, worker, 1, fluid->numX, &from, &to );
+    const float *s = fluid->s;
+
+    for ( int i = from; i < to; i++ ) {
+        for ( int j = 1; j < fluid->numY; j++ ) {
+
+            int c = i * n + j;
+            float su = 0.0f;
+            float wu = 0.0f;
+            float sv = 0.0f;
+            float wv = 0.0f;
+
+            for ( int w = 0; w < pool->threadCount; w++ ) {
+                const float *sums = particles->sums + (size_t) w * 4 * cells;
+                su += sums[2*c];
+                wu += sums[2*c+1];
+                sv += sums[2*cells+2*c];
+                wv += sums[2*cells+2*c+1];
+            }
+
+            if ( wu > 0.0f && s[c] != 0.0f && s[c-n] != 0.0f ) {
+                fluid->u[c] = su / wu;
+            }
+            if ( wv > 0.0f && s[c] != 0.0f && s[c-1] != 0.0f ) {
+                fluid->v[c] = sv / wv;
+            }
+
+        }
+    }
+
+}
+
+/**
+ * @brief Gives each particle of a band the velocity of the grid (PIC)
+ * blended with its own plus the change made by the projection (FLIP).
+ */
+static void gridToParticlesTask( FluidPool *pool, int worker, void *data ) {
+
+    const ParticlesTask *task = (const ParticlesTask*) data;
+    FluidParticles *particles = task->particles;
+    const Fluid *fluid = task->fluid;
+    const float h2 = 0.5f * fluid->h;
+    const float flip = particles->flipRatio;
+    const float *u = fluid->u;
+    const float *v = fluid->v;
+    const float *prevU = particles->prevU;
+    const float *prevV = particles->prevV;
+
+    int from;
+    int to;
+    getBandFluidPool( pool, worker, 0, particles->count, &from, &to );
+
+    for ( int p = from; p < to; p++ ) {
+
+        float x = particles->x[p];
+        float y = particles->y[p];
+        float pic = 0.0f;
+        float change = 0.0f;
+
+        FaceWeights fu = getFaceWeights( fluid, x, y, 0.0f, h2 );
+        for ( int k = 0; k < 4; k++ ) {
+            pic += fu.w[k] * u[fu.c[k]];
+            change += fu.w[k] * ( u[fu.c[k]] - prevU[fu.c[k]] );
+        }
+        particles->u[p] = ( 1.0f - flip ) * pic + flip * ( particles->u[p] + change );
+
+        pic = 0.0f;
+        change = 0.0f;
+
+        FaceWeights fv = getFaceWeights( fluid, x, y, h2, 0.0f );
+        for ( int k = 0; k < 4; k++ ) {
+            pic += fv.w[k] * v[fv.c[k]];
+            change += fv.w[k] * ( v[fv.c[k]] - prevV[fv.c[k]] );
+        }
+        particles->v[p] = ( 1.0f - flip ) * pic + flip * ( particles->v[p] + change );
+
+    }
+
+}
+
+/**
+ * @brief Faces of the field offset by dx and dy around ( x, y ), as in
+ * sampleFieldFluid, but never on the last column or row, so the
+ * particles only touch the faces inside the grid.
+ */
+static inline FaceWeights getFaceWeights( const Fluid *fluid, float x, float y, float dx, float dy ) {
+
+    const int n = fluid->numY;
+    const float h = fluid->h;
+    const float h1 = 1.0f / h;
+
+    x = fmaxf( fminf( x, ( fluid->numX - 1 ) * h ), h ) - dx;
+    y = fmaxf( fminf( y, ( fluid->numY - 1 ) * h ), h ) - dy;
+
+    // x and y are at least h / 2, so truncating floors them
+    int x0 = (int) fminf( x * h1, fluid->numX - 2 );
+    float tx = ( x - x0 * h ) * h1;
+    int x1 = x0 + 1 < fluid->numX - 2 ? x0 + 1 : fluid->numX - 2;
+
+    int y0 = (int) fminf( y * h1, fluid->numY - 2 );
+    float ty = ( y - y0 * h ) * h1;
+    int y1 = y0 + 1 < fluid->numY - 2 ? y0 + 1 : fluid->numY - 2;
+
+    float sx = 1.0f - tx;
+    float sy = 1.0f - ty;
+
+    return (FaceWeights) {
+        .c = { x0*n+y0, x1*n+y0, x1*n+y1, x0*n+y1 },
+        .w = { sx * sy, tx * sy, tx * ty, sx * ty }
+    };
+
+}
+
+/**
+ * @brief Uniform random number in [ 0, 1 ), xorshift32.
+ */
+static float randomFluidParticles( FluidParticles *particles ) {
+    unsigned int x = particles->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    particles->seed = x;
+    return ( x >> 8 ) * ( 1.0f / 16777216.0f );
+}
@@ -0,0 +1,228 @@
+/**
+ * @file Fluid.h
+ * @author Prof. Dr. David Buzatto
+ * @brief Fluid struct and functions declarations.
+ *
+ * Incompressible fluid on a staggered (MAC) grid, based on the Eulerian
+ * fluid simulation of Matthias Müller's Ten Minute Physics
+ * (https://matthias-research.github.io/pages/tenMinutePhysics/).
+ *
+ * Cell (i, j) is stored at i * numY + j. u is sampled at the middle of
+ * its left face and v at the middle of its bottom face; p (pressure)
+ * and m (smoke) at its center. s is 0 for solid cells and 1 for fluid
+ * cells. The grid has a border of one cell on each side.
+ *
+ * The projection can run in red-black order: cells where i + j is even
+ * (red) only share faces with cells where it is odd (black), so each
+ * color is relaxed by all the threads of the pool at once, one band of
+ * columns each. Over-relaxed, the last black cells kept 0.9 of their
+ * divergence and left a residual 2 to 4 times that of the serial
+ * lexicographic Gauss-Seidel sweep; the last black half sweep is not
+ * over-relaxed, and the residual is 10 times lower than that, a half
+ * to a fifth of the serial one from 40 iterations on (see the
+ * convergence benchmark).
+ *
+ * Gauss-Seidel needs more iterations the larger the grid. The third
+ * solver writes the projection as the linear system A x = -div of the
+ * fluid cells, where the diagonal of A is the number of open faces of
+ * each cell and -1 links it to each fluid neighbor, and solves it with
+ * conjugate gradients preconditioned by the modified incomplete
+ * Cholesky factorization MIC(0), as in Robert Bridson's "Fluid
+ * Simulation for Computer Graphics". It stops when the greatest
+ * divergence is under FLUID_PCG_TOLERANCE, whatever the iterations
+ * given to Gauss-Seidel, but MIC(0) only makes the iterations grow
+ * about as fast as the side of the grid: 73, 131, 241 and 521 on the
+ * wind tunnels of 128² to 1024² of the benchmark.
+ *
+ * The fourth solver uses the same conjugate gradients with a multigrid
+ * preconditioner, as in McAdams, Sifakis and Teran's "A parallel
+ * multigrid Poisson solver for fluids simulation on large grids": one
+ * V-cycle over levels of half the cells on each side, down to at most
+ * FLUID_MG_COARSEST cells on the smaller one. Each level relaxes its
+ * fluid cells in red-black order, restricts what is left to the next
+ * level, adds back the bilinear interpolation of its correction and
+ * relaxes again in the opposite order, so the preconditioner stays
+ * symmetric. A coarse cell is fixed at 0 (like the open right border)
+ * if any of its cells is, fluid if any of its cells is and solid
+ * otherwise. It takes 6, 7, 7 and 8 iterations on the same wind
+ * tunnels, 0.7 s instead of about 17 s for one projection of 1024².
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <FluidPool.h>
+
+// greatest divergence accepted by the conjugate gradient solver, and
+// the tuning of the MIC(0) preconditioner
+#define FLUID_PCG_TOLERANCE 1e-4f
+#define FLUID_MIC_TUNING 0.97f
+#define FLUID_MIC_SAFETY 0.25f
+
+// iterations of the conjugate gradient solvers before they give up
+#define FLUID_PCG_MAX_ITERS 2000
+
+// greatest cells on the smaller side of the coarsest multigrid level,
+// the red-black relaxations of each level on the way down and up and
+// the ones that solve the coarsest level
+#define FLUID_MG_COARSEST 4
+#define FLUID_MG_SMOOTHING 2
+#define FLUID_MG_COARSEST_ITERS 16
+
+typedef enum FieldType {
+    U_FIELD,
+    V_FIELD,
+    S_FIELD
+} FieldType;
+
+typedef enum FluidSolver {
+    FLUID_SOLVER_GAUSS_SEIDEL,
+    FLUID_SOLVER_RED_BLACK,
+    FLUID_SOLVER_PCG,
+    FLUID_SOLVER_MGPCG,
+    FLUID_SOLVER_COUNT
+} FluidSolver;
+
+typedef enum FluidAdvection {
+    FLUID_ADVECTION_SCALAR,
+    FLUID_ADVECTION_SSE2,
+    FLUID_ADVECTION_AVX2,
+    FLUID_ADVECTION_COUNT
+} FluidAdvection;
+
+// a level of the multigrid preconditioner, with a border of one cell
+// like the fluid
+typedef struct FluidLevel {
+    int numX;
+    int numY;
+    unsigned char *type;    // solid, fluid or fixed at 0
+    float *diag;            // open faces of the fluid cells, 0 on the others
+    float *x;
+    float *b;
+    float *r;
+} FluidLevel;
+
+// seconds spent in each part of the last step
+typedef struct FluidStepTimes {
+    double integration;
+    double projection;
+    double extrapolation;
+    double advection;
+    double transfer;            // particles to grid and back, in FLIP mode
+    double total;
+} FluidStepTimes;
+
+typedef struct Fluid {
+    float density;
+    int numX;
+    int numY;
+    int numCells;
+    float h;
+    float *u;
+    float *v;
+    float *newU;
+    float *newV;
+    float *p;
+    float *s;
+    float *m;
+    float *newM;
+    FluidSolver solver;
+    FluidPool *pool;            // red-black threads, not owned
+    FluidAdvection advection;   // kernel of advectVelocityFluid and advectSmokeFluid
+    // conjugate gradient: diagonal of A (0 for cells that are not
+    // solved), preconditioner, solution, residual, auxiliary and
+    // search vectors. The solution grows with the grid, so they are
+    // doubles, or A x could not be computed to the tolerance
+    float *diag;
+    double *precon;
+    double *x;
+    double *r;
+    double *z;
+    double *d;
+    // multigrid preconditioner, from the grid itself to the coarsest
+    FluidLevel *levels;
+    int numLevels;
+    // iterations done and greatest divergence left by the last
+    // projection of simulateFluid
+    int solverIters;
+    float residual;
+    FluidStepTimes times;
+} Fluid;
+
+/**
+ * @brief Creates a fluid of numX x numY cells, plus the border, of size
+ * h, at rest, filled with fluid and without smoke, solved serially
+ * with Gauss-Seidel and advected with the fastest kernel supported by
+ * the processor.
+ */
+Fluid* createFluid( float density, int numX, int numY, float h );
+void destroyFluid( Fluid *fluid );
+
+/**
+ * @brief Adds gravity to the vertical velocity of the fluid cells.
+ */
+void integrateFluid( Fluid *fluid, float dt, float gravity );
+
+/**
+ * @brief Makes the velocity divergence free with numIters iterations
+ * of Gauss-Seidel, over-relaxed by overRelaxation (in [1, 2)), or with
+ * the conjugate gradient solvers, that ignore both and iterate until
+ * FLUID_PCG_TOLERANCE or FLUID_PCG_MAX_ITERS, computing the pressure on
+ * the way. Returns the iterations done.
+ */
+int solveIncompressibilityFluid( Fluid *fluid, int numIters, float dt, float overRelaxation );
+
+/**
+ * @brief Copies the tangential velocities next to the border to it.
+ */
+void extrapolateFluid( Fluid *fluid );
+
+/**
+ * @brief Bilinear sample of a field at ( x, y ), in simulation units.
+ */
+float sampleFieldFluid( const Fluid *fluid, float x, float y, FieldType field );
+
+/**
+ * @brief Semi-Lagrangian advection of the velocity: each velocity
+ * component gets the velocity at the point it came from dt ago. The
+ * scalar kernel is the reference for the vectorized ones of
+ * FluidAdvection.h.
+ */
+void advectVelocityFluid( Fluid *fluid, float dt );
+
+/**
+ * @brief Semi-Lagrangian advection of the smoke.
+ */
+void advectSmokeFluid( Fluid *fluid, float dt );
+
+/**
+ * @brief Advances the fluid by dt, timing each part of the step.
+ */
+void simulateFluid( Fluid *fluid, float dt, float gravity, int numIters, float overRelaxation );
+
+/**
+ * @brief Greatest absolute divergence of the fluid cells, the residual
+ * of the projection.
+ */
+float getDivergenceFluid( const Fluid *fluid );
+
+/**
+ * @brief Solid bottom, top and left borders, inflow of inVelocity
+ * through the left border and a stream of smoke pipeHeight (a fraction
+ * of the height) high in the middle of it.
+ */
+void setupWindTunnelFluid( Fluid *fluid, float inVelocity, float pipeHeight );
+
+/**
+ * @brief Makes the cells inside the circle at ( x, y ) solid, with
+ * velocity ( vx, vy ), and all the other inner cells fluid.
+ */
+void setObstacleFluid( Fluid *fluid, float x, float y, float radius, float vx, float vy );
+
+const char *getNameFluidSolver( FluidSolver solver );
+
+/**
+ * @brief Monotonic wall clock seconds, that work with or without a
+ * window.
+ */
+double getTimeFluid( void );
@@ -0,0 +1,61 @@
+/**
+ * @file FluidAdvection.h
+ * @author Prof. Dr. David Buzatto
+ * @brief Vectorized advection kernels declarations.
+ *
+ * The semi-Lagrangian advection traces each velocity face and each
+ * smoke center back in time and samples the field there bilinearly.
+ * The vectorized kernels trace 4 (SSE2) or 8 (AVX2) cells of a column
+ * at once, gathering the four corners of each sample, with the same
+ * float operations in the same order as the scalar advection of
+ * Fluid.c, so the results only differ if the compiler reorders or
+ * fuses the scalar ones.
+ *
+ * The grid is walked in tiles of FLUID_ADVECTION_TILE cells of every
+ * column, so the columns around the one being traced (about 30 KiB of
+ * the five fields a velocity tile reads and writes) are still in the
+ * L1 cache when the next column needs them, what whole columns of a
+ * large grid would not be. Shorter tiles break the streams that the
+ * prefetcher follows and were slower.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <Fluid.h>
+
+#define FLUID_ADVECTION_TILE 512
+
+// greatest difference to the scalar kernel accepted by the benchmark
+#define FLUID_ADVECTION_TOLERANCE 1e-5f
+
+/**
+ * @brief Advects u and v into newU and newV with the given kernel, that
+ * must be supported by the processor. newU and newV must be copies of
+ * u and v, that are kept where there is nothing to advect.
+ */
+void advectVelocityFluidAdvection( FluidAdvection type, Fluid *fluid, float dt );
+
+/**
+ * @brief Advects m into newM, that must be a copy of m, with the given
+ * kernel.
+ */
+void advectSmokeFluidAdvection( FluidAdvection type, Fluid *fluid, float dt );
+
+bool isSupportedFluidAdvection( FluidAdvection type );
+
+/**
+ * @brief The fastest kernel supported by the processor.
+ */
+FluidAdvection getBestFluidAdvection( void );
+
+const char *getNameFluidAdvection( FluidAdvection type );
+
+/**
+ * @brief Advects developed wind tunnels of 128² to 1024² cells with
+ * every supported kernel, printing the time of each and its greatest
+ * difference to the scalar kernel. Returns false if any difference is
+ * greater than FLUID_ADVECTION_TOLERANCE.
+ */
+bool runFluidAdvectionBenchmark( void );
@@ -0,0 +1,27 @@
+/**
+ * @file FluidBenchmark.h
+ * @author Prof. Dr. David Buzatto
+ * @brief Headless benchmark of the fluid solver.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdbool.h>
+
+/**
+ * @brief Simulates a wind tunnel of 128², 256², 512² and 1024² cells
+ * with the serial Gauss-Seidel projection, with the red-black one on
+ * 1, 2, 4 and 8 threads (and N, if there are more processors) and with
+ * the two conjugate gradient ones, printing the steps per second, the
+ * projection time, the iterations and the residual of each, and how
+ * each projection converges next to Gauss-Seidel; the conjugate
+ * gradients report the iterations they took to reach the tolerance.
+ * Then simulates a 256² wind tunnel in FLIP/PIC mode with up to 2M
+ * particles on the same thread counts and runs the advection benchmark.
+ * Returns false if red-black gives different results on different
+ * thread counts or leaves more divergence than Gauss-Seidel, if a
+ * conjugate gradient solver does not converge or if an advection
+ * kernel does not match the scalar one.
+ */
+bool runFluidBenchmark( void );
@@ -0,0 +1,65 @@
+/**
+ * @file FluidPool.h
+ * @author Prof. Dr. David Buzatto
+ * @brief FluidPool struct and functions declarations.
+ *
+ * A fixed pool of threads that run the same task at once, each one over
+ * its own band of the grid, with a barrier to wait for each other
+ * between the phases of the task. The calling thread is worker 0.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <pthread.h>
+
+typedef struct FluidPool FluidPool;
+
+typedef void (*FluidPoolTask)( FluidPool *pool, int worker, void *data );
+
+struct FluidPool {
+
+    pthread_t *threads;
+    int threadCount;            // workers, with the calling thread
+
+    // guards everything below
+    pthread_mutex_t mutex;
+    pthread_cond_t workAvailable;
+    pthread_cond_t workFinished;
+    pthread_cond_t barrierReleased;
+
+    FluidPoolTask task;
+    void *data;
+    unsigned int generation;
+    int busyThreads;
+    bool running;
+
+    int barrierCount;
+    unsigned int barrierGeneration;
+
+};
+
+FluidPool* createFluidPool( int threadCount );
+void destroyFluidPool( FluidPool *pool );
+
+/**
+ * @brief Runs task on every worker and returns when all of them are done.
+ */
+void runFluidPool( FluidPool *pool, FluidPoolTask task, void *data );
+
+/**
+ * @brief Waits until every worker of the running task gets here.
+ */
+void syncFluidPool( FluidPool *pool );
+
+/**
+ * @brief Splits [ begin, end ) evenly between the workers, returning
+ * the band [ *from, *to ) of worker.
+ */
+void getBandFluidPool( const FluidPool *pool, int worker, int begin, int end, int *from, int *to );
+
+/**
+ * @brief Number of processors, used as the default thread count.
+ */
+int getProcessorCount( void );
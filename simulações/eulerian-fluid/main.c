@@ -19,11 +19,17 @@
  * Library headers.
  --------------------------------------------*/
 #include <raylib.h>
+#include <rlgl.h>
 
 /*---------------------------------------------
  * Project headers.
  --------------------------------------------*/
 #include <utils.h>
+#include <Fluid.h>
+#include <FluidAdvection.h>
+#include <FluidBenchmark.h>
+#include <FluidParticles.h>
+#include <FluidPool.h>
 
 /*---------------------------------------------
  * Macros. 
@@ -33,13 +39,90 @@
 /*--------------------------------------------
  * Constants. 
  -------------------------------------------*/
-
+const int SCREEN_WIDTH = 1000;
+const int SCREEN_HEIGHT = 600;
+
+// the domain is 1 unit high, inside a view 1.1 units high
+const float SIM_HEIGHT = 1.1f;
+const float DOMAIN_HEIGHT = 1.0f;
+const int RESOLUTION = 200;
+const float DENSITY = 1000.0f;
+const float TIME_STEP = 1.0f / 60.0f;
+const float GRAVITY = 0.0f;
+const int NUM_ITERS = 40;
+const float OVER_RELAXATION = 1.9f;
+const float IN_VELOCITY = 2.0f;
+const float PIPE_HEIGHT = 0.1f;
+const float OBSTACLE_RADIUS = 0.15f;
+const float OBSTACLE_X = 0.4f;
+const float OBSTACLE_Y = 0.5f;
+
+// weight of the last step in the times shown
+const double TIME_SMOOTHING = 0.1;
+
+// flip/pic mode, with the particles drawn as squares of PARTICLE_SIZE
+// pixels colored by their speed, up to PARTICLE_MAX_SPEED; 2^20
+// particles step at about 4.8 steps per second on a single core, so
+// this is not real time (see FluidParticles.h)
+const int PARTICLE_COUNT = 1 << 20;
+const float FLIP_RATIO = 0.9f;
+const float PARTICLE_SIZE = 1.5f;
+const float PARTICLE_MAX_SPEED = 4.0f;
+
+// each particle is an instance of two triangles, with its x, y, u and
+// v taken from the four blocks of the vertex buffer
+const char *PARTICLE_VERTEX_SHADER = 
+    "#version 330\n"
+    "in float particleX;\n"
+    "in float particleY;\n"
+    "in float particleU;\n"
+    "in float particleV;\n"
+    "uniform vec2 scale;\n"
+    "uniform vec2 size;\n"
+    "uniform float maxSpeed;\n"
+    "out vec3 color;\n"
+    "const vec2 corners[6] = vec2[6]( vec2( -0.5, -0.5 ), vec2( 0.5, -0.5 ), vec2( 0.5, 0.5 ),\n"
+    "                                 vec2( -0.5, -0.5 ), vec2( 0.5, 0.5 ), vec2( -0.5, 0.5 ) );\n"
+    "void main() {\n"
+    "    vec2 p = vec2( particleX, particleY ) * scale - 1.0 + corners[gl_VertexID] * size;\n"
+    "    gl_Position = vec4( p, 0.0, 1.0 );\n"
+    "    float t = clamp( length( vec2( particleU, particleV ) ) / maxSpeed, 0.0, 0.9999 ) * 4.0;\n"
+    "    float s = fract( t );\n"
+    "    color = t < 1.0 ? vec3( 0.0, s, 1.0 ) : t < 2.0 ? vec3( 0.0, 1.0, 1.0 - s ) :\n"
+    "            t < 3.0 ? vec3( s, 1.0, 0.0 ) : vec3( 1.0, 1.0 - s, 0.0 );\n"
+    "}\n";
+
+const char *PARTICLE_FRAGMENT_SHADER = 
+    "#version 330\n"
+    "in vec3 color;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    finalColor = vec4( color, 0.5 );\n"
+    "}\n";
 
 /*---------------------------------------------
  * Custom types (enums, structs, unions etc.)
  --------------------------------------------*/
 typedef struct GameWorld {
-    int dummy;
+    Fluid *fluid;
+    FluidPool *pool;
+    FluidSolver solver;
+    FluidAdvection advection;
+    FluidParticles *particles;  // NULL out of flip/pic mode
+    float dt;
+    float gravity;
+    int numIters;
+    float overRelaxation;
+    float obstacleX;
+    float obstacleY;
+    float obstacleRadius;
+    bool dragging;
+    bool paused;
+    bool showSmoke;
+    bool showPressure;
+    bool showParticles;
+    FluidStepTimes times;
+    int steps;
 } GameWorld;
 
 
@@ -48,6 +131,22 @@ typedef struct GameWorld {
  --------------------------------------------*/
 GameWorld gw;
 
+float simHeight;
+float cScale;
+float simWidth;
+
+// one pixel per cell, uploaded to the texture each frame
+Color *fieldPixels;
+Texture2D fieldTexture;
+
+// the particles, uploaded to the vertex buffer each frame
+Shader particleShader;
+unsigned int particleVao;
+unsigned int particleVbo;
+int particleScaleLoc;
+int particleSizeLoc;
+int particleMaxSpeedLoc;
+
 
 /*---------------------------------------------
  * Function prototypes. 
@@ -85,35 +184,36 @@ void loadResources( void );
  */
 void unloadResources( void );
 
+/**
+ * @brief Wind tunnel: fluid entering from the left at IN_VELOCITY, with
+ * a stream of smoke in the middle, around a circular obstacle.
+ */
+void setupWindTunnel( GameWorld *gw );
 
-float simHeight;
-float cScale;
-float simWidth;
-int cnt;
-
-typedef enum FieldType {
-    U_FIELD,
-    V_FIELD,
-    S_FIELD
-} FieldType;
-
-typedef struct Fluid {
-    float density;
-    int numX;
-    int numY;
-    int numCells;
-    int h;
-    float *u;
-    float *v;
-    float *newU;
-    float *newV;
-    float *p;
-    float *s;
-    float *m;
-    float *newM;
-} Fluid;
-
-Fluid fluid;
+/**
+ * @brief Moves the obstacle to ( x, y ), making its cells solid and
+ * giving them its velocity so it pushes the fluid when dragged.
+ */
+void setObstacle( GameWorld *gw, float x, float y, bool reset );
+
+/**
+ * @brief Colors the cells (smoke, pressure or both) into the pixels of
+ * the field texture and uploads them.
+ */
+void updateFieldTexture( const GameWorld *gw );
+
+/**
+ * @brief Uploads the particles and draws them, all in one draw call.
+ */
+void drawParticles( const GameWorld *gw );
+
+/**
+ * @brief Enters flip/pic mode, with particles spread over the fluid,
+ * or leaves it.
+ */
+void setParticles( GameWorld *gw, bool enabled );
+
+Color getSciColor( float value, float minValue, float maxValue );
 
 float cX( float x ) {
     return x * cScale;
@@ -123,27 +223,30 @@ float cY( float y ) {
     return GetScreenHeight() - y * cScale;
 }
 
-int main( void ) {
+int main( int argc, char **argv ) {
 
-    const int screenWidth = 400;
-    const int screenHeight = 400;
+    // headless benchmark of the solver
+    if ( argc > 1 && strcmp( argv[1], "--benchmark" ) == 0 ) {
+        return runFluidBenchmark() ? 0 : 1;
+    }
+
+    // headless benchmark of the advection kernels
+    if ( argc > 1 && strcmp( argv[1], "--advection-benchmark" ) == 0 ) {
+        return runFluidAdvectionBenchmark() ? 0 : 1;
+    }
 
     // turn antialiasing on (if possible)
     SetConfigFlags( FLAG_MSAA_4X_HINT );
-    InitWindow( screenWidth, screenHeight, "Window Title" );
+    InitWindow( SCREEN_WIDTH, SCREEN_HEIGHT, "Eulerian Fluid" );
     InitAudioDevice();
     SetTargetFPS( 60 );    
 
-    simHeight = 1.1;	
-	cScale = GetScreenHeight() / simHeight;
-	simWidth = GetScreenWidth() / cScale;
-    cnt = 0;
+    simHeight = SIM_HEIGHT;
+    cScale = GetScreenHeight() / simHeight;
+    simWidth = GetScreenWidth() / cScale;
 
-    fluid = (Fluid) {
-        
-    };
-    loadResources();
     createGameWorld();
+    loadResources();
     while ( !WindowShouldClose() ) {
         inputAndUpdate( &gw );
         draw( &gw );
@@ -159,15 +262,144 @@ int main( void ) {
 
 void inputAndUpdate( GameWorld *gw ) {
 
-}
+    Vector2 mouse = GetMousePosition();
+    float x = mouse.x / cScale;
+    float y = ( GetScreenHeight() - mouse.y ) / cScale;
+
+    if ( IsMouseButtonPressed( MOUSE_BUTTON_LEFT ) ) {
+        gw->dragging = true;
+        setObstacle( gw, x, y, true );
+    } else if ( IsMouseButtonReleased( MOUSE_BUTTON_LEFT ) ) {
+        gw->dragging = false;
+    } else if ( gw->dragging ) {
+        setObstacle( gw, x, y, false );
+    }
+
+    if ( IsKeyPressed( KEY_SPACE ) ) {
+        gw->paused = !gw->paused;
+    }
+
+    if ( IsKeyPressed( KEY_M ) ) {
+        gw->showSmoke = !gw->showSmoke;
+    }
+
+    if ( IsKeyPressed( KEY_P ) ) {
+        gw->showPressure = !gw->showPressure;
+    }
+
+    if ( IsKeyPressed( KEY_S ) ) {
+        gw->solver = ( gw->solver + 1 ) % FLUID_SOLVER_COUNT;
+        gw->fluid->solver = gw->solver;
+    }
+
+    // next kernel supported by the processor
+    if ( IsKeyPressed( KEY_A ) ) {
+        do {
+            gw->advection = ( gw->advection + 1 ) % FLUID_ADVECTION_COUNT;
+        } while ( !isSupportedFluidAdvection( gw->advection ) );
+        gw->fluid->advection = gw->advection;
+    }
+
+    if ( IsKeyPressed( KEY_F ) ) {
+        setParticles( gw, gw->particles == NULL );
+    }
+
+    if ( IsKeyPressed( KEY_V ) ) {
+        gw->showParticles = !gw->showParticles;
+    }
 
+    if ( IsKeyPressed( KEY_O ) ) {
+        gw->overRelaxation = gw->overRelaxation == 1.0f ? OVER_RELAXATION : 1.0f;
+    }
+
+    if ( IsKeyPressed( KEY_UP ) ) {
+        gw->numIters += 10;
+    } else if ( IsKeyPressed( KEY_DOWN ) && gw->numIters > 10 ) {
+        gw->numIters -= 10;
+    }
+
+    if ( IsKeyPressed( KEY_R ) ) {
+        setupWindTunnel( gw );
+    }
+
+    if ( !gw->paused || IsKeyPressed( KEY_RIGHT ) ) {
+
+        if ( gw->particles != NULL ) {
+            simulateFluidParticles( gw->particles, gw->fluid, gw->dt, gw->gravity, gw->numIters, gw->overRelaxation );
+        } else {
+            simulateFluid( gw->fluid, gw->dt, gw->gravity, gw->numIters, gw->overRelaxation );
+        }
+
+        // smoothed, so the readout is steady
+        const FluidStepTimes *t = &gw->fluid->times;
+        double k = gw->steps == 0 ? 1.0 : TIME_SMOOTHING;
+        gw->times.integration += k * ( t->integration - gw->times.integration );
+        gw->times.projection += k * ( t->projection - gw->times.projection );
+        gw->times.extrapolation += k * ( t->extrapolation - gw->times.extrapolation );
+        gw->times.advection += k * ( t->advection - gw->times.advection );
+        gw->times.transfer += k * ( t->transfer - gw->times.transfer );
+        gw->times.total += k * ( t->total - gw->times.total );
+        gw->steps++;
+
+    }
+
+}
 
 void draw( const GameWorld *gw ) {
 
     BeginDrawing();
     ClearBackground( WHITE );
 
-    
+    const Fluid *f = gw->fluid;
+
+    updateFieldTexture( gw );
+
+    // the texture has the bottom row of cells first
+    DrawTexturePro( 
+        fieldTexture, 
+        (Rectangle) { 0, 0, f->numX, -f->numY }, 
+        (Rectangle) { 0, cY( f->numY * f->h ), cX( f->numX * f->h ), f->numY * f->h * cScale }, 
+        (Vector2) { 0 }, 0, WHITE );
+
+    if ( gw->particles != NULL && gw->showParticles ) {
+        drawParticles( gw );
+    }
+
+    float r = gw->obstacleRadius + f->h;
+    DrawCircle( cX( gw->obstacleX ), cY( gw->obstacleY ), cScale * r, gw->showPressure ? BLACK : LIGHTGRAY );
+    DrawCircleLines( cX( gw->obstacleX ), cY( gw->obstacleY ), cScale * r, BLACK );
+
+    // the conjugate gradient solvers iterate until the tolerance, not
+    // up to the iterations set with the arrows
+    if ( gw->solver == FLUID_SOLVER_PCG || gw->solver == FLUID_SOLVER_MGPCG ) {
+        DrawText( 
+            TextFormat( "%dx%d cells, %s, %d iterations to %.0e, residual %.1e%s", 
+                        f->numX - 2, f->numY - 2, getNameFluidSolver( gw->solver ), 
+                        f->solverIters, FLUID_PCG_TOLERANCE, f->residual, gw->paused ? " (paused)" : "" ), 
+            10, 8, 20, BLACK );
+    } else {
+        DrawText( 
+            TextFormat( "%dx%d cells, %s (%d threads), %d/%d iterations, residual %.1e, over-relaxation %.1f%s", 
+                        f->numX - 2, f->numY - 2, getNameFluidSolver( gw->solver ), 
+                        gw->solver == FLUID_SOLVER_RED_BLACK ? gw->pool->threadCount : 1, 
+                        f->solverIters, gw->numIters, f->residual, gw->overRelaxation, gw->paused ? " (paused)" : "" ), 
+            10, 8, 20, BLACK );
+    }
+    DrawText( 
+        TextFormat( "step: %.2f ms (projection %.2f, advection %.2f %s, other %.2f)", 
+                    gw->times.total * 1000, gw->times.projection * 1000, 
+                    gw->times.advection * 1000, getNameFluidAdvection( gw->advection ), 
+                    ( gw->times.integration + gw->times.extrapolation ) * 1000 ), 
+        10, 30, 20, BLACK );
+
+    if ( gw->particles != NULL ) {
+        DrawText( 
+            TextFormat( "flip/pic: %d particles, flip ratio %.2f, transfer %.2f ms", 
+                        gw->particles->count, gw->particles->flipRatio, gw->times.transfer * 1000 ), 
+            10, 52, 20, BLACK );
+    }
+
+    DrawFPS( GetScreenWidth() - 90, 10 );
 
     EndDrawing();
 
@@ -178,19 +410,238 @@ void createGameWorld( void ) {
     printf( "creating game world...\n" );
 
     gw = (GameWorld) {
-        .dummy = 0
+        .fluid = NULL,
+        .pool = createFluidPool( getProcessorCount() ),
+        .solver = FLUID_SOLVER_RED_BLACK,
+        .advection = getBestFluidAdvection(),
+        .particles = NULL,
+        .dt = TIME_STEP,
+        .gravity = GRAVITY,
+        .numIters = NUM_ITERS,
+        .overRelaxation = OVER_RELAXATION,
+        .obstacleRadius = OBSTACLE_RADIUS,
+        .dragging = false,
+        .paused = false,
+        .showSmoke = true,
+        .showPressure = false,
+        .showParticles = true,
+        .times = {0},
+        .steps = 0
     };
 
+    setupWindTunnel( &gw );
+
 }
 
 void destroyGameWorld( void ) {
     printf( "destroying game world...\n" );
+    setParticles( &gw, false );
+    destroyFluid( gw.fluid );
+    destroyFluidPool( gw.pool );
 }
 
 void loadResources( void ) {
+
     printf( "loading resources...\n" );
+
+    Image image = GenImageColor( gw.fluid->numX, gw.fluid->numY, BLACK );
+    fieldTexture = LoadTextureFromImage( image );
+    UnloadImage( image );
+
+    fieldPixels = (Color*) malloc( gw.fluid->numCells * sizeof( Color ) );
+
+    particleShader = LoadShaderFromMemory( PARTICLE_VERTEX_SHADER, PARTICLE_FRAGMENT_SHADER );
+    particleScaleLoc = GetShaderLocation( particleShader, "scale" );
+    particleSizeLoc = GetShaderLocation( particleShader, "size" );
+    particleMaxSpeedLoc = GetShaderLocation( particleShader, "maxSpeed" );
+
+    // x, y, u and v of all the particles, one block after the other,
+    // each one a per instance attribute
+    const char *attributes[4] = { "particleX", "particleY", "particleU", "particleV" };
+    size_t block = PARTICLE_COUNT * sizeof( float );
+
+    particleVao = rlLoadVertexArray();
+    rlEnableVertexArray( particleVao );
+    particleVbo = rlLoadVertexBuffer( NULL, 4 * block, true );
+
+    for ( int k = 0; k < 4; k++ ) {
+        int loc = GetShaderLocationAttrib( particleShader, attributes[k] );
+        if ( loc >= 0 ) {
+            rlSetVertexAttribute( loc, 1, RL_FLOAT, false, 0, (const void*) ( k * block ) );
+            rlSetVertexAttributeDivisor( loc, 1 );
+            rlEnableVertexAttribute( loc );
+        }
+    }
+
+    rlDisableVertexArray();
+
 }
 
 void unloadResources( void ) {
     printf( "unloading resources...\n" );
-}
\ No newline at end of file
+    UnloadTexture( fieldTexture );
+    free( fieldPixels );
+    UnloadShader( particleShader );
+    rlUnloadVertexArray( particleVao );
+    rlUnloadVertexBuffer( particleVbo );
+}
+
+void setupWindTunnel( GameWorld *gw ) {
+
+    float domainWidth = DOMAIN_HEIGHT / simHeight * simWidth;
+    float h = DOMAIN_HEIGHT / RESOLUTION;
+    int numX = (int) floorf( domainWidth / h );
+    int numY = (int) floorf( DOMAIN_HEIGHT / h );
+
+    if ( gw->fluid != NULL ) {
+        destroyFluid( gw->fluid );
+    }
+
+    gw->fluid = createFluid( DENSITY, numX, numY, h );
+    gw->fluid->solver = gw->solver;
+    gw->fluid->advection = gw->advection;
+    gw->fluid->pool = gw->pool;
+
+    setupWindTunnelFluid( gw->fluid, IN_VELOCITY, PIPE_HEIGHT );
+    setObstacle( gw, OBSTACLE_X, OBSTACLE_Y, true );
+
+    // spread again over the new fluid
+    if ( gw->particles != NULL ) {
+        setParticles( gw, false );
+        setParticles( gw, true );
+    }
+
+}
+
+void setObstacle( GameWorld *gw, float x, float y, bool reset ) {
+
+    float vx = 0.0f;
+    float vy = 0.0f;
+
+    if ( !reset ) {
+        vx = ( x - gw->obstacleX ) / gw->dt;
+        vy = ( y - gw->obstacleY ) / gw->dt;
+    }
+
+    gw->obstacleX = x;
+    gw->obstacleY = y;
+
+    setObstacleFluid( gw->fluid, x, y, gw->obstacleRadius, vx, vy );
+
+}
+
+void updateFieldTexture( const GameWorld *gw ) {
+
+    const Fluid *f = gw->fluid;
+    int n = f->numY;
+
+    float minP = f->p[0];
+    float maxP = f->p[0];
+
+    if ( gw->showPressure ) {
+        for ( int i = 0; i < f->numCells; i++ ) {
+            minP = fminf( minP, f->p[i] );
+            maxP = fmaxf( maxP, f->p[i] );
+        }
+    }
+
+    // the texture is row major, one row for each j
+    for ( int i = 0; i < f->numX; i++ ) {
+        for ( int j = 0; j < f->numY; j++ ) {
+
+            Color color;
+            float smoke = f->m[i*n+j];
+
+            if ( gw->showPressure ) {
+                color = getSciColor( f->p[i*n+j], minP, maxP );
+                if ( gw->showSmoke ) {
+                    color.r = (unsigned char) fmaxf( 0.0f, color.r - 255 * smoke );
+                    color.g = (unsigned char) fmaxf( 0.0f, color.g - 255 * smoke );
+                    color.b = (unsigned char) fmaxf( 0.0f, color.b - 255 * smoke );
+                }
+            } else if ( gw->showSmoke ) {
+                unsigned char c = (unsigned char) ( 255 * fminf( fmaxf( smoke, 0.0f ), 1.0f ) );
+                color = (Color) { c, c, c, 255 };
+            } else {
+                color = WHITE;
+            }
+
+            if ( f->s[i*n+j] == 0.0f ) {
+                color = BLACK;
+            }
+
+            fieldPixels[j*f->numX+i] = color;
+
+        }
+    }
+
+    UpdateTexture( fieldTexture, fieldPixels );
+
+}
+
+void drawParticles( const GameWorld *gw ) {
+
+    const FluidParticles *p = gw->particles;
+
+    // what raylib has batched so far goes below the particles
+    rlDrawRenderBatchActive();
+
+    rlUpdateVertexBuffer( particleVbo, p->x, 4 * p->count * sizeof( float ), 0 );
+
+    // from the simulation to clip coordinates, both with y up
+    float w = GetScreenWidth();
+    float h = GetScreenHeight();
+    float scale[2] = { 2.0f * cScale / w, 2.0f * cScale / h };
+    float size[2] = { 2.0f * PARTICLE_SIZE / w, 2.0f * PARTICLE_SIZE / h };
+    SetShaderValue( particleShader, particleScaleLoc, scale, SHADER_UNIFORM_VEC2 );
+    SetShaderValue( particleShader, particleSizeLoc, size, SHADER_UNIFORM_VEC2 );
+    SetShaderValue( particleShader, particleMaxSpeedLoc, &PARTICLE_MAX_SPEED, SHADER_UNIFORM_FLOAT );
+
+    rlEnableShader( particleShader.id );
+    rlEnableVertexArray( particleVao );
+    rlDrawVertexArrayInstanced( 0, 6, p->count );
+    rlDisableVertexArray();
+    rlDisableShader();
+
+}
+
+void setParticles( GameWorld *gw, bool enabled ) {
+
+    if ( gw->particles != NULL ) {
+        destroyFluidParticles( gw->particles );
+        gw->particles = NULL;
+    }
+
+    if ( enabled ) {
+        gw->particles = createFluidParticles( gw->fluid, PARTICLE_COUNT, FLIP_RATIO );
+    }
+
+}
+
+/**
+ * @brief Blue, cyan, green, yellow and red scale of value between
+ * minValue and maxValue.
+ */
+Color getSciColor( float value, float minValue, float maxValue ) {
+
+    value = fminf( fmaxf( value, minValue ), maxValue - 0.0001f );
+    float d = maxValue - minValue;
+    value = d == 0.0f ? 0.5f : ( value - minValue ) / d;
+
+    float m = 0.25f;
+    int num = (int) floorf( value / m );
+    float s = ( value - num * m ) / m;
+    float r = 0.0f;
+    float g = 0.0f;
+    float b = 0.0f;
+
+    switch ( num ) {
+        case 0: r = 0.0f; g = s;        b = 1.0f;     break;
+        case 1: r = 0.0f; g = 1.0f;     b = 1.0f - s; break;
+        case 2: r = s;    g = 1.0f;     b = 0.0f;     break;
+        case 3: r = 1.0f; g = 1.0f - s; b = 0.0f;     break;
+    }
+
+    return (Color) { 255 * r, 255 * g, 255 * b, 255 };
+
+}
@@ -8,6 +8,7 @@
 #include <GameWorld.h>
 
 #include <iostream>
+#include <chrono>
 #include <fmt/format.h>
 #include <cmath>
 #include <string>
@@ -16,9 +17,16 @@
 #include <cassert>
 #include <algorithm>
 #include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
 #include <raylib.h>
 
 #include <GameState.h>
+#include <HashLife.h>
+#include <LifeBoard.h>
+#include <LifePattern.h>
+#include <SparseLife.h>
 
 /**
  * @brief Construct a new GameWorld object
@@ -26,48 +34,44 @@
 GameWorld::GameWorld() : 
         minCellWidth( 1 ),
         boardWidth( 960 ),
+        lines( boardWidth / minCellWidth ),
+        columns( lines ),
+        runner( std::make_unique<SparseLife>() ),
+        snapshot( nullptr ),
+        engineName( "sparse" ),
+        maxStepExponent( 0 ),
+        stepExponent( 0 ),
+        cellsTexture {},
+        uploadedSnapshot( 0 ),
+        gridTexture {},
+        gridCellWidth( 0 ),
+        viewLine( lines / 2 ),
+        viewColumn( columns / 2 ),
+        dragRemainder { 0, 0 },
         state( GameState::IDLE ) {
 
     loadResources();
     std::cout << "creating game world..." << std::endl;
 
-    lines = boardWidth / minCellWidth;
-    columns = lines;
-
     cellWidth = allowedCellWidths[currentZoom];
+    cellsPerPixel = 1;
     
-    evolutionArraySize = columns * lines;
-    evolutionArray = new int[evolutionArraySize];
-    resetArray = new int[evolutionArraySize];
-    newGeneration = new int[evolutionArraySize];
-
     drawGrid = true;
 
-    currentTime = 0;
-    timeToWait = 0.3;
-
-    std::fill_n( evolutionArray, evolutionArraySize, 0 );
-
-    evolutionArray[454554] = 1;
-    evolutionArray[455513] = 1;
-    evolutionArray[456473] = 1;
-    evolutionArray[456474] = 1;
-    evolutionArray[456475] = 1;
-    evolutionArray[455525] = 1;
-    evolutionArray[454564] = 1;
-    evolutionArray[454563] = 1;
-    evolutionArray[455523] = 1;
-    evolutionArray[456483] = 1;
-    evolutionArray[466084] = 1;
-    evolutionArray[465125] = 1;
-    evolutionArray[464165] = 1;
-    evolutionArray[464164] = 1;
-    evolutionArray[464163] = 1;
-    evolutionArray[465113] = 1;
-    evolutionArray[466074] = 1;
-    evolutionArray[466075] = 1;
-    evolutionArray[465115] = 1;
-    evolutionArray[464155] = 1;
+    currentRate = 3;
+    maxSpeed = false;
+    runner.setTargetRate( targetRates[currentRate] );
+
+    // four gliders, at the center of the screen
+    const char seed[] = 
+        "x = 13, y = 13, rule = B3/S23\n"
+        "bo8b2o$o9bobo$3o7bo8$2bo7b3o$obo9bo$b2o8bo!\n";
+
+    auto lock = runner.lockEngine();
+    std::string error;
+    decodeLifePattern( seed, sizeof( seed ) - 1, runner.getEngine(), viewLine, viewColumn, error );
+    engineName = runner.getEngine().getName();
+    maxStepExponent = runner.getEngine().getMaxStepExponent();
 
 }
 
@@ -77,8 +81,6 @@ GameWorld::GameWorld() :
 GameWorld::~GameWorld() {
     unloadResources();
     std::cout << "destroying game world..." << std::endl;
-    delete[] evolutionArray;
-    delete[] newGeneration;
 }
 
 /**
@@ -94,72 +96,100 @@ void GameWorld::inputAndUpdate() {
         }
     } else if ( mw < 0 ) {
         currentZoom--;
-        if ( currentZoom < 0 ) {
-            currentZoom = 0;
+        if ( currentZoom < MIN_ZOOM ) {
+            currentZoom = MIN_ZOOM;
         }
     }
-    cellWidth = allowedCellWidths[currentZoom];
+    cellWidth = currentZoom >= 0 ? allowedCellWidths[currentZoom] : 1;
+    int shift = currentZoom >= 0 ? 0 : -currentZoom;
+    cellsPerPixel = 1 << shift;
+
+    pan();
 
-    startLine = (lines / 2) - (boardWidth / cellWidth / 2);
-    endLine = startLine + (boardWidth / cellWidth);
-    startColumn = (columns / 2) - (boardWidth / cellWidth / 2);
-    endColumn = startColumn + (boardWidth / cellWidth);
+    // aligned to the squares of cells of a pixel, so each square always
+    // has the same cells
+    int squares = boardWidth / cellWidth;
+    startLine = ( ( viewLine >> shift ) - squares / 2 ) << shift;
+    endLine = startLine + ( static_cast<long long>( squares ) << shift );
+    startColumn = ( ( viewColumn >> shift ) - squares / 2 ) << shift;
+    endColumn = startColumn + ( static_cast<long long>( squares ) << shift );
 
     if ( IsKeyPressed( KEY_UP ) ) {
-        timeToWait += 0.05;
-        if ( timeToWait > 2.0 ) {
-            timeToWait = 2.0;
-        }
+        currentRate = std::min( currentRate + 1, RATE_COUNT - 1 );
+        runner.setTargetRate( targetRates[currentRate] );
     } else if ( IsKeyPressed( KEY_DOWN ) ) {
-        timeToWait -= 0.05;
-        if ( timeToWait < 0.05 ) {
-            timeToWait = 0.05;
-        }
+        currentRate = std::max( currentRate - 1, 0 );
+        runner.setTargetRate( targetRates[currentRate] );
     }
 
-    if ( state == GameState::RUNNING && currentTime >= timeToWait ) {
-        createNewGeneration();
-        currentTime = 0;
-    } else {
-        currentTime += GetFrameTime();
+    if ( IsKeyPressed( KEY_M ) ) {
+        maxSpeed = !maxSpeed;
+        runner.setMaxSpeed( maxSpeed );
+    }
+
+    if ( IsKeyPressed( KEY_RIGHT ) ) {
+        stepExponent = std::min( stepExponent + 1, maxStepExponent );
+        runner.setStepExponent( stepExponent );
+    } else if ( IsKeyPressed( KEY_LEFT ) ) {
+        stepExponent = std::max( stepExponent - 1, 0 );
+        runner.setStepExponent( stepExponent );
+    }
+
+    if ( IsKeyPressed( KEY_H ) ) {
+        switchEngine();
     }
 
     if ( IsMouseButtonDown( MOUSE_BUTTON_LEFT ) && state != GameState::RUNNING ) {
-        int line = GetMouseY() / cellWidth + startLine;
-        int column = GetMouseX() / cellWidth + startColumn;
-        if ( evolutionArray[line*columns + column] == 0 ) {
-            evolutionArray[line*columns + column] = 1;
-            //std::cout << "added: " << line*columns+column << std::endl;
-        }
+        setCell( true );
     } else if ( IsMouseButtonDown( MOUSE_BUTTON_RIGHT ) && state != GameState::RUNNING ) {
-        int line = GetMouseY() / cellWidth + startLine;
-        int column = GetMouseX() / cellWidth + startColumn;
-        if ( evolutionArray[line*columns + column] == 1 ) {
-            evolutionArray[line*columns + column] = 0;
-            //std::cout << "removed: " << line*columns+column << std::endl;
-        }
+        setCell( false );
     }
 
     if ( IsKeyPressed( KEY_R ) && state != GameState::IDLE ) {
-        std::copy( resetArray, resetArray+evolutionArraySize, evolutionArray );
+        runner.setRunning( false );
+        {
+            auto lock = runner.lockEngine();
+            runner.getEngine().restore();
+        }
+        runner.requestSnapshot();
         state = GameState::IDLE;
     }
 
     if ( IsKeyPressed( KEY_SPACE ) ) {
         if ( state == GameState::IDLE ) {
-            std::copy( evolutionArray, evolutionArray+evolutionArraySize, resetArray );
+            {
+                auto lock = runner.lockEngine();
+                runner.getEngine().save();
+            }
             state = GameState::RUNNING;
         } else if ( state == GameState::RUNNING ) {
             state = GameState::PAUSED;
         } else if ( state == GameState::PAUSED ) {
             state = GameState::RUNNING;
         }
+        runner.setRunning( state == GameState::RUNNING );
     }
 
     if ( IsKeyPressed( KEY_G ) ) {
         drawGrid = !drawGrid;
     }
 
+    if ( IsFileDropped() ) {
+        FilePathList files = LoadDroppedFiles();
+        if ( files.count > 0 ) {
+            loadPattern( files.paths[0] );
+        }
+        UnloadDroppedFiles( files );
+    }
+
+    if ( IsKeyPressed( KEY_E ) ) {
+        savePattern();
+    }
+
+    runner.setViewport( startLine, startColumn, squares, squares, cellsPerPixel );
+    snapshot = &runner.acquireSnapshot();
+    updateTextures();
+
 }
 
 /**
@@ -170,36 +200,44 @@ void GameWorld::draw() const {
     BeginDrawing();
     ClearBackground( WHITE );
 
-    for ( int i = startLine; i < endLine; i++ ) {
-        for ( int j = startColumn; j <= endColumn; j++ ) {
-            if ( evolutionArray[i*columns + j] ) {
-                DrawRectangle( 
-                    j * cellWidth - startColumn * cellWidth, 
-                    i * cellWidth - startLine * cellWidth, 
-                    cellWidth, cellWidth, BLACK );
-            }
-        }
+    // one texture for the cells and one for the grid, whatever the
+    // population; the snapshot may still be of the last viewport, just
+    // after a pan or a zoom
+    if ( cellsTexture.id != 0 ) {
+        float pixelsPerCell = static_cast<float>( cellWidth ) / cellsPerPixel;
+        Rectangle source { 0, 0, 
+            static_cast<float>( cellsTexture.width ), 
+            static_cast<float>( cellsTexture.height ) };
+        Rectangle dest { 
+            ( snapshot->column - startColumn ) * pixelsPerCell,
+            ( snapshot->line - startLine ) * pixelsPerCell,
+            snapshot->columns * snapshot->cellsPerPixel * pixelsPerCell,
+            snapshot->lines * snapshot->cellsPerPixel * pixelsPerCell };
+        DrawTexturePro( cellsTexture, source, dest, Vector2 { 0, 0 }, 0, WHITE );
     }
 
-    if ( drawGrid ) {
-        for ( int i = 1; i < endLine - startLine; i++ ) {
-            if ( i % 10 == 0 ) {
-                DrawLine( 0, i * cellWidth, GetScreenWidth(), i * cellWidth, BLACK );
-            } else {
-                DrawLine( 0, i * cellWidth, GetScreenWidth(), i * cellWidth, GRAY );
-            }
-        }
-
-        for ( int i = 1; i < endColumn - startColumn; i++ ) {
-            if ( i % 10 == 0 ) {
-                DrawLine( i * cellWidth, 0, i * cellWidth, GetScreenHeight(), BLACK );
-            } else {
-                DrawLine( i * cellWidth, 0, i * cellWidth, GetScreenHeight(), GRAY );
-            }
-        }
+    if ( drawGrid && cellsPerPixel == 1 && cellWidth >= MIN_GRID_CELL_WIDTH && gridTexture.id != 0 ) {
+        // the tile starts at the lines and columns multiple of 10
+        Rectangle source {
+            static_cast<float>( ( startColumn % 10 + 10 ) % 10 * cellWidth ),
+            static_cast<float>( ( startLine % 10 + 10 ) % 10 * cellWidth ),
+            static_cast<float>( GetScreenWidth() ),
+            static_cast<float>( GetScreenHeight() ) };
+        DrawTextureRec( gridTexture, source, Vector2 { 0, 0 }, WHITE );
     }
 
-    DrawText( TextFormat( "%.2f segundos para a próxima geração.", timeToWait ), 20, 20, 20, BLUE );
+    if ( maxSpeed ) {
+        DrawText( "velocidade máxima.", 20, 20, 20, BLUE );
+    } else {
+        DrawText( TextFormat( "%.0f passos por segundo.", targetRates[currentRate] ), 20, 20, 20, BLUE );
+    }
+    DrawText( TextFormat( "%s: geração %lld, população %lld, 2^%d gerações por passo.",
+                          engineName, snapshot->generation, 
+                          snapshot->population, stepExponent ), 20, 45, 20, BLUE );
+    DrawText( TextFormat( "centro: linha %lld, coluna %lld.", viewLine, viewColumn ), 20, 70, 20, BLUE );
+    DrawText( TextFormat( "%.0f gerações/s, %.0f passos não exibidos/s.", 
+                          runner.getGenerationsPerSecond(), runner.getSkippedPerSecond() ), 20, 95, 20, BLUE );
+    DrawText( message.c_str(), 20, 120, 20, BLUE );
 
     EndDrawing();
 
@@ -209,53 +247,217 @@ int GameWorld::getBoardWidth() const {
     return boardWidth;
 }
 
-void GameWorld::createNewGeneration() {
-
-    for ( int i = 0; i < lines; i++ ) {
-        for ( int j = 0; j < columns; j++ ) {
-            int p = i*columns+j;
-            int n = countNeighbors( i, j );
-            if ( evolutionArray[p] ) {
-                if ( n <= 1 || n >= 4 ) {
-                    newGeneration[p] = 0;
-                } else {
-                    newGeneration[p] = 1;
-                }
-            } else {
-                if ( n == 3 ) {
-                    newGeneration[p] = 1;
-                } else {
-                    newGeneration[p] = 0;
+/**
+ * @brief Sets the cell under the mouse.
+ */
+void GameWorld::setCell( bool alive ) {
+
+    long long line = startLine + static_cast<long long>( GetMouseY() / cellWidth ) * cellsPerPixel;
+    long long column = startColumn + static_cast<long long>( GetMouseX() / cellWidth ) * cellsPerPixel;
+
+    auto lock = runner.lockEngine();
+    if ( runner.getEngine().get( line, column ) != alive ) {
+        runner.getEngine().set( line, column, alive );
+        lock.unlock();
+        runner.requestSnapshot();
+    }
+
+}
+
+/**
+ * @brief Copies the live cells to the next engine (sparse, packed,
+ * HashLife), that keeps going from there. Only the cells in a square
+ * of MAX_SWITCH_SIZE around the center of the screen are copied, and
+ * the packed board keeps only the ones inside it.
+ */
+void GameWorld::switchEngine() {
+
+    runner.setRunning( false );
+    state = GameState::IDLE;
+
+    {
+        auto lock = runner.lockEngine();
+        LifeEngine &engine = runner.getEngine();
+
+        long long top, left, bottom, right;
+        bool found = engine.getBounds( top, left, bottom, right );
+
+        top = std::max( top, viewLine - MAX_SWITCH_SIZE / 2 );
+        bottom = std::min( bottom, viewLine + MAX_SWITCH_SIZE / 2 - 1 );
+        left = std::max( left, viewColumn - MAX_SWITCH_SIZE / 2 );
+        right = std::min( right, viewColumn + MAX_SWITCH_SIZE / 2 - 1 );
+
+        std::vector<unsigned char> cells;
+        int copyLines = found && top <= bottom ? static_cast<int>( bottom - top + 1 ) : 0;
+        int copyColumns = found && left <= right ? static_cast<int>( right - left + 1 ) : 0;
+        if ( copyLines > 0 && copyColumns > 0 ) {
+            engine.getRegion( top, left, copyLines, copyColumns, cells );
+        }
+
+        std::unique_ptr<LifeEngine> next;
+        if ( dynamic_cast<SparseLife*>( &engine ) != nullptr ) {
+            next = std::make_unique<LifeBoard>( lines, columns );
+        } else if ( dynamic_cast<LifeBoard*>( &engine ) != nullptr ) {
+            next = std::make_unique<HashLife>();
+        } else {
+            next = std::make_unique<SparseLife>();
+        }
+
+        for ( int i = 0; i < copyLines; i++ ) {
+            for ( int j = 0; j < copyColumns; j++ ) {
+                if ( cells[i*copyColumns+j] ) {
+                    next->set( top + i, left + j, true );
                 }
             }
         }
+
+        engineName = next->getName();
+        maxStepExponent = next->getMaxStepExponent();
+        runner.setEngine( std::move( next ) );
+    }
+
+    stepExponent = std::min( stepExponent, maxStepExponent );
+    runner.setStepExponent( stepExponent );
+    runner.requestSnapshot();
+
+}
+
+/**
+ * @brief Loads an RLE or Life 1.06 file, dropped on the window, in
+ * place of the cells, centered on the screen.
+ */
+void GameWorld::loadPattern( const char *path ) {
+
+    runner.setRunning( false );
+    state = GameState::IDLE;
+
+    {
+        auto lock = runner.lockEngine();
+        LifeEngine &engine = runner.getEngine();
+        engine.clear();
+
+        std::string error;
+        auto start = std::chrono::steady_clock::now();
+        bool loaded = loadLifePattern( path, engine, viewLine, viewColumn, error );
+        double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+        if ( loaded ) {
+            message = TextFormat( "%s: %lld células em %.2f segundos.", 
+                                  GetFileName( path ), engine.getPopulation(), seconds );
+        } else {
+            message = error;
+        }
     }
 
-    std::copy( newGeneration, newGeneration+evolutionArraySize, evolutionArray );
+    std::cout << message << std::endl;
+    runner.requestSnapshot();
 
 }
 
-int GameWorld::countNeighbors( int line, int column ) {
+/**
+ * @brief Saves the cells, with E, in export.rle and export.lif.
+ */
+void GameWorld::savePattern() {
+
+    auto lock = runner.lockEngine();
+    std::string error;
+
+    if ( saveLifePatternRle( "export.rle", runner.getEngine(), error ) &&
+         saveLifePattern106( "export.lif", runner.getEngine(), error ) ) {
+        message = "células salvas em export.rle e export.lif.";
+    } else {
+        message = error;
+    }
+
+    std::cout << message << std::endl;
+
+}
+
+/**
+ * @brief Uploads a new snapshot, black for the live cells and gray for
+ * the squares that are partly alive, and makes the tile of the grid
+ * when the cell width changes.
+ */
+void GameWorld::updateTextures() {
+
+    if ( snapshot->number != uploadedSnapshot && snapshot->lines > 0 && snapshot->columns > 0 ) {
 
-    int count = 0;
+        uploadedSnapshot = snapshot->number;
+        pixels.resize( snapshot->density.size() );
+        for ( size_t i = 0; i < pixels.size(); i++ ) {
+            pixels[i] = 255 - snapshot->density[i];
+        }
 
-    for ( int i = line-1; i < line + 2; i++ ) {
-        for ( int j = column-1; j < column + 2; j++ ) {
-            if ( i >= 0 &&
-                 i < lines && 
-                 j >= 0 &&
-                 j < columns &&
-                 evolutionArray[i*columns+j] ) {
-                count++;
+        if ( cellsTexture.width != snapshot->columns || cellsTexture.height != snapshot->lines ) {
+            if ( cellsTexture.id != 0 ) {
+                UnloadTexture( cellsTexture );
             }
+            Image image { pixels.data(), snapshot->columns, snapshot->lines, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE };
+            cellsTexture = LoadTextureFromImage( image );
+        } else {
+            UpdateTexture( cellsTexture, pixels.data() );
+        }
+
+    }
+
+    if ( cellWidth >= MIN_GRID_CELL_WIDTH && gridCellWidth != cellWidth ) {
+
+        if ( gridTexture.id != 0 ) {
+            UnloadTexture( gridTexture );
+        }
+
+        int size = 10 * cellWidth;
+        Image image = GenImageColor( size, size, BLANK );
+        for ( int i = 1; i < 10; i++ ) {
+            ImageDrawRectangle( &image, i * cellWidth, 0, 1, size, GRAY );
+            ImageDrawRectangle( &image, 0, i * cellWidth, size, 1, GRAY );
         }
+        ImageDrawRectangle( &image, 0, 0, 1, size, BLACK );
+        ImageDrawRectangle( &image, 0, 0, size, 1, BLACK );
+
+        gridTexture = LoadTextureFromImage( image );
+        SetTextureWrap( gridTexture, TEXTURE_WRAP_REPEAT );
+        UnloadImage( image );
+        gridCellWidth = cellWidth;
+
+    }
+
+}
+
+/**
+ * @brief Moves the view with WASD, a sixtieth of the screen per frame,
+ * or by dragging with the middle button.
+ */
+void GameWorld::pan() {
+
+    long long speed = std::max( 1, boardWidth / cellWidth / 60 ) * static_cast<long long>( cellsPerPixel );
+
+    if ( IsKeyDown( KEY_W ) ) {
+        viewLine -= speed;
+    } else if ( IsKeyDown( KEY_S ) ) {
+        viewLine += speed;
     }
 
-    if ( evolutionArray[line*columns+column] ) {
-        count--;
+    if ( IsKeyDown( KEY_A ) ) {
+        viewColumn -= speed;
+    } else if ( IsKeyDown( KEY_D ) ) {
+        viewColumn += speed;
     }
 
-    return count;
+    // the pixels dragged that do not make a whole cell yet
+    if ( IsMouseButtonDown( MOUSE_BUTTON_MIDDLE ) ) {
+        Vector2 delta = GetMouseDelta();
+        dragRemainder.x += delta.x;
+        dragRemainder.y += delta.y;
+        long long draggedLines = static_cast<long long>( dragRemainder.y / cellWidth );
+        long long draggedColumns = static_cast<long long>( dragRemainder.x / cellWidth );
+        viewLine -= draggedLines * cellsPerPixel;
+        viewColumn -= draggedColumns * cellsPerPixel;
+        dragRemainder.y -= draggedLines * cellWidth;
+        dragRemainder.x -= draggedColumns * cellWidth;
+    } else {
+        dragRemainder = { 0, 0 };
+    }
 
 }
 
@@ -273,4 +475,13 @@ void GameWorld::loadResources() {
  */
 void GameWorld::unloadResources() {
     std::cout << "unloading resources..." << std::endl;
+    // the textures went away with the window if it was closed
+    if ( IsWindowReady() ) {
+        if ( cellsTexture.id != 0 ) {
+            UnloadTexture( cellsTexture );
+        }
+        if ( gridTexture.id != 0 ) {
+            UnloadTexture( gridTexture );
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,599 @@
+/**
+ * @file HashLife.cpp
+ * @author Prof. Dr. David Buzatto
+ * @brief HashLife class implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <HashLife.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+static inline size_t hashChildren( const void *nw, const void *ne, const void *sw, const void *se ) {
+    uint64_t h = reinterpret_cast<uintptr_t>( nw );
+    h = h * 0x9e3779b97f4a7c15ULL + reinterpret_cast<uintptr_t>( ne );
+    h = h * 0x9e3779b97f4a7c15ULL + reinterpret_cast<uintptr_t>( sw );
+    h = h * 0x9e3779b97f4a7c15ULL + reinterpret_cast<uintptr_t>( se );
+    return static_cast<size_t>( h ^ ( h >> 29 ) );
+}
+
+HashLife::HashLife( size_t memoryLimit ) :
+        usedInLastBlock( NODE_BLOCK_SIZE ),
+        freeNodes( nullptr ),
+        nodeCount( 0 ),
+        // each node and its two slots of the table
+        nodeLimit( memoryLimit / ( sizeof( Node ) + 2 * sizeof( Node* ) ) ),
+        collectThreshold( nodeLimit ),
+        table( 1 << 16, nullptr ),
+        deadCell { nullptr, nullptr, nullptr, nullptr, nullptr, 0, 0, false },
+        aliveCell { nullptr, nullptr, nullptr, nullptr, nullptr, 1, 0, false },
+        emptyNodes( 1, &deadCell ),
+        generation( 0 ),
+        resultExponent( 0 ),
+        savedGeneration( 0 ) {
+    root = getEmpty( MIN_ROOT_LEVEL );
+    savedRoot = root;
+}
+
+const char *HashLife::getName() const {
+    return "hashlife";
+}
+
+bool HashLife::get( long long line, long long column ) const {
+
+    long long half = 1LL << ( root->level - 1 );
+    if ( line < -half || line >= half || column < -half || column >= half ) {
+        return false;
+    }
+
+    // relative to the top left corner of each node
+    line += half;
+    column += half;
+    const Node *node = root;
+
+    while ( node->level > 0 ) {
+        long long h = 1LL << ( node->level - 1 );
+        if ( line < h ) {
+            node = column < h ? node->nw : node->ne;
+        } else {
+            node = column < h ? node->sw : node->se;
+            line -= h;
+        }
+        if ( column >= h ) {
+            column -= h;
+        }
+    }
+
+    return node == &aliveCell;
+
+}
+
+void HashLife::set( long long line, long long column, bool alive ) {
+
+    while ( root->level < MAX_LEVEL ) {
+        long long half = 1LL << ( root->level - 1 );
+        if ( line >= -half && line < half && column >= -half && column < half ) {
+            break;
+        }
+        root = expand( root );
+    }
+
+    long long half = 1LL << ( root->level - 1 );
+    if ( line < -half || line >= half || column < -half || column >= half ) {
+        return;
+    }
+
+    root = setCell( root, line + half, column + half, alive );
+    collectIfFull();
+
+}
+
+void HashLife::clear() {
+    root = getEmpty( MIN_ROOT_LEVEL );
+    generation = 0;
+}
+
+void HashLife::getRegion( long long line, long long column, int lines, int columns,
+                          std::vector<unsigned char> &cells ) const {
+    cells.assign( static_cast<size_t>( lines ) * columns, 0 );
+    long long half = 1LL << ( root->level - 1 );
+    fillRegion( root, -half, -half, line, column, lines, columns, cells );
+}
+
+void HashLife::getDensity( long long line, long long column, int lines, int columns, 
+                           int cellsPerPixel, std::vector<unsigned char> &density ) const {
+
+    std::vector<int> counts( static_cast<size_t>( lines ) * columns, 0 );
+    long long half = 1LL << ( root->level - 1 );
+    fillDensity( root, -half, -half, line, column, lines, columns, cellsPerPixel, counts );
+
+    density.resize( counts.size() );
+    for ( size_t i = 0; i < counts.size(); i++ ) {
+        density[i] = toDensity( counts[i], cellsPerPixel * cellsPerPixel );
+    }
+
+}
+
+bool HashLife::getBounds( long long &top, long long &left, 
+                          long long &bottom, long long &right ) const {
+    bool found = false;
+    long long half = 1LL << ( root->level - 1 );
+    fillBounds( root, -half, -half, top, left, bottom, right, found );
+    return found;
+}
+
+long long HashLife::getPopulation() const {
+    return root->population;
+}
+
+long long HashLife::getGeneration() const {
+    return generation;
+}
+
+int HashLife::getMaxStepExponent() const {
+    return MAX_STEP_EXPONENT;
+}
+
+void HashLife::step( int exponent ) {
+
+    if ( exponent < 0 || exponent > MAX_STEP_EXPONENT ||
+         generation > std::numeric_limits<long long>::max() - ( 1LL << exponent ) ) {
+        return;
+    }
+
+    if ( exponent != resultExponent ) {
+        clearResults();
+        resultExponent = exponent;
+    }
+
+    // the pattern must be in the center quarter of a root big enough
+    // that nothing it becomes leaves the center half, that is the result;
+    // the root expanded once more may not pass MAX_LEVEL
+    while ( root->level < exponent + 2 || !isCentered( root ) ) {
+        if ( root->level >= MAX_LEVEL - 1 ) {
+            return;
+        }
+        root = expand( root );
+    }
+    root = expand( root );
+
+    root = getResult( root );
+    generation += 1LL << exponent;
+
+    collectIfFull();
+
+}
+
+void HashLife::save() {
+    savedRoot = root;
+    savedGeneration = generation;
+}
+
+void HashLife::restore() {
+    root = savedRoot;
+    generation = savedGeneration;
+}
+
+size_t HashLife::getNodeCount() const {
+    return nodeCount;
+}
+
+HashLife::Node *HashLife::allocateNode() {
+
+    nodeCount++;
+
+    if ( freeNodes != nullptr ) {
+        Node *node = freeNodes;
+        freeNodes = node->nw;
+        return node;
+    }
+
+    if ( usedInLastBlock == NODE_BLOCK_SIZE ) {
+        blocks.push_back( std::make_unique<Node[]>( NODE_BLOCK_SIZE ) );
+        usedInLastBlock = 0;
+    }
+
+    return &blocks.back()[usedInLastBlock++];
+
+}
+
+/**
+ * @brief The unique node with the given children.
+ */
+HashLife::Node *HashLife::join( Node *nw, Node *ne, Node *sw, Node *se ) {
+
+    size_t mask = table.size() - 1;
+    size_t i = hashChildren( nw, ne, sw, se ) & mask;
+
+    while ( table[i] != nullptr ) {
+        Node *node = table[i];
+        if ( node->nw == nw && node->ne == ne && node->sw == sw && node->se == se ) {
+            return node;
+        }
+        i = ( i + 1 ) & mask;
+    }
+
+    Node *node = allocateNode();
+    *node = Node {
+        nw, ne, sw, se, nullptr,
+        nw->population + ne->population + sw->population + se->population,
+        nw->level + 1,
+        false
+    };
+    table[i] = node;
+
+    if ( nodeCount * 2 > table.size() ) {
+        growTable();
+    }
+
+    return node;
+
+}
+
+void HashLife::insert( Node *node ) {
+    size_t mask = table.size() - 1;
+    size_t i = hashChildren( node->nw, node->ne, node->sw, node->se ) & mask;
+    while ( table[i] != nullptr ) {
+        i = ( i + 1 ) & mask;
+    }
+    table[i] = node;
+}
+
+void HashLife::growTable() {
+    std::vector<Node*> old( table.size() * 2, nullptr );
+    std::swap( old, table );
+    for ( Node *node : old ) {
+        if ( node != nullptr ) {
+            insert( node );
+        }
+    }
+}
+
+HashLife::Node *HashLife::getEmpty( int level ) {
+    while ( static_cast<int>( emptyNodes.size() ) <= level ) {
+        Node *e = emptyNodes.back();
+        emptyNodes.push_back( join( e, e, e, e ) );
+    }
+    return emptyNodes[level];
+}
+
+/**
+ * @brief The node of the next level with node at its center.
+ */
+HashLife::Node *HashLife::expand( Node *node ) {
+    Node *e = getEmpty( node->level - 1 );
+    return join(
+        join( e, e, e, node->nw ), join( e, e, node->ne, e ),
+        join( e, node->sw, e, e ), join( node->se, e, e, e ) );
+}
+
+/**
+ * @brief If every live cell is in the center quarter of the node.
+ */
+bool HashLife::isCentered( const Node *node ) const {
+    return node->nw->se->population + node->ne->sw->population +
+           node->sw->ne->population + node->se->nw->population == node->population;
+}
+
+HashLife::Node *HashLife::center( Node *node ) {
+    return join( node->nw->se, node->ne->sw, node->sw->ne, node->se->nw );
+}
+
+/**
+ * @brief The center of the node, advanced 2^min( resultExponent,
+ * level - 2 ) generations.
+ */
+HashLife::Node *HashLife::getResult( Node *node ) {
+
+    if ( node->result != nullptr ) {
+        return node->result;
+    }
+
+    Node *result;
+
+    if ( node->population == 0 ) {
+        result = getEmpty( node->level - 1 );
+    } else if ( node->level == 2 ) {
+        result = getBaseResult( node );
+    } else {
+
+        // nine overlapping nodes of the level below, a half of them
+        // apart from each other
+        Node *n00 = node->nw;
+        Node *n01 = join( node->nw->ne, node->ne->nw, node->nw->se, node->ne->sw );
+        Node *n02 = node->ne;
+        Node *n10 = join( node->nw->sw, node->nw->se, node->sw->nw, node->sw->ne );
+        Node *n11 = center( node );
+        Node *n12 = join( node->ne->sw, node->ne->se, node->se->nw, node->se->ne );
+        Node *n20 = node->sw;
+        Node *n21 = join( node->sw->ne, node->se->nw, node->sw->se, node->se->sw );
+        Node *n22 = node->se;
+
+        Node *r00, *r01, *r02, *r10, *r11, *r12, *r20, *r21, *r22;
+
+        if ( resultExponent >= node->level - 2 ) {
+            // full speed: two halves of 2^( level - 3 ) generations
+            r00 = getResult( n00 );
+            r01 = getResult( n01 );
+            r02 = getResult( n02 );
+            r10 = getResult( n10 );
+            r11 = getResult( n11 );
+            r12 = getResult( n12 );
+            r20 = getResult( n20 );
+            r21 = getResult( n21 );
+            r22 = getResult( n22 );
+        } else {
+            // slower: only the second half advances
+            r00 = center( n00 );
+            r01 = center( n01 );
+            r02 = center( n02 );
+            r10 = center( n10 );
+            r11 = center( n11 );
+            r12 = center( n12 );
+            r20 = center( n20 );
+            r21 = center( n21 );
+            r22 = center( n22 );
+        }
+
+        result = join(
+            getResult( join( r00, r01, r10, r11 ) ), getResult( join( r01, r02, r11, r12 ) ),
+            getResult( join( r10, r11, r20, r21 ) ), getResult( join( r11, r12, r21, r22 ) ) );
+
+    }
+
+    node->result = result;
+    return result;
+
+}
+
+/**
+ * @brief The four center cells of a node of level 2, one generation
+ * later.
+ */
+HashLife::Node *HashLife::getBaseResult( Node *node ) {
+
+    // the 4x4 cells
+    Node *quadrants[2][2] = { { node->nw, node->ne }, { node->sw, node->se } };
+    int cells[4][4];
+
+    for ( int i = 0; i < 4; i++ ) {
+        for ( int j = 0; j < 4; j++ ) {
+            Node *q = quadrants[i/2][j/2];
+            Node *cells2[2][2] = { { q->nw, q->ne }, { q->sw, q->se } };
+            cells[i][j] = cells2[i%2][j%2] == &aliveCell;
+        }
+    }
+
+    Node *next[2][2];
+
+    for ( int i = 1; i <= 2; i++ ) {
+        for ( int j = 1; j <= 2; j++ ) {
+            int n = -cells[i][j];
+            for ( int di = -1; di <= 1; di++ ) {
+                for ( int dj = -1; dj <= 1; dj++ ) {
+                    n += cells[i+di][j+dj];
+                }
+            }
+            bool alive = n == 3 || ( n == 2 && cells[i][j] );
+            next[i-1][j-1] = alive ? &aliveCell : &deadCell;
+        }
+    }
+
+    return join( next[0][0], next[0][1], next[1][0], next[1][1] );
+
+}
+
+/**
+ * @brief The node with the cell at line and column, relative to the
+ * top left corner of the node, set.
+ */
+HashLife::Node *HashLife::setCell( Node *node, long long line, long long column, bool alive ) {
+
+    if ( node->level == 0 ) {
+        return alive ? &aliveCell : &deadCell;
+    }
+
+    long long h = 1LL << ( node->level - 1 );
+
+    if ( line < h ) {
+        if ( column < h ) {
+            return join( setCell( node->nw, line, column, alive ), node->ne, node->sw, node->se );
+        }
+        return join( node->nw, setCell( node->ne, line, column - h, alive ), node->sw, node->se );
+    }
+
+    if ( column < h ) {
+        return join( node->nw, node->ne, setCell( node->sw, line - h, column, alive ), node->se );
+    }
+    return join( node->nw, node->ne, node->sw, setCell( node->se, line - h, column - h, alive ) );
+
+}
+
+/**
+ * @brief Writes the live cells of node, whose top left corner is at
+ * nodeLine and nodeColumn, that are in the region.
+ */
+void HashLife::fillRegion( const Node *node, long long nodeLine, long long nodeColumn,
+                           long long line, long long column, int lines, int columns,
+                           std::vector<unsigned char> &cells ) const {
+
+    if ( node->population == 0 ) {
+        return;
+    }
+
+    // before the cells, that may be out of the region too
+    long long size = 1LL << node->level;
+    if ( nodeLine >= line + lines || nodeLine + size <= line ||
+         nodeColumn >= column + columns || nodeColumn + size <= column ) {
+        return;
+    }
+
+    if ( node->level == 0 ) {
+        cells[( nodeLine - line ) * columns + ( nodeColumn - column )] = 1;
+        return;
+    }
+
+    long long h = size / 2;
+    fillRegion( node->nw, nodeLine, nodeColumn, line, column, lines, columns, cells );
+    fillRegion( node->ne, nodeLine, nodeColumn + h, line, column, lines, columns, cells );
+    fillRegion( node->sw, nodeLine + h, nodeColumn, line, column, lines, columns, cells );
+    fillRegion( node->se, nodeLine + h, nodeColumn + h, line, column, lines, columns, cells );
+
+}
+
+/**
+ * @brief Adds the live cells of node, whose top left corner is at
+ * nodeLine and nodeColumn, to the counts of the squares of the region,
+ * the whole population at once when the node is inside one square.
+ */
+void HashLife::fillDensity( const Node *node, long long nodeLine, long long nodeColumn,
+                            long long line, long long column, int lines, int columns,
+                            int cellsPerPixel, std::vector<int> &counts ) const {
+
+    if ( node->population == 0 ) {
+        return;
+    }
+
+    long long last = ( 1LL << node->level ) - 1;
+    long long regionLines = static_cast<long long>( lines ) * cellsPerPixel;
+    long long regionColumns = static_cast<long long>( columns ) * cellsPerPixel;
+
+    if ( nodeLine > line + regionLines - 1 || nodeLine + last < line ||
+         nodeColumn > column + regionColumns - 1 || nodeColumn + last < column ) {
+        return;
+    }
+
+    if ( nodeLine >= line && nodeColumn >= column ) {
+        long long i = ( nodeLine - line ) / cellsPerPixel;
+        long long j = ( nodeColumn - column ) / cellsPerPixel;
+        if ( i == ( nodeLine + last - line ) / cellsPerPixel && 
+             j == ( nodeColumn + last - column ) / cellsPerPixel && i < lines && j < columns ) {
+            counts[i*columns+j] += static_cast<int>( node->population );
+            return;
+        }
+    }
+
+    long long h = 1LL << ( node->level - 1 );
+    fillDensity( node->nw, nodeLine, nodeColumn, line, column, lines, columns, cellsPerPixel, counts );
+    fillDensity( node->ne, nodeLine, nodeColumn + h, line, column, lines, columns, cellsPerPixel, counts );
+    fillDensity( node->sw, nodeLine + h, nodeColumn, line, column, lines, columns, cellsPerPixel, counts );
+    fillDensity( node->se, nodeLine + h, nodeColumn + h, line, column, lines, columns, cellsPerPixel, counts );
+
+}
+
+/**
+ * @brief Grows the bounds with the live cells of node, skipping the
+ * nodes that are already inside them.
+ */
+void HashLife::fillBounds( const Node *node, long long nodeLine, long long nodeColumn, 
+                           long long &top, long long &left, long long &bottom, long long &right, 
+                           bool &found ) const {
+
+    if ( node->population == 0 ) {
+        return;
+    }
+
+    long long last = ( 1LL << node->level ) - 1;
+    if ( found && nodeLine >= top && nodeLine + last <= bottom && 
+         nodeColumn >= left && nodeColumn + last <= right ) {
+        return;
+    }
+
+    if ( node->level == 0 ) {
+        if ( !found ) {
+            top = bottom = nodeLine;
+            left = right = nodeColumn;
+            found = true;
+        }
+        top = std::min( top, nodeLine );
+        bottom = std::max( bottom, nodeLine );
+        left = std::min( left, nodeColumn );
+        right = std::max( right, nodeColumn );
+        return;
+    }
+
+    long long h = 1LL << ( node->level - 1 );
+    fillBounds( node->nw, nodeLine, nodeColumn, top, left, bottom, right, found );
+    fillBounds( node->ne, nodeLine, nodeColumn + h, top, left, bottom, right, found );
+    fillBounds( node->sw, nodeLine + h, nodeColumn, top, left, bottom, right, found );
+    fillBounds( node->se, nodeLine + h, nodeColumn + h, top, left, bottom, right, found );
+
+}
+
+void HashLife::clearResults() {
+    for ( Node *node : table ) {
+        if ( node != nullptr ) {
+            node->result = nullptr;
+        }
+    }
+}
+
+void HashLife::mark( Node *node ) {
+    if ( node == nullptr || node->level == 0 || node->marked ) {
+        return;
+    }
+    node->marked = true;
+    mark( node->nw );
+    mark( node->ne );
+    mark( node->sw );
+    mark( node->se );
+    mark( node->result );
+}
+
+/**
+ * @brief Frees the nodes that can not be reached from the roots, the
+ * empty nodes or the results of the ones that can.
+ */
+void HashLife::collectGarbage() {
+
+    mark( root );
+    mark( savedRoot );
+    for ( Node *node : emptyNodes ) {
+        mark( node );
+    }
+
+    std::vector<Node*> old( table.size(), nullptr );
+    std::swap( old, table );
+
+    for ( Node *node : old ) {
+        if ( node == nullptr ) {
+            continue;
+        }
+        if ( node->marked ) {
+            node->marked = false;
+            insert( node );
+        } else {
+            node->nw = freeNodes;
+            freeNodes = node;
+            nodeCount--;
+        }
+    }
+
+}
+
+/**
+ * @brief Collects the garbage when there are more nodes than the limit,
+ * discarding the results too if that is not enough. The next collection
+ * waits for twice the nodes that were kept, so a universe that needs
+ * most of the limit is not collected at every change.
+ */
+void HashLife::collectIfFull() {
+
+    if ( nodeCount <= collectThreshold ) {
+        return;
+    }
+
+    collectGarbage();
+    if ( nodeCount > nodeLimit / 2 ) {
+        clearResults();
+        collectGarbage();
+    }
+
+    collectThreshold = std::max( nodeLimit, 2 * nodeCount );
+
+}
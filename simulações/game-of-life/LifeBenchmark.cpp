@@ -0,0 +1,335 @@
+/**
+ * @file LifeBenchmark.cpp
+ * @author Prof. Dr. David Buzatto
+ * @brief Headless benchmark of the Game of Life kernels, implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <LifeBenchmark.h>
+#include <HashLife.h>
+#include <LifeBoard.h>
+#include <LifePattern.h>
+#include <SparseLife.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+static constexpr int BENCHMARK_SIZE = 960;
+static constexpr int BENCHMARK_GENERATIONS = 200;
+static constexpr double BENCHMARK_MIN_SECONDS = 1.0;
+static constexpr int PATTERN_SIZE = 4096;
+
+/**
+ * @brief The kernel GameWorld used before LifeBoard: one int per cell,
+ * nine bounds checked reads per cell and a copy of the new generation.
+ */
+class IntBoard {
+
+    int lines;
+    int columns;
+    std::vector<int> cells;
+    std::vector<int> newGeneration;
+
+    int countNeighbors( int line, int column ) const {
+        int count = 0;
+        for ( int i = line-1; i < line + 2; i++ ) {
+            for ( int j = column-1; j < column + 2; j++ ) {
+                if ( i >= 0 && i < lines && j >= 0 && j < columns && cells[i*columns+j] ) {
+                    count++;
+                }
+            }
+        }
+        if ( cells[line*columns+column] ) {
+            count--;
+        }
+        return count;
+    }
+
+public:
+
+    IntBoard( int lines, int columns ) :
+            lines( lines ),
+            columns( columns ),
+            cells( lines * columns, 0 ),
+            newGeneration( lines * columns, 0 ) {
+    }
+
+    bool get( int line, int column ) const {
+        return cells[line*columns+column];
+    }
+
+    void set( int line, int column, bool alive ) {
+        cells[line*columns+column] = alive;
+    }
+
+    void step() {
+        for ( int i = 0; i < lines; i++ ) {
+            for ( int j = 0; j < columns; j++ ) {
+                int p = i*columns+j;
+                int n = countNeighbors( i, j );
+                if ( cells[p] ) {
+                    newGeneration[p] = n <= 1 || n >= 4 ? 0 : 1;
+                } else {
+                    newGeneration[p] = n == 3 ? 1 : 0;
+                }
+            }
+        }
+        std::copy( newGeneration.begin(), newGeneration.end(), cells.begin() );
+    }
+
+};
+
+/**
+ * @brief Steps the board at least generations times and for at least
+ * BENCHMARK_MIN_SECONDS, returning the generations per second.
+ */
+template<typename Board>
+static double measure( Board &board, int generations ) {
+
+    auto start = std::chrono::steady_clock::now();
+    int steps = 0;
+    double seconds = 0;
+
+    while ( steps < generations || seconds < BENCHMARK_MIN_SECONDS ) {
+        board.step();
+        steps++;
+        seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    }
+
+    return steps / seconds;
+
+}
+
+bool runLifeBenchmark() {
+
+    IntBoard intBoard( BENCHMARK_SIZE, BENCHMARK_SIZE );
+    LifeBoard packedBoard( BENCHMARK_SIZE, BENCHMARK_SIZE );
+    IntBoard checkBoard( BENCHMARK_SIZE, BENCHMARK_SIZE );
+    LifeBoard packedCheckBoard( BENCHMARK_SIZE, BENCHMARK_SIZE );
+
+    // the same random board for every kernel, a third of it alive
+    uint32_t seed = 12345;
+    for ( int i = 0; i < BENCHMARK_SIZE; i++ ) {
+        for ( int j = 0; j < BENCHMARK_SIZE; j++ ) {
+            seed = seed * 1103515245u + 12345u;
+            bool alive = ( seed >> 16 ) % 3 == 0;
+            intBoard.set( i, j, alive );
+            packedBoard.set( i, j, alive );
+            checkBoard.set( i, j, alive );
+            packedCheckBoard.set( i, j, alive );
+        }
+    }
+
+    std::printf( "%dx%d random board, a third alive\n", BENCHMARK_SIZE, BENCHMARK_SIZE );
+    std::printf( "%-8s %14s %10s\n", "kernel", "generations/s", "speedup" );
+
+    double intRate = measure( intBoard, 1 );
+    std::printf( "%-8s %14.1f %9.2fx\n", "int", intRate, 1.0 );
+
+    double packedRate = measure( packedBoard, BENCHMARK_GENERATIONS );
+    std::printf( "%-8s %14.1f %9.2fx\n", "packed", packedRate, packedRate / intRate );
+
+    // the same generations in both kernels must give the same board
+    for ( int g = 0; g < BENCHMARK_GENERATIONS; g++ ) {
+        checkBoard.step();
+        packedCheckBoard.step();
+    }
+
+    int differences = 0;
+    for ( int i = 0; i < BENCHMARK_SIZE; i++ ) {
+        for ( int j = 0; j < BENCHMARK_SIZE; j++ ) {
+            if ( checkBoard.get( i, j ) != packedCheckBoard.get( i, j ) ) {
+                differences++;
+            }
+        }
+    }
+
+    std::printf( "after %d generations: %lld cells alive, %d different cells\n", 
+                 BENCHMARK_GENERATIONS, packedCheckBoard.getPopulation(), differences );
+
+    // the sparse universe computes only the tiles around the activity,
+    // so it is measured with the whole board alive and with a few
+    // gliders; a soup in the middle of the board must end the same in
+    // both while it does not reach the border
+    SparseLife sparse;
+    for ( int i = 0; i < BENCHMARK_SIZE; i++ ) {
+        for ( int j = 0; j < BENCHMARK_SIZE; j++ ) {
+            seed = seed * 1103515245u + 12345u;
+            sparse.set( i, j, ( seed >> 16 ) % 3 == 0 );
+        }
+    }
+
+    double sparseRate = measure( sparse, BENCHMARK_GENERATIONS );
+    std::printf( "%-8s %14.1f %9.2fx\n", "sparse", sparseRate, sparseRate / intRate );
+
+    LifeBoard glidersBoard( BENCHMARK_SIZE, BENCHMARK_SIZE );
+    SparseLife glidersSparse;
+    for ( int k = 0; k < 4; k++ ) {
+        int line = BENCHMARK_SIZE / 2 + ( k / 2 ) * 20;
+        int column = BENCHMARK_SIZE / 2 + ( k % 2 ) * 20;
+        const int glider[5][2] = { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 2, 1 }, { 2, 2 } };
+        for ( const auto &cell : glider ) {
+            glidersBoard.set( line + cell[0], column + cell[1], true );
+            glidersSparse.set( line + cell[0], column + cell[1], true );
+        }
+    }
+
+    std::printf( "\nfour gliders on the %dx%d board\n", BENCHMARK_SIZE, BENCHMARK_SIZE );
+    double glidersPackedRate = measure( glidersBoard, BENCHMARK_GENERATIONS );
+    std::printf( "%-8s %14.1f %9.2fx\n", "packed", glidersPackedRate, 1.0 );
+    double glidersSparseRate = measure( glidersSparse, BENCHMARK_GENERATIONS );
+    std::printf( "%-8s %14.1f %9.2fx (%zu tiles)\n", "sparse", glidersSparseRate, 
+                 glidersSparseRate / glidersPackedRate, glidersSparse.getTileCount() );
+
+    LifeBoard soupBoard( BENCHMARK_SIZE, BENCHMARK_SIZE );
+    SparseLife soupSparse;
+    HashLife soupHash;
+    int soupStart = BENCHMARK_SIZE / 2 - 64;
+    for ( int i = soupStart; i < soupStart + 128; i++ ) {
+        for ( int j = soupStart; j < soupStart + 128; j++ ) {
+            seed = seed * 1103515245u + 12345u;
+            bool alive = ( seed >> 16 ) % 3 == 0;
+            soupBoard.set( i, j, alive );
+            soupSparse.set( i, j, alive );
+            soupHash.set( i, j, alive );
+        }
+    }
+
+    for ( int g = 0; g < BENCHMARK_GENERATIONS; g++ ) {
+        soupBoard.step();
+        soupSparse.step();
+        soupHash.step( 0 );
+    }
+
+    std::vector<unsigned char> boardCells;
+    std::vector<unsigned char> sparseCells;
+    soupBoard.getRegion( 0, 0, BENCHMARK_SIZE, BENCHMARK_SIZE, boardCells );
+    soupSparse.getRegion( 0, 0, BENCHMARK_SIZE, BENCHMARK_SIZE, sparseCells );
+    int sparseDifferences = 0;
+    for ( size_t i = 0; i < boardCells.size(); i++ ) {
+        sparseDifferences += boardCells[i] != sparseCells[i];
+    }
+
+    // and a region whose borders cut the nodes and the tiles, so the
+    // cells out of it must not be written
+    std::vector<unsigned char> boardRegion;
+    std::vector<unsigned char> sparseRegion;
+    std::vector<unsigned char> hashRegion;
+    std::vector<unsigned char> hashCells;
+    soupHash.getRegion( 0, 0, BENCHMARK_SIZE, BENCHMARK_SIZE, hashCells );
+    soupBoard.getRegion( soupStart + 5, soupStart + 3, 101, 99, boardRegion );
+    soupSparse.getRegion( soupStart + 5, soupStart + 3, 101, 99, sparseRegion );
+    soupHash.getRegion( soupStart + 5, soupStart + 3, 101, 99, hashRegion );
+    int hashDifferences = 0;
+    for ( size_t i = 0; i < boardCells.size(); i++ ) {
+        hashDifferences += boardCells[i] != hashCells[i];
+    }
+    for ( size_t i = 0; i < boardRegion.size(); i++ ) {
+        sparseDifferences += boardRegion[i] != sparseRegion[i];
+        hashDifferences += boardRegion[i] != hashRegion[i];
+    }
+
+    std::printf( "128x128 soup after %d generations: %lld cells alive, "
+                 "%d different cells in sparse, %d in hashlife\n", 
+                 BENCHMARK_GENERATIONS, soupSparse.getPopulation(), sparseDifferences, hashDifferences );
+
+    return differences == 0 && sparseDifferences == 0 && hashDifferences == 0;
+
+}
+
+static double secondsSince( std::chrono::steady_clock::time_point start ) {
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+}
+
+bool runPatternBenchmark() {
+
+    // a third of the cells alive, from line and column 0
+    SparseLife pattern;
+    uint32_t seed = 54321;
+    for ( int i = 0; i < PATTERN_SIZE; i++ ) {
+        for ( int j = 0; j < PATTERN_SIZE; j++ ) {
+            seed = seed * 1103515245u + 12345u;
+            if ( ( seed >> 16 ) % 3 == 0 ) {
+                pattern.set( i, j, true );
+            }
+        }
+    }
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    std::string rlePath = ( directory / "life-benchmark.rle" ).string();
+    std::string life106Path = ( directory / "life-benchmark.lif" ).string();
+    std::string error;
+
+    std::printf( "%dx%d random pattern, %lld cells alive\n", PATTERN_SIZE, PATTERN_SIZE, pattern.getPopulation() );
+    std::printf( "%-10s %-8s %10s %10s %12s\n", "file", "engine", "MB", "seconds", "Mcells/s" );
+
+    const char *paths[2] = { rlePath.c_str(), life106Path.c_str() };
+    const char *formats[2] = { "rle", "life 1.06" };
+    double megabytes[2];
+
+    for ( int f = 0; f < 2; f++ ) {
+        auto start = std::chrono::steady_clock::now();
+        bool saved = f == 0 ? 
+            saveLifePatternRle( paths[f], pattern, error ) : 
+            saveLifePattern106( paths[f], pattern, error );
+        double seconds = secondsSince( start );
+        if ( !saved ) {
+            std::printf( "%s\n", error.c_str() );
+            return false;
+        }
+        megabytes[f] = std::filesystem::file_size( paths[f] ) / ( 1024.0 * 1024.0 );
+        std::printf( "%-10s %-8s %10.1f %10.3f %12.2f\n", formats[f], "save", megabytes[f], 
+                     seconds, pattern.getPopulation() / seconds / 1e6 );
+    }
+
+    // loaded with the first cell at 0 0, to be compared with the pattern
+    bool same = true;
+    std::vector<unsigned char> expected;
+    std::vector<unsigned char> loaded;
+    pattern.getRegion( 0, 0, PATTERN_SIZE, PATTERN_SIZE, expected );
+
+    for ( int f = 0; f < 2; f++ ) {
+        for ( int e = 0; e < 3; e++ ) {
+
+            std::unique_ptr<LifeEngine> engine;
+            if ( e == 0 ) {
+                engine = std::make_unique<LifeBoard>( PATTERN_SIZE, PATTERN_SIZE );
+            } else if ( e == 1 ) {
+                engine = std::make_unique<SparseLife>();
+            } else {
+                engine = std::make_unique<HashLife>();
+            }
+
+            long long center = f == 0 ? PATTERN_SIZE / 2 : 0;
+            auto start = std::chrono::steady_clock::now();
+            bool ok = loadLifePattern( paths[f], *engine, center, center, error );
+            double seconds = secondsSince( start );
+
+            if ( !ok ) {
+                std::printf( "%s\n", error.c_str() );
+                same = false;
+                continue;
+            }
+
+            engine->getRegion( 0, 0, PATTERN_SIZE, PATTERN_SIZE, loaded );
+            bool equal = loaded == expected && engine->getPopulation() == pattern.getPopulation();
+            same = same && equal;
+
+            std::printf( "%-10s %-8s %10.1f %10.3f %12.2f%s\n", formats[f], engine->getName(), megabytes[f], 
+                         seconds, pattern.getPopulation() / seconds / 1e6, equal ? "" : " different" );
+
+        }
+    }
+
+    std::filesystem::remove( rlePath );
+    std::filesystem::remove( life106Path );
+
+    return same;
+
+}
@@ -0,0 +1,206 @@
+/**
+ * @file LifeBoard.cpp
+ * @author Prof. Dr. David Buzatto
+ * @brief LifeBoard class implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <LifeBoard.h>
+#include <LifeKernel.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+LifeBoard::LifeBoard( int lines, int columns ) :
+        lines( lines ),
+        columns( columns ),
+        words( ( columns + 63 ) / 64 ),
+        cells( static_cast<size_t>( lines + 2 ) * words, 0 ),
+        nextCells( static_cast<size_t>( lines + 2 ) * words, 0 ),
+        lastWordMask( columns % 64 == 0 ? ~0ULL : ( 1ULL << ( columns % 64 ) ) - 1 ),
+        generation( 0 ),
+        savedCells( cells ),
+        savedGeneration( 0 ) {
+}
+
+int LifeBoard::getLines() const {
+    return lines;
+}
+
+int LifeBoard::getColumns() const {
+    return columns;
+}
+
+const char *LifeBoard::getName() const {
+    return "packed";
+}
+
+long long LifeBoard::getGeneration() const {
+    return generation;
+}
+
+int LifeBoard::getMaxStepExponent() const {
+    return MAX_STEP_EXPONENT;
+}
+
+bool LifeBoard::get( long long line, long long column ) const {
+    if ( line < 0 || line >= lines || column < 0 || column >= columns ) {
+        return false;
+    }
+    return ( cells[( line + 1 ) * words + column / 64] >> ( column % 64 ) ) & 1;
+}
+
+void LifeBoard::set( long long line, long long column, bool alive ) {
+    if ( line < 0 || line >= lines || column < 0 || column >= columns ) {
+        return;
+    }
+    uint64_t &word = cells[( line + 1 ) * words + column / 64];
+    uint64_t bit = 1ULL << ( column % 64 );
+    word = alive ? word | bit : word & ~bit;
+}
+
+void LifeBoard::clear() {
+    std::fill( cells.begin(), cells.end(), 0 );
+    generation = 0;
+}
+
+void LifeBoard::getRegion( long long line, long long column, int regionLines, int regionColumns, 
+                           std::vector<unsigned char> &region ) const {
+
+    region.assign( static_cast<size_t>( regionLines ) * regionColumns, 0 );
+
+    for ( int i = 0; i < regionLines; i++ ) {
+        for ( int j = 0; j < regionColumns; j++ ) {
+            region[i*regionColumns+j] = get( line + i, column + j );
+        }
+    }
+
+}
+
+void LifeBoard::getDensity( long long line, long long column, int regionLines, int regionColumns, 
+                            int cellsPerPixel, std::vector<unsigned char> &density ) const {
+
+    std::vector<int> counts( static_cast<size_t>( regionLines ) * regionColumns, 0 );
+
+    long long first = std::max( line, 0LL );
+    long long last = std::min( line + static_cast<long long>( regionLines ) * cellsPerPixel, 
+                               static_cast<long long>( lines ) );
+    long long cellColumns = static_cast<long long>( regionColumns ) * cellsPerPixel;
+
+    for ( long long i = first; i < last; i++ ) {
+        int *lineCounts = &counts[( i - line ) / cellsPerPixel * regionColumns];
+        for ( int w = 0; w < words; w++ ) {
+            uint64_t word = cells[( i + 1 ) * words + w];
+            while ( word != 0 ) {
+                long long j = w * 64LL + std::countr_zero( word ) - column;
+                if ( j >= 0 && j < cellColumns ) {
+                    lineCounts[j / cellsPerPixel]++;
+                }
+                word &= word - 1;
+            }
+        }
+    }
+
+    density.resize( counts.size() );
+    for ( size_t i = 0; i < counts.size(); i++ ) {
+        density[i] = toDensity( counts[i], cellsPerPixel * cellsPerPixel );
+    }
+
+}
+
+bool LifeBoard::getBounds( long long &top, long long &left, 
+                           long long &bottom, long long &right ) const {
+
+    bool found = false;
+
+    for ( int i = 0; i < lines; i++ ) {
+        for ( int w = 0; w < words; w++ ) {
+            uint64_t word = cells[( i + 1 ) * words + w];
+            if ( word == 0 ) {
+                continue;
+            }
+            long long first = w * 64LL + std::countr_zero( word );
+            long long last = w * 64LL + 63 - std::countl_zero( word );
+            if ( !found ) {
+                top = i;
+                left = first;
+                right = last;
+                found = true;
+            }
+            bottom = i;
+            left = std::min( left, first );
+            right = std::max( right, last );
+        }
+    }
+
+    return found;
+
+}
+
+long long LifeBoard::getPopulation() const {
+    long long population = 0;
+    for ( uint64_t word : cells ) {
+        population += std::popcount( word );
+    }
+    return population;
+}
+
+void LifeBoard::step( int exponent ) {
+    for ( long long g = 0; g < ( 1LL << exponent ); g++ ) {
+        step();
+    }
+}
+
+void LifeBoard::save() {
+    savedCells = cells;
+    savedGeneration = generation;
+}
+
+void LifeBoard::restore() {
+    cells = savedCells;
+    generation = savedGeneration;
+}
+
+void LifeBoard::step() {
+
+    for ( int i = 1; i <= lines; i++ ) {
+
+        const uint64_t *above = &cells[( i - 1 ) * words];
+        const uint64_t *line = &cells[i * words];
+        const uint64_t *below = &cells[( i + 1 ) * words];
+        uint64_t *next = &nextCells[i * words];
+
+        for ( int w = 0; w < words; w++ ) {
+
+            // the words to the sides give the bits that cross the border
+            // of the word when shifted
+            bool hasLeft = w > 0;
+            bool hasRight = w < words - 1;
+
+            uint64_t a = above[w];
+            uint64_t aWest = ( a << 1 ) | ( hasLeft ? above[w-1] >> 63 : 0 );
+            uint64_t aEast = ( a >> 1 ) | ( hasRight ? above[w+1] << 63 : 0 );
+
+            uint64_t c = line[w];
+            uint64_t cWest = ( c << 1 ) | ( hasLeft ? line[w-1] >> 63 : 0 );
+            uint64_t cEast = ( c >> 1 ) | ( hasRight ? line[w+1] << 63 : 0 );
+
+            uint64_t b = below[w];
+            uint64_t bWest = ( b << 1 ) | ( hasLeft ? below[w-1] >> 63 : 0 );
+            uint64_t bEast = ( b >> 1 ) | ( hasRight ? below[w+1] << 63 : 0 );
+
+            next[w] = nextLifeWord( aWest, a, aEast, cWest, c, cEast, bWest, b, bEast );
+
+        }
+
+        next[words-1] &= lastWordMask;
+
+    }
+
+    std::swap( cells, nextCells );
+    generation++;
+
+}
@@ -0,0 +1,15 @@
+/**
+ * @file LifeEngine.cpp
+ * @author Prof. Dr. David Buzatto
+ * @brief LifeEngine class implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <LifeEngine.h>
+
+unsigned char LifeEngine::toDensity( int count, int area ) {
+    if ( count == 0 ) {
+        return 0;
+    }
+    return static_cast<unsigned char>( MIN_DENSITY + ( 255 - MIN_DENSITY ) * count / area );
+}
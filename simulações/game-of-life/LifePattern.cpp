@@ -0,0 +1,564 @@
+/**
+ * @file LifePattern.cpp
+ * @author Prof. Dr. David Buzatto
+ * @brief LifePatternReader class implementation and the functions that
+ * load and save patterns.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <LifePattern.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static constexpr size_t READ_BUFFER_SIZE = 1 << 16;
+static constexpr long long MAX_SAVE_CELLS = 1 << 24;
+static constexpr int RLE_LINE_LENGTH = 70;
+
+/**
+ * @brief Appends the digit c to value, returning false, with value as it
+ * was, if it would pass max.
+ */
+static bool appendDigit( long long &value, char c, long long max ) {
+    int digit = c - '0';
+    if ( value > ( max - digit ) / 10 ) {
+        return false;
+    }
+    value = value * 10 + digit;
+    return true;
+}
+
+LifePatternReader::LifePatternReader( LifeEngine &engine, long long centerLine, long long centerColumn ) :
+        engine( engine ),
+        centerLine( centerLine ),
+        centerColumn( centerColumn ),
+        state( State::LINE_START ),
+        format( Format::UNKNOWN ),
+        firstLine( true ),
+        line {},
+        lineLength( 0 ),
+        originLine( centerLine ),
+        originColumn( centerColumn ),
+        patternLine( 0 ),
+        patternColumn( 0 ),
+        count( 0 ),
+        hasCount( false ),
+        numbers { 0, 0 },
+        numberCount( 0 ),
+        negative( false ),
+        hasDigits( false ),
+        cellCount( 0 ) {
+}
+
+void LifePatternReader::read( const char *data, size_t size ) {
+
+    for ( size_t i = 0; i < size; i++ ) {
+
+        char c = data[i];
+
+        switch ( state ) {
+
+            case State::DONE:
+            case State::FAILED:
+                return;
+
+            case State::LINE_START:
+                readLine( c );
+                break;
+
+            case State::FIRST_LINE:
+            case State::COMMENT:
+            case State::RLE_HEADER:
+                if ( c == '\n' ) {
+                    line[lineLength] = '\0';
+                    if ( state == State::FIRST_LINE ) {
+                        if ( std::strncmp( line, "#Life 1.06", 10 ) == 0 ) {
+                            format = Format::LIFE_106;
+                        } else if ( std::strncmp( line, "#Life", 5 ) == 0 ) {
+                            fail( "só a versão 1.06 do formato Life é aceita" );
+                            return;
+                        }
+                        state = State::LINE_START;
+                    } else if ( state == State::RLE_HEADER ) {
+                        readHeader();
+                    } else {
+                        state = State::LINE_START;
+                    }
+                } else if ( state != State::COMMENT && c != '\r' && lineLength < MAX_LINE - 1 ) {
+                    line[lineLength++] = c;
+                }
+                break;
+
+            case State::RLE_BODY:
+                readRle( c );
+                break;
+
+            case State::LIFE_106_NUMBERS:
+                readLife106( c );
+                break;
+
+        }
+
+    }
+
+}
+
+bool LifePatternReader::finish() {
+    // ends a last line without a line break
+    if ( state != State::DONE && state != State::FAILED ) {
+        read( "\n", 1 );
+    }
+    return state != State::FAILED;
+}
+
+long long LifePatternReader::getCellCount() const {
+    return cellCount;
+}
+
+const std::string &LifePatternReader::getError() const {
+    return error;
+}
+
+void LifePatternReader::fail( const char *message ) {
+    error = message;
+    state = State::FAILED;
+}
+
+/**
+ * @brief The first character of a line that is not in the body of an
+ * RLE pattern.
+ */
+void LifePatternReader::readLine( char c ) {
+
+    if ( std::isspace( static_cast<unsigned char>( c ) ) ) {
+        return;
+    }
+
+    if ( c == '#' ) {
+        if ( firstLine ) {
+            line[0] = c;
+            lineLength = 1;
+            state = State::FIRST_LINE;
+        } else {
+            state = State::COMMENT;
+        }
+        firstLine = false;
+        return;
+    }
+
+    firstLine = false;
+
+    if ( format == Format::LIFE_106 ) {
+        state = State::LIFE_106_NUMBERS;
+        readLife106( c );
+    } else if ( c == 'x' ) {
+        format = Format::RLE;
+        line[0] = c;
+        lineLength = 1;
+        state = State::RLE_HEADER;
+    } else {
+        // RLE without a header, from the center
+        format = Format::RLE;
+        state = State::RLE_BODY;
+        readRle( c );
+    }
+
+}
+
+/**
+ * @brief Reads "x = w, y = h, rule = r", centering the pattern.
+ */
+void LifePatternReader::readHeader() {
+
+    long long width = 0;
+    long long height = 0;
+    char *p = line;
+
+    while ( *p != '\0' ) {
+
+        while ( std::isspace( static_cast<unsigned char>( *p ) ) || *p == ',' ) {
+            p++;
+        }
+        char *key = p;
+        while ( std::isalpha( static_cast<unsigned char>( *p ) ) ) {
+            p++;
+        }
+        size_t keyLength = p - key;
+        while ( std::isspace( static_cast<unsigned char>( *p ) ) ) {
+            p++;
+        }
+        if ( *p != '=' || keyLength == 0 ) {
+            fail( "cabeçalho RLE inválido" );
+            return;
+        }
+        p++;
+        while ( std::isspace( static_cast<unsigned char>( *p ) ) ) {
+            p++;
+        }
+
+        if ( keyLength == 1 && ( *key == 'x' || *key == 'y' ) ) {
+            char *end;
+            long long value = std::strtoll( p, &end, 10 );
+            if ( end == p || value < 0 || value > MAX_NUMBER ) {
+                fail( "tamanho inválido no cabeçalho RLE" );
+                return;
+            }
+            ( *key == 'x' ? width : height ) = value;
+            p = end;
+        } else if ( keyLength == 4 && std::strncmp( key, "rule", 4 ) == 0 ) {
+            // B3/S23 or 23/3, in any case
+            char rule[16];
+            int ruleLength = 0;
+            while ( *p != '\0' && *p != ',' ) {
+                if ( !std::isspace( static_cast<unsigned char>( *p ) ) && ruleLength < 15 ) {
+                    rule[ruleLength++] = static_cast<char>( std::toupper( static_cast<unsigned char>( *p ) ) );
+                }
+                p++;
+            }
+            rule[ruleLength] = '\0';
+            if ( std::strcmp( rule, "B3/S23" ) != 0 && std::strcmp( rule, "23/3" ) != 0 ) {
+                fail( "só a regra B3/S23 é aceita" );
+                return;
+            }
+        } else {
+            while ( *p != '\0' && *p != ',' ) {
+                p++;
+            }
+        }
+
+    }
+
+    originLine = centerLine - height / 2;
+    originColumn = centerColumn - width / 2;
+    state = State::RLE_BODY;
+
+}
+
+void LifePatternReader::readRle( char c ) {
+
+    if ( c >= '0' && c <= '9' ) {
+        if ( !appendDigit( count, c, MAX_RUN ) ) {
+            fail( "contagem grande demais no padrão RLE" );
+        }
+        hasCount = true;
+        return;
+    }
+
+    if ( std::isspace( static_cast<unsigned char>( c ) ) ) {
+        return;
+    }
+
+    long long n = hasCount ? count : 1;
+    count = 0;
+    hasCount = false;
+
+    if ( c == 'b' || c == '.' ) {
+        patternColumn += n;
+    } else if ( c == '$' ) {
+        patternLine += n;
+        patternColumn = 0;
+    } else if ( c == '!' ) {
+        state = State::DONE;
+    } else if ( std::isalpha( static_cast<unsigned char>( c ) ) ) {
+        // o, or any state of the multi-state rules, is alive
+        if ( cellCount + n > MAX_CELLS ) {
+            fail( "células vivas demais no padrão RLE" );
+            return;
+        }
+        for ( long long k = 0; k < n; k++ ) {
+            engine.set( originLine + patternLine, originColumn + patternColumn + k, true );
+        }
+        patternColumn += n;
+        cellCount += n;
+    } else {
+        fail( "caractere inesperado no padrão RLE" );
+        return;
+    }
+
+    // the runs add up, so the position is bounded too
+    if ( patternLine > MAX_NUMBER || patternColumn > MAX_NUMBER ) {
+        fail( "padrão RLE grande demais" );
+    }
+
+}
+
+void LifePatternReader::readLife106( char c ) {
+
+    if ( c >= '0' && c <= '9' ) {
+        if ( numberCount == 2 ) {
+            fail( "mais de dois números numa linha Life 1.06" );
+            return;
+        }
+        if ( !hasDigits ) {
+            numbers[numberCount] = 0;
+            hasDigits = true;
+        }
+        if ( !appendDigit( numbers[numberCount], c, MAX_NUMBER ) ) {
+            fail( "coordenada grande demais no padrão Life 1.06" );
+        }
+    } else if ( c == '-' && !hasDigits && !negative ) {
+        negative = true;
+    } else if ( c == ' ' || c == '\t' || c == '\r' ) {
+        endLife106Number();
+    } else if ( c == '\n' ) {
+        endLife106Number();
+        endLife106Line();
+    } else if ( c == '#' && numberCount == 0 && !hasDigits && !negative ) {
+        state = State::COMMENT;
+    } else {
+        fail( "caractere inesperado no padrão Life 1.06" );
+    }
+
+}
+
+void LifePatternReader::endLife106Number() {
+    if ( hasDigits ) {
+        if ( negative ) {
+            numbers[numberCount] = -numbers[numberCount];
+        }
+        numberCount++;
+    } else if ( negative ) {
+        fail( "número inválido no padrão Life 1.06" );
+    }
+    hasDigits = false;
+    negative = false;
+}
+
+/**
+ * @brief Sets the cell of a line, with its column and its line.
+ */
+void LifePatternReader::endLife106Line() {
+
+    if ( state == State::FAILED ) {
+        return;
+    }
+
+    if ( numberCount == 2 ) {
+        if ( cellCount == MAX_CELLS ) {
+            fail( "células vivas demais no padrão Life 1.06" );
+            return;
+        }
+        engine.set( centerLine + numbers[1], centerColumn + numbers[0], true );
+        cellCount++;
+    } else if ( numberCount != 0 ) {
+        fail( "linha Life 1.06 sem os dois números" );
+        return;
+    }
+
+    numberCount = 0;
+    state = State::LINE_START;
+
+}
+
+bool loadLifePattern( const char *path, LifeEngine &engine,
+                      long long centerLine, long long centerColumn, std::string &error ) {
+
+    std::FILE *file = std::fopen( path, "rb" );
+    if ( file == nullptr ) {
+        error = std::string( "não foi possível abrir " ) + path;
+        return false;
+    }
+
+    LifePatternReader reader( engine, centerLine, centerColumn );
+    std::vector<char> buffer( READ_BUFFER_SIZE );
+    size_t size;
+
+    while ( ( size = std::fread( buffer.data(), 1, buffer.size(), file ) ) > 0 ) {
+        reader.read( buffer.data(), size );
+    }
+
+    bool readError = std::ferror( file ) != 0;
+    std::fclose( file );
+
+    if ( readError ) {
+        error = std::string( "erro ao ler " ) + path;
+        return false;
+    }
+
+    if ( !reader.finish() ) {
+        error = reader.getError();
+        return false;
+    }
+
+    return true;
+
+}
+
+bool decodeLifePattern( const char *data, size_t size, LifeEngine &engine,
+                        long long centerLine, long long centerColumn, std::string &error ) {
+    LifePatternReader reader( engine, centerLine, centerColumn );
+    reader.read( data, size );
+    if ( !reader.finish() ) {
+        error = reader.getError();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes a run of an RLE pattern, breaking the lines at
+ * RLE_LINE_LENGTH characters.
+ */
+static void writeRleRun( std::FILE *file, long long length, char tag, int &lineLength ) {
+
+    char text[32];
+    int textLength = length > 1 ?
+        std::snprintf( text, sizeof( text ), "%lld%c", length, tag ) :
+        std::snprintf( text, sizeof( text ), "%c", tag );
+
+    if ( lineLength + textLength > RLE_LINE_LENGTH ) {
+        std::fputc( '\n', file );
+        lineLength = 0;
+    }
+
+    std::fputs( text, file );
+    lineLength += textLength;
+
+}
+
+/**
+ * @brief The box around the live cells and how many of its lines fit
+ * in MAX_SAVE_CELLS cells. Returns false and sets error if not even one
+ * does.
+ */
+static bool getSaveBox( const LifeEngine &engine, long long &top, long long &left,
+                        long long &width, long long &height, int &stripLines, std::string &error ) {
+
+    long long bottom, right;
+    if ( engine.getBounds( top, left, bottom, right ) ) {
+        width = right - left + 1;
+        height = bottom - top + 1;
+    } else {
+        top = left = width = height = 0;
+    }
+
+    if ( width > MAX_SAVE_CELLS ) {
+        error = "o padrão é largo demais para ser salvo";
+        return false;
+    }
+
+    stripLines = static_cast<int>( std::max( 1LL, std::min( height, MAX_SAVE_CELLS / std::max( width, 1LL ) ) ) );
+    return true;
+
+}
+
+bool saveLifePatternRle( const char *path, const LifeEngine &engine, std::string &error ) {
+
+    long long top, left, width, height;
+    int stripLines;
+    if ( !getSaveBox( engine, top, left, width, height, stripLines, error ) ) {
+        return false;
+    }
+
+    std::FILE *file = std::fopen( path, "wb" );
+    if ( file == nullptr ) {
+        error = std::string( "não foi possível criar " ) + path;
+        return false;
+    }
+
+    std::fprintf( file, "#C generation %lld\n", engine.getGeneration() );
+    std::fprintf( file, "x = %lld, y = %lld, rule = B3/S23\n", width, height );
+
+    // the line breaks and the dead cells are only written before live
+    // cells, so the ones at the end of each line and of the pattern
+    // are left out
+    std::vector<unsigned char> cells;
+    int lineLength = 0;
+    long long pendingLines = 0;
+
+    for ( long long i = 0; i < height; i += stripLines ) {
+
+        int lines = static_cast<int>( std::min<long long>( stripLines, height - i ) );
+        engine.getRegion( top + i, left, lines, static_cast<int>( width ), cells );
+
+        for ( int k = 0; k < lines; k++ ) {
+
+            const unsigned char *cellLine = &cells[static_cast<size_t>( k ) * width];
+            long long pendingDead = 0;
+            long long j = 0;
+
+            while ( j < width ) {
+                long long start = j;
+                unsigned char alive = cellLine[j];
+                while ( j < width && cellLine[j] == alive ) {
+                    j++;
+                }
+                if ( !alive ) {
+                    pendingDead = j - start;
+                    continue;
+                }
+                if ( pendingLines > 0 ) {
+                    writeRleRun( file, pendingLines, '$', lineLength );
+                    pendingLines = 0;
+                }
+                if ( pendingDead > 0 ) {
+                    writeRleRun( file, pendingDead, 'b', lineLength );
+                    pendingDead = 0;
+                }
+                writeRleRun( file, j - start, 'o', lineLength );
+            }
+
+            pendingLines++;
+
+        }
+
+    }
+
+    writeRleRun( file, 1, '!', lineLength );
+    std::fputc( '\n', file );
+
+    bool writeError = std::ferror( file ) != 0;
+    if ( std::fclose( file ) != 0 || writeError ) {
+        error = std::string( "erro ao escrever " ) + path;
+        return false;
+    }
+
+    return true;
+
+}
+
+bool saveLifePattern106( const char *path, const LifeEngine &engine, std::string &error ) {
+
+    long long top, left, width, height;
+    int stripLines;
+    if ( !getSaveBox( engine, top, left, width, height, stripLines, error ) ) {
+        return false;
+    }
+
+    std::FILE *file = std::fopen( path, "wb" );
+    if ( file == nullptr ) {
+        error = std::string( "não foi possível criar " ) + path;
+        return false;
+    }
+
+    std::fputs( "#Life 1.06\n", file );
+
+    std::vector<unsigned char> cells;
+
+    for ( long long i = 0; i < height; i += stripLines ) {
+        int lines = static_cast<int>( std::min<long long>( stripLines, height - i ) );
+        engine.getRegion( top + i, left, lines, static_cast<int>( width ), cells );
+        for ( int k = 0; k < lines; k++ ) {
+            for ( long long j = 0; j < width; j++ ) {
+                if ( cells[k*width+j] ) {
+                    std::fprintf( file, "%lld %lld\n", left + j, top + i + k );
+                }
+            }
+        }
+    }
+
+    bool writeError = std::ferror( file ) != 0;
+    if ( std::fclose( file ) != 0 || writeError ) {
+        error = std::string( "erro ao escrever " ) + path;
+        return false;
+    }
+
+    return true;
+
+}
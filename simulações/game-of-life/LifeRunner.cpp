@@ -0,0 +1,299 @@
+/**
+ * @file LifeRunner.cpp
+ * @author Prof. Dr. David Buzatto
+ * @brief LifeRunner class implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <LifeRunner.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+LifeRunner::LifeRunner( std::unique_ptr<LifeEngine> engine ) :
+        engine( std::move( engine ) ),
+        snapshots {},
+        frontSnapshot( 0 ),
+        readySnapshot( 1 ),
+        backSnapshot( 2 ),
+        readyIsNew( false ),
+        running( false ),
+        maxSpeed( false ),
+        targetRate( 10 ),
+        stepExponent( 0 ),
+        publishRequested( true ),
+        rescheduled( true ),
+        stopping( false ),
+        engineWaiters( 0 ),
+        viewportLine( 0 ),
+        viewportColumn( 0 ),
+        viewportLines( 0 ),
+        viewportColumns( 0 ),
+        viewportCellsPerPixel( 1 ),
+        steps( 0 ),
+        published( 0 ),
+        rateStart( Clock::now() ),
+        rateStartGeneration( 0 ),
+        skippedInWindow( 0 ),
+        generationsPerSecond( 0 ),
+        skippedPerSecond( 0 ),
+        lastShownSteps( 0 ) {
+    producer = std::thread( &LifeRunner::produce, this );
+}
+
+LifeRunner::~LifeRunner() {
+    {
+        std::lock_guard<std::mutex> lock( controlMutex );
+        stopping = true;
+    }
+    controlChanged.notify_one();
+    producer.join();
+}
+
+std::unique_lock<std::mutex> LifeRunner::lockEngine() {
+
+    // the producer waits while there are waiters, or at maximum speed it
+    // would take the engine again as soon as it let it go
+    {
+        std::lock_guard<std::mutex> lock( controlMutex );
+        engineWaiters++;
+    }
+
+    std::unique_lock<std::mutex> engineLock( engineMutex );
+
+    {
+        std::lock_guard<std::mutex> lock( controlMutex );
+        engineWaiters--;
+    }
+    controlChanged.notify_one();
+
+    return engineLock;
+
+}
+
+LifeEngine &LifeRunner::getEngine() {
+    return *engine;
+}
+
+void LifeRunner::setEngine( std::unique_ptr<LifeEngine> engine ) {
+    this->engine = std::move( engine );
+}
+
+void LifeRunner::setRunning( bool running ) {
+    {
+        std::lock_guard<std::mutex> lock( controlMutex );
+        this->running = running;
+        rescheduled = true;
+    }
+    controlChanged.notify_one();
+}
+
+void LifeRunner::setMaxSpeed( bool maxSpeed ) {
+    {
+        std::lock_guard<std::mutex> lock( controlMutex );
+        this->maxSpeed = maxSpeed;
+        rescheduled = true;
+    }
+    controlChanged.notify_one();
+}
+
+void LifeRunner::setTargetRate( double stepsPerSecond ) {
+    {
+        std::lock_guard<std::mutex> lock( controlMutex );
+        targetRate = stepsPerSecond;
+        rescheduled = true;
+    }
+    controlChanged.notify_one();
+}
+
+void LifeRunner::setStepExponent( int stepExponent ) {
+    std::lock_guard<std::mutex> lock( controlMutex );
+    this->stepExponent = stepExponent;
+}
+
+void LifeRunner::setViewport( long long line, long long column, int lines, int columns, int cellsPerPixel ) {
+    {
+        std::lock_guard<std::mutex> lock( controlMutex );
+        if ( line == viewportLine && column == viewportColumn &&
+             lines == viewportLines && columns == viewportColumns && 
+             cellsPerPixel == viewportCellsPerPixel ) {
+            return;
+        }
+        viewportLine = line;
+        viewportColumn = column;
+        viewportLines = lines;
+        viewportColumns = columns;
+        viewportCellsPerPixel = cellsPerPixel;
+        publishRequested = true;
+    }
+    controlChanged.notify_one();
+}
+
+void LifeRunner::requestSnapshot() {
+    {
+        std::lock_guard<std::mutex> lock( controlMutex );
+        publishRequested = true;
+    }
+    controlChanged.notify_one();
+}
+
+const LifeSnapshot &LifeRunner::acquireSnapshot() {
+
+    {
+        std::lock_guard<std::mutex> lock( bufferMutex );
+        if ( readyIsNew ) {
+            std::swap( frontSnapshot, readySnapshot );
+            readyIsNew = false;
+        }
+    }
+
+    const LifeSnapshot &snapshot = snapshots[frontSnapshot];
+
+    // the steps between two shown snapshots were never drawn
+    if ( snapshot.steps > lastShownSteps + 1 ) {
+        skippedInWindow += snapshot.steps - lastShownSteps - 1;
+    }
+    lastShownSteps = std::max( lastShownSteps, snapshot.steps );
+
+    double seconds = std::chrono::duration<double>( Clock::now() - rateStart ).count();
+    if ( seconds >= 1.0 || snapshot.generation < rateStartGeneration ) {
+        generationsPerSecond = std::max( 0.0, ( snapshot.generation - rateStartGeneration ) / seconds );
+        skippedPerSecond = skippedInWindow / seconds;
+        rateStart = Clock::now();
+        rateStartGeneration = snapshot.generation;
+        skippedInWindow = 0;
+    }
+
+    return snapshot;
+
+}
+
+double LifeRunner::getGenerationsPerSecond() const {
+    return generationsPerSecond;
+}
+
+double LifeRunner::getSkippedPerSecond() const {
+    return skippedPerSecond;
+}
+
+/**
+ * @brief The loop of the producer thread: waits for a step or for a
+ * snapshot to be asked for, and does them.
+ */
+void LifeRunner::produce() {
+
+    Clock::time_point nextStep = Clock::now();
+
+    while ( true ) {
+
+        bool doStep = false;
+        bool doPublish = false;
+        int exponent = 0;
+        bool fast = false;
+
+        {
+            std::unique_lock<std::mutex> lock( controlMutex );
+
+            while ( true ) {
+
+                if ( stopping ) {
+                    return;
+                }
+
+                if ( rescheduled ) {
+                    nextStep = Clock::now();
+                    rescheduled = false;
+                }
+
+                if ( engineWaiters > 0 ) {
+                    controlChanged.wait( lock );
+                    continue;
+                }
+
+                doStep = running && ( maxSpeed || Clock::now() >= nextStep );
+                doPublish = publishRequested;
+                if ( doStep || doPublish ) {
+                    break;
+                }
+
+                if ( running ) {
+                    controlChanged.wait_until( lock, nextStep );
+                } else {
+                    controlChanged.wait( lock );
+                }
+
+            }
+
+            if ( doStep && !maxSpeed ) {
+                // a late step does not make the next ones hurry
+                auto period = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>( 1.0 / targetRate ) );
+                nextStep = std::max( nextStep + period, Clock::now() );
+            }
+
+            publishRequested = false;
+            exponent = stepExponent;
+            fast = maxSpeed;
+        }
+
+        std::lock_guard<std::mutex> lock( engineMutex );
+
+        if ( doStep ) {
+            engine->step( std::min( exponent, engine->getMaxStepExponent() ) );
+            steps++;
+        }
+
+        // at maximum speed, only when the last snapshot was taken
+        if ( !fast || doPublish ) {
+            publish();
+        } else {
+            bool taken;
+            {
+                std::lock_guard<std::mutex> bufferLock( bufferMutex );
+                taken = !readyIsNew;
+            }
+            if ( taken ) {
+                publish();
+            }
+        }
+
+    }
+
+}
+
+/**
+ * @brief Copies the viewport into the back snapshot and exchanges it
+ * with the ready one. Only called by the producer, with the engine
+ * locked.
+ */
+void LifeRunner::publish() {
+
+    LifeSnapshot &snapshot = snapshots[backSnapshot];
+
+    {
+        std::lock_guard<std::mutex> lock( controlMutex );
+        snapshot.line = viewportLine;
+        snapshot.column = viewportColumn;
+        snapshot.lines = viewportLines;
+        snapshot.columns = viewportColumns;
+        snapshot.cellsPerPixel = viewportCellsPerPixel;
+    }
+
+    engine->getDensity( snapshot.line, snapshot.column, snapshot.lines, snapshot.columns, 
+                        snapshot.cellsPerPixel, snapshot.density );
+    snapshot.generation = engine->getGeneration();
+    snapshot.population = engine->getPopulation();
+    snapshot.steps = steps;
+    snapshot.number = ++published;
+
+    std::lock_guard<std::mutex> lock( bufferMutex );
+    std::swap( backSnapshot, readySnapshot );
+    readyIsNew = true;
+
+}
@@ -0,0 +1,440 @@
+/**
+ * @file SparseLife.cpp
+ * @author Prof. Dr. David Buzatto
+ * @brief SparseLife class implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <SparseLife.h>
+#include <LifeKernel.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+SparseLife::SparseLife() :
+        population( 0 ),
+        generation( 0 ),
+        savedPopulation( 0 ),
+        savedGeneration( 0 ) {
+}
+
+const char *SparseLife::getName() const {
+    return "sparse";
+}
+
+bool SparseLife::get( long long line, long long column ) const {
+    const Tile *tile = find( { line >> TILE_SHIFT, column >> TILE_SHIFT } );
+    if ( tile == nullptr ) {
+        return false;
+    }
+    return ( tile->cells[line & ( TILE_SIZE - 1 )] >> ( column & ( TILE_SIZE - 1 ) ) ) & 1;
+}
+
+void SparseLife::set( long long line, long long column, bool alive ) {
+
+    TileKey key { line >> TILE_SHIFT, column >> TILE_SHIFT };
+    Tile *tile = find( key );
+
+    if ( tile == nullptr ) {
+        if ( !alive ) {
+            return;
+        }
+        tile = &create( key );
+    }
+
+    uint64_t &word = tile->cells[line & ( TILE_SIZE - 1 )];
+    uint64_t bit = 1ULL << ( column & ( TILE_SIZE - 1 ) );
+    if ( ( ( word & bit ) != 0 ) == alive ) {
+        return;
+    }
+
+    word ^= bit;
+    tile->population += alive ? 1 : -1;
+    population += alive ? 1 : -1;
+    activate( key, *tile );
+
+}
+
+void SparseLife::clear() {
+    tiles.clear();
+    activeTiles.clear();
+    population = 0;
+    generation = 0;
+}
+
+void SparseLife::getRegion( long long line, long long column, int lines, int columns,
+                            std::vector<unsigned char> &cells ) const {
+
+    cells.assign( static_cast<size_t>( lines ) * columns, 0 );
+    if ( lines <= 0 || columns <= 0 ) {
+        return;
+    }
+
+    long long firstLine = line >> TILE_SHIFT;
+    long long lastLine = ( line + lines - 1 ) >> TILE_SHIFT;
+    long long firstColumn = column >> TILE_SHIFT;
+    long long lastColumn = ( column + columns - 1 ) >> TILE_SHIFT;
+
+    // looks the tiles of the region up, unless there are fewer tiles
+    // in the whole universe
+    if ( static_cast<size_t>( ( lastLine - firstLine + 1 ) * ( lastColumn - firstColumn + 1 ) ) <= tiles.size() ) {
+        for ( long long i = firstLine; i <= lastLine; i++ ) {
+            for ( long long j = firstColumn; j <= lastColumn; j++ ) {
+                const Tile *tile = find( { i, j } );
+                if ( tile != nullptr ) {
+                    copyTile( { i, j }, *tile, line, column, lines, columns, cells );
+                }
+            }
+        }
+    } else {
+        for ( const auto &[key, tile] : tiles ) {
+            if ( key.line >= firstLine && key.line <= lastLine && 
+                 key.column >= firstColumn && key.column <= lastColumn ) {
+                copyTile( key, tile, line, column, lines, columns, cells );
+            }
+        }
+    }
+
+}
+
+void SparseLife::getDensity( long long line, long long column, int lines, int columns, 
+                             int cellsPerPixel, std::vector<unsigned char> &density ) const {
+
+    std::vector<int> counts( static_cast<size_t>( lines ) * columns, 0 );
+
+    if ( lines > 0 && columns > 0 ) {
+
+        long long lastCellLine = line + static_cast<long long>( lines ) * cellsPerPixel - 1;
+        long long lastCellColumn = column + static_cast<long long>( columns ) * cellsPerPixel - 1;
+        long long firstLine = line >> TILE_SHIFT;
+        long long lastLine = lastCellLine >> TILE_SHIFT;
+        long long firstColumn = column >> TILE_SHIFT;
+        long long lastColumn = lastCellColumn >> TILE_SHIFT;
+
+        // the same choice of getRegion
+        if ( static_cast<size_t>( ( lastLine - firstLine + 1 ) * ( lastColumn - firstColumn + 1 ) ) <= tiles.size() ) {
+            for ( long long i = firstLine; i <= lastLine; i++ ) {
+                for ( long long j = firstColumn; j <= lastColumn; j++ ) {
+                    const Tile *tile = find( { i, j } );
+                    if ( tile != nullptr ) {
+                        countTile( { i, j }, *tile, line, column, lines, columns, cellsPerPixel, counts );
+                    }
+                }
+            }
+        } else {
+            for ( const auto &[key, tile] : tiles ) {
+                if ( key.line >= firstLine && key.line <= lastLine && 
+                     key.column >= firstColumn && key.column <= lastColumn ) {
+                    countTile( key, tile, line, column, lines, columns, cellsPerPixel, counts );
+                }
+            }
+        }
+
+    }
+
+    density.resize( counts.size() );
+    for ( size_t i = 0; i < counts.size(); i++ ) {
+        density[i] = toDensity( counts[i], cellsPerPixel * cellsPerPixel );
+    }
+
+}
+
+bool SparseLife::getBounds( long long &top, long long &left, 
+                            long long &bottom, long long &right ) const {
+
+    bool found = false;
+
+    for ( const auto &[key, tile] : tiles ) {
+
+        if ( tile.population == 0 ) {
+            continue;
+        }
+
+        int first = 0;
+        int last = TILE_SIZE - 1;
+        uint64_t columns = 0;
+        while ( tile.cells[first] == 0 ) {
+            first++;
+        }
+        while ( tile.cells[last] == 0 ) {
+            last--;
+        }
+        for ( int i = first; i <= last; i++ ) {
+            columns |= tile.cells[i];
+        }
+
+        long long tileTop = key.line * TILE_SIZE + first;
+        long long tileBottom = key.line * TILE_SIZE + last;
+        long long tileLeft = key.column * TILE_SIZE + std::countr_zero( columns );
+        long long tileRight = key.column * TILE_SIZE + TILE_SIZE - 1 - std::countl_zero( columns );
+
+        if ( !found ) {
+            top = tileTop;
+            bottom = tileBottom;
+            left = tileLeft;
+            right = tileRight;
+            found = true;
+        }
+
+        top = std::min( top, tileTop );
+        bottom = std::max( bottom, tileBottom );
+        left = std::min( left, tileLeft );
+        right = std::max( right, tileRight );
+
+    }
+
+    return found;
+
+}
+
+long long SparseLife::getPopulation() const {
+    return population;
+}
+
+long long SparseLife::getGeneration() const {
+    return generation;
+}
+
+int SparseLife::getMaxStepExponent() const {
+    return MAX_STEP_EXPONENT;
+}
+
+void SparseLife::step( int exponent ) {
+    for ( long long g = 0; g < ( 1LL << exponent ); g++ ) {
+        step();
+    }
+}
+
+void SparseLife::step() {
+
+    // the active tiles and the tiles around them, the missing ones only
+    // if live cells of the active tile touch them
+    computedTiles.clear();
+
+    for ( const TileKey &key : activeTiles ) {
+
+        Tile *tile = find( key );
+        uint64_t columns = 0;
+
+        if ( tile != nullptr ) {
+            tile->active = false;
+            for ( int i = 0; i < TILE_SIZE; i++ ) {
+                columns |= tile->cells[i];
+            }
+        }
+
+        for ( int di = -1; di <= 1; di++ ) {
+            for ( int dj = -1; dj <= 1; dj++ ) {
+
+                TileKey neighborKey { key.line + di, key.column + dj };
+                Tile *neighbor = find( neighborKey );
+
+                if ( neighbor == nullptr ) {
+                    if ( tile == nullptr ) {
+                        continue;
+                    }
+                    uint64_t border = di < 0 ? tile->cells[0] : di > 0 ? tile->cells[TILE_SIZE-1] : columns;
+                    uint64_t mask = dj < 0 ? 1ULL : dj > 0 ? 1ULL << ( TILE_SIZE - 1 ) : ~0ULL;
+                    if ( ( border & mask ) == 0 ) {
+                        continue;
+                    }
+                    neighbor = &create( neighborKey );
+                }
+
+                if ( neighbor->computedGeneration != generation ) {
+                    neighbor->computedGeneration = generation;
+                    computedTiles.push_back( { neighborKey, neighbor } );
+                }
+
+            }
+        }
+
+    }
+
+    for ( const TileRef &ref : computedTiles ) {
+        computeNext( ref.key, *ref.tile );
+    }
+
+    // the tiles that changed are the active ones of the next generation
+    activeTiles.clear();
+
+    for ( const TileRef &ref : computedTiles ) {
+
+        Tile &tile = *ref.tile;
+        bool changed = false;
+        int tilePopulation = 0;
+
+        for ( int i = 0; i < TILE_SIZE; i++ ) {
+            changed |= tile.cells[i] != tile.nextCells[i];
+            tilePopulation += std::popcount( tile.nextCells[i] );
+            tile.cells[i] = tile.nextCells[i];
+        }
+
+        population += tilePopulation - tile.population;
+        tile.population = tilePopulation;
+
+        if ( changed ) {
+            activate( ref.key, tile );
+        }
+
+    }
+
+    for ( const TileRef &ref : computedTiles ) {
+        if ( ref.tile->population == 0 ) {
+            tiles.erase( ref.key );
+        }
+    }
+
+    computedTiles.clear();
+    generation++;
+
+}
+
+void SparseLife::save() {
+    savedTiles = tiles;
+    savedActiveTiles = activeTiles;
+    savedPopulation = population;
+    savedGeneration = generation;
+}
+
+void SparseLife::restore() {
+    tiles = savedTiles;
+    activeTiles = savedActiveTiles;
+    population = savedPopulation;
+    generation = savedGeneration;
+}
+
+size_t SparseLife::getTileCount() const {
+    return tiles.size();
+}
+
+size_t SparseLife::getActiveTileCount() const {
+    return activeTiles.size();
+}
+
+SparseLife::Tile *SparseLife::find( const TileKey &key ) {
+    auto it = tiles.find( key );
+    return it == tiles.end() ? nullptr : &it->second;
+}
+
+const SparseLife::Tile *SparseLife::find( const TileKey &key ) const {
+    auto it = tiles.find( key );
+    return it == tiles.end() ? nullptr : &it->second;
+}
+
+SparseLife::Tile &SparseLife::create( const TileKey &key ) {
+    Tile &tile = tiles[key];
+    std::fill( tile.cells, tile.cells + TILE_SIZE, 0 );
+    tile.population = 0;
+    tile.computedGeneration = -1;
+    tile.active = false;
+    return tile;
+}
+
+void SparseLife::activate( const TileKey &key, Tile &tile ) {
+    if ( !tile.active ) {
+        tile.active = true;
+        activeTiles.push_back( key );
+    }
+}
+
+/**
+ * @brief Computes the next generation of the tile into its nextCells,
+ * with the borders taken from the tiles around it.
+ */
+void SparseLife::computeNext( const TileKey &key, Tile &tile ) {
+
+    const Tile *around[3][3];
+    for ( int di = -1; di <= 1; di++ ) {
+        for ( int dj = -1; dj <= 1; dj++ ) {
+            around[di+1][dj+1] = find( { key.line + di, key.column + dj } );
+        }
+    }
+
+    // the lines of the tile and the ones above and below it, each with
+    // its words shifted one column to each side
+    uint64_t center[TILE_SIZE+2];
+    uint64_t west[TILE_SIZE+2];
+    uint64_t east[TILE_SIZE+2];
+
+    for ( int i = -1; i <= TILE_SIZE; i++ ) {
+
+        int row = i < 0 ? 0 : i < TILE_SIZE ? 1 : 2;
+        int line = i < 0 ? TILE_SIZE - 1 : i < TILE_SIZE ? i : 0;
+
+        const Tile *w = around[row][0];
+        const Tile *c = around[row][1];
+        const Tile *e = around[row][2];
+
+        uint64_t word = c != nullptr ? c->cells[line] : 0;
+        center[i+1] = word;
+        west[i+1] = ( word << 1 ) | ( w != nullptr ? w->cells[line] >> ( TILE_SIZE - 1 ) : 0 );
+        east[i+1] = ( word >> 1 ) | ( e != nullptr ? e->cells[line] << ( TILE_SIZE - 1 ) : 0 );
+
+    }
+
+    for ( int i = 0; i < TILE_SIZE; i++ ) {
+        tile.nextCells[i] = nextLifeWord( 
+            west[i], center[i], east[i],
+            west[i+1], center[i+1], east[i+1],
+            west[i+2], center[i+2], east[i+2] );
+    }
+
+}
+
+/**
+ * @brief Adds the live cells of the tile to the counts of the squares
+ * of the region.
+ */
+void SparseLife::countTile( const TileKey &key, const Tile &tile, long long line, long long column,
+                            int lines, int columns, int cellsPerPixel, std::vector<int> &counts ) const {
+
+    long long tileLine = key.line * TILE_SIZE;
+    long long tileColumn = key.column * TILE_SIZE;
+    long long regionColumns = static_cast<long long>( columns ) * cellsPerPixel;
+
+    long long first = std::max( line, tileLine );
+    long long last = std::min( line + static_cast<long long>( lines ) * cellsPerPixel, tileLine + TILE_SIZE );
+
+    for ( long long i = first; i < last; i++ ) {
+        uint64_t word = tile.cells[i - tileLine];
+        int *lineCounts = &counts[( i - line ) / cellsPerPixel * columns];
+        while ( word != 0 ) {
+            long long j = tileColumn + std::countr_zero( word ) - column;
+            if ( j >= 0 && j < regionColumns ) {
+                lineCounts[j / cellsPerPixel]++;
+            }
+            word &= word - 1;
+        }
+    }
+
+}
+
+/**
+ * @brief Writes the live cells of the tile that are in the region.
+ */
+void SparseLife::copyTile( const TileKey &key, const Tile &tile, long long line, long long column,
+                           int lines, int columns, std::vector<unsigned char> &cells ) const {
+
+    long long tileLine = key.line * TILE_SIZE;
+    long long tileColumn = key.column * TILE_SIZE;
+
+    long long first = std::max( line, tileLine );
+    long long last = std::min( line + lines, tileLine + TILE_SIZE );
+
+    for ( long long i = first; i < last; i++ ) {
+        uint64_t word = tile.cells[i - tileLine];
+        while ( word != 0 ) {
+            long long j = tileColumn + std::countr_zero( word );
+            if ( j >= column && j < column + columns ) {
+                cells[( i - line ) * columns + ( j - column )] = 1;
+            }
+            word &= word - 1;
+        }
+    }
+
+}
@@ -11,6 +11,12 @@
 #include <raylib.h>
 #include <Drawable.h>
 #include <GameState.h>
+#include <LifeEngine.h>
+#include <LifeRunner.h>
+
+#include <memory>
+#include <string>
+#include <vector>
 
 class GameWorld : public virtual Drawable {
 
@@ -19,27 +25,61 @@ class GameWorld : public virtual Drawable {
     int lines;
     int columns;
 
-    int *evolutionArray;
-    int *resetArray;
-    int *newGeneration;
-    int evolutionArraySize;
+    // computes the generations of the sparse universe, the packed
+    // board or HashLife, switched with H, in a thread of its own
+    LifeRunner runner;
+    const LifeSnapshot *snapshot;
+    const char *engineName;
+    int maxStepExponent;
+    int stepExponent;           // 2^stepExponent generations per step
+
+    // the largest square of cells copied between engines
+    const long long MAX_SWITCH_SIZE = 4096;
 
+    // the zoom levels below 0 show 2^-zoom x 2^-zoom cells in each
+    // pixel, by their density
+    const int MIN_ZOOM = -4;
     const int MAX_ZOOM = 6;
     const int allowedCellWidths[8] = { 1, 2, 4, 8, 12, 24, 48 };
     int currentZoom = 5;
     int cellWidth;
-
-    int startLine;
-    int endLine;
-    int startColumn;
-    int endColumn;
+    int cellsPerPixel;
+
+    // the snapshot as a texture of one texel per square of cells, and a
+    // tile of 10x10 cells of the grid repeated over the screen, only
+    // drawn from MIN_GRID_CELL_WIDTH pixels per cell
+    const int MIN_GRID_CELL_WIDTH = 4;
+    Texture2D cellsTexture;
+    std::vector<unsigned char> pixels;
+    long long uploadedSnapshot;
+    Texture2D gridTexture;
+    int gridCellWidth;
+
+    // the cell at the center of the screen, moved with WASD or by
+    // dragging with the middle button
+    long long viewLine;
+    long long viewColumn;
+    Vector2 dragRemainder;
+
+    long long startLine;
+    long long endLine;
+    long long startColumn;
+    long long endColumn;
 
     bool drawGrid;
 
-    float currentTime;
-    float timeToWait;
+    // steps per second, changed with UP and DOWN, or as fast as
+    // possible, toggled with M
+    static constexpr int RATE_COUNT = 11;
+    const double targetRates[RATE_COUNT] = { 1, 2, 3, 5, 10, 20, 30, 60, 120, 240, 480 };
+    int currentRate;
+    bool maxSpeed;
+
     GameState state;
 
+    // of the last pattern loaded or saved
+    std::string message;
+
 public:
 
     /**
@@ -66,8 +106,12 @@ public:
 
 private:
 
-    void createNewGeneration();
-    int countNeighbors( int line, int column );
+    void switchEngine();
+    void setCell( bool alive );
+    void loadPattern( const char *path );
+    void savePattern();
+    void updateTextures();
+    void pan();
 
     /**
      * @brief Load game resources like images, textures, sounds, fonts, shaders,
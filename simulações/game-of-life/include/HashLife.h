@@ -0,0 +1,156 @@
+/**
+ * @file HashLife.h
+ * @author Prof. Dr. David Buzatto
+ * @brief HashLife class declaration. An unbounded Game of Life engine
+ * based on Bill Gosper's HashLife.
+ *
+ * The universe is a quadtree: a node of level k is a square of 2^k x
+ * 2^k cells made of four nodes of level k - 1, and the nodes of level
+ * 0 are the dead and the alive cell. Every node is unique (equal
+ * squares are the same node, found in a hash table by its four
+ * children), so a pattern that repeats in space is stored once. The
+ * result of a node of level k is its center, of level k - 1, advanced
+ * 2^min( j, k - 2 ) generations, where 2^j is the current step; it is
+ * computed from the results of nine nodes of level k - 1 and kept in
+ * the node, so a pattern that repeats in space or in time is computed
+ * once too, what lets periodic patterns advance billions of generations
+ * in a few steps.
+ *
+ * The results are only valid for the step they were computed with and
+ * are discarded when it changes. When there are more nodes than fit in
+ * the memory limit, the ones that can not be reached from the universe
+ * (or the saved one) are collected between steps and changes of
+ * cells; if that is not enough, the results are discarded too, so a
+ * single step may still go over the limit.
+ *
+ * The root is centered at line 0 and column 0 and grows as needed, up
+ * to MAX_LEVEL.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <LifeEngine.h>
+
+class HashLife : public LifeEngine {
+
+    struct Node {
+        Node *nw;               // children, NULL at level 0
+        Node *ne;
+        Node *sw;
+        Node *se;
+        Node *result;           // of the current step, or NULL
+        long long population;
+        int level;
+        bool marked;            // reachable, while collecting garbage
+    };
+
+    static constexpr int NODE_BLOCK_SIZE = 1 << 16;
+    static constexpr int MIN_ROOT_LEVEL = 3;
+    static constexpr int MAX_LEVEL = 62;             // coordinates fit in long long
+
+    // a step needs a root of level exponent + 2, expanded once more
+    static constexpr int MAX_STEP_EXPONENT = MAX_LEVEL - 3;
+
+    // nodes are allocated in blocks, so they never move, and the freed
+    // ones are linked through nw
+    std::vector<std::unique_ptr<Node[]>> blocks;
+    int usedInLastBlock;
+    Node *freeNodes;
+    size_t nodeCount;
+    size_t nodeLimit;
+    size_t collectThreshold;
+
+    // open addressing, at most half full
+    std::vector<Node*> table;
+
+    Node deadCell;
+    Node aliveCell;
+    std::vector<Node*> emptyNodes;  // of each level
+
+    Node *root;
+    long long generation;
+    int resultExponent;
+
+    Node *savedRoot;
+    long long savedGeneration;
+
+    Node *allocateNode();
+    Node *join( Node *nw, Node *ne, Node *sw, Node *se );
+    void insert( Node *node );
+    void growTable();
+
+    Node *getEmpty( int level );
+    Node *expand( Node *node );
+    bool isCentered( const Node *node ) const;
+    Node *center( Node *node );
+    Node *getResult( Node *node );
+    Node *getBaseResult( Node *node );
+
+    Node *setCell( Node *node, long long line, long long column, bool alive );
+    void fillRegion( const Node *node, long long nodeLine, long long nodeColumn,
+                     long long line, long long column, int lines, int columns,
+                     std::vector<unsigned char> &cells ) const;
+
+    void fillDensity( const Node *node, long long nodeLine, long long nodeColumn,
+                      long long line, long long column, int lines, int columns,
+                      int cellsPerPixel, std::vector<int> &counts ) const;
+    void fillBounds( const Node *node, long long nodeLine, long long nodeColumn, 
+                     long long &top, long long &left, long long &bottom, long long &right, 
+                     bool &found ) const;
+
+    void clearResults();
+    void mark( Node *node );
+    void collectGarbage();
+    void collectIfFull();
+
+public:
+
+    /**
+     * @brief Construct a new HashLife object with every cell dead, that
+     * keeps its nodes in about memoryLimit bytes.
+     */
+    HashLife( size_t memoryLimit = 256 * 1024 * 1024 );
+
+    HashLife( const HashLife& ) = delete;
+    HashLife &operator=( const HashLife& ) = delete;
+
+    virtual const char *getName() const;
+
+    virtual bool get( long long line, long long column ) const;
+    virtual void set( long long line, long long column, bool alive );
+    virtual void clear();
+    virtual void getRegion( long long line, long long column, int lines, int columns,
+                            std::vector<unsigned char> &cells ) const;
+
+    /**
+     * @brief Adds the population of whole nodes that fit in a square,
+     * so the cost follows the squares, not the cells.
+     */
+    virtual void getDensity( long long line, long long column, int lines, int columns, 
+                             int cellsPerPixel, std::vector<unsigned char> &density ) const;
+
+    virtual bool getBounds( long long &top, long long &left, 
+                            long long &bottom, long long &right ) const;
+
+    virtual long long getPopulation() const;
+    virtual long long getGeneration() const;
+    virtual int getMaxStepExponent() const;
+
+    /**
+     * @brief Advances 2^exponent generations at once. Does nothing if
+     * the generation would not fit in long long or if the pattern would
+     * need a root above MAX_LEVEL.
+     */
+    virtual void step( int exponent );
+
+    virtual void save();
+    virtual void restore();
+
+    size_t getNodeCount() const;
+
+};
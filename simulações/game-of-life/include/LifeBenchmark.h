@@ -0,0 +1,26 @@
+/**
+ * @file LifeBenchmark.h
+ * @author Prof. Dr. David Buzatto
+ * @brief Headless benchmark of the Game of Life kernels.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+/**
+ * @brief Runs a random 960x960 board with the original kernel, one int
+ * per cell with the neighbors counted one by one, and with the packed
+ * kernel of LifeBoard, printing the generations per second of each,
+ * then the sparse universe of SparseLife against the packed board with
+ * the whole board alive and with four gliders. Returns false if the
+ * boards of any two kernels end different.
+ */
+bool runLifeBenchmark();
+
+/**
+ * @brief Saves a random PATTERN_SIZE x PATTERN_SIZE pattern in RLE and
+ * in Life 1.06 to the temporary directory and loads both files into
+ * each engine, printing the time and the speed of each load and of the
+ * saves. Returns false if any load does not give the same cells.
+ */
+bool runPatternBenchmark();
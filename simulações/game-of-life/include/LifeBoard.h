@@ -0,0 +1,93 @@
+/**
+ * @file LifeBoard.h
+ * @author Prof. Dr. David Buzatto
+ * @brief LifeBoard class declaration. A bounded Game of Life board with
+ * 64 cells packed in each word, where the cells out of the board are
+ * always dead.
+ *
+ * Bit k of word w of a line is the cell of column w * 64 + k. A new
+ * generation is computed a whole word at a time: the neighbors of each
+ * bit are the words of the lines above and below and the words shifted
+ * one column to each side, and their count is added bit by bit with
+ * full adders made of logical operations, so each of the 64 cells of a
+ * word gets the bits of its own count. The lines above the first and
+ * below the last are kept dead, so no bounds are checked, and the new
+ * generation goes to a second board that is swapped with the current
+ * one.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <LifeEngine.h>
+
+class LifeBoard : public LifeEngine {
+
+    static constexpr int MAX_STEP_EXPONENT = 8;
+
+    int lines;
+    int columns;
+    int words;                  // per line
+
+    // lines + 2 lines of words, the first and the last always dead
+    std::vector<uint64_t> cells;
+    std::vector<uint64_t> nextCells;
+
+    uint64_t lastWordMask;      // columns of the last word of a line
+    long long generation;
+
+    std::vector<uint64_t> savedCells;
+    long long savedGeneration;
+
+public:
+
+    /**
+     * @brief Construct a new LifeBoard object with every cell dead.
+     */
+    LifeBoard( int lines, int columns );
+
+    int getLines() const;
+    int getColumns() const;
+
+    virtual const char *getName() const;
+
+    /**
+     * @brief Returns false for the cells out of the board.
+     */
+    virtual bool get( long long line, long long column ) const;
+
+    /**
+     * @brief Ignores the cells out of the board.
+     */
+    virtual void set( long long line, long long column, bool alive );
+
+    virtual void clear();
+    virtual void getRegion( long long line, long long column, int lines, int columns, 
+                            std::vector<unsigned char> &cells ) const;
+    virtual void getDensity( long long line, long long column, int lines, int columns, 
+                             int cellsPerPixel, std::vector<unsigned char> &density ) const;
+
+    virtual bool getBounds( long long &top, long long &left, 
+                            long long &bottom, long long &right ) const;
+
+    virtual long long getPopulation() const;
+    virtual long long getGeneration() const;
+    virtual int getMaxStepExponent() const;
+
+    /**
+     * @brief Computes 2^exponent generations, one by one.
+     */
+    virtual void step( int exponent );
+
+    /**
+     * @brief Computes the next generation.
+     */
+    void step();
+
+    virtual void save();
+    virtual void restore();
+
+};
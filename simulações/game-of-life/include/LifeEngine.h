@@ -0,0 +1,83 @@
+/**
+ * @file LifeEngine.h
+ * @author Prof. Dr. David Buzatto
+ * @brief LifeEngine class declaration. The interface of the engines
+ * that compute the generations of the Game of Life, so GameWorld can
+ * use any of them.
+ *
+ * The cells are addressed by line and column; an engine may be bounded
+ * (the cells out of its board are always dead) or not.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <vector>
+
+class LifeEngine {
+
+public:
+
+    static constexpr int MIN_DENSITY = 64;
+
+    virtual ~LifeEngine() = default;
+
+    virtual const char *getName() const = 0;
+
+    virtual bool get( long long line, long long column ) const = 0;
+    virtual void set( long long line, long long column, bool alive ) = 0;
+    virtual void clear() = 0;
+
+    /**
+     * @brief Writes the cells of the region of lines x columns cells that
+     * starts at line and column into cells, one byte per cell (1 if
+     * alive), line by line.
+     */
+    virtual void getRegion( long long line, long long column, int lines, int columns, 
+                            std::vector<unsigned char> &cells ) const = 0;
+
+    /**
+     * @brief Writes the density of the region of lines x columns squares
+     * of cellsPerPixel x cellsPerPixel cells that starts at line and
+     * column into density, one byte per square, line by line: 0 if
+     * every cell is dead, 255 if every cell is alive and at least
+     * MIN_DENSITY if any is, so a lone cell is still seen.
+     */
+    virtual void getDensity( long long line, long long column, int lines, int columns, 
+                             int cellsPerPixel, std::vector<unsigned char> &density ) const = 0;
+
+    /**
+     * @brief The first and last lines and columns with live cells.
+     * Returns false if there are none.
+     */
+    virtual bool getBounds( long long &top, long long &left, 
+                            long long &bottom, long long &right ) const = 0;
+
+    virtual long long getPopulation() const = 0;
+    virtual long long getGeneration() const = 0;
+
+    /**
+     * @brief The greatest exponent accepted by step.
+     */
+    virtual int getMaxStepExponent() const = 0;
+
+    /**
+     * @brief Advances 2^exponent generations.
+     */
+    virtual void step( int exponent ) = 0;
+
+    /**
+     * @brief Keeps the current state, to be brought back by restore.
+     */
+    virtual void save() = 0;
+    virtual void restore() = 0;
+
+protected:
+
+    /**
+     * @brief The density of a square of area cells with count of them
+     * alive.
+     */
+    static unsigned char toDensity( int count, int area );
+
+};
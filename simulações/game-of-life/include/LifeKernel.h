@@ -0,0 +1,53 @@
+/**
+ * @file LifeKernel.h
+ * @author Prof. Dr. David Buzatto
+ * @brief The bit sliced kernel shared by the packed engines: the next
+ * state of 64 cells of a word, computed at once.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Adds three bits of each column, into the bit of ones and the
+ * bit of twos.
+ */
+inline void addThree( uint64_t a, uint64_t b, uint64_t c, uint64_t &ones, uint64_t &twos ) {
+    uint64_t t = a ^ b;
+    ones = t ^ c;
+    twos = ( a & b ) | ( t & c );
+}
+
+/**
+ * @brief The next state of the cells of word c. a and b are the words
+ * of the lines above and below, and the West and East words are the
+ * words shifted one column, so bit k of each holds the neighbor of
+ * bit k to that side.
+ */
+inline uint64_t nextLifeWord( uint64_t aWest, uint64_t a, uint64_t aEast,
+                              uint64_t cWest, uint64_t c, uint64_t cEast,
+                              uint64_t bWest, uint64_t b, uint64_t bEast ) {
+
+    // the counts of the line above (0 to 3), of the line below
+    // (0 to 3) and of the two sides (0 to 2)
+    uint64_t aOnes, aTwos, bOnes, bTwos;
+    addThree( aWest, a, aEast, aOnes, aTwos );
+    addThree( bWest, b, bEast, bOnes, bTwos );
+    uint64_t cOnes = cWest ^ cEast;
+    uint64_t cTwos = cWest & cEast;
+
+    // count = ones + 2 * ( aTwos + bTwos + cTwos + carry )
+    uint64_t ones, carry;
+    addThree( aOnes, bOnes, cOnes, ones, carry );
+
+    // the twos must add to exactly one, so the count is 2 or 3
+    uint64_t twosOnes, twosTwos;
+    addThree( aTwos, bTwos, cTwos, twosOnes, twosTwos );
+    uint64_t oneTwo = ~twosTwos & ( twosOnes ^ carry );
+
+    // 3 neighbors or 2 neighbors and alive
+    return oneTwo & ( ones | c );
+
+}
@@ -0,0 +1,139 @@
+/**
+ * @file LifePattern.h
+ * @author Prof. Dr. David Buzatto
+ * @brief LifePatternReader class declaration and the functions that
+ * load and save Game of Life patterns in the RLE and Life 1.06
+ * formats.
+ *
+ * The reader is a state machine fed with pieces of the file as they
+ * are read, of any size, that sets each live cell in the engine as soon
+ * as it is decoded, so a pattern of many megabytes is never kept in
+ * memory, as text or as cells. The format is found by the first line:
+ * "#Life 1.06" for Life 1.06, where each line has the column and the
+ * line of a live cell, or RLE otherwise, where "x = w, y = h" is
+ * followed by runs of dead (b) and live (o) cells, with $ ending a line
+ * and ! ending the pattern. Only the rule B3/S23 is accepted, and a
+ * pattern with a run, a coordinate or a count of live cells above the
+ * limits below is rejected.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <LifeEngine.h>
+
+class LifePatternReader {
+
+    enum class State {
+        LINE_START,
+        FIRST_LINE,         // a # line, that may be the Life 1.06 one
+        COMMENT,
+        RLE_HEADER,
+        RLE_BODY,
+        LIFE_106_NUMBERS,
+        DONE,
+        FAILED
+    };
+
+    enum class Format {
+        UNKNOWN,
+        RLE,
+        LIFE_106
+    };
+
+    // the engine is locked while a pattern is read, so it may not have
+    // runs or cells that take long to set, nor reach coordinates that
+    // do not fit in long long
+    static constexpr int MAX_LINE = 256;
+    static constexpr long long MAX_NUMBER = 1LL << 40;     // coordinates and sizes
+    static constexpr long long MAX_RUN = 1LL << 20;        // cells of an RLE run
+    static constexpr long long MAX_CELLS = 1LL << 26;      // live cells
+
+    LifeEngine &engine;
+    long long centerLine;
+    long long centerColumn;
+
+    State state;
+    Format format;
+    bool firstLine;
+
+    // the first line and the RLE header, the only text kept
+    char line[MAX_LINE];
+    int lineLength;
+
+    // the position of the next RLE cell and the run being read
+    long long originLine;
+    long long originColumn;
+    long long patternLine;
+    long long patternColumn;
+    long long count;
+    bool hasCount;
+
+    // the numbers of a Life 1.06 line
+    long long numbers[2];
+    int numberCount;
+    bool negative;
+    bool hasDigits;
+
+    long long cellCount;
+    std::string error;
+
+    void fail( const char *message );
+    void readLine( char c );
+    void readHeader();
+    void readRle( char c );
+    void readLife106( char c );
+    void endLife106Number();
+    void endLife106Line();
+
+public:
+
+    /**
+     * @brief Construct a new LifePatternReader object, that centers an
+     * RLE pattern at centerLine and centerColumn, and puts the cell 0 0
+     * of a Life 1.06 pattern there.
+     */
+    LifePatternReader( LifeEngine &engine, long long centerLine, long long centerColumn );
+
+    /**
+     * @brief Decodes the next piece of the pattern.
+     */
+    void read( const char *data, size_t size );
+
+    /**
+     * @brief Ends the pattern, returning false if it was not valid.
+     */
+    bool finish();
+
+    long long getCellCount() const;
+    const std::string &getError() const;
+
+};
+
+/**
+ * @brief Loads the pattern of the file into the engine, a piece at a
+ * time. Returns false and sets error if it can not be read.
+ */
+bool loadLifePattern( const char *path, LifeEngine &engine,
+                      long long centerLine, long long centerColumn, std::string &error );
+
+/**
+ * @brief Loads a pattern in memory into the engine.
+ */
+bool decodeLifePattern( const char *data, size_t size, LifeEngine &engine,
+                      long long centerLine, long long centerColumn, std::string &error );
+
+/**
+ * @brief Saves the live cells of the engine in RLE, the box around them
+ * read in strips of lines. Fails if a line of the box is too wide.
+ */
+bool saveLifePatternRle( const char *path, const LifeEngine &engine, std::string &error );
+
+/**
+ * @brief Saves the live cells of the engine in Life 1.06, with their
+ * own lines and columns, so loading it at 0 0 puts them back.
+ */
+bool saveLifePattern106( const char *path, const LifeEngine &engine, std::string &error );
@@ -0,0 +1,153 @@
+/**
+ * @file LifeRunner.h
+ * @author Prof. Dr. David Buzatto
+ * @brief LifeRunner class declaration. Computes the generations of an
+ * engine in a thread of its own, so drawing and input never wait for
+ * them.
+ *
+ * After a step the producer thread copies the density of the region of
+ * the viewport, with the generation and the population, into a
+ * snapshot of a triple buffer: it writes the back snapshot and
+ * exchanges it with the ready one, and the render thread exchanges the
+ * ready snapshot with the front one when there is a newer one, so each
+ * side always has a snapshot of its own and the front one is the
+ * newest completed. Steps happen at a target rate or, at maximum
+ * speed, one after the other, and then a snapshot is only copied when
+ * the last one was taken.
+ *
+ * The engine may only be used by other threads while locked with
+ * lockEngine, what holds the producer between steps: the producer does
+ * not start another step while a thread waits for the lock.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <LifeEngine.h>
+
+struct LifeSnapshot {
+    long long line;                 // of the first cell
+    long long column;
+    int lines;                      // of squares of cells
+    int columns;
+    int cellsPerPixel;              // the side of the squares
+    std::vector<unsigned char> density;
+    long long generation;
+    long long population;
+    long long steps;                // computed by the runner so far
+    long long number;               // of the snapshot, to know a new one
+};
+
+class LifeRunner {
+
+    using Clock = std::chrono::steady_clock;
+
+    std::unique_ptr<LifeEngine> engine;
+    std::mutex engineMutex;
+
+    // triple buffer, the indexes exchanged under bufferMutex
+    LifeSnapshot snapshots[3];
+    int frontSnapshot;
+    int readySnapshot;
+    int backSnapshot;
+    bool readyIsNew;
+    std::mutex bufferMutex;
+
+    // control, set by the render thread
+    std::mutex controlMutex;
+    std::condition_variable controlChanged;
+    bool running;
+    bool maxSpeed;
+    double targetRate;              // steps per second
+    int stepExponent;
+    bool publishRequested;
+    bool rescheduled;
+    bool stopping;
+    int engineWaiters;              // threads in lockEngine
+    long long viewportLine;
+    long long viewportColumn;
+    int viewportLines;
+    int viewportColumns;
+    int viewportCellsPerPixel;
+
+    long long steps;
+    long long published;
+
+    // measured by the render thread, a window of about one second
+    Clock::time_point rateStart;
+    long long rateStartGeneration;
+    long long skippedInWindow;
+    double generationsPerSecond;
+    double skippedPerSecond;
+    long long lastShownSteps;
+
+    std::thread producer;
+
+    void produce();
+    void publish();
+
+public:
+
+    /**
+     * @brief Construct a new LifeRunner object, stopped, and starts its
+     * thread.
+     */
+    LifeRunner( std::unique_ptr<LifeEngine> engine );
+
+    /**
+     * @brief Stops the thread and destroy the LifeRunner object.
+     */
+    ~LifeRunner();
+
+    LifeRunner( const LifeRunner& ) = delete;
+    LifeRunner &operator=( const LifeRunner& ) = delete;
+
+    /**
+     * @brief Holds the producer, so the engine can be used until the
+     * lock is released.
+     */
+    std::unique_lock<std::mutex> lockEngine();
+
+    /**
+     * @brief The engine, only while locked.
+     */
+    LifeEngine &getEngine();
+    void setEngine( std::unique_ptr<LifeEngine> engine );
+
+    void setRunning( bool running );
+    void setMaxSpeed( bool maxSpeed );
+    void setTargetRate( double stepsPerSecond );
+    void setStepExponent( int stepExponent );
+
+    /**
+     * @brief Sets the region copied into the snapshots, of lines x columns
+     * squares of cellsPerPixel x cellsPerPixel cells, asking for a new
+     * snapshot when it changes.
+     */
+    void setViewport( long long line, long long column, int lines, int columns, int cellsPerPixel );
+
+    /**
+     * @brief Asks for a new snapshot without a step, after the engine
+     * was changed.
+     */
+    void requestSnapshot();
+
+    /**
+     * @brief The newest completed snapshot, valid until the next call.
+     * Should be called once per frame by the render thread, that
+     * measures the generations per second and the steps that were
+     * never shown.
+     */
+    const LifeSnapshot &acquireSnapshot();
+
+    double getGenerationsPerSecond() const;
+    double getSkippedPerSecond() const;
+
+};
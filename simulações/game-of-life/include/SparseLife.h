@@ -0,0 +1,128 @@
+/**
+ * @file SparseLife.h
+ * @author Prof. Dr. David Buzatto
+ * @brief SparseLife class declaration. An unbounded Game of Life
+ * universe made of tiles of 64x64 cells kept in a hash map.
+ *
+ * Each tile is 64 words, one per line, computed with the same packed
+ * kernel of LifeBoard; the lines and the columns at its borders come
+ * from the eight tiles around it. Only the tiles that are active (that
+ * changed in the last generation or were edited) and the ones around
+ * them are computed, since a tile whose neighborhood did not change
+ * can not change, so the cost of a generation follows the activity
+ * instead of the size of the universe. A missing tile is dead: it is
+ * only created when live cells of an active tile touch it, and the
+ * tiles that die are freed.
+ *
+ * Tile (i, j) holds lines i * 64 to i * 64 + 63 and columns j * 64 to
+ * j * 64 + 63, for any line and column.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <LifeEngine.h>
+
+class SparseLife : public LifeEngine {
+
+    static constexpr int TILE_SIZE = 64;
+    static constexpr int TILE_SHIFT = 6;
+    static constexpr int MAX_STEP_EXPONENT = 8;
+
+    struct TileKey {
+        long long line;
+        long long column;
+        bool operator==( const TileKey &other ) const = default;
+    };
+
+    struct TileKeyHash {
+        size_t operator()( const TileKey &key ) const {
+            uint64_t h = static_cast<uint64_t>( key.line ) * 0x9e3779b97f4a7c15ULL;
+            h ^= static_cast<uint64_t>( key.column ) + 0x632be59bd9b4e019ULL + ( h << 6 ) + ( h >> 2 );
+            return static_cast<size_t>( h ^ ( h >> 31 ) );
+        }
+    };
+
+    struct Tile {
+        uint64_t cells[TILE_SIZE];
+        uint64_t nextCells[TILE_SIZE];
+        int population;
+        long long computedGeneration;   // so it is computed once
+        bool active;                    // in activeTiles
+    };
+
+    struct TileRef {
+        TileKey key;
+        Tile *tile;
+    };
+
+    // the nodes of an unordered_map do not move, so the tiles can be
+    // pointed to while others are created
+    std::unordered_map<TileKey, Tile, TileKeyHash> tiles;
+    std::vector<TileKey> activeTiles;
+    std::vector<TileRef> computedTiles;
+
+    long long population;
+    long long generation;
+
+    std::unordered_map<TileKey, Tile, TileKeyHash> savedTiles;
+    std::vector<TileKey> savedActiveTiles;
+    long long savedPopulation;
+    long long savedGeneration;
+
+    Tile *find( const TileKey &key );
+    const Tile *find( const TileKey &key ) const;
+    Tile &create( const TileKey &key );
+    void activate( const TileKey &key, Tile &tile );
+    void computeNext( const TileKey &key, Tile &tile );
+    void countTile( const TileKey &key, const Tile &tile, long long line, long long column,
+                    int lines, int columns, int cellsPerPixel, std::vector<int> &counts ) const;
+    void copyTile( const TileKey &key, const Tile &tile, long long line, long long column,
+                   int lines, int columns, std::vector<unsigned char> &cells ) const;
+
+public:
+
+    /**
+     * @brief Construct a new SparseLife object with every cell dead.
+     */
+    SparseLife();
+
+    virtual const char *getName() const;
+
+    virtual bool get( long long line, long long column ) const;
+    virtual void set( long long line, long long column, bool alive );
+    virtual void clear();
+    virtual void getRegion( long long line, long long column, int lines, int columns,
+                            std::vector<unsigned char> &cells ) const;
+    virtual void getDensity( long long line, long long column, int lines, int columns, 
+                             int cellsPerPixel, std::vector<unsigned char> &density ) const;
+
+    virtual bool getBounds( long long &top, long long &left,
+                            long long &bottom, long long &right ) const;
+
+    virtual long long getPopulation() const;
+    virtual long long getGeneration() const;
+    virtual int getMaxStepExponent() const;
+
+    /**
+     * @brief Computes 2^exponent generations, one by one.
+     */
+    virtual void step( int exponent );
+
+    /**
+     * @brief Computes the next generation.
+     */
+    void step();
+
+    virtual void save();
+    virtual void restore();
+
+    size_t getTileCount() const;
+    size_t getActiveTileCount() const;
+
+};
@@ -7,8 +7,20 @@
  * @copyright Copyright (c) 2024
  */
 #include <GameWindow.h>
+#include <LifeBenchmark.h>
 
-int main( void ) {
+#include <cstdio>
+#include <cstring>
+
+int main( int argc, char **argv ) {
+
+    // headless benchmark of the kernels
+    if ( argc > 1 && std::strcmp( argv[1], "--benchmark" ) == 0 ) {
+        bool kernels = runLifeBenchmark();
+        std::printf( "\n" );
+        bool patterns = runPatternBenchmark();
+        return kernels && patterns ? 0 : 1;
+    }
 
     GameWindow gameWindow;
     gameWindow.init();
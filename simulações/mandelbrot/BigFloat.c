@@ -0,0 +1,128 @@
+/**
+ * @file BigFloat.c
+ * @author Prof. Dr. David Buzatto
+ * @brief BigFloat implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "BigFloat.h"
+
+static int compareMagnitudeBigFloat( const BigFloat *a, const BigFloat *b, int limbs );
+static void addMagnitudeBigFloat( BigFloat *r, const BigFloat *a, const BigFloat *b, int limbs );
+static void subMagnitudeBigFloat( BigFloat *r, const BigFloat *a, const BigFloat *b, int limbs );
+
+void setDoubleBigFloat( BigFloat *r, double value, int limbs ) {
+
+    memset( r->limbs, 0, sizeof( r->limbs ) );
+    r->sign = value < 0 ? -1 : 1;
+    value = fabs( value );
+
+    // every step takes 32 bits out of value, so a double is copied exactly
+    for ( int i = 0; i < limbs && value > 0; i++ ) {
+        double limb = floor( value );
+        r->limbs[i] = (uint32_t) limb;
+        value = ( value - limb ) * 4294967296.0;
+    }
+
+}
+
+double toDoubleBigFloat( const BigFloat *a, int limbs ) {
+
+    double value = 0;
+    double scale = 1;
+
+    for ( int i = 0; i < limbs; i++ ) {
+        value += a->limbs[i] * scale;
+        scale /= 4294967296.0;
+    }
+
+    return a->sign * value;
+
+}
+
+void addBigFloat( BigFloat *r, const BigFloat *a, const BigFloat *b, int limbs ) {
+
+    if ( a->sign == b->sign ) {
+        addMagnitudeBigFloat( r, a, b, limbs );
+        r->sign = a->sign;
+    } else if ( compareMagnitudeBigFloat( a, b, limbs ) >= 0 ) {
+        int sign = a->sign;
+        subMagnitudeBigFloat( r, a, b, limbs );
+        r->sign = sign;
+    } else {
+        int sign = b->sign;
+        subMagnitudeBigFloat( r, b, a, limbs );
+        r->sign = sign;
+    }
+
+}
+
+void subBigFloat( BigFloat *r, const BigFloat *a, const BigFloat *b, int limbs ) {
+    BigFloat negB = *b;
+    negB.sign = -b->sign;
+    addBigFloat( r, a, &negB, limbs );
+}
+
+void mulBigFloat( BigFloat *r, const BigFloat *a, const BigFloat *b, int limbs ) {
+
+    // schoolbook product of the limbs as big endian integers: the
+    // product has 2 * limbs limbs, where the first one would be the
+    // overflow of the integer part and the last limbs - 1 are dropped
+    uint32_t product[2 * BIG_FLOAT_MAX_LIMBS] = { 0 };
+
+    for ( int i = limbs - 1; i >= 0; i-- ) {
+        uint64_t carry = 0;
+        for ( int j = limbs - 1; j >= 0; j-- ) {
+            uint64_t current = (uint64_t) a->limbs[i] * b->limbs[j] + product[i + j + 1] + carry;
+            product[i + j + 1] = (uint32_t) current;
+            carry = current >> 32;
+        }
+        product[i] = (uint32_t) carry;
+    }
+
+    int sign = a->sign * b->sign;
+    memcpy( r->limbs, product + 1, limbs * sizeof( uint32_t ) );
+    r->sign = sign;
+
+}
+
+void addDoubleBigFloat( BigFloat *r, const BigFloat *a, double value, int limbs ) {
+    BigFloat b;
+    setDoubleBigFloat( &b, value, limbs );
+    addBigFloat( r, a, &b, limbs );
+}
+
+static int compareMagnitudeBigFloat( const BigFloat *a, const BigFloat *b, int limbs ) {
+    for ( int i = 0; i < limbs; i++ ) {
+        if ( a->limbs[i] != b->limbs[i] ) {
+            return a->limbs[i] > b->limbs[i] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+static void addMagnitudeBigFloat( BigFloat *r, const BigFloat *a, const BigFloat *b, int limbs ) {
+    uint64_t carry = 0;
+    for ( int i = limbs - 1; i >= 0; i-- ) {
+        uint64_t current = (uint64_t) a->limbs[i] + b->limbs[i] + carry;
+        r->limbs[i] = (uint32_t) current;
+        carry = current >> 32;
+    }
+}
+
+/**
+ * @brief |r| = |a| - |b|, with |a| >= |b|.
+ */
+static void subMagnitudeBigFloat( BigFloat *r, const BigFloat *a, const BigFloat *b, int limbs ) {
+    int64_t borrow = 0;
+    for ( int i = limbs - 1; i >= 0; i-- ) {
+        int64_t current = (int64_t) a->limbs[i] - b->limbs[i] - borrow;
+        borrow = current < 0;
+        r->limbs[i] = (uint32_t) ( current + ( borrow << 32 ) );
+    }
+}
\ No newline at end of file
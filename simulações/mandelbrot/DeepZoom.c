@@ -0,0 +1,147 @@
+/**
+ * @file DeepZoom.c
+ * @author Prof. Dr. David Buzatto
+ * @brief Deep zoom with perturbation theory, implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "BigFloat.h"
+#include "DeepZoom.h"
+#include "FractalKernel.h"
+
+int getLimbsDeepZoom( double span ) {
+
+    // integer limb, the bits of the span, 64 guard bits
+    int bits = (int) ceil( -log2( span ) ) + 64;
+    int limbs = 1 + ( bits + 31 ) / 32;
+
+    if ( limbs < 3 ) {
+        limbs = 3;
+    } else if ( limbs > BIG_FLOAT_MAX_LIMBS ) {
+        limbs = BIG_FLOAT_MAX_LIMBS;
+    }
+
+    return limbs;
+
+}
+
+ReferenceOrbit* createReferenceOrbit( const BigFloat *z0x, const BigFloat *z0y,
+                                      const BigFloat *cx, const BigFloat *cy,
+                                      int maxIterations, double bailout, int limbs ) {
+
+    ReferenceOrbit *orbit = (ReferenceOrbit*) malloc( sizeof( ReferenceOrbit ) );
+    orbit->x = (double*) malloc( ( maxIterations + 1 ) * sizeof( double ) );
+    orbit->y = (double*) malloc( ( maxIterations + 1 ) * sizeof( double ) );
+    orbit->limbs = limbs;
+    orbit->length = 0;
+
+    BigFloat x = *z0x;
+    BigFloat y = *z0y;
+    BigFloat xx;
+    BigFloat yy;
+    BigFloat xy;
+
+    for ( int n = 0; n <= maxIterations; n++ ) {
+
+        double dx = toDoubleBigFloat( &x, limbs );
+        double dy = toDoubleBigFloat( &y, limbs );
+        orbit->x[n] = dx;
+        orbit->y[n] = dy;
+        orbit->length++;
+
+        // at least two points, so a pixel can always take one step
+        if ( n > 0 && dx * dx + dy * dy > bailout ) {
+            break;
+        }
+
+        // z = ( x^2 - y^2 + cx ) + ( 2xy + cy )i
+        mulBigFloat( &xx, &x, &x, limbs );
+        mulBigFloat( &yy, &y, &y, limbs );
+        mulBigFloat( &xy, &x, &y, limbs );
+        subBigFloat( &x, &xx, &yy, limbs );
+        addBigFloat( &x, &x, cx, limbs );
+        addBigFloat( &y, &xy, &xy, limbs );
+        addBigFloat( &y, &y, cy, limbs );
+
+    }
+
+    return orbit;
+
+}
+
+void destroyReferenceOrbit( ReferenceOrbit *orbit ) {
+    free( orbit->x );
+    free( orbit->y );
+    free( orbit );
+}
+
+long long iterateDeepZoom( const ReferenceOrbit *orbit, const FractalKernelRow *row ) {
+
+    const double *refX = orbit->x;
+    const double *refY = orbit->y;
+    long long glitches = 0;
+
+    for ( int i = 0; i < row->count; i++ ) {
+
+        double dzx = row->zx[i];
+        double dzy = row->zy[i];
+        const double dcx = row->cx[i];
+        const double dcy = row->cy[i];
+        double x = refX[0] + dzx;
+        double y = refY[0] + dzy;
+        int n = 0;
+        int iteration;
+
+        for ( iteration = 0; iteration < row->maxIterations; iteration++ ) {
+
+            x = refX[n] + dzx;
+            y = refY[n] + dzy;
+            double r2 = x * x + y * y;
+
+            if ( row->inclusiveBailout ? !( r2 <= row->bailout ) : !( r2 < row->bailout ) ) {
+                break;
+            }
+
+            // rebasing: restart from the beginning of the orbit when
+            // the pixel is closer to zero than to the reference, when
+            // the glitch criterion says the precision of dz is lost, or
+            // when the reference orbit is over
+            double refR2 = refX[n] * refX[n] + refY[n] * refY[n];
+            double dzR2 = dzx * dzx + dzy * dzy;
+            bool glitch = r2 < DEEP_ZOOM_GLITCH_TOLERANCE * refR2;
+
+            if ( glitch || r2 < dzR2 || n + 1 >= orbit->length ) {
+                if ( glitch ) {
+                    glitches++;
+                }
+                dzx = x - refX[0];
+                dzy = y - refY[0];
+                n = 0;
+            }
+
+            double ndzx = 2 * ( refX[n] * dzx - refY[n] * dzy ) + ( dzx * dzx - dzy * dzy ) + dcx;
+            double ndzy = 2 * ( refX[n] * dzy + refY[n] * dzx ) + 2 * dzx * dzy + dcy;
+            dzx = ndzx;
+            dzy = ndzy;
+            n++;
+
+        }
+
+        if ( iteration == row->maxIterations ) {
+            x = refX[n] + dzx;
+            y = refY[n] + dzy;
+        }
+
+        row->iterations[i] = iteration;
+        row->x[i] = x;
+        row->y[i] = y;
+
+    }
+
+    return glitches;
+
+}
\ No newline at end of file
@@ -0,0 +1,486 @@
+/**
+ * @file FractalKernel.c
+ * @author Prof. Dr. David Buzatto
+ * @brief Escape time kernels implementation.
+ * 
+ * @copyright Copyright (c) 2024
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "FractalKernel.h"
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#define FRACTAL_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+#define BENCHMARK_SIZE 512
+#define BENCHMARK_VIEW_COUNT 3
+
+static long long iterateScalar( const FractalKernelRow *row, int start );
+
+#ifdef FRACTAL_KERNEL_X86
+static long long iterateSSE2( const FractalKernelRow *row );
+static long long iterateAVX2( const FractalKernelRow *row );
+#endif
+
+long long iterateFractalKernel( FractalKernelType type, const FractalKernelRow *row ) {
+
+    switch ( type ) {
+#ifdef FRACTAL_KERNEL_X86
+        case FRACTAL_KERNEL_SSE2:
+            return iterateSSE2( row );
+        case FRACTAL_KERNEL_AVX2:
+            return iterateAVX2( row );
+#endif
+        default:
+            return iterateScalar( row, 0 );
+    }
+
+}
+
+bool isSupportedFractalKernel( FractalKernelType type ) {
+
+    switch ( type ) {
+        case FRACTAL_KERNEL_SCALAR:
+            return true;
+#ifdef FRACTAL_KERNEL_X86
+        case FRACTAL_KERNEL_SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports( "sse2" );
+        case FRACTAL_KERNEL_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports( "avx2" );
+#endif
+        default:
+            return false;
+    }
+
+}
+
+FractalKernelType getBestFractalKernel( void ) {
+    for ( int type = FRACTAL_KERNEL_TYPE_COUNT - 1; type > FRACTAL_KERNEL_SCALAR; type-- ) {
+        if ( isSupportedFractalKernel( type ) ) {
+            return type;
+        }
+    }
+    return FRACTAL_KERNEL_SCALAR;
+}
+
+const char *getNameFractalKernel( FractalKernelType type ) {
+    switch ( type ) {
+        case FRACTAL_KERNEL_SCALAR: return "scalar";
+        case FRACTAL_KERNEL_SSE2:   return "sse2";
+        case FRACTAL_KERNEL_AVX2:   return "avx2";
+        default:                    return "unknown";
+    }
+}
+
+/**
+ * @brief Reference kernel, one point at a time, from start to the end
+ * of the row. The vectorized kernels use it for the last points.
+ */
+static long long iterateScalar( const FractalKernelRow *row, int start ) {
+
+    long long saved = 0;
+
+    for ( int i = start; i < row->count; i++ ) {
+
+        double x = row->zx[i];
+        double y = row->zy[i];
+        const double x0 = row->cx[i];
+        const double y0 = row->cy[i];
+        double xTemp;
+        int iteration;
+
+        // z saved at powers of two, and the iterations until the next save
+        double savedX = x;
+        double savedY = y;
+        int period = 1;
+        int steps = 0;
+
+        for ( iteration = 0; 
+              iteration < row->maxIterations && 
+              ( row->inclusiveBailout ? x*x + y*y <= row->bailout : x*x + y*y < row->bailout ); 
+              iteration++ ) {
+
+            xTemp = x * x - y * y + x0;
+            y = 2 * x * y + y0;
+            x = xTemp;
+
+            if ( row->periodicity ) {
+                if ( x == savedX && y == savedY ) {
+                    saved += row->maxIterations - iteration - 1;
+                    iteration = row->maxIterations;
+                    break;
+                }
+                if ( ++steps == period ) {
+                    savedX = x;
+                    savedY = y;
+                    period *= 2;
+                    steps = 0;
+                }
+            }
+
+        }
+
+        row->iterations[i] = iteration;
+        row->x[i] = x;
+        row->y[i] = y;
+
+    }
+
+    return saved;
+
+}
+
+#ifdef FRACTAL_KERNEL_X86
+
+/*
+ * The lanes that escaped are masked off: they keep their last z and
+ * stop counting, while the others go on until every lane escaped or
+ * the iteration limit is reached. Each lane sees exactly the scalar
+ * sequence of operations (no fused multiply-add), so the results are
+ * bit identical.
+ */
+
+static inline __m128d stepSSE2( __m128d *x, __m128d *y, __m128d x0, __m128d y0, __m128d active, __m128d bailout, bool inclusiveBailout ) {
+
+    const __m128d xx = _mm_mul_pd( *x, *x );
+    const __m128d yy = _mm_mul_pd( *y, *y );
+    const __m128d r2 = _mm_add_pd( xx, yy );
+
+    active = _mm_and_pd( active, inclusiveBailout ? _mm_cmple_pd( r2, bailout ) : _mm_cmplt_pd( r2, bailout ) );
+
+    const __m128d xTemp = _mm_add_pd( _mm_sub_pd( xx, yy ), x0 );
+    const __m128d yTemp = _mm_add_pd( _mm_mul_pd( _mm_mul_pd( _mm_set1_pd( 2.0 ), *x ), *y ), y0 );
+    *x = _mm_or_pd( _mm_and_pd( active, xTemp ), _mm_andnot_pd( active, *x ) );
+    *y = _mm_or_pd( _mm_and_pd( active, yTemp ), _mm_andnot_pd( active, *y ) );
+
+    return active;
+
+}
+
+/*
+ * Four points at a time, in two independent vectors, so one of them
+ * is computed while the other waits for the latency of its multiplies.
+ */
+static long long iterateSSE2( const FractalKernelRow *row ) {
+
+    const __m128d bailout = _mm_set1_pd( row->bailout );
+    long long saved = 0;
+    int i;
+
+    for ( i = 0; i + 4 <= row->count; i += 4 ) {
+
+        __m128d xa = _mm_loadu_pd( row->zx + i );
+        __m128d ya = _mm_loadu_pd( row->zy + i );
+        __m128d xb = _mm_loadu_pd( row->zx + i + 2 );
+        __m128d yb = _mm_loadu_pd( row->zy + i + 2 );
+        const __m128d x0a = _mm_loadu_pd( row->cx + i );
+        const __m128d y0a = _mm_loadu_pd( row->cy + i );
+        const __m128d x0b = _mm_loadu_pd( row->cx + i + 2 );
+        const __m128d y0b = _mm_loadu_pd( row->cy + i + 2 );
+        __m128d activeA = _mm_castsi128_pd( _mm_set1_epi32( -1 ) );
+        __m128d activeB = activeA;
+        __m128i countsA = _mm_setzero_si128();
+        __m128i countsB = _mm_setzero_si128();
+
+        // lanes stopped by the periodicity checking
+        __m128d savedXa = xa;
+        __m128d savedYa = ya;
+        __m128d savedXb = xb;
+        __m128d savedYb = yb;
+        __m128d cyclingA = _mm_setzero_pd();
+        __m128d cyclingB = _mm_setzero_pd();
+        int period = 1;
+        int steps = 0;
+
+        for ( int iteration = 0; iteration < row->maxIterations; iteration++ ) {
+
+            activeA = stepSSE2( &xa, &ya, x0a, y0a, activeA, bailout, row->inclusiveBailout );
+            activeB = stepSSE2( &xb, &yb, x0b, y0b, activeB, bailout, row->inclusiveBailout );
+
+            if ( row->periodicity ) {
+                const __m128d repeatA = _mm_and_pd( activeA, _mm_and_pd( _mm_cmpeq_pd( xa, savedXa ), _mm_cmpeq_pd( ya, savedYa ) ) );
+                const __m128d repeatB = _mm_and_pd( activeB, _mm_and_pd( _mm_cmpeq_pd( xb, savedXb ), _mm_cmpeq_pd( yb, savedYb ) ) );
+                cyclingA = _mm_or_pd( cyclingA, repeatA );
+                cyclingB = _mm_or_pd( cyclingB, repeatB );
+                activeA = _mm_andnot_pd( repeatA, activeA );
+                activeB = _mm_andnot_pd( repeatB, activeB );
+                if ( ++steps == period ) {
+                    savedXa = xa;
+                    savedYa = ya;
+                    savedXb = xb;
+                    savedYb = yb;
+                    period *= 2;
+                    steps = 0;
+                }
+            }
+
+            if ( _mm_movemask_pd( _mm_or_pd( activeA, activeB ) ) == 0 ) {
+                break;
+            }
+
+            // active lanes are all ones, that is, -1
+            countsA = _mm_sub_epi64( countsA, _mm_castpd_si128( activeA ) );
+            countsB = _mm_sub_epi64( countsB, _mm_castpd_si128( activeB ) );
+
+        }
+
+        int64_t laneCounts[4];
+        _mm_storeu_si128( (__m128i*) laneCounts, countsA );
+        _mm_storeu_si128( (__m128i*) ( laneCounts + 2 ), countsB );
+        int cycling = _mm_movemask_pd( cyclingA ) | _mm_movemask_pd( cyclingB ) << 2;
+        for ( int k = 0; k < 4; k++ ) {
+            if ( cycling & ( 1 << k ) ) {
+                saved += row->maxIterations - laneCounts[k] - 1;
+                laneCounts[k] = row->maxIterations;
+            }
+            row->iterations[i + k] = (int) laneCounts[k];
+        }
+        _mm_storeu_pd( row->x + i, xa );
+        _mm_storeu_pd( row->y + i, ya );
+        _mm_storeu_pd( row->x + i + 2, xb );
+        _mm_storeu_pd( row->y + i + 2, yb );
+
+    }
+
+    return saved + iterateScalar( row, i );
+
+}
+
+__attribute__(( target( "avx2" ) ))
+static inline __m256d stepAVX2( __m256d *x, __m256d *y, __m256d x0, __m256d y0, __m256d active, __m256d bailout, bool inclusiveBailout ) {
+
+    const __m256d xx = _mm256_mul_pd( *x, *x );
+    const __m256d yy = _mm256_mul_pd( *y, *y );
+    const __m256d r2 = _mm256_add_pd( xx, yy );
+
+    if ( inclusiveBailout ) {
+        active = _mm256_and_pd( active, _mm256_cmp_pd( r2, bailout, _CMP_LE_OQ ) );
+    } else {
+        active = _mm256_and_pd( active, _mm256_cmp_pd( r2, bailout, _CMP_LT_OQ ) );
+    }
+
+    const __m256d xTemp = _mm256_add_pd( _mm256_sub_pd( xx, yy ), x0 );
+    const __m256d yTemp = _mm256_add_pd( _mm256_mul_pd( _mm256_mul_pd( _mm256_set1_pd( 2.0 ), *x ), *y ), y0 );
+    *x = _mm256_blendv_pd( *x, xTemp, active );
+    *y = _mm256_blendv_pd( *y, yTemp, active );
+
+    return active;
+
+}
+
+/*
+ * Eight points at a time, in two independent vectors, so one of them
+ * is computed while the other waits for the latency of its multiplies.
+ */
+__attribute__(( target( "avx2" ) ))
+static long long iterateAVX2( const FractalKernelRow *row ) {
+
+    const __m256d bailout = _mm256_set1_pd( row->bailout );
+    long long saved = 0;
+    int i;
+
+    for ( i = 0; i + 8 <= row->count; i += 8 ) {
+
+        __m256d xa = _mm256_loadu_pd( row->zx + i );
+        __m256d ya = _mm256_loadu_pd( row->zy + i );
+        __m256d xb = _mm256_loadu_pd( row->zx + i + 4 );
+        __m256d yb = _mm256_loadu_pd( row->zy + i + 4 );
+        const __m256d x0a = _mm256_loadu_pd( row->cx + i );
+        const __m256d y0a = _mm256_loadu_pd( row->cy + i );
+        const __m256d x0b = _mm256_loadu_pd( row->cx + i + 4 );
+        const __m256d y0b = _mm256_loadu_pd( row->cy + i + 4 );
+        __m256d activeA = _mm256_castsi256_pd( _mm256_set1_epi64x( -1 ) );
+        __m256d activeB = activeA;
+        __m256i countsA = _mm256_setzero_si256();
+        __m256i countsB = _mm256_setzero_si256();
+
+        // lanes stopped by the periodicity checking
+        __m256d savedXa = xa;
+        __m256d savedYa = ya;
+        __m256d savedXb = xb;
+        __m256d savedYb = yb;
+        __m256d cyclingA = _mm256_setzero_pd();
+        __m256d cyclingB = _mm256_setzero_pd();
+        int period = 1;
+        int steps = 0;
+
+        for ( int iteration = 0; iteration < row->maxIterations; iteration++ ) {
+
+            activeA = stepAVX2( &xa, &ya, x0a, y0a, activeA, bailout, row->inclusiveBailout );
+            activeB = stepAVX2( &xb, &yb, x0b, y0b, activeB, bailout, row->inclusiveBailout );
+
+            if ( row->periodicity ) {
+                const __m256d repeatA = _mm256_and_pd( activeA, _mm256_and_pd( _mm256_cmp_pd( xa, savedXa, _CMP_EQ_OQ ), _mm256_cmp_pd( ya, savedYa, _CMP_EQ_OQ ) ) );
+                const __m256d repeatB = _mm256_and_pd( activeB, _mm256_and_pd( _mm256_cmp_pd( xb, savedXb, _CMP_EQ_OQ ), _mm256_cmp_pd( yb, savedYb, _CMP_EQ_OQ ) ) );
+                cyclingA = _mm256_or_pd( cyclingA, repeatA );
+                cyclingB = _mm256_or_pd( cyclingB, repeatB );
+                activeA = _mm256_andnot_pd( repeatA, activeA );
+                activeB = _mm256_andnot_pd( repeatB, activeB );
+                if ( ++steps == period ) {
+                    savedXa = xa;
+                    savedYa = ya;
+                    savedXb = xb;
+                    savedYb = yb;
+                    period *= 2;
+                    steps = 0;
+                }
+            }
+
+            if ( _mm256_movemask_pd( _mm256_or_pd( activeA, activeB ) ) == 0 ) {
+                break;
+            }
+
+            // active lanes are all ones, that is, -1
+            countsA = _mm256_sub_epi64( countsA, _mm256_castpd_si256( activeA ) );
+            countsB = _mm256_sub_epi64( countsB, _mm256_castpd_si256( activeB ) );
+
+        }
+
+        int64_t laneCounts[8];
+        _mm256_storeu_si256( (__m256i*) laneCounts, countsA );
+        _mm256_storeu_si256( (__m256i*) ( laneCounts + 4 ), countsB );
+        int cycling = _mm256_movemask_pd( cyclingA ) | _mm256_movemask_pd( cyclingB ) << 4;
+        for ( int k = 0; k < 8; k++ ) {
+            if ( cycling & ( 1 << k ) ) {
+                saved += row->maxIterations - laneCounts[k] - 1;
+                laneCounts[k] = row->maxIterations;
+            }
+            row->iterations[i + k] = (int) laneCounts[k];
+        }
+        _mm256_storeu_pd( row->x + i, xa );
+        _mm256_storeu_pd( row->y + i, ya );
+        _mm256_storeu_pd( row->x + i + 4, xb );
+        _mm256_storeu_pd( row->y + i + 4, yb );
+
+    }
+
+    // the compiler does not clear the upper halves of the registers at
+    // the end of a function with an avx2 target, and the sse code that
+    // runs next would pay for the transition at every instruction
+    _mm256_zeroupper();
+
+    return saved + iterateScalar( row, i );
+
+}
+
+#endif
+
+bool runFractalKernelBenchmark( void ) {
+
+    // minX, maxX, minY, maxY, iterations, mandelbrot (1) or julia (0)
+    const double views[BENCHMARK_VIEW_COUNT][6] = {
+        { -2.00, 0.47, -1.12, 1.12, 256, 1 },
+        { -0.7600, -0.7400, 0.0900, 0.1100, 1000, 1 },
+        { -2.00, 2.00, -2.00, 2.00, 500, 0 }
+    };
+    const double juliaX = -0.8;
+    const double juliaY = 0.156;
+
+    const int size = BENCHMARK_SIZE * BENCHMARK_SIZE;
+    double *zx = (double*) malloc( size * sizeof( double ) );
+    double *zy = (double*) malloc( size * sizeof( double ) );
+    double *cx = (double*) malloc( size * sizeof( double ) );
+    double *cy = (double*) malloc( size * sizeof( double ) );
+    int *referenceIterations = (int*) malloc( size * sizeof( int ) );
+    double *referenceX = (double*) malloc( size * sizeof( double ) );
+    double *referenceY = (double*) malloc( size * sizeof( double ) );
+    int *iterations = (int*) malloc( size * sizeof( int ) );
+    double *x = (double*) malloc( size * sizeof( double ) );
+    double *y = (double*) malloc( size * sizeof( double ) );
+    bool identical = true;
+
+    printf( "%-8s %-6s %12s %10s %s\n", "view", "kernel", "Mpix-it/s", "seconds", "result" );
+
+    for ( int v = 0; v < BENCHMARK_VIEW_COUNT; v++ ) {
+
+        bool mandelbrot = views[v][5] != 0;
+
+        for ( int i = 0; i < BENCHMARK_SIZE; i++ ) {
+            for ( int j = 0; j < BENCHMARK_SIZE; j++ ) {
+                int p = i * BENCHMARK_SIZE + j;
+                double px = views[v][0] + ( views[v][1] - views[v][0] ) * j / BENCHMARK_SIZE;
+                double py = views[v][2] + ( views[v][3] - views[v][2] ) * i / BENCHMARK_SIZE;
+                zx[p] = mandelbrot ? 0 : px;
+                zy[p] = mandelbrot ? 0 : py;
+                cx[p] = mandelbrot ? px : juliaX;
+                cy[p] = mandelbrot ? py : juliaY;
+            }
+        }
+
+        for ( int type = FRACTAL_KERNEL_SCALAR; type < FRACTAL_KERNEL_TYPE_COUNT; type++ ) {
+
+            if ( !isSupportedFractalKernel( type ) ) {
+                printf( "%-8d %-6s %12s %10s %s\n", v, getNameFractalKernel( type ), "-", "-", "not supported" );
+                continue;
+            }
+
+            bool reference = type == FRACTAL_KERNEL_SCALAR;
+            FractalKernelRow row = {
+                .count = BENCHMARK_SIZE,
+                .maxIterations = (int) views[v][4],
+                .bailout = mandelbrot ? ( 1 << 16 ) : 4,
+                .inclusiveBailout = mandelbrot
+            };
+
+            long long totalIterations = 0;
+            clock_t start = clock();
+
+            for ( int i = 0; i < BENCHMARK_SIZE; i++ ) {
+                int p = i * BENCHMARK_SIZE;
+                row.zx = zx + p;
+                row.zy = zy + p;
+                row.cx = cx + p;
+                row.cy = cy + p;
+                row.iterations = ( reference ? referenceIterations : iterations ) + p;
+                row.x = ( reference ? referenceX : x ) + p;
+                row.y = ( reference ? referenceY : y ) + p;
+                iterateFractalKernel( type, &row );
+            }
+
+            double seconds = (double) ( clock() - start ) / CLOCKS_PER_SEC;
+
+            for ( int p = 0; p < size; p++ ) {
+                totalIterations += referenceIterations[p];
+            }
+
+            const char *result = "reference";
+            if ( !reference ) {
+                bool same = memcmp( iterations, referenceIterations, size * sizeof( int ) ) == 0 &&
+                            memcmp( x, referenceX, size * sizeof( double ) ) == 0 &&
+                            memcmp( y, referenceY, size * sizeof( double ) ) == 0;
+                result = same ? "identical" : "MISMATCH";
+                identical = identical && same;
+            }
+
+            printf( "%-8d %-6s %12.1f %10.4f %s\n", 
+                    v, getNameFractalKernel( type ), 
+                    seconds > 0 ? totalIterations / seconds / 1e6 : 0, 
+                    seconds, result );
+
+        }
+
+    }
+
+    free( zx );
+    free( zy );
+    free( cx );
+    free( cy );
+    free( referenceIterations );
+    free( referenceX );
+    free( referenceY );
+    free( iterations );
+    free( x );
+    free( y );
+
+    return identical;
+
+}
@@ -0,0 +1,145 @@
+/**
+ * @file FractalPalette.c
+ * @author Prof. Dr. David Buzatto
+ * @brief FractalPalette implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "raylib.h"
+#include "raymath.h"
+#include "FractalPalette.h"
+
+static Color getColorFractalPalette( int iteration, double maxIterations, bool colored, bool gradient, double hueStart, double hueEnd );
+
+FractalPalette* createFractalPalette( void ) {
+
+    FractalPalette *palette = (FractalPalette*) malloc( sizeof( FractalPalette ) );
+
+    palette->capacity = 0;
+    palette->colors = NULL;
+    palette->maxIterations = 0;
+    palette->steps = 1;
+    palette->gradient = false;
+    setupFractalPalette( palette, 0, false, false, 0, 0 );
+
+    return palette;
+
+}
+
+void destroyFractalPalette( FractalPalette *palette ) {
+    free( palette->colors );
+    free( palette );
+}
+
+void setupFractalPalette( FractalPalette *palette, int maxIterations, bool colored, bool gradient, double hueStart, double hueEnd ) {
+
+    // gradients blend each color with the next one in steps entries,
+    // fewer when there are many colors and they are already close
+    int steps = 1;
+    if ( gradient ) {
+        steps = FRACTAL_PALETTE_MAX_STEPS;
+        while ( steps > 1 && ( maxIterations + 1 ) * steps > FRACTAL_PALETTE_MAX_SIZE ) {
+            steps /= 2;
+        }
+    }
+
+    // one more entry past maxIterations to blend with
+    int size = ( maxIterations + 1 ) * steps + 1;
+
+    if ( size > palette->capacity ) {
+        palette->capacity = size;
+        palette->colors = (Color*) realloc( palette->colors, palette->capacity * sizeof( Color ) );
+    }
+
+    palette->maxIterations = maxIterations;
+    palette->steps = steps;
+    palette->gradient = gradient;
+
+    double max = maxIterations > 0 ? maxIterations : 1;
+    Color next = getColorFractalPalette( 0, max, colored, gradient, hueStart, hueEnd );
+
+    for ( int i = 0; i <= maxIterations; i++ ) {
+
+        Color current = next;
+        next = getColorFractalPalette( i + 1, max, colored, gradient, hueStart, hueEnd );
+
+        for ( int j = 0; j < steps; j++ ) {
+            int t = j * 256 / steps;
+            int u = 256 - t;
+            palette->colors[i * steps + j] = (Color) {
+                .r = ( current.r * u + next.r * t ) >> 8,
+                .g = ( current.g * u + next.g * t ) >> 8,
+                .b = ( current.b * u + next.b * t ) >> 8,
+                .a = 255
+            };
+        }
+
+    }
+
+    palette->colors[size - 1] = next;
+
+}
+
+void colorFractalPalette( const FractalPalette *palette, const int *iterations, const float *smoothIterations, Color *colors, int count ) {
+
+    const Color *table = palette->colors;
+    const int maxIterations = palette->maxIterations;
+
+    if ( palette->gradient ) {
+
+        const float steps = (float) palette->steps;
+        const float max = (float) ( maxIterations * palette->steps );
+
+        for ( int i = 0; i < count; i++ ) {
+            float s = smoothIterations[i] * steps;
+            s = s > 0 ? s : 0;
+            s = s < max ? s : max;
+            colors[i] = table[(int) s];
+        }
+
+    } else {
+
+        // old pixels may have been iterated with a greater limit
+        for ( int i = 0; i < count; i++ ) {
+            int k = iterations[i];
+            colors[i] = table[k < maxIterations ? k : maxIterations];
+        }
+
+    }
+
+}
+
+float getSmoothIteration( int iteration, int maxIterations, double x, double y ) {
+
+    if ( iteration >= maxIterations ) {
+        return 0;
+    }
+
+    double logZn = log( x * x + y * y ) / 2;
+    double nu = log( logZn / log( 2 ) ) / log( 2 );
+
+    return (float) ( iteration - 1 - nu );
+
+}
+
+/**
+ * @brief Color of an iteration count, before blending.
+ */
+static Color getColorFractalPalette( int iteration, double maxIterations, bool colored, bool gradient, double hueStart, double hueEnd ) {
+
+    if ( colored ) {
+        return ColorFromHSV( hueStart + ( hueEnd - hueStart ) * ( iteration / maxIterations ), 1, 0.7 );
+    }
+
+    // gradient goes from black, plain from white
+    double c = gradient ? 255 * ( iteration / maxIterations ) : 255 - 255 * ( iteration / maxIterations );
+    unsigned char v = (unsigned char) Clamp( c, 0, 255 );
+
+    return (Color) { v, v, v, 255 };
+
+}
@@ -0,0 +1,808 @@
+/**
+ * @file FractalRenderer.c
+ * @author Prof. Dr. David Buzatto
+ * @brief FractalRenderer implementation.
+ * 
+ * @copyright Copyright (c) 2024
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#if !defined( _WIN32 )
+#include <unistd.h>
+#endif
+
+#include "raylib.h"
+#include "raymath.h"
+#include "DeepZoom.h"
+#include "FractalKernel.h"
+#include "FractalPalette.h"
+#include "FractalRenderer.h"
+
+static void *workerFractalRenderer( void *data );
+static bool renderTileFractalRenderer( FractalRenderer *fr, const RenderTile *tile, const RenderParams *params, FractalKernelType kernel, int pass, unsigned int generation, SampleBuffer *buffer, RenderStats *stats );
+static bool subdivideFractalRenderer( FractalRenderer *fr, const RenderTile *tile, const RenderParams *params, FractalKernelType kernel, unsigned int generation, SampleBuffer *buffer, RenderStats *stats, int x0, int y0, int x1, int y1 );
+static void addTilePointFractalRenderer( const RenderTile *tile, SampleBuffer *buffer, int x, int y );
+static bool sampleTileFractalRenderer( FractalRenderer *fr, const RenderTile *tile, const RenderParams *params, FractalKernelType kernel, unsigned int generation, SampleBuffer *buffer, RenderStats *stats );
+static bool isCurrentFractalRenderer( FractalRenderer *fr, unsigned int generation );
+static void copyTileLinesFractalRenderer( FractalRenderer *fr, const RenderTile *tile, const int *iterations, const float *smoothIterations, int y, int lines, bool sameLine );
+static int compareTilesByCenterDistance( const void *t1, const void *t2 );
+static void freeRetiredOrbitsFractalRenderer( FractalRenderer *fr );
+
+// used by the tile sorting comparator
+static int sortingCenterX;
+static int sortingCenterY;
+
+FractalRenderer* createFractalRenderer( int width, int height, int tileSize, int threadCount ) {
+
+    FractalRenderer *fr = (FractalRenderer*) malloc( sizeof( FractalRenderer ) );
+
+    fr->width = width;
+    fr->height = height;
+    fr->iterations = (int*) calloc( width * height, sizeof( int ) );
+    fr->smoothIterations = (float*) calloc( width * height, sizeof( float ) );
+    fr->pixels = (Color*) calloc( width * height, sizeof( Color ) );
+    fr->pixelsChanged = false;
+    fr->palette = createFractalPalette();
+    fr->recolorTime = 0;
+
+    int columns = ( width + tileSize - 1 ) / tileSize;
+    int lines = ( height + tileSize - 1 ) / tileSize;
+    fr->tileCount = columns * lines;
+    fr->tileSize = tileSize;
+    fr->tiles = (RenderTile*) malloc( fr->tileCount * sizeof( RenderTile ) );
+
+    for ( int i = 0; i < lines; i++ ) {
+        for ( int j = 0; j < columns; j++ ) {
+            RenderTile *tile = &fr->tiles[i * columns + j];
+            tile->x = j * tileSize;
+            tile->y = i * tileSize;
+            tile->width = tile->x + tileSize > width ? width - tile->x : tileSize;
+            tile->height = tile->y + tileSize > height ? height - tile->y : tileSize;
+        }
+    }
+
+    sortingCenterX = width / 2;
+    sortingCenterY = height / 2;
+    qsort( fr->tiles, fr->tileCount, sizeof( RenderTile ), compareTilesByCenterDistance );
+
+    pthread_mutex_init( &fr->mutex, NULL );
+    pthread_cond_init( &fr->workAvailable, NULL );
+
+    // nothing to render until the first start
+    fr->generation = 0;
+    fr->pass = FRACTAL_RENDERER_PASSES;
+    fr->nextTile = fr->tileCount;
+    fr->finishedTiles = 0;
+    fr->startTime = 0;
+    fr->finishTime = 0;
+    fr->renderedTiles = 0;
+    fr->stats = (RenderStats) { 0 };
+    fr->finished = true;
+    fr->kernel = getBestFractalKernel();
+    fr->params = (RenderParams) { 0 };
+
+    fr->retiredOrbitCapacity = 4;
+    fr->retiredOrbitCount = 0;
+    fr->retiredOrbits = (ReferenceOrbit**) malloc( fr->retiredOrbitCapacity * sizeof( ReferenceOrbit* ) );
+    fr->busyThreads = 0;
+
+    fr->running = true;
+    fr->threadCount = threadCount < 1 ? 1 : threadCount;
+    fr->threads = (pthread_t*) malloc( fr->threadCount * sizeof( pthread_t ) );
+    for ( int i = 0; i < fr->threadCount; i++ ) {
+        pthread_create( &fr->threads[i], NULL, workerFractalRenderer, fr );
+    }
+
+    return fr;
+
+}
+
+void destroyFractalRenderer( FractalRenderer *fr ) {
+
+    pthread_mutex_lock( &fr->mutex );
+    fr->running = false;
+    pthread_cond_broadcast( &fr->workAvailable );
+    pthread_mutex_unlock( &fr->mutex );
+
+    for ( int i = 0; i < fr->threadCount; i++ ) {
+        pthread_join( fr->threads[i], NULL );
+    }
+
+    pthread_cond_destroy( &fr->workAvailable );
+    pthread_mutex_destroy( &fr->mutex );
+
+    freeRetiredOrbitsFractalRenderer( fr );
+    free( fr->retiredOrbits );
+    if ( fr->params.orbit != NULL ) {
+        destroyReferenceOrbit( fr->params.orbit );
+    }
+
+    free( fr->threads );
+    free( fr->tiles );
+    destroyFractalPalette( fr->palette );
+    free( fr->iterations );
+    free( fr->smoothIterations );
+    free( fr->pixels );
+    free( fr );
+
+}
+
+void startFractalRenderer( FractalRenderer *fr, const RenderParams *params ) {
+
+    pthread_mutex_lock( &fr->mutex );
+
+    // threads may still be reading the old orbit
+    if ( fr->params.orbit != NULL && fr->params.orbit != params->orbit ) {
+        if ( fr->retiredOrbitCount == fr->retiredOrbitCapacity ) {
+            fr->retiredOrbitCapacity *= 2;
+            fr->retiredOrbits = (ReferenceOrbit**) realloc( fr->retiredOrbits, fr->retiredOrbitCapacity * sizeof( ReferenceOrbit* ) );
+        }
+        fr->retiredOrbits[fr->retiredOrbitCount++] = fr->params.orbit;
+    }
+
+    if ( fr->busyThreads == 0 ) {
+        freeRetiredOrbitsFractalRenderer( fr );
+    }
+
+    // tiles of the old generation that are being rendered are
+    // discarded by their threads at the next line
+    fr->params = *params;
+    setupFractalPalette( fr->palette, params->maxIterations, params->colored, params->gradient, params->hueStart, params->hueEnd );
+    fr->generation++;
+    fr->pass = 0;
+    fr->nextTile = 0;
+    fr->finishedTiles = 0;
+    fr->renderedTiles = 0;
+    fr->stats = (RenderStats) { 0 };
+    fr->finished = false;
+    fr->startTime = GetTime();
+    fr->finishTime = fr->startTime;
+
+    pthread_cond_broadcast( &fr->workAvailable );
+    pthread_mutex_unlock( &fr->mutex );
+
+}
+
+void recolorFractalRenderer( FractalRenderer *fr, const RenderParams *params ) {
+
+    pthread_mutex_lock( &fr->mutex );
+
+    double startTime = GetTime();
+
+    // the tiles still being rendered take the new colors from the
+    // palette, so only the color parameters are updated
+    fr->params.colored = params->colored;
+    fr->params.gradient = params->gradient;
+    fr->params.hueStart = params->hueStart;
+    fr->params.hueEnd = params->hueEnd;
+    setupFractalPalette( fr->palette, fr->params.maxIterations, params->colored, params->gradient, params->hueStart, params->hueEnd );
+    colorFractalPalette( fr->palette, fr->iterations, fr->smoothIterations, fr->pixels, fr->width * fr->height );
+    fr->pixelsChanged = true;
+
+    fr->recolorTime = GetTime() - startTime;
+
+    pthread_mutex_unlock( &fr->mutex );
+
+}
+
+void uploadFractalRenderer( FractalRenderer *fr, Texture2D texture ) {
+
+    pthread_mutex_lock( &fr->mutex );
+
+    if ( fr->pixelsChanged ) {
+        UpdateTexture( texture, fr->pixels );
+        fr->pixelsChanged = false;
+    }
+
+    pthread_mutex_unlock( &fr->mutex );
+
+}
+
+void setKernelFractalRenderer( FractalRenderer *fr, FractalKernelType kernel ) {
+    pthread_mutex_lock( &fr->mutex );
+    fr->kernel = kernel;
+    pthread_mutex_unlock( &fr->mutex );
+}
+
+FractalKernelType getKernelFractalRenderer( FractalRenderer *fr ) {
+    pthread_mutex_lock( &fr->mutex );
+    FractalKernelType kernel = fr->kernel;
+    pthread_mutex_unlock( &fr->mutex );
+    return kernel;
+}
+
+RenderStats getStatsFractalRenderer( FractalRenderer *fr ) {
+    pthread_mutex_lock( &fr->mutex );
+    RenderStats stats = fr->stats;
+    pthread_mutex_unlock( &fr->mutex );
+    return stats;
+}
+
+double getRecolorTimeFractalRenderer( FractalRenderer *fr ) {
+    pthread_mutex_lock( &fr->mutex );
+    double time = fr->recolorTime;
+    pthread_mutex_unlock( &fr->mutex );
+    return time;
+}
+
+bool isFinishedFractalRenderer( FractalRenderer *fr ) {
+    pthread_mutex_lock( &fr->mutex );
+    bool finished = fr->finished;
+    pthread_mutex_unlock( &fr->mutex );
+    return finished;
+}
+
+double getTilesPerSecondFractalRenderer( FractalRenderer *fr ) {
+
+    pthread_mutex_lock( &fr->mutex );
+    double time = ( fr->finished ? fr->finishTime : GetTime() ) - fr->startTime;
+    int renderedTiles = fr->renderedTiles;
+    pthread_mutex_unlock( &fr->mutex );
+
+    return time > 0 ? renderedTiles / time : 0;
+
+}
+
+double getRenderTimeFractalRenderer( FractalRenderer *fr ) {
+    pthread_mutex_lock( &fr->mutex );
+    double time = ( fr->finished ? fr->finishTime : GetTime() ) - fr->startTime;
+    pthread_mutex_unlock( &fr->mutex );
+    return time;
+}
+
+int getProcessorCount( void ) {
+#if defined( _WIN32 )
+    int count = pthread_num_processors_np();
+#else
+    int count = (int) sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+    return count < 1 ? 1 : count;
+}
+
+const char *getNameFractalShortcut( FractalShortcut shortcut ) {
+    switch ( shortcut ) {
+        case FRACTAL_SHORTCUT_CARDIOID:    return "cardioid";
+        case FRACTAL_SHORTCUT_PERIODICITY: return "periodicity";
+        case FRACTAL_SHORTCUT_SUBDIVISION: return "subdivision";
+        default:                           return "unknown";
+    }
+}
+
+bool isInsideCardioidOrBulb( double cx, double cy ) {
+
+    // https://en.wikipedia.org/wiki/Plotting_algorithms_for_the_Mandelbrot_set#Cardioid_/_bulb_checking
+    double x = cx - 0.25;
+    double yy = cy * cy;
+    double q = x * x + yy;
+
+    if ( q * ( q + x ) <= 0.25 * yy ) {
+        return true;
+    }
+
+    return ( cx + 1 ) * ( cx + 1 ) + yy <= 0.0625;
+
+}
+
+static void *workerFractalRenderer( void *data ) {
+
+    FractalRenderer *fr = (FractalRenderer*) data;
+
+    // a line of samples or every point of a tile
+    int tileArea = fr->tileSize * fr->tileSize;
+    SampleBuffer *buffer = createSampleBuffer( fr->width > tileArea ? fr->width : tileArea );
+
+    pthread_mutex_lock( &fr->mutex );
+
+    while ( true ) {
+
+        while ( fr->running && fr->nextTile >= fr->tileCount ) {
+            pthread_cond_wait( &fr->workAvailable, &fr->mutex );
+        }
+
+        if ( !fr->running ) {
+            break;
+        }
+
+        RenderTile tile = fr->tiles[fr->nextTile++];
+        RenderParams params = fr->params;
+        FractalKernelType kernel = fr->kernel;
+        unsigned int generation = fr->generation;
+        int pass = fr->pass;
+        RenderStats stats = { 0 };
+        fr->busyThreads++;
+
+        pthread_mutex_unlock( &fr->mutex );
+        bool completed = renderTileFractalRenderer( fr, &tile, &params, kernel, pass, generation, buffer, &stats );
+        pthread_mutex_lock( &fr->mutex );
+
+        fr->busyThreads--;
+        if ( fr->busyThreads == 0 ) {
+            freeRetiredOrbitsFractalRenderer( fr );
+        }
+
+        if ( completed && generation == fr->generation ) {
+
+            fr->finishedTiles++;
+            fr->renderedTiles++;
+            fr->stats.iterations += stats.iterations;
+            fr->stats.glitches += stats.glitches;
+            for ( int i = 0; i < FRACTAL_SHORTCUT_COUNT; i++ ) {
+                fr->stats.savedIterations[i] += stats.savedIterations[i];
+            }
+
+            if ( fr->finishedTiles == fr->tileCount ) {
+                fr->pass++;
+                fr->finishedTiles = 0;
+                if ( fr->pass < FRACTAL_RENDERER_PASSES ) {
+                    fr->nextTile = 0;
+                    pthread_cond_broadcast( &fr->workAvailable );
+                } else {
+                    fr->finished = true;
+                    fr->finishTime = GetTime();
+                }
+            }
+
+        }
+
+    }
+
+    pthread_mutex_unlock( &fr->mutex );
+
+    destroySampleBuffer( buffer );
+
+    return NULL;
+
+}
+
+/**
+ * @brief Renders a tile one line of samples at a time or, in the full
+ * resolution pass with the subdivision, all at once. Returns false if
+ * the render was cancelled while the tile was being rendered.
+ */
+static bool renderTileFractalRenderer( FractalRenderer *fr, const RenderTile *tile, const RenderParams *params, FractalKernelType kernel, int pass, unsigned int generation, SampleBuffer *buffer, RenderStats *stats ) {
+
+    if ( pass > 0 && params->shortcuts[FRACTAL_SHORTCUT_SUBDIVISION] ) {
+
+        memset( buffer->known, 0, tile->width * tile->height * sizeof( bool ) );
+        buffer->leafCount = 0;
+
+        if ( !subdivideFractalRenderer( fr, tile, params, kernel, generation, buffer, stats, 0, 0, tile->width - 1, tile->height - 1 ) ) {
+            return false;
+        }
+
+        buffer->count = 0;
+        for ( int i = 0; i < buffer->leafCount; i++ ) {
+            int p = buffer->leafPoints[i];
+            buffer->px[i] = tile->x + p % tile->width;
+            buffer->py[i] = tile->y + p / tile->width;
+        }
+        buffer->count = buffer->leafCount;
+
+        if ( !sampleTileFractalRenderer( fr, tile, params, kernel, generation, buffer, stats ) ) {
+            return false;
+        }
+
+        pthread_mutex_lock( &fr->mutex );
+        bool current = generation == fr->generation;
+        if ( current ) {
+            copyTileLinesFractalRenderer( fr, tile, buffer->tileIterations, buffer->tileSmoothIterations, tile->y, tile->height, false );
+        }
+        pthread_mutex_unlock( &fr->mutex );
+
+        return current;
+
+    }
+
+    int step = pass == 0 ? FRACTAL_RENDERER_COARSE_BLOCK_SIZE : 1;
+    int samples = ( tile->width + step - 1 ) / step;
+
+    for ( int i = 0; i < tile->height; i += step ) {
+
+        int y = tile->y + i;
+        int lines = i + step > tile->height ? tile->height - i : step;
+
+        for ( int s = 0; s < samples; s++ ) {
+            buffer->px[s] = tile->x + s * step;
+            buffer->py[s] = y;
+        }
+        buffer->count = samples;
+
+        sampleFractalPoints( params, kernel, fr->width, fr->height, buffer, stats );
+
+        for ( int s = 0; s < samples; s++ ) {
+            for ( int k = s * step; k < ( s + 1 ) * step && k < tile->width; k++ ) {
+                buffer->tileIterations[k] = buffer->sampleIterations[s];
+                buffer->tileSmoothIterations[k] = buffer->sampleSmoothIterations[s];
+            }
+        }
+
+        pthread_mutex_lock( &fr->mutex );
+
+        if ( generation != fr->generation ) {
+            pthread_mutex_unlock( &fr->mutex );
+            return false;
+        }
+
+        copyTileLinesFractalRenderer( fr, tile, buffer->tileIterations, buffer->tileSmoothIterations, y, lines, true );
+
+        pthread_mutex_unlock( &fr->mutex );
+
+    }
+
+    return true;
+
+}
+
+SampleBuffer* createSampleBuffer( int capacity ) {
+
+    SampleBuffer *buffer = (SampleBuffer*) malloc( sizeof( SampleBuffer ) );
+
+    buffer->capacity = capacity;
+    buffer->px = (int*) malloc( capacity * sizeof( int ) );
+    buffer->py = (int*) malloc( capacity * sizeof( int ) );
+    buffer->count = 0;
+    buffer->indexes = (int*) malloc( capacity * sizeof( int ) );
+    buffer->zx = (double*) malloc( capacity * sizeof( double ) );
+    buffer->zy = (double*) malloc( capacity * sizeof( double ) );
+    buffer->cx = (double*) malloc( capacity * sizeof( double ) );
+    buffer->cy = (double*) malloc( capacity * sizeof( double ) );
+    buffer->iterations = (int*) malloc( capacity * sizeof( int ) );
+    buffer->x = (double*) malloc( capacity * sizeof( double ) );
+    buffer->y = (double*) malloc( capacity * sizeof( double ) );
+    buffer->sampleIterations = (int*) malloc( capacity * sizeof( int ) );
+    buffer->sampleSmoothIterations = (float*) malloc( capacity * sizeof( float ) );
+    buffer->tileIterations = (int*) malloc( capacity * sizeof( int ) );
+    buffer->tileSmoothIterations = (float*) malloc( capacity * sizeof( float ) );
+    buffer->known = (bool*) malloc( capacity * sizeof( bool ) );
+    buffer->leafPoints = (int*) malloc( capacity * sizeof( int ) );
+    buffer->leafCount = 0;
+
+    return buffer;
+
+}
+
+void destroySampleBuffer( SampleBuffer *buffer ) {
+    free( buffer->px );
+    free( buffer->py );
+    free( buffer->indexes );
+    free( buffer->zx );
+    free( buffer->zy );
+    free( buffer->cx );
+    free( buffer->cy );
+    free( buffer->iterations );
+    free( buffer->x );
+    free( buffer->y );
+    free( buffer->sampleIterations );
+    free( buffer->sampleSmoothIterations );
+    free( buffer->tileIterations );
+    free( buffer->tileSmoothIterations );
+    free( buffer->known );
+    free( buffer->leafPoints );
+    free( buffer );
+}
+
+void sampleFractalPoints( const RenderParams *params, FractalKernelType kernel, int width, int height, SampleBuffer *buffer, RenderStats *stats ) {
+
+    // the cardioid test needs the whole c, that deep zoom does not have
+    bool cardioid = params->shortcuts[FRACTAL_SHORTCUT_CARDIOID] && params->mandelbrot && !params->deep;
+    int count = 0;
+
+    for ( int i = 0; i < buffer->count; i++ ) {
+
+        double zx;
+        double zy;
+        double cx;
+        double cy;
+        setupFractalPoint( params, buffer->px[i], buffer->py[i], width, height, &zx, &zy, &cx, &cy );
+
+        if ( cardioid && isInsideCardioidOrBulb( cx, cy ) ) {
+            buffer->sampleIterations[i] = params->maxIterations;
+            buffer->sampleSmoothIterations[i] = 0;
+            stats->savedIterations[FRACTAL_SHORTCUT_CARDIOID] += params->maxIterations;
+        } else {
+            buffer->zx[count] = zx;
+            buffer->zy[count] = zy;
+            buffer->cx[count] = cx;
+            buffer->cy[count] = cy;
+            buffer->indexes[count] = i;
+            count++;
+        }
+
+    }
+
+    FractalKernelRow row = {
+        .count = count,
+        .zx = buffer->zx,
+        .zy = buffer->zy,
+        .cx = buffer->cx,
+        .cy = buffer->cy,
+        .iterations = buffer->iterations,
+        .x = buffer->x,
+        .y = buffer->y
+    };
+    setupFractalKernelRow( params, &row );
+
+    long long saved = 0;
+    if ( params->deep ) {
+        stats->glitches += iterateDeepZoom( params->orbit, &row );
+    } else {
+        saved = iterateFractalKernel( kernel, &row );
+    }
+    stats->savedIterations[FRACTAL_SHORTCUT_PERIODICITY] += saved;
+    stats->iterations -= saved;
+
+    for ( int k = 0; k < count; k++ ) {
+        int i = buffer->indexes[k];
+        int iteration = buffer->iterations[k];
+        buffer->sampleIterations[i] = iteration;
+        buffer->sampleSmoothIterations[i] = getSmoothIteration( iteration, params->maxIterations, buffer->x[k], buffer->y[k] );
+        stats->iterations += iteration;
+    }
+
+}
+
+/**
+ * @brief Mariani-Silver subdivision of the rectangle from ( x0, y0 ) to
+ * ( x1, y1 ) of the tile, inclusive: if its border is entirely in the
+ * set, the set is connected and has no holes, so is its interior. Else
+ * it is split in four, until it is small enough to be iterated. Returns
+ * false if the render was cancelled.
+ */
+static bool subdivideFractalRenderer( FractalRenderer *fr, const RenderTile *tile, const RenderParams *params, FractalKernelType kernel, unsigned int generation, SampleBuffer *buffer, RenderStats *stats, int x0, int y0, int x1, int y1 ) {
+
+    buffer->count = 0;
+    for ( int x = x0; x <= x1; x++ ) {
+        addTilePointFractalRenderer( tile, buffer, x, y0 );
+        addTilePointFractalRenderer( tile, buffer, x, y1 );
+    }
+    for ( int y = y0 + 1; y < y1; y++ ) {
+        addTilePointFractalRenderer( tile, buffer, x0, y );
+        addTilePointFractalRenderer( tile, buffer, x1, y );
+    }
+
+    if ( !sampleTileFractalRenderer( fr, tile, params, kernel, generation, buffer, stats ) ) {
+        return false;
+    }
+
+    const int *iterations = buffer->tileIterations;
+    const int width = tile->width;
+    bool inside = true;
+
+    for ( int x = x0; x <= x1 && inside; x++ ) {
+        inside = iterations[y0 * width + x] == params->maxIterations && 
+                 iterations[y1 * width + x] == params->maxIterations;
+    }
+    for ( int y = y0 + 1; y < y1 && inside; y++ ) {
+        inside = iterations[y * width + x0] == params->maxIterations && 
+                 iterations[y * width + x1] == params->maxIterations;
+    }
+
+    if ( inside ) {
+        for ( int y = y0 + 1; y < y1; y++ ) {
+            for ( int x = x0 + 1; x < x1; x++ ) {
+                int p = y * width + x;
+                if ( !buffer->known[p] ) {
+                    buffer->known[p] = true;
+                    buffer->tileIterations[p] = params->maxIterations;
+                    buffer->tileSmoothIterations[p] = 0;
+                    stats->savedIterations[FRACTAL_SHORTCUT_SUBDIVISION] += params->maxIterations;
+                }
+            }
+        }
+        return true;
+    }
+
+    if ( x1 - x0 <= FRACTAL_RENDERER_MIN_SUBDIVISION || y1 - y0 <= FRACTAL_RENDERER_MIN_SUBDIVISION ) {
+        for ( int y = y0 + 1; y < y1; y++ ) {
+            for ( int x = x0 + 1; x < x1; x++ ) {
+                int p = y * width + x;
+                if ( !buffer->known[p] ) {
+                    buffer->known[p] = true;
+                    buffer->leafPoints[buffer->leafCount++] = p;
+                }
+            }
+        }
+        return true;
+    }
+
+    // the four halves share their middle borders
+    int xm = ( x0 + x1 ) / 2;
+    int ym = ( y0 + y1 ) / 2;
+
+    return subdivideFractalRenderer( fr, tile, params, kernel, generation, buffer, stats, x0, y0, xm, ym ) &&
+           subdivideFractalRenderer( fr, tile, params, kernel, generation, buffer, stats, xm, y0, x1, ym ) &&
+           subdivideFractalRenderer( fr, tile, params, kernel, generation, buffer, stats, x0, ym, xm, y1 ) &&
+           subdivideFractalRenderer( fr, tile, params, kernel, generation, buffer, stats, xm, ym, x1, y1 );
+
+}
+
+/**
+ * @brief Adds the point ( x, y ) of the tile to the buffer if it was
+ * not sampled yet.
+ */
+static void addTilePointFractalRenderer( const RenderTile *tile, SampleBuffer *buffer, int x, int y ) {
+
+    int p = y * tile->width + x;
+
+    if ( !buffer->known[p] ) {
+        buffer->known[p] = true;
+        buffer->px[buffer->count] = tile->x + x;
+        buffer->py[buffer->count] = tile->y + y;
+        buffer->count++;
+    }
+
+}
+
+/**
+ * @brief Samples the points added to the buffer and stores their
+ * results in the tile arrays. Returns false if the render was
+ * cancelled.
+ */
+static bool sampleTileFractalRenderer( FractalRenderer *fr, const RenderTile *tile, const RenderParams *params, FractalKernelType kernel, unsigned int generation, SampleBuffer *buffer, RenderStats *stats ) {
+
+    if ( buffer->count == 0 ) {
+        return true;
+    }
+
+    if ( !isCurrentFractalRenderer( fr, generation ) ) {
+        return false;
+    }
+
+    sampleFractalPoints( params, kernel, fr->width, fr->height, buffer, stats );
+
+    for ( int i = 0; i < buffer->count; i++ ) {
+        int p = ( buffer->py[i] - tile->y ) * tile->width + buffer->px[i] - tile->x;
+        buffer->tileIterations[p] = buffer->sampleIterations[i];
+        buffer->tileSmoothIterations[p] = buffer->sampleSmoothIterations[i];
+    }
+
+    return true;
+
+}
+
+static bool isCurrentFractalRenderer( FractalRenderer *fr, unsigned int generation ) {
+    pthread_mutex_lock( &fr->mutex );
+    bool current = generation == fr->generation;
+    pthread_mutex_unlock( &fr->mutex );
+    return current;
+}
+
+/**
+ * @brief Copies lines of the tile to the image, starting at the line y,
+ * and colors them. The source is a single line repeated if sameLine is
+ * true, else one line per image line. Must be called with the mutex
+ * locked, so a recolor can not miss the lines.
+ */
+static void copyTileLinesFractalRenderer( FractalRenderer *fr, const RenderTile *tile, const int *iterations, const float *smoothIterations, int y, int lines, bool sameLine ) {
+
+    for ( int k = 0; k < lines; k++ ) {
+        int start = ( y + k ) * fr->width + tile->x;
+        int source = sameLine ? 0 : k * tile->width;
+        memcpy( &fr->iterations[start], iterations + source, tile->width * sizeof( int ) );
+        memcpy( &fr->smoothIterations[start], smoothIterations + source, tile->width * sizeof( float ) );
+        colorFractalPalette( fr->palette, &fr->iterations[start], &fr->smoothIterations[start], &fr->pixels[start], tile->width );
+    }
+
+    fr->pixelsChanged = true;
+
+}
+
+/**
+ * @brief Frees the orbits of older renders. Must be called with the
+ * mutex locked and no thread rendering.
+ */
+static void freeRetiredOrbitsFractalRenderer( FractalRenderer *fr ) {
+    for ( int i = 0; i < fr->retiredOrbitCount; i++ ) {
+        destroyReferenceOrbit( fr->retiredOrbits[i] );
+    }
+    fr->retiredOrbitCount = 0;
+}
+
+static int compareTilesByCenterDistance( const void *t1, const void *t2 ) {
+
+    const RenderTile *a = (const RenderTile*) t1;
+    const RenderTile *b = (const RenderTile*) t2;
+
+    int ax = a->x + a->width / 2 - sortingCenterX;
+    int ay = a->y + a->height / 2 - sortingCenterY;
+    int bx = b->x + b->width / 2 - sortingCenterX;
+    int by = b->y + b->height / 2 - sortingCenterY;
+
+    return ( ax * ax + ay * ay ) - ( bx * bx + by * by );
+
+}
+
+void setupFractalPoint( const RenderParams *params, double px, double py, int width, int height, 
+                        double *zx, double *zy, double *cx, double *cy ) {
+
+    // based on https://en.wikipedia.org/wiki/Mandelbrot_set
+    //          https://en.wikipedia.org/wiki/Julia_set
+
+    if ( params->deep ) {
+
+        // offset from the reference, at the center of the view
+        const double dx = ( px / width - 0.5 ) * params->spanX;
+        const double dy = ( py / height - 0.5 ) * params->spanY;
+
+        if ( params->mandelbrot ) {
+            *zx = 0.0;
+            *zy = 0.0;
+            *cx = dx;
+            *cy = dy;
+        } else {
+            *zx = dx;
+            *zy = dy;
+            *cx = 0.0;
+            *cy = 0.0;
+        }
+
+        return;
+
+    }
+
+    const double x0 = Lerp( params->minX, params->maxX, ( px / width ) );   // real
+    const double y0 = Lerp( params->minY, params->maxY, ( py / height ) );  // imaginary
+
+    if ( params->mandelbrot ) {
+        // fixed complex number
+        *zx = 0.0;
+        *zy = 0.0;
+        *cx = x0;
+        *cy = y0;
+    } else {
+        // variyng complex number (min and max related to scapeRadius)
+        *zx = x0;
+        *zy = y0;
+        *cx = params->cx;
+        *cy = params->cy;
+    }
+
+}
+
+void setupFractalKernelRow( const RenderParams *params, FractalKernelRow *row ) {
+    row->maxIterations = params->maxIterations;
+    row->periodicity = params->shortcuts[FRACTAL_SHORTCUT_PERIODICITY];
+    if ( params->mandelbrot ) {
+        row->bailout = 1 << 16;
+        row->inclusiveBailout = true;
+    } else {
+        row->bailout = params->scapeRadius * params->scapeRadius;
+        row->inclusiveBailout = false;
+    }
+}
+
+void getFractalSample( const RenderParams *params, double px, double py, int width, int height, 
+                       int *iteration, float *smoothIteration ) {
+
+    double zx;
+    double zy;
+    double cx;
+    double cy;
+    double x;
+    double y;
+
+    setupFractalPoint( params, px, py, width, height, &zx, &zy, &cx, &cy );
+
+    FractalKernelRow row = {
+        .count = 1,
+        .zx = &zx,
+        .zy = &zy,
+        .cx = &cx,
+        .cy = &cy,
+        .iterations = iteration,
+        .x = &x,
+        .y = &y
+    };
+    setupFractalKernelRow( params, &row );
+    iterateFractalKernel( FRACTAL_KERNEL_SCALAR, &row );
+
+    *smoothIteration = getSmoothIteration( *iteration, params->maxIterations, x, y );
+
+}
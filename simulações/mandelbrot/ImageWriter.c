@@ -0,0 +1,344 @@
+/**
+ * @file ImageWriter.c
+ * @author Prof. Dr. David Buzatto
+ * @brief ImageWriter implementation.
+ *
+ * PNG: https://www.w3.org/TR/png/
+ * zlib and deflate: https://www.rfc-editor.org/rfc/rfc1950
+ *                   https://www.rfc-editor.org/rfc/rfc1951
+ *
+ * @copyright Copyright (c) 2024
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "raylib.h"
+#include "ImageWriter.h"
+
+#define DEFLATE_MIN_MATCH 3
+#define DEFLATE_MAX_MATCH 258
+#define ADLER_MOD 65521
+#define ADLER_BLOCK 5552
+
+static void writeBytesImageWriter( ImageWriter *writer, const void *data, size_t size );
+static void writeUInt32ImageWriter( ImageWriter *writer, uint32_t value );
+static void writeChunkImageWriter( ImageWriter *writer, const char *type, const uint8_t *data, uint32_t size );
+static void flushChunkImageWriter( ImageWriter *writer );
+static void putByteImageWriter( ImageWriter *writer, uint8_t value );
+static void writeBitsImageWriter( ImageWriter *writer, uint32_t value, int count );
+static void writeSymbolImageWriter( ImageWriter *writer, int symbol );
+static void writeMatchImageWriter( ImageWriter *writer, int length );
+static void deflateLineImageWriter( ImageWriter *writer, const uint8_t *data, int size );
+static uint32_t updateAdler32( uint32_t adler, const uint8_t *data, size_t size );
+static uint32_t updateCrc32( uint32_t crc, const uint8_t *data, size_t size );
+static uint32_t reverseBits( uint32_t value, int count );
+
+// length codes 257 to 285 of deflate
+static const int LENGTH_BASES[] = { 
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 
+};
+static const int LENGTH_EXTRA_BITS[] = { 
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 
+};
+static const int LENGTH_CODES = sizeof( LENGTH_BASES ) / sizeof( LENGTH_BASES[0] );
+
+// one pixel back, distance code 2 of deflate
+static const int PIXEL_DISTANCE = 3;
+static const int PIXEL_DISTANCE_CODE = 2;
+
+static uint32_t crcTable[256];
+static bool crcTableReady = false;
+
+ImageWriter* createImageWriter( const char *fileName, int width, int height ) {
+
+    ImageWriterFormat format;
+
+    if ( IsFileExtension( fileName, ".png" ) ) {
+        format = IMAGE_WRITER_PNG;
+    } else if ( IsFileExtension( fileName, ".ppm" ) ) {
+        format = IMAGE_WRITER_PPM;
+    } else {
+        return NULL;
+    }
+
+    FILE *file = fopen( fileName, "wb" );
+    if ( file == NULL ) {
+        return NULL;
+    }
+
+    ImageWriter *writer = (ImageWriter*) malloc( sizeof( ImageWriter ) );
+
+    writer->file = file;
+    writer->format = format;
+    writer->width = width;
+    writer->height = height;
+    writer->writtenLines = 0;
+    writer->line = (uint8_t*) malloc( 3 * width + 1 );
+    writer->bits = 0;
+    writer->bitCount = 0;
+    writer->chunkSize = 0;
+    writer->adler = 1;
+    writer->bytes = 0;
+    writer->failed = false;
+
+    if ( format == IMAGE_WRITER_PPM ) {
+
+        char header[64];
+        int size = snprintf( header, sizeof( header ), "P6\n%d %d\n255\n", width, height );
+        writeBytesImageWriter( writer, header, size );
+
+    } else {
+
+        const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        writeBytesImageWriter( writer, signature, sizeof( signature ) );
+
+        // 8 bits per channel, rgb, no interlacing
+        uint8_t header[13] = {
+            width >> 24, width >> 16, width >> 8, width,
+            height >> 24, height >> 16, height >> 8, height,
+            8, 2, 0, 0, 0
+        };
+        writeChunkImageWriter( writer, "IHDR", header, sizeof( header ) );
+
+        // zlib header (deflate, 32K window) and the only deflate block,
+        // final, with fixed Huffman codes
+        putByteImageWriter( writer, 0x78 );
+        putByteImageWriter( writer, 0x01 );
+        writeBitsImageWriter( writer, 1, 1 );
+        writeBitsImageWriter( writer, 1, 2 );
+
+    }
+
+    return writer;
+
+}
+
+void writeLinesImageWriter( ImageWriter *writer, const Color *pixels, int lines ) {
+
+    for ( int i = 0; i < lines; i++ ) {
+
+        const Color *linePixels = pixels + (size_t) i * writer->width;
+        uint8_t *rgb = writer->line + 1;
+
+        for ( int j = 0; j < writer->width; j++ ) {
+            rgb[3 * j] = linePixels[j].r;
+            rgb[3 * j + 1] = linePixels[j].g;
+            rgb[3 * j + 2] = linePixels[j].b;
+        }
+
+        if ( writer->format == IMAGE_WRITER_PPM ) {
+            writeBytesImageWriter( writer, rgb, 3 * writer->width );
+        } else {
+            // filter type none
+            writer->line[0] = 0;
+            writer->adler = updateAdler32( writer->adler, writer->line, 3 * writer->width + 1 );
+            deflateLineImageWriter( writer, writer->line, 3 * writer->width + 1 );
+        }
+
+        writer->writtenLines++;
+
+    }
+
+}
+
+bool destroyImageWriter( ImageWriter *writer ) {
+
+    if ( writer->format == IMAGE_WRITER_PNG ) {
+
+        // end of block, padding to a byte and the adler-32 of the data
+        writeSymbolImageWriter( writer, 256 );
+        if ( writer->bitCount > 0 ) {
+            writeBitsImageWriter( writer, 0, 8 - writer->bitCount );
+        }
+        putByteImageWriter( writer, writer->adler >> 24 );
+        putByteImageWriter( writer, writer->adler >> 16 );
+        putByteImageWriter( writer, writer->adler >> 8 );
+        putByteImageWriter( writer, writer->adler );
+        flushChunkImageWriter( writer );
+
+        writeChunkImageWriter( writer, "IEND", NULL, 0 );
+
+    }
+
+    bool ok = !writer->failed && writer->writtenLines == writer->height;
+    ok = fclose( writer->file ) == 0 && ok;
+
+    free( writer->line );
+    free( writer );
+
+    return ok;
+
+}
+
+static void writeBytesImageWriter( ImageWriter *writer, const void *data, size_t size ) {
+    if ( fwrite( data, 1, size, writer->file ) != size ) {
+        writer->failed = true;
+    }
+    writer->bytes += size;
+}
+
+static void writeUInt32ImageWriter( ImageWriter *writer, uint32_t value ) {
+    uint8_t bytes[4] = { value >> 24, value >> 16, value >> 8, value };
+    writeBytesImageWriter( writer, bytes, 4 );
+}
+
+static void writeChunkImageWriter( ImageWriter *writer, const char *type, const uint8_t *data, uint32_t size ) {
+
+    uint32_t crc = updateCrc32( 0xFFFFFFFF, (const uint8_t*) type, 4 );
+    crc = updateCrc32( crc, data, size );
+
+    writeUInt32ImageWriter( writer, size );
+    writeBytesImageWriter( writer, type, 4 );
+    writeBytesImageWriter( writer, data, size );
+    writeUInt32ImageWriter( writer, crc ^ 0xFFFFFFFF );
+
+}
+
+static void flushChunkImageWriter( ImageWriter *writer ) {
+    if ( writer->chunkSize > 0 ) {
+        writeChunkImageWriter( writer, "IDAT", writer->chunk, writer->chunkSize );
+        writer->chunkSize = 0;
+    }
+}
+
+/**
+ * @brief Appends a byte of the zlib stream to the current IDAT chunk.
+ */
+static void putByteImageWriter( ImageWriter *writer, uint8_t value ) {
+    writer->chunk[writer->chunkSize++] = value;
+    if ( writer->chunkSize == IMAGE_WRITER_CHUNK_SIZE ) {
+        flushChunkImageWriter( writer );
+    }
+}
+
+/**
+ * @brief Writes count bits of value, least significant first, as
+ * deflate packs its data.
+ */
+static void writeBitsImageWriter( ImageWriter *writer, uint32_t value, int count ) {
+
+    writer->bits |= value << writer->bitCount;
+    writer->bitCount += count;
+
+    while ( writer->bitCount >= 8 ) {
+        putByteImageWriter( writer, writer->bits & 0xFF );
+        writer->bits >>= 8;
+        writer->bitCount -= 8;
+    }
+
+}
+
+/**
+ * @brief Writes a literal or length symbol with its fixed Huffman code.
+ * Huffman codes are packed most significant bit first.
+ */
+static void writeSymbolImageWriter( ImageWriter *writer, int symbol ) {
+    if ( symbol < 144 ) {
+        writeBitsImageWriter( writer, reverseBits( 0x30 + symbol, 8 ), 8 );
+    } else if ( symbol < 256 ) {
+        writeBitsImageWriter( writer, reverseBits( 0x190 + symbol - 144, 9 ), 9 );
+    } else if ( symbol < 280 ) {
+        writeBitsImageWriter( writer, reverseBits( symbol - 256, 7 ), 7 );
+    } else {
+        writeBitsImageWriter( writer, reverseBits( 0xC0 + symbol - 280, 8 ), 8 );
+    }
+}
+
+/**
+ * @brief Writes a copy of length bytes from one pixel back.
+ */
+static void writeMatchImageWriter( ImageWriter *writer, int length ) {
+
+    int code = LENGTH_CODES - 1;
+    while ( LENGTH_BASES[code] > length ) {
+        code--;
+    }
+
+    writeSymbolImageWriter( writer, 257 + code );
+    writeBitsImageWriter( writer, length - LENGTH_BASES[code], LENGTH_EXTRA_BITS[code] );
+    writeBitsImageWriter( writer, reverseBits( PIXEL_DISTANCE_CODE, 5 ), 5 );
+
+}
+
+static void deflateLineImageWriter( ImageWriter *writer, const uint8_t *data, int size ) {
+
+    // the filter byte and the first pixel are always literals
+    int i = 0;
+
+    while ( i < size ) {
+
+        int length = 0;
+        if ( i > PIXEL_DISTANCE ) {
+            while ( length < DEFLATE_MAX_MATCH && i + length < size && 
+                    data[i + length] == data[i + length - PIXEL_DISTANCE] ) {
+                length++;
+            }
+        }
+
+        if ( length >= DEFLATE_MIN_MATCH ) {
+            writeMatchImageWriter( writer, length );
+            i += length;
+        } else {
+            writeSymbolImageWriter( writer, data[i] );
+            i++;
+        }
+
+    }
+
+}
+
+static uint32_t updateAdler32( uint32_t adler, const uint8_t *data, size_t size ) {
+
+    uint32_t a = adler & 0xFFFF;
+    uint32_t b = adler >> 16;
+
+    // the sums can go this far without overflowing before the modulo
+    while ( size > 0 ) {
+        size_t block = size < ADLER_BLOCK ? size : ADLER_BLOCK;
+        for ( size_t i = 0; i < block; i++ ) {
+            a += data[i];
+            b += a;
+        }
+        a %= ADLER_MOD;
+        b %= ADLER_MOD;
+        data += block;
+        size -= block;
+    }
+
+    return b << 16 | a;
+
+}
+
+static uint32_t updateCrc32( uint32_t crc, const uint8_t *data, size_t size ) {
+
+    if ( !crcTableReady ) {
+        for ( uint32_t n = 0; n < 256; n++ ) {
+            uint32_t c = n;
+            for ( int k = 0; k < 8; k++ ) {
+                c = c & 1 ? 0xEDB88320 ^ ( c >> 1 ) : c >> 1;
+            }
+            crcTable[n] = c;
+        }
+        crcTableReady = true;
+    }
+
+    for ( size_t i = 0; i < size; i++ ) {
+        crc = crcTable[( crc ^ data[i] ) & 0xFF] ^ ( crc >> 8 );
+    }
+
+    return crc;
+
+}
+
+static uint32_t reverseBits( uint32_t value, int count ) {
+    uint32_t reversed = 0;
+    for ( int i = 0; i < count; i++ ) {
+        reversed = reversed << 1 | ( ( value >> i ) & 1 );
+    }
+    return reversed;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file PosterRenderer.c
+ * @author Prof. Dr. David Buzatto
+ * @brief PosterRenderer implementation.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "raylib.h"
+#include "FractalKernel.h"
+#include "FractalPalette.h"
+#include "FractalRenderer.h"
+#include "ImageWriter.h"
+#include "PosterRenderer.h"
+
+// seconds between two progress lines
+#define POSTER_RENDERER_PROGRESS_INTERVAL 0.5
+
+static void *workerPosterRenderer( void *data );
+static void printProgressPosterRenderer( PosterRenderer *pr, int writtenStrips, double seconds );
+static double getSecondsPosterRenderer( void );
+
+bool renderPoster( const RenderParams *params, int width, int height, int threadCount, const char *fileName ) {
+
+    ImageWriter *writer = createImageWriter( fileName, width, height );
+    if ( writer == NULL ) {
+        fprintf( stderr, "could not create %s (png or ppm)\n", fileName );
+        return false;
+    }
+
+    PosterRenderer pr;
+    pr.params = *params;
+    pr.params.deep = false;
+    pr.params.orbit = NULL;
+    pr.kernel = getBestFractalKernel();
+    pr.palette = createFractalPalette();
+    setupFractalPalette( pr.palette, params->maxIterations, params->colored, params->gradient, params->hueStart, params->hueEnd );
+    pr.width = width;
+    pr.height = height;
+    pr.stripCount = ( height + POSTER_RENDERER_STRIP_HEIGHT - 1 ) / POSTER_RENDERER_STRIP_HEIGHT;
+
+    pr.slotCount = threadCount * POSTER_RENDERER_SLOTS_PER_THREAD;
+    pr.slots = (PosterSlot*) malloc( pr.slotCount * sizeof( PosterSlot ) );
+    for ( int i = 0; i < pr.slotCount; i++ ) {
+        pr.slots[i].strip = -1;
+        pr.slots[i].done = false;
+        pr.slots[i].pixels = (Color*) malloc( (size_t) width * POSTER_RENDERER_STRIP_HEIGHT * sizeof( Color ) );
+    }
+
+    pthread_mutex_init( &pr.mutex, NULL );
+    pthread_cond_init( &pr.stripReady, NULL );
+    pthread_cond_init( &pr.slotFree, NULL );
+    pr.nextStrip = 0;
+    pr.stats = (RenderStats) {0};
+
+    printf( "poster: %dx%d, %d iterations, %d threads, %s kernel, %d strips of %d rows, %.1f MB of strips\n",
+            width, height, params->maxIterations, threadCount, getNameFractalKernel( pr.kernel ),
+            pr.stripCount, POSTER_RENDERER_STRIP_HEIGHT,
+            (double) pr.slotCount * width * POSTER_RENDERER_STRIP_HEIGHT * sizeof( Color ) / ( 1 << 20 ) );
+
+    double startTime = getSecondsPosterRenderer();
+    double progressTime = startTime;
+
+    pthread_t *threads = (pthread_t*) malloc( threadCount * sizeof( pthread_t ) );
+    for ( int i = 0; i < threadCount; i++ ) {
+        pthread_create( &threads[i], NULL, workerPosterRenderer, &pr );
+    }
+
+    // writes the strips in order as they are finished
+    for ( int s = 0; s < pr.stripCount; s++ ) {
+
+        PosterSlot *slot = &pr.slots[s % pr.slotCount];
+
+        pthread_mutex_lock( &pr.mutex );
+        while ( slot->strip != s || !slot->done ) {
+            pthread_cond_wait( &pr.stripReady, &pr.mutex );
+        }
+        pthread_mutex_unlock( &pr.mutex );
+
+        int y = s * POSTER_RENDERER_STRIP_HEIGHT;
+        int lines = height - y < POSTER_RENDERER_STRIP_HEIGHT ? height - y : POSTER_RENDERER_STRIP_HEIGHT;
+        writeLinesImageWriter( writer, slot->pixels, lines );
+
+        pthread_mutex_lock( &pr.mutex );
+        slot->strip = -1;
+        slot->done = false;
+        pthread_cond_broadcast( &pr.slotFree );
+        pthread_mutex_unlock( &pr.mutex );
+
+        double now = getSecondsPosterRenderer();
+        if ( now - progressTime >= POSTER_RENDERER_PROGRESS_INTERVAL ) {
+            printProgressPosterRenderer( &pr, s + 1, now - startTime );
+            progressTime = now;
+        }
+
+    }
+
+    for ( int i = 0; i < threadCount; i++ ) {
+        pthread_join( threads[i], NULL );
+    }
+
+    long long bytes = writer->bytes;
+    bool ok = destroyImageWriter( writer );
+    double seconds = getSecondsPosterRenderer() - startTime;
+
+    printProgressPosterRenderer( &pr, pr.stripCount, seconds );
+    printf( "\n" );
+    printf( "%.2f seconds, %.1f MB written to %s\n", seconds, (double) bytes / ( 1 << 20 ), fileName );
+    for ( int i = 0; i < FRACTAL_SHORTCUT_COUNT; i++ ) {
+        if ( i != FRACTAL_SHORTCUT_SUBDIVISION ) {
+            printf( "%s saved %.1f Mit\n", getNameFractalShortcut( i ), pr.stats.savedIterations[i] / 1e6 );
+        }
+    }
+    if ( !ok ) {
+        fprintf( stderr, "could not write %s\n", fileName );
+    }
+
+    free( threads );
+    for ( int i = 0; i < pr.slotCount; i++ ) {
+        free( pr.slots[i].pixels );
+    }
+    free( pr.slots );
+    destroyFractalPalette( pr.palette );
+    pthread_mutex_destroy( &pr.mutex );
+    pthread_cond_destroy( &pr.stripReady );
+    pthread_cond_destroy( &pr.slotFree );
+
+    return ok;
+
+}
+
+static void *workerPosterRenderer( void *data ) {
+
+    PosterRenderer *pr = (PosterRenderer*) data;
+    SampleBuffer *buffer = createSampleBuffer( pr->width );
+
+    while ( true ) {
+
+        // takes the next strip as soon as its slot was written
+        pthread_mutex_lock( &pr->mutex );
+        while ( pr->nextStrip < pr->stripCount && pr->slots[pr->nextStrip % pr->slotCount].strip != -1 ) {
+            pthread_cond_wait( &pr->slotFree, &pr->mutex );
+        }
+        if ( pr->nextStrip == pr->stripCount ) {
+            pthread_mutex_unlock( &pr->mutex );
+            break;
+        }
+        int strip = pr->nextStrip++;
+        PosterSlot *slot = &pr->slots[strip % pr->slotCount];
+        slot->strip = strip;
+        pthread_mutex_unlock( &pr->mutex );
+
+        RenderStats stats = {0};
+        int y0 = strip * POSTER_RENDERER_STRIP_HEIGHT;
+
+        for ( int y = y0; y < y0 + POSTER_RENDERER_STRIP_HEIGHT && y < pr->height; y++ ) {
+
+            for ( int x = 0; x < pr->width; x++ ) {
+                buffer->px[x] = x;
+                buffer->py[x] = y;
+            }
+            buffer->count = pr->width;
+
+            sampleFractalPoints( &pr->params, pr->kernel, pr->width, pr->height, buffer, &stats );
+            colorFractalPalette( pr->palette, buffer->sampleIterations, buffer->sampleSmoothIterations, 
+                                 slot->pixels + (size_t) ( y - y0 ) * pr->width, pr->width );
+
+        }
+
+        pthread_mutex_lock( &pr->mutex );
+        slot->done = true;
+        pr->stats.iterations += stats.iterations;
+        for ( int i = 0; i < FRACTAL_SHORTCUT_COUNT; i++ ) {
+            pr->stats.savedIterations[i] += stats.savedIterations[i];
+        }
+        pthread_cond_broadcast( &pr->stripReady );
+        pthread_mutex_unlock( &pr->mutex );
+
+    }
+
+    destroySampleBuffer( buffer );
+
+    return NULL;
+
+}
+
+static void printProgressPosterRenderer( PosterRenderer *pr, int writtenStrips, double seconds ) {
+
+    int lines = writtenStrips * POSTER_RENDERER_STRIP_HEIGHT;
+    lines = lines < pr->height ? lines : pr->height;
+
+    pthread_mutex_lock( &pr->mutex );
+    long long iterations = pr->stats.iterations;
+    pthread_mutex_unlock( &pr->mutex );
+
+    seconds = seconds > 0 ? seconds : 1e-9;
+    printf( "\r%5.1f%%  %8.2f Mpix/s  %10.1f Mpix-it/s", 
+            100.0 * lines / pr->height, 
+            (double) lines * pr->width / seconds / 1e6, 
+            iterations / seconds / 1e6 );
+    fflush( stdout );
+
+}
+
+/**
+ * @brief Wall clock seconds, since clock() is processor time of all
+ * threads on some systems.
+ */
+static double getSecondsPosterRenderer( void ) {
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
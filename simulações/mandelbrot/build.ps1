@@ -43,6 +43,7 @@ if ( $compile -or $cleanAndCompile -or $compileAndRun -or $all ) {
         -Wextra `
         -pedantic-errors `
         -std=c99 `
+        -pthread `
         -Wno-missing-braces `
         -I include/ `
         -L lib/ `
@@ -0,0 +1,39 @@
+/**
+ * @file BigFloat.h
+ * @author Prof. Dr. David Buzatto
+ * @brief BigFloat struct and functions declarations.
+ *
+ * A signed fixed point number made of 32 bit limbs: the first limb is
+ * the integer part and the others the fraction, from the most to the
+ * least significant. The operations work with the first limbs limbs of
+ * their arguments, so the precision can follow the zoom.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdint.h>
+
+#define BIG_FLOAT_MAX_LIMBS 24
+
+typedef struct BigFloat {
+    int sign;                               // 1 or -1
+    uint32_t limbs[BIG_FLOAT_MAX_LIMBS];
+} BigFloat;
+
+void setDoubleBigFloat( BigFloat *r, double value, int limbs );
+double toDoubleBigFloat( const BigFloat *a, int limbs );
+
+void addBigFloat( BigFloat *r, const BigFloat *a, const BigFloat *b, int limbs );
+void subBigFloat( BigFloat *r, const BigFloat *a, const BigFloat *b, int limbs );
+
+/**
+ * @brief r = a * b, truncated to limbs limbs. The integer part of the
+ * result must fit in one limb.
+ */
+void mulBigFloat( BigFloat *r, const BigFloat *a, const BigFloat *b, int limbs );
+
+/**
+ * @brief r = a + value, with value converted exactly.
+ */
+void addDoubleBigFloat( BigFloat *r, const BigFloat *a, double value, int limbs );
\ No newline at end of file
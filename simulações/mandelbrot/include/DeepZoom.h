@@ -0,0 +1,58 @@
+/**
+ * @file DeepZoom.h
+ * @author Prof. Dr. David Buzatto
+ * @brief Deep zoom with perturbation theory, declarations.
+ *
+ * Only one point, the reference (the center of the view), is iterated
+ * with BigFloats. Every pixel iterates just its difference dz to the
+ * reference orbit Z in double precision:
+ *
+ *     dz(n+1) = 2 Z(n) dz(n) + dz(n)^2 + dc
+ *
+ * dz and dc are small but have a small exponent too, so doubles keep
+ * their relative precision far beyond the 1e-13 where the plain double
+ * kernels break into blocks.
+ *
+ * When the pixel gets closer to zero than to the reference (glitch),
+ * or the reference orbit ends before the pixel escapes, the pixel is
+ * rebased: its dz is taken relative to the start of the orbit again.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdbool.h>
+#include "BigFloat.h"
+#include "FractalKernel.h"
+
+// Pauldelbrot's glitch criterion, |z|^2 < tolerance * |Z|^2
+#define DEEP_ZOOM_GLITCH_TOLERANCE 1e-6
+
+typedef struct ReferenceOrbit {
+    double *x;
+    double *y;
+    int length;
+    int limbs;
+} ReferenceOrbit;
+
+/**
+ * @brief Limbs needed for a view of the given span.
+ */
+int getLimbsDeepZoom( double span );
+
+/**
+ * @brief Iterates z = z^2 + c from z0 with BigFloats, storing each z
+ * rounded to double, until it escapes or maxIterations is reached.
+ */
+ReferenceOrbit* createReferenceOrbit( const BigFloat *z0x, const BigFloat *z0y,
+                                      const BigFloat *cx, const BigFloat *cy,
+                                      int maxIterations, double bailout, int limbs );
+void destroyReferenceOrbit( ReferenceOrbit *orbit );
+
+/**
+ * @brief Iterates a row of points by perturbation. zx and zy of the
+ * row are the starting dz, cx and cy are dc, and x and y receive the
+ * full last z (Z + dz). Returns how many glitches were found, each
+ * one fixed by rebasing.
+ */
+long long iterateDeepZoom( const ReferenceOrbit *orbit, const FractalKernelRow *row );
\ No newline at end of file
@@ -0,0 +1,66 @@
+/**
+ * @file FractalKernel.h
+ * @author Prof. Dr. David Buzatto
+ * @brief Escape time kernels declarations.
+ *
+ * Each kernel iterates z = z^2 + c for a row of points and stores the
+ * iteration count and the last z of each one. The vectorized kernels
+ * run the same double precision operations in the same order as the
+ * scalar one, so all of them give bit identical results.
+ *
+ * With periodicity checking, each point saves its z at powers of two
+ * iterations (Brent's method) and stops, as a point of the set, when z
+ * repeats exactly: from then on the orbit would cycle forever. Exact
+ * comparisons never stop an orbit that would escape, so the iteration
+ * counts do not change.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdbool.h>
+
+typedef enum FractalKernelType {
+    FRACTAL_KERNEL_SCALAR,
+    FRACTAL_KERNEL_SSE2,
+    FRACTAL_KERNEL_AVX2,
+    FRACTAL_KERNEL_TYPE_COUNT
+} FractalKernelType;
+
+typedef struct FractalKernelRow {
+    int count;
+    const double *zx;       // starting z
+    const double *zy;
+    const double *cx;       // c of each point
+    const double *cy;
+    int maxIterations;
+    double bailout;         // squared escape radius
+    bool inclusiveBailout;  // keep iterating while |z|^2 <= bailout instead of <
+    bool periodicity;       // stop cycling orbits
+    int *iterations;        // results
+    double *x;              // last z
+    double *y;
+} FractalKernelRow;
+
+/**
+ * @brief Iterates every point of the row with the given kernel, that
+ * must be supported by the processor. Returns the iterations saved by
+ * the periodicity checking.
+ */
+long long iterateFractalKernel( FractalKernelType type, const FractalKernelRow *row );
+
+bool isSupportedFractalKernel( FractalKernelType type );
+
+/**
+ * @brief The fastest kernel supported by the processor.
+ */
+FractalKernelType getBestFractalKernel( void );
+
+const char *getNameFractalKernel( FractalKernelType type );
+
+/**
+ * @brief Runs every supported kernel over fixed views, printing their
+ * speed in millions of pixel iterations per second and checking that
+ * they match the scalar kernel. Returns false on any mismatch.
+ */
+bool runFractalKernelBenchmark( void );
\ No newline at end of file
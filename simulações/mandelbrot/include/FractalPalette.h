@@ -0,0 +1,49 @@
+/**
+ * @file FractalPalette.h
+ * @author Prof. Dr. David Buzatto
+ * @brief FractalPalette struct and functions declarations.
+ *
+ * Coloring is a separate pass over the iteration counts and smooth
+ * iterations of the pixels: each color is a lookup in a table built
+ * once for each set of color parameters, with one color per iteration
+ * count or, in gradient mode, steps blended colors per iteration count.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdbool.h>
+#include "raylib.h"
+
+// blends per iteration count in gradient mode, and the table size
+// limit that makes the blends fewer for large iteration limits
+#define FRACTAL_PALETTE_MAX_STEPS 32
+#define FRACTAL_PALETTE_MAX_SIZE ( 1 << 18 )
+
+typedef struct FractalPalette {
+    Color *colors;      // ( maxIterations + 1 ) * steps + 1 entries
+    int capacity;
+    int maxIterations;
+    int steps;
+    bool gradient;
+} FractalPalette;
+
+FractalPalette* createFractalPalette( void );
+void destroyFractalPalette( FractalPalette *palette );
+
+/**
+ * @brief Rebuilds the lookup table.
+ */
+void setupFractalPalette( FractalPalette *palette, int maxIterations, bool colored, bool gradient, double hueStart, double hueEnd );
+
+/**
+ * @brief Colors count pixels from their iteration counts, or from their
+ * smooth iterations in gradient mode.
+ */
+void colorFractalPalette( const FractalPalette *palette, const int *iterations, const float *smoothIterations, Color *colors, int count );
+
+/**
+ * @brief Continuous iteration count of a point that escaped after
+ * iteration iterations with last z = x + yi, or 0 if it did not escape.
+ */
+float getSmoothIteration( int iteration, int maxIterations, double x, double y );
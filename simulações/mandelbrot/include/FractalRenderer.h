@@ -0,0 +1,255 @@
+/**
+ * @file FractalRenderer.h
+ * @author Prof. Dr. David Buzatto
+ * @brief FractalRenderer struct and functions declarations.
+ *
+ * The image is split in tiles that are rendered by a pool of threads
+ * in two passes: a coarse one, where each block of pixels gets the
+ * color of its first pixel, and a full resolution one. Starting a new
+ * render cancels the tiles that are still pending.
+ *
+ * The iteration count and the smooth iteration of every pixel are kept,
+ * so a change in the colors just colors them again with the palette.
+ *
+ * Points of the set run every iteration, so three shortcuts can skip
+ * them: the main cardioid and period 2 bulb test, the periodicity
+ * checking of the kernels and, in the full resolution pass, the
+ * Mariani-Silver subdivision, that splits each tile in rectangles
+ * until their borders are entirely in the set and fills them.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <pthread.h>
+#include "raylib.h"
+#include "DeepZoom.h"
+#include "FractalKernel.h"
+#include "FractalPalette.h"
+
+#define FRACTAL_RENDERER_COARSE_BLOCK_SIZE 8
+#define FRACTAL_RENDERER_PASSES 2
+
+// rectangles of the subdivision this size or smaller are iterated
+#define FRACTAL_RENDERER_MIN_SUBDIVISION 8
+
+typedef enum FractalShortcut {
+    FRACTAL_SHORTCUT_CARDIOID,
+    FRACTAL_SHORTCUT_PERIODICITY,
+    FRACTAL_SHORTCUT_SUBDIVISION,
+    FRACTAL_SHORTCUT_COUNT
+} FractalShortcut;
+
+// everything that changes the rendered fractal
+typedef struct RenderParams {
+    double minX;
+    double maxX;
+    double minY;
+    double maxY;
+    bool mandelbrot;
+    bool colored;
+    bool gradient;
+    int maxIterations;
+    double cx;
+    double cy;
+    double scapeRadius;
+    double hueStart;
+    double hueEnd;
+    // deep zoom: pixels are offsets of up to half a span from the
+    // reference orbit, computed at the center of the view
+    bool deep;
+    double spanX;
+    double spanY;
+    ReferenceOrbit *orbit;
+    bool shortcuts[FRACTAL_SHORTCUT_COUNT];
+} RenderParams;
+
+// work done by a render
+typedef struct RenderStats {
+    long long iterations;
+    long long savedIterations[FRACTAL_SHORTCUT_COUNT];
+    long long glitches;
+} RenderStats;
+
+// samples of a render thread: the points to iterate, the kernel input
+// and output of the ones that are not shortcut, their results and the
+// results of the current tile
+typedef struct SampleBuffer {
+    int capacity;
+    int *px;
+    int *py;
+    int count;
+    int *indexes;
+    double *zx;
+    double *zy;
+    double *cx;
+    double *cy;
+    int *iterations;
+    double *x;
+    double *y;
+    int *sampleIterations;
+    float *sampleSmoothIterations;
+    int *tileIterations;
+    float *tileSmoothIterations;
+    bool *known;
+    // interiors of the rectangles too small to subdivide, iterated all
+    // at once at the end of the tile
+    int *leafPoints;
+    int leafCount;
+} SampleBuffer;
+
+typedef struct RenderTile {
+    int x;
+    int y;
+    int width;
+    int height;
+} RenderTile;
+
+typedef struct FractalRenderer {
+
+    int width;
+    int height;
+    int *iterations;
+    float *smoothIterations;
+    Color *pixels;
+    bool pixelsChanged;
+
+    RenderTile *tiles;
+    int tileCount;
+    int tileSize;
+
+    pthread_t *threads;
+    int threadCount;
+    bool running;
+
+    // guards everything below and the pixels
+    pthread_mutex_t mutex;
+    pthread_cond_t workAvailable;
+
+    RenderParams params;
+    FractalPalette *palette;
+    double recolorTime;
+    FractalKernelType kernel;
+    unsigned int generation;
+    int pass;
+    int nextTile;
+    int finishedTiles;
+
+    double startTime;
+    double finishTime;
+    int renderedTiles;
+    RenderStats stats;
+    bool finished;
+
+    // orbits of older renders, freed when no thread is rendering
+    ReferenceOrbit **retiredOrbits;
+    int retiredOrbitCount;
+    int retiredOrbitCapacity;
+    int busyThreads;
+
+} FractalRenderer;
+
+/**
+ * @brief Creates a dinamically allocated FractalRenderer struct instance
+ * and starts its threads. The tiles are ordered from the center of the
+ * image to its borders, so the middle of the view refines first.
+ */
+FractalRenderer* createFractalRenderer( int width, int height, int tileSize, int threadCount );
+
+/**
+ * @brief Stops the threads and destroys a FractalRenderer object.
+ */
+void destroyFractalRenderer( FractalRenderer *fr );
+
+/**
+ * @brief Starts rendering params, cancelling the current render. The
+ * renderer takes the ownership of the reference orbit of deep zoom
+ * params.
+ */
+void startFractalRenderer( FractalRenderer *fr, const RenderParams *params );
+
+/**
+ * @brief Colors the pixels again with the colors of params, keeping the
+ * iteration parameters of the current render.
+ */
+void recolorFractalRenderer( FractalRenderer *fr, const RenderParams *params );
+
+/**
+ * @brief Uploads the pixels to texture if any tile was rendered since
+ * the last upload.
+ */
+void uploadFractalRenderer( FractalRenderer *fr, Texture2D texture );
+
+/**
+ * @brief Changes the escape time kernel used by the next renders.
+ */
+void setKernelFractalRenderer( FractalRenderer *fr, FractalKernelType kernel );
+FractalKernelType getKernelFractalRenderer( FractalRenderer *fr );
+
+bool isFinishedFractalRenderer( FractalRenderer *fr );
+
+/**
+ * @brief Iterations done and saved by the shortcuts, and glitches found
+ * and fixed by rebasing, in the current (or last) render.
+ */
+RenderStats getStatsFractalRenderer( FractalRenderer *fr );
+
+/**
+ * @brief Seconds taken by the last recolor.
+ */
+double getRecolorTimeFractalRenderer( FractalRenderer *fr );
+
+/**
+ * @brief Tiles rendered per second by the current (or last) render.
+ */
+double getTilesPerSecondFractalRenderer( FractalRenderer *fr );
+
+/**
+ * @brief Seconds from the start of the current render to its final
+ * image, or until now if it is not finished.
+ */
+double getRenderTimeFractalRenderer( FractalRenderer *fr );
+
+/**
+ * @brief Number of processors, used as the default thread count.
+ */
+int getProcessorCount( void );
+
+const char *getNameFractalShortcut( FractalShortcut shortcut );
+
+/**
+ * @brief Tests if c is inside the main cardioid or the period 2 bulb
+ * of the Mandelbrot set.
+ */
+bool isInsideCardioidOrBulb( double cx, double cy );
+
+/**
+ * @brief Computes the starting z and the c of the pixel (px, py) of a
+ * width x height image.
+ */
+void setupFractalPoint( const RenderParams *params, double px, double py, int width, int height, 
+                        double *zx, double *zy, double *cx, double *cy );
+
+/**
+ * @brief Sets the iteration limit and the bailout of a kernel row.
+ */
+void setupFractalKernelRow( const RenderParams *params, FractalKernelRow *row );
+
+SampleBuffer* createSampleBuffer( int capacity );
+void destroySampleBuffer( SampleBuffer *buffer );
+
+/**
+ * @brief Iterates the points ( px, py ) of the buffer, of a width x
+ * height image, skipping the ones inside the cardioid or the bulb when
+ * that shortcut is on, and stores their results in the sample arrays
+ * of the buffer. The work done is added to stats.
+ */
+void sampleFractalPoints( const RenderParams *params, FractalKernelType kernel, int width, int height, SampleBuffer *buffer, RenderStats *stats );
+
+/**
+ * @brief Computes the iteration count and the smooth iteration of the
+ * pixel (px, py) of a width x height image with the scalar kernel.
+ */
+void getFractalSample( const RenderParams *params, double px, double py, int width, int height, 
+                       int *iteration, float *smoothIteration );
\ No newline at end of file
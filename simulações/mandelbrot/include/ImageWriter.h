@@ -0,0 +1,65 @@
+/**
+ * @file ImageWriter.h
+ * @author Prof. Dr. David Buzatto
+ * @brief ImageWriter struct and functions declarations.
+ *
+ * Writes an image to a PNG or PPM file (chosen by the extension of the
+ * file name) a few lines at a time, so the whole image never needs to
+ * be in memory. The PNG data is compressed as it is written with fixed
+ * Huffman codes, where the runs of equal pixels, common in fractals,
+ * are coded as copies of the previous pixel.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "raylib.h"
+
+#define IMAGE_WRITER_CHUNK_SIZE ( 1 << 16 )
+
+typedef enum ImageWriterFormat {
+    IMAGE_WRITER_PPM,
+    IMAGE_WRITER_PNG
+} ImageWriterFormat;
+
+typedef struct ImageWriter {
+
+    FILE *file;
+    ImageWriterFormat format;
+    int width;
+    int height;
+    int writtenLines;
+
+    // png: raw line (filter byte and rgb), deflate bit stream and the
+    // data of the current IDAT chunk
+    uint8_t *line;
+    uint32_t bits;
+    int bitCount;
+    uint8_t chunk[IMAGE_WRITER_CHUNK_SIZE];
+    int chunkSize;
+    uint32_t adler;
+
+    long long bytes;            // written to the file
+    bool failed;
+
+} ImageWriter;
+
+/**
+ * @brief Creates the file and writes its header. Returns NULL if the
+ * file could not be created or its extension is not png or ppm.
+ */
+ImageWriter* createImageWriter( const char *fileName, int width, int height );
+
+/**
+ * @brief Writes the next lines of the image, width pixels each.
+ */
+void writeLinesImageWriter( ImageWriter *writer, const Color *pixels, int lines );
+
+/**
+ * @brief Finishes and closes the file and destroys the writer. Returns
+ * false if any write failed or not every line was written.
+ */
+bool destroyImageWriter( ImageWriter *writer );
@@ -0,0 +1,61 @@
+/**
+ * @file PosterRenderer.h
+ * @author Prof. Dr. David Buzatto
+ * @brief PosterRenderer struct and functions declarations.
+ *
+ * Renders images far larger than the memory for their pixels, with no
+ * window: the image is split in horizontal strips that the threads
+ * render in a ring of slots, while the calling thread writes the
+ * finished strips to the file in order. A thread only takes a strip
+ * when its slot was written, so at most slotCount strips are in memory.
+ *
+ * Each row is iterated with the cardioid and periodicity shortcuts of
+ * params; subdivision works on tiles and is not used.
+ *
+ * @copyright Copyright (c) 2024
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <pthread.h>
+#include "raylib.h"
+#include "FractalKernel.h"
+#include "FractalPalette.h"
+#include "FractalRenderer.h"
+
+#define POSTER_RENDERER_STRIP_HEIGHT 16
+#define POSTER_RENDERER_SLOTS_PER_THREAD 2
+
+typedef struct PosterSlot {
+    int strip;          // -1 when free
+    bool done;
+    Color *pixels;
+} PosterSlot;
+
+typedef struct PosterRenderer {
+
+    RenderParams params;
+    FractalKernelType kernel;
+    FractalPalette *palette;
+    int width;
+    int height;
+    int stripCount;
+
+    PosterSlot *slots;
+    int slotCount;
+
+    // guards everything below and the slots
+    pthread_mutex_t mutex;
+    pthread_cond_t stripReady;
+    pthread_cond_t slotFree;
+    int nextStrip;
+    RenderStats stats;
+
+} PosterRenderer;
+
+/**
+ * @brief Renders params to a width x height PNG or PPM file (chosen by
+ * its extension) with threadCount threads, printing the progress and
+ * the throughput. Returns false if the file could not be written.
+ */
+bool renderPoster( const RenderParams *params, int width, int height, int threadCount, const char *fileName );
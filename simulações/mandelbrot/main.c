@@ -24,11 +24,17 @@
 /*---------------------------------------------
  * Project headers.
  --------------------------------------------*/
+#include "BigFloat.h"
+#include "DeepZoom.h"
+#include "FractalKernel.h"
+#include "FractalRenderer.h"
+#include "PosterRenderer.h"
 
 /*---------------------------------------------
  * Macros. 
  --------------------------------------------*/
 #define MAX_ZOOM 15
+#define BENCHMARK_VIEWS 4
 
 /*--------------------------------------------
  * Constants. 
@@ -46,10 +52,23 @@ const bool START_MANDELBROT = true;
 const bool START_COLORED = true;
 const bool START_GRADIENT = false;
 const bool START_ZOOMING = false;
+const bool START_SHORTCUTS = true;
 
 const double MIN_HUE = 0;
 const double MAX_HUE = 360;
 const double COMPLEX_REAL_IMAGINARY_LIMIT = 2;
+const int RENDER_TILE_SIZE = 64;
+const double DEEP_ZOOM_FACTOR = 4;
+const double DEEP_ZOOM_MAX_SPAN = 4;
+const int POSTER_MAX_ITERATIONS = 1000;
+
+// fixed views (minX, maxX, minY, maxY, iterations) rendered by the benchmark
+const double BENCHMARK_VIEW_DATA[BENCHMARK_VIEWS][5] = {
+    { -2.00, 0.47, -1.12, 1.12, 50 },              // full set
+    { -0.7600, -0.7400, 0.0900, 0.1100, 500 },     // seahorse valley
+    { -1.7700, -1.7500, -0.0100, 0.0100, 1000 },   // mini mandelbrot
+    { -0.7453, -0.7433, 0.1117, 0.1137, 2000 }     // deep spirals
+};
 
 /*---------------------------------------------
  * Custom types (enums, structs, unions etc.)
@@ -120,6 +139,33 @@ double lastMinY[MAX_ZOOM];
 double lastMaxY[MAX_ZOOM];
 int currentZoom;
 
+// the fractal is rendered into a cpu buffer by the renderer threads and
+// uploaded to a texture, restarting only when the render parameters change
+FractalRenderer *fractalRenderer;
+Texture2D fractalTexture;
+RenderParams renderedParams;
+bool fractalRendered;
+
+// deep zoom: the center is kept as BigFloats and the view is rendered
+// by perturbation of a reference orbit computed at the center
+bool deepZoom;
+BigFloat deepCenterX;
+BigFloat deepCenterY;
+double deepSpanX;
+double deepSpanY;
+ReferenceOrbit *deepOrbit;  // owned by the renderer once started
+bool deepOrbitDirty;
+
+// skip the iteration of points of the set, toggled with 1, 2 and 3
+bool shortcuts[FRACTAL_SHORTCUT_COUNT];
+
+// -1 when the benchmark is not running
+int benchmarkView = -1;
+double benchmarkTimes[BENCHMARK_VIEWS];
+double benchmarkTilesPerSecond[BENCHMARK_VIEWS];
+RenderStats benchmarkStats[BENCHMARK_VIEWS];
+bool benchmarkDone;
+
 
 /*---------------------------------------------
  * Function prototypes. 
@@ -129,7 +175,16 @@ int currentZoom;
  * @param gw GameWorld struct pointer.
  */
 void inputAndUpdate( void );
-int getIteration( double x0, double y0, double x, double y, int maxIterations );
+RenderParams getRenderParams( void );
+bool equalsIterationRenderParams( const RenderParams *p1, const RenderParams *p2 );
+bool equalsColorRenderParams( const RenderParams *p1, const RenderParams *p2 );
+void setBenchmarkView( int view );
+const char *getStatsText( const RenderStats *stats );
+void startDeepZoom( void );
+void stopDeepZoom( void );
+void zoomDeepZoom( double factor, int mouseX, int mouseY );
+void updateDeepZoomOrbit( void );
+int runPoster( int argc, char **argv );
 
 /**
  * @brief Draws the state of the game.
@@ -141,7 +196,17 @@ void drawComplexBar( const ComplexBar *complexBar );
 void drawSliderControl( const SliderControl *sliderControl );
 bool interceptsSliderControlCoord( const SliderControl *sliderControl, int x, int y );
 
-int main( void ) {
+int main( int argc, char **argv ) {
+
+    // headless benchmark of the escape time kernels
+    if ( argc > 1 && strcmp( argv[1], "--kernel-benchmark" ) == 0 ) {
+        return runFractalKernelBenchmark() ? 0 : 1;
+    }
+
+    // headless render of a huge image to a file
+    if ( argc > 1 && strcmp( argv[1], "--poster" ) == 0 ) {
+        return runPoster( argc, argv );
+    }
 
     SetConfigFlags( FLAG_MSAA_4X_HINT );
     InitWindow( SCREENS_SIZE, SCREENS_SIZE, "Fractais de Mandelbrot e Julia" );
@@ -238,11 +303,24 @@ int main( void ) {
 
     currentZoom = 0;
 
+    for ( int i = 0; i < FRACTAL_SHORTCUT_COUNT; i++ ) {
+        shortcuts[i] = START_SHORTCUTS;
+    }
+
+    Image fractalImage = GenImageColor( GetScreenWidth(), GetScreenHeight(), WHITE );
+    fractalTexture = LoadTextureFromImage( fractalImage );
+    UnloadImage( fractalImage );
+    fractalRenderer = createFractalRenderer( GetScreenWidth(), GetScreenHeight(), RENDER_TILE_SIZE, getProcessorCount() );
+    fractalRendered = false;
+
     while ( !WindowShouldClose() ) {
         inputAndUpdate();
         draw();
     }
 
+    destroyFractalRenderer( fractalRenderer );
+    UnloadTexture( fractalTexture );
+
     CloseAudioDevice();
     CloseWindow();
     return 0;
@@ -311,7 +389,13 @@ void inputAndUpdate( void ) {
 
     int wheelMove = GetMouseWheelMove();
 
-    if ( wheelMove > 0 ) {
+    if ( deepZoom ) {
+        if ( wheelMove > 0 ) {
+            zoomDeepZoom( 1 / DEEP_ZOOM_FACTOR, GetMouseX(), GetMouseY() );
+        } else if ( wheelMove < 0 ) {
+            zoomDeepZoom( DEEP_ZOOM_FACTOR, GetMouseX(), GetMouseY() );
+        }
+    } else if ( wheelMove > 0 ) {
 
         if ( currentZoom < MAX_ZOOM ) {
 
@@ -364,10 +448,13 @@ void inputAndUpdate( void ) {
 
     }
 
+    // deep views need thousands of iterations
+    int iterationsStep = IsKeyDown( KEY_LEFT_SHIFT ) ? 1000 : 10;
+
     if ( IsKeyPressed( KEY_UP ) ) {
-        maxIterations += 10;
+        maxIterations += iterationsStep;
     } else if ( IsKeyPressed( KEY_DOWN ) ) {
-        maxIterations -= 10;
+        maxIterations -= iterationsStep;
         if ( maxIterations < 0 ) {
             maxIterations = 0;
         }
@@ -388,6 +475,9 @@ void inputAndUpdate( void ) {
         maxY = MAX_Y;
         currentZoom = 0;
         mandelbrot = true;
+        if ( deepZoom ) {
+            startDeepZoom();
+        }
     }
 
     if ( IsKeyPressed( KEY_J ) ) {
@@ -397,6 +487,25 @@ void inputAndUpdate( void ) {
         maxY = scapeRadius;
         currentZoom = 0;
         mandelbrot = false;
+        if ( deepZoom ) {
+            startDeepZoom();
+        }
+    }
+
+    // cycles between the kernels supported by the processor
+    if ( IsKeyPressed( KEY_K ) ) {
+        FractalKernelType kernel = getKernelFractalRenderer( fractalRenderer );
+        do {
+            kernel = ( kernel + 1 ) % FRACTAL_KERNEL_TYPE_COUNT;
+        } while ( !isSupportedFractalKernel( kernel ) );
+        setKernelFractalRenderer( fractalRenderer, kernel );
+        fractalRendered = false;
+    }
+
+    for ( int i = 0; i < FRACTAL_SHORTCUT_COUNT; i++ ) {
+        if ( IsKeyPressed( KEY_ONE + i ) ) {
+            shortcuts[i] = !shortcuts[i];
+        }
     }
 
     if ( IsKeyPressed( KEY_Z ) ) {
@@ -416,6 +525,17 @@ void inputAndUpdate( void ) {
             maxY = scapeRadius;
         }
         currentZoom = 0;
+        if ( deepZoom ) {
+            startDeepZoom();
+        }
+    }
+
+    if ( IsKeyPressed( KEY_D ) && benchmarkView == -1 ) {
+        if ( deepZoom ) {
+            stopDeepZoom();
+        } else {
+            startDeepZoom();
+        }
     }
 
     hueControlStart.value = Lerp( MIN_HUE, MAX_HUE, ( hueControlStart.pos.x - colorBar.pos.x ) / colorBar.width );
@@ -426,217 +546,294 @@ void inputAndUpdate( void ) {
     cx = complexControlReal.value;
     cy = complexControlImaginary.value;
 
+    // the next benchmark view starts when the current one is final
+    if ( benchmarkView != -1 && fractalRendered && isFinishedFractalRenderer( fractalRenderer ) ) {
+        benchmarkTimes[benchmarkView] = getRenderTimeFractalRenderer( fractalRenderer );
+        benchmarkTilesPerSecond[benchmarkView] = getTilesPerSecondFractalRenderer( fractalRenderer );
+        benchmarkStats[benchmarkView] = getStatsFractalRenderer( fractalRenderer );
+        TraceLog( LOG_INFO, "BENCHMARK: view %d: %.3f s to final image, %.1f tiles/s, %s", 
+                  benchmarkView, benchmarkTimes[benchmarkView], benchmarkTilesPerSecond[benchmarkView],
+                  getStatsText( &benchmarkStats[benchmarkView] ) );
+        if ( benchmarkView + 1 < BENCHMARK_VIEWS ) {
+            setBenchmarkView( benchmarkView + 1 );
+        } else {
+            benchmarkView = -1;
+            benchmarkDone = true;
+        }
+    }
+
+    if ( IsKeyPressed( KEY_B ) && benchmarkView == -1 ) {
+        benchmarkDone = false;
+        setBenchmarkView( 0 );
+    }
+
+    if ( deepZoom ) {
+        updateDeepZoomOrbit();
+    }
+
+    RenderParams params = getRenderParams();
+
+    // colors alone do not need the fractal to be iterated again
+    if ( !fractalRendered || !equalsIterationRenderParams( &params, &renderedParams ) ) {
+        startFractalRenderer( fractalRenderer, &params );
+        renderedParams = params;
+        fractalRendered = true;
+    } else if ( !equalsColorRenderParams( &params, &renderedParams ) ) {
+        recolorFractalRenderer( fractalRenderer, &params );
+        renderedParams = params;
+    }
+
+    uploadFractalRenderer( fractalRenderer, fractalTexture );
+
 }
 
-void draw( void ) {
+void setBenchmarkView( int view ) {
+    if ( deepZoom ) {
+        stopDeepZoom();
+    }
+    benchmarkView = view;
+    minX = BENCHMARK_VIEW_DATA[view][0];
+    maxX = BENCHMARK_VIEW_DATA[view][1];
+    minY = BENCHMARK_VIEW_DATA[view][2];
+    maxY = BENCHMARK_VIEW_DATA[view][3];
+    maxIterations = (int) BENCHMARK_VIEW_DATA[view][4];
+    mandelbrot = true;
+    currentZoom = 0;
 
-    BeginDrawing();
-    ClearBackground( WHITE );
+}
 
-    // based on https://en.wikipedia.org/wiki/Mandelbrot_set
-    //          https://en.wikipedia.org/wiki/Julia_set
-    
-    Color color = { 0, 0, 0, 255 };
-
-    for ( int i = 0; i < GetScreenHeight(); i++ ) {
-        for ( int j = 0; j < GetScreenWidth(); j++ ) {
-
-            double px = j;
-            double py = i;
-            double x = 0.0;
-            double y = 0.0;
-            double x0;
-            double y0;
-            double xTemp;
-            int iteration;
-
-            if ( mandelbrot ) {
-
-                // fixed complex number
-                x0 = Lerp( minX, maxX, ( px / GetScreenWidth() ) );   // real
-                y0 = Lerp( minY, maxY, ( py / GetScreenHeight() ) );  // imaginary
-
-                for ( iteration = 0; 
-                      iteration < maxIterations && 
-                      x*x + y*y <= ( 1 << 16 ); 
-                      iteration++ ) {
-                    xTemp = x * x - y * y + x0;
-                    y = 2 * x * y + y0;
-                    x = xTemp;
-                }
+/**
+ * @brief Starts the deep zoom from the current view.
+ */
+void startDeepZoom( void ) {
+    deepZoom = true;
+    setDoubleBigFloat( &deepCenterX, ( minX + maxX ) / 2, BIG_FLOAT_MAX_LIMBS );
+    setDoubleBigFloat( &deepCenterY, ( minY + maxY ) / 2, BIG_FLOAT_MAX_LIMBS );
+    deepSpanX = maxX - minX;
+    deepSpanY = maxY - minY;
+    deepOrbitDirty = true;
+}
 
-                if ( colored ) {
-
-                    if ( gradient ) {
-
-                        double diff = 0;
-                        if ( iteration < maxIterations ) {
-                            double logZn = log( x * x + y * y ) / 2;
-                            double nu = log( logZn / log(2) ) / log(2);
-                            diff = iteration - 1 - nu;
-                        }
-
-                        double vStart = diff;
-                        double vEnd = diff;
-                        /*double vStart = diff;
-                        double vEnd = iteration;
-                        double vStart = iteration;
-                        double vEnd = diff;
-                        double vStart = iteration;
-                        double vEnd = iteration;*/
-
-                        Color color1 = ColorFromHSV( 
-                                hueControlStart.value + 
-                                ( hueControlEnd.value - hueControlStart.value ) * 
-                                ( ((int) vStart) / (double) maxIterations ), 
-                                1, 0.7 );
-                        Color color2 = ColorFromHSV( 
-                                hueControlStart.value + 
-                                ( hueControlEnd.value - hueControlStart.value ) * 
-                                ( ((int) (vEnd+1)) / (double) maxIterations ), 
-                                1, 0.7 );
-
-                        diff = diff - ((long)diff);
-
-                        color = (Color) {
-                            .r = Lerp( color1.r, color2.r, diff ),
-                            .g = Lerp( color1.g, color2.g, diff ),
-                            .b = Lerp( color1.b, color2.b, diff ),
-                            .a = 255
-                        };
-
-                    } else {
-
-                        color = ColorFromHSV( hueControlStart.value + 
-                            ( hueControlEnd.value - hueControlStart.value ) * 
-                            ( iteration / (double) maxIterations ), 
-                            1, 0.7 );
-
-                    }
-
-                } else {
-
-                    int c;
-                    
-                    if ( gradient ) {
-
-                        double diff = 0;
-                        if ( iteration < maxIterations ) {
-                            double logZn = log( x * x + y * y ) / 2;
-                            double nu = log( logZn / log(2) ) / log(2);
-                            diff = iteration - 1 - nu;
-                        }
-                        
-                        double c1 = 255 * (diff) / ( (double) maxIterations );
-                        double c2 = 255 * (diff+1) / ( (double) maxIterations );
-                        diff = diff - ((long)diff);
-
-                        c = Lerp( c1, c2, diff );
-
-                    } else {
-                        c = 255 - 255 * ( iteration / (double) maxIterations );
-                    }
-
-                    color.r = c;
-                    color.g = c;
-                    color.b = c;
+/**
+ * @brief Goes back to the plain kernels, as near to the deep view as
+ * doubles allow.
+ */
+void stopDeepZoom( void ) {
 
-                }
+    double centerX = toDoubleBigFloat( &deepCenterX, BIG_FLOAT_MAX_LIMBS );
+    double centerY = toDoubleBigFloat( &deepCenterY, BIG_FLOAT_MAX_LIMBS );
 
-            } else {
-
-                // variyng complex number (min and max related to scapeRadius)
-                x0 = Lerp( minX, maxX, ( px / GetScreenWidth() ) );    // real
-                y0 = Lerp( minY, maxY, ( py / GetScreenHeight() ) );   // imaginary
-                
-                for ( iteration = 0; 
-                      iteration < maxIterations && 
-                      x0*x0 + y0*y0 < scapeRadius*scapeRadius; 
-                      iteration++ ) {
-                    xTemp = x0 * x0 - y0 * y0;
-                    y0 = 2 * x0 * y0 + cy;
-                    x0 = xTemp + cx;
-                }
+    minX = centerX - deepSpanX / 2;
+    maxX = centerX + deepSpanX / 2;
+    minY = centerY - deepSpanY / 2;
+    maxY = centerY + deepSpanY / 2;
+    currentZoom = 0;
 
-                if ( colored ) {
+    // the renderer frees the orbit when it is replaced
+    deepZoom = false;
+    deepOrbit = NULL;
 
-                    if ( gradient ) {
+}
 
-                        double diff = 0;
-                        if ( iteration < maxIterations ) {
-                            double logZn = log( x0 * x0 + y0 * y0 ) / 2;
-                            double nu = log( logZn / log(2) ) / log(2);
-                            diff = iteration - 1 - nu;
-                        }
+/**
+ * @brief Zooms in (factor < 1) centering the view at the mouse, or
+ * zooms out (factor > 1) keeping the center.
+ */
+void zoomDeepZoom( double factor, int mouseX, int mouseY ) {
+
+    if ( factor < 1 ) {
+        // full precision, the orbit takes only the limbs it needs
+        addDoubleBigFloat( &deepCenterX, &deepCenterX, ( (double) mouseX / GetScreenWidth() - 0.5 ) * deepSpanX, BIG_FLOAT_MAX_LIMBS );
+        addDoubleBigFloat( &deepCenterY, &deepCenterY, ( (double) mouseY / GetScreenHeight() - 0.5 ) * deepSpanY, BIG_FLOAT_MAX_LIMBS );
+    } else if ( deepSpanX * factor > DEEP_ZOOM_MAX_SPAN ) {
+        return;
+    }
 
-                        double vStart = diff;
-                        double vEnd = diff;
+    deepSpanX *= factor;
+    deepSpanY *= factor;
+    deepOrbitDirty = true;
 
-                        Color color1 = ColorFromHSV( 
-                                hueControlStart.value + 
-                                ( hueControlEnd.value - hueControlStart.value ) * 
-                                ( ((int) vStart) / (double) maxIterations ), 
-                                1, 0.7 );
-                        Color color2 = ColorFromHSV( 
-                                hueControlStart.value + 
-                                ( hueControlEnd.value - hueControlStart.value ) * 
-                                ( ((int) (vEnd+1)) / (double) maxIterations ), 
-                                1, 0.7 );
+}
 
-                        diff = diff - ((long)diff);
+/**
+ * @brief Computes the reference orbit again when the center or the
+ * iteration parameters change.
+ */
+void updateDeepZoomOrbit( void ) {
+
+    static int orbitMaxIterations;
+    static bool orbitMandelbrot;
+    static double orbitCx;
+    static double orbitCy;
+
+    if ( !deepOrbitDirty && deepOrbit != NULL &&
+         orbitMaxIterations == maxIterations &&
+         orbitMandelbrot == mandelbrot &&
+         ( mandelbrot || ( orbitCx == cx && orbitCy == cy ) ) ) {
+        return;
+    }
 
-                        color = (Color) {
-                            .r = Lerp( color1.r, color2.r, diff ),
-                            .g = Lerp( color1.g, color2.g, diff ),
-                            .b = Lerp( color1.b, color2.b, diff ),
-                            .a = 255
-                        };
+    RenderParams params = getRenderParams();
+    FractalKernelRow row;
+    setupFractalKernelRow( &params, &row );
+
+    int limbs = getLimbsDeepZoom( fmin( deepSpanX, deepSpanY ) );
+    BigFloat zero;
+    setDoubleBigFloat( &zero, 0, limbs );
+
+    if ( mandelbrot ) {
+        deepOrbit = createReferenceOrbit( &zero, &zero, &deepCenterX, &deepCenterY, maxIterations, row.bailout, limbs );
+    } else {
+        BigFloat juliaX;
+        BigFloat juliaY;
+        setDoubleBigFloat( &juliaX, cx, limbs );
+        setDoubleBigFloat( &juliaY, cy, limbs );
+        deepOrbit = createReferenceOrbit( &deepCenterX, &deepCenterY, &juliaX, &juliaY, maxIterations, row.bailout, limbs );
+    }
 
-                    } else {
+    orbitMaxIterations = maxIterations;
+    orbitMandelbrot = mandelbrot;
+    orbitCx = cx;
+    orbitCy = cy;
+    deepOrbitDirty = false;
 
-                        color = ColorFromHSV( hueControlStart.value + 
-                            ( hueControlEnd.value - hueControlStart.value ) * 
-                            ( iteration / (double) maxIterations ), 
-                            1, 0.7 );
+    // the new orbit may reuse the address of a freed one
+    fractalRendered = false;
 
-                    }
+}
 
-                } else {
+/**
+ * @brief Iterations done and saved by each shortcut, in millions.
+ */
+const char *getStatsText( const RenderStats *stats ) {
+    return TextFormat( "%.1fM iterations, saved: %s %.1fM, %s %.1fM, %s %.1fM",
+                       stats->iterations / 1e6,
+                       getNameFractalShortcut( FRACTAL_SHORTCUT_CARDIOID ),
+                       stats->savedIterations[FRACTAL_SHORTCUT_CARDIOID] / 1e6,
+                       getNameFractalShortcut( FRACTAL_SHORTCUT_PERIODICITY ),
+                       stats->savedIterations[FRACTAL_SHORTCUT_PERIODICITY] / 1e6,
+                       getNameFractalShortcut( FRACTAL_SHORTCUT_SUBDIVISION ),
+                       stats->savedIterations[FRACTAL_SHORTCUT_SUBDIVISION] / 1e6 );
+}
 
-                    int c;
-                    
-                    if ( gradient ) {
+RenderParams getRenderParams( void ) {
+
+    RenderParams params = {
+        .minX = minX,
+        .maxX = maxX,
+        .minY = minY,
+        .maxY = maxY,
+        .mandelbrot = mandelbrot,
+        .colored = colored,
+        .gradient = gradient,
+        .maxIterations = maxIterations,
+        .cx = cx,
+        .cy = cy,
+        .scapeRadius = scapeRadius,
+        .hueStart = hueControlStart.value,
+        .hueEnd = hueControlEnd.value,
+        .deep = deepZoom,
+        .spanX = deepSpanX,
+        .spanY = deepSpanY,
+        .orbit = deepZoom ? deepOrbit : NULL
+    };
 
-                        double diff = 0;
-                        if ( iteration < maxIterations ) {
-                            double logZn = log( x0 * x0 + y0 * y0 ) / 2;
-                            double nu = log( logZn / log(2) ) / log(2);
-                            diff = iteration - 1 - nu;
-                        }
-                        
-                        double c1 = 255 * (diff) / ( (double) maxIterations );
-                        double c2 = 255 * (diff+1) / ( (double) maxIterations );
-                        diff = diff - ((long)diff);
+    for ( int i = 0; i < FRACTAL_SHORTCUT_COUNT; i++ ) {
+        params.shortcuts[i] = shortcuts[i];
+    }
 
-                        c = Lerp( c1, c2, diff );
+    return params;
 
-                    } else {
-                        c = 255 - 255 * ( iteration / (double) maxIterations );
-                    }
+}
 
-                    color.r = c;
-                    color.g = c;
-                    color.b = c;
+/**
+ * @brief --poster file width height [minX maxX minY maxY [iterations]]
+ * Without a region, renders the whole Mandelbrot set, widened to the
+ * proportion of the image.
+ */
+int runPoster( int argc, char **argv ) {
 
-                }
+    if ( argc != 5 && argc != 9 && argc != 10 ) {
+        fprintf( stderr, "usage: %s --poster file width height [minX maxX minY maxY [iterations]]\n", argv[0] );
+        return 1;
+    }
 
-            }
+    int width = atoi( argv[3] );
+    int height = atoi( argv[4] );
+    if ( width <= 0 || height <= 0 ) {
+        fprintf( stderr, "invalid size %sx%s\n", argv[3], argv[4] );
+        return 1;
+    }
 
-            DrawPixel( px, py, color );
+    RenderParams params = {
+        .minX = MIN_X,
+        .maxX = MAX_X,
+        .minY = MIN_Y,
+        .maxY = MAX_Y,
+        .mandelbrot = true,
+        .colored = START_COLORED,
+        .gradient = START_GRADIENT,
+        .maxIterations = POSTER_MAX_ITERATIONS,
+        .scapeRadius = 2,
+        .hueStart = MIN_HUE,
+        .hueEnd = MAX_HUE
+    };
 
+    if ( argc >= 9 ) {
+        params.minX = atof( argv[5] );
+        params.maxX = atof( argv[6] );
+        params.minY = atof( argv[7] );
+        params.maxY = atof( argv[8] );
+        if ( argc == 10 ) {
+            params.maxIterations = atoi( argv[9] );
         }
+    } else {
+        double scale = fmax( ( MAX_X - MIN_X ) / width, ( MAX_Y - MIN_Y ) / height );
+        double centerX = ( MIN_X + MAX_X ) / 2;
+        double centerY = ( MIN_Y + MAX_Y ) / 2;
+        params.minX = centerX - scale * width / 2;
+        params.maxX = centerX + scale * width / 2;
+        params.minY = centerY - scale * height / 2;
+        params.maxY = centerY + scale * height / 2;
     }
 
+    for ( int i = 0; i < FRACTAL_SHORTCUT_COUNT; i++ ) {
+        params.shortcuts[i] = START_SHORTCUTS;
+    }
+
+    return renderPoster( &params, width, height, getProcessorCount(), argv[2] ) ? 0 : 1;
+
+}
+
+bool equalsIterationRenderParams( const RenderParams *p1, const RenderParams *p2 ) {
+    return p1->deep == p2->deep &&
+           // deep views are placed by the orbit and the span
+           ( p1->deep ?
+               p1->orbit == p2->orbit && p1->spanX == p2->spanX && p1->spanY == p2->spanY :
+               p1->minX == p2->minX && p1->maxX == p2->maxX &&
+               p1->minY == p2->minY && p1->maxY == p2->maxY ) &&
+           p1->mandelbrot == p2->mandelbrot &&
+           p1->maxIterations == p2->maxIterations &&
+           p1->scapeRadius == p2->scapeRadius &&
+           memcmp( p1->shortcuts, p2->shortcuts, sizeof( p1->shortcuts ) ) == 0 &&
+           // julia constant only matters for julia sets
+           ( p1->mandelbrot || ( p1->cx == p2->cx && p1->cy == p2->cy ) );
+}
+
+bool equalsColorRenderParams( const RenderParams *p1, const RenderParams *p2 ) {
+    return p1->colored == p2->colored &&
+           p1->gradient == p2->gradient &&
+           // hue only matters when colored
+           ( !p1->colored || ( p1->hueStart == p2->hueStart && p1->hueEnd == p2->hueEnd ) );
+}
+
+void draw( void ) {
+
+    BeginDrawing();
+    ClearBackground( WHITE );
+
+    DrawTexture( fractalTexture, 0, 0, WHITE );
+
     if ( zooming ) {
         DrawRectangleLines( 
             GetMouseX() - ZOOM_SQUARE_SIZE / 2, 
@@ -655,6 +852,41 @@ void draw( void ) {
     }
 
     DrawFPS( 20, GetScreenHeight() - 60 );
+    DrawText( 
+        TextFormat( "%s (%s): %.3f s, %.0f tiles/s, recolor %.3f ms", 
+                    isFinishedFractalRenderer( fractalRenderer ) ? "final" : "rendering",
+                    getNameFractalKernel( getKernelFractalRenderer( fractalRenderer ) ),
+                    getRenderTimeFractalRenderer( fractalRenderer ),
+                    getTilesPerSecondFractalRenderer( fractalRenderer ),
+                    getRecolorTimeFractalRenderer( fractalRenderer ) * 1000 ),
+        20, GetScreenHeight() - 80, 20, WHITE );
+
+    RenderStats stats = getStatsFractalRenderer( fractalRenderer );
+    DrawText( 
+        TextFormat( "shortcuts (1, 2, 3): %s %s %s", 
+                    shortcuts[FRACTAL_SHORTCUT_CARDIOID] ? "on" : "off",
+                    shortcuts[FRACTAL_SHORTCUT_PERIODICITY] ? "on" : "off",
+                    shortcuts[FRACTAL_SHORTCUT_SUBDIVISION] ? "on" : "off" ),
+        20, GetScreenHeight() - 140, 20, WHITE );
+    DrawText( getStatsText( &stats ), 20, GetScreenHeight() - 120, 20, WHITE );
+
+    if ( deepZoom ) {
+        DrawText( 
+            TextFormat( "deep zoom: span %.3e, %d bits, orbit %d/%d, %lld glitches", 
+                        deepSpanX, deepOrbit->limbs * 32, deepOrbit->length, maxIterations + 1,
+                        stats.glitches ),
+            20, GetScreenHeight() - 100, 20, WHITE );
+    }
+
+    if ( benchmarkView != -1 || benchmarkDone ) {
+        for ( int i = 0; i < BENCHMARK_VIEWS; i++ ) {
+            const char *text = i < benchmarkView || benchmarkDone ?
+                TextFormat( "view %d: %.3f s, %.0f tiles/s, %s", i, benchmarkTimes[i], benchmarkTilesPerSecond[i], getStatsText( &benchmarkStats[i] ) ) :
+                TextFormat( "view %d: %s", i, i == benchmarkView ? "rendering..." : "waiting" );
+            DrawText( text, 20, 60 + i * 25, 20, WHITE );
+        }
+    }
+
     EndDrawing();
 
 }